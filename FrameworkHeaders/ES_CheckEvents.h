@@ -24,6 +24,5 @@ typedef bool CheckFunc (void);
 typedef CheckFunc (*pCheckFunc);
 
 bool ES_CheckUserEvents(void);
-bool CheckIRSensor(void);
 
 #endif  // ES_CheckEvents_H
@@ -33,7 +33,7 @@
 /****************************************************************************/
 // This macro determines that nuber of services that are *actually* used in
 // a particular application. It will vary in value from 1 to MAX_NUM_SERVICES
-#define NUM_SERVICES 5
+#define NUM_SERVICES 7
 
 /****************************************************************************/
 // These are the definitions for Service 0, the lowest priority service.
@@ -83,11 +83,11 @@
 // These are the definitions for Service 3
 #if NUM_SERVICES > 3
 // the header file with the public function prototypes
-#define SERV_3_HEADER "PerceptionService.h"
+#define SERV_3_HEADER "ShiftService.h"
 // the name of the Init function
-#define SERV_3_INIT InitPerceptionService
+#define SERV_3_INIT InitShiftService
 // the name of the run function
-#define SERV_3_RUN RunPerceptionService
+#define SERV_3_RUN RunShiftService
 // How big should this services Queue be?
 #define SERV_3_QUEUE_SIZE 3
 #endif
@@ -109,11 +109,11 @@
 // These are the definitions for Service 5
 #if NUM_SERVICES > 5
 // the header file with the public function prototypes
-#define SERV_5_HEADER "TestHarnessService5.h"
+#define SERV_5_HEADER "LEDSeqService.h"
 // the name of the Init function
-#define SERV_5_INIT InitTestHarnessService5
+#define SERV_5_INIT InitLEDSeqService
 // the name of the run function
-#define SERV_5_RUN RunTestHarnessService5
+#define SERV_5_RUN RunLEDSeqService
 // How big should this services Queue be?
 #define SERV_5_QUEUE_SIZE 3
 #endif
@@ -122,11 +122,11 @@
 // These are the definitions for Service 6
 #if NUM_SERVICES > 6
 // the header file with the public function prototypes
-#define SERV_6_HEADER "TestHarnessService6.h"
+#define SERV_6_HEADER "HapticService.h"
 // the name of the Init function
-#define SERV_6_INIT InitTestHarnessService6
+#define SERV_6_INIT InitHapticService
 // the name of the run function
-#define SERV_6_RUN RunTestHarnessService6
+#define SERV_6_RUN RunHapticService
 // How big should this services Queue be?
 #define SERV_6_QUEUE_SIZE 3
 #endif
@@ -272,7 +272,11 @@ typedef enum
           ES_UPDATE_SHIFT,
           ES_BUZZ,
           ES_SCROLL,
-          ES_NEW_POT
+          ES_NEW_POT,
+          ES_SPI_DONE,          /* SPI1 transaction queue has drained */
+          ES_PLAY_LED_SEQ,      /* EventParam is the LEDSeq_t to play */
+          ES_STOP_LED_SEQ,      /* EventParam is the LEDSeq_t to stop */
+          ES_HAPTIC             /* EventParam is the HapticPattern_t to play */
 
 }ES_EventType_t;
 
@@ -308,7 +312,7 @@ typedef enum
 
 /****************************************************************************/
 // This is the list of event checking functions
-#define EVENT_CHECK_LIST Check4Keystroke, CheckHallEffect, CheckIRSensor, CheckPotSensor
+#define EVENT_CHECK_LIST Check4Keystroke, CheckSensorEdges, CheckPotSensor
 
 /****************************************************************************/
 // These are the definitions for the post functions to be executed when the
@@ -320,13 +324,13 @@ typedef enum
 #define TIMER0_RESP_FUNC TIMER_UNUSED
 #define TIMER1_RESP_FUNC TIMER_UNUSED
 #define TIMER2_RESP_FUNC TIMER_UNUSED
-#define TIMER3_RESP_FUNC TIMER_UNUSED
-#define TIMER4_RESP_FUNC TIMER_UNUSED
-#define TIMER5_RESP_FUNC TIMER_UNUSED
+#define TIMER3_RESP_FUNC PostHapticService
+#define TIMER4_RESP_FUNC PostLEDSeqService
+#define TIMER5_RESP_FUNC PostLEDService
 #define TIMER6_RESP_FUNC PostLEDService
-#define TIMER7_RESP_FUNC PostGameService
+#define TIMER7_RESP_FUNC TIMER_UNUSED
 #define TIMER8_RESP_FUNC PostBuzzService
-#define TIMER9_RESP_FUNC PostPerceptionService
+#define TIMER9_RESP_FUNC PostShiftService
 #define TIMER10_RESP_FUNC PostGameService
 #define TIMER11_RESP_FUNC PostGameService
 #define TIMER12_RESP_FUNC PostGameService
@@ -350,7 +354,9 @@ typedef enum
 #define USER_INPUT_TIMER 10
 #define SHIFT_TIMER 9
 #define BUZZER_TIMER 8
-#define COIN_DELAY_TIMER 7
 #define SCROLL_TIMER 6
+#define BRIGHTNESS_TIMER 5
+#define LED_SEQ_TIMER 4
+#define HAPTIC_TIMER 3
 
 #endif /* ES_CONFIGURE_H */
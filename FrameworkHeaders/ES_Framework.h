@@ -40,10 +40,77 @@ typedef enum
   FailedOther
 }ES_Return_t;
 
+// every post, post turned away, and run function call and return goes in
+// a trace of the last ES_TRACE_LEN; ES_PrintEventHistory prints the last
+// ES_HISTORY_LEN of them and ES_StartTraceDump sends the lot
+#define ES_TRACE_LEN   256      // a power of 2
+#define ES_HISTORY_LEN 24
+
+// uncomment to stop at the first post a queue turns away, printing the
+// queues and the history before it
+//#define ES_TRAP_ON_OVERFLOW
+
+// how a service's queue has fared since reset
+typedef struct
+{
+  uint8_t Size;
+  uint8_t Depth;                // events in it now
+  uint8_t HighWater;            // the most it has held
+  uint32_t NumFailed;           // posts it turned away
+  ES_Event_t FirstFailed;       // the first of them
+}ES_QueueStats_t;
+
+// how long the passes through ES_Run's loop took, in CP0 Count ticks
+typedef struct
+{
+  uint32_t NumLoops;
+  uint32_t TotalTicks;
+  uint32_t MaxTicks;
+}ES_LoopStats_t;
+
+// a pass through ES_Run's loop longer than this is an overrun
+#define ES_LATENCY_LIMIT_US 2000
+// passes are counted by length in buckets that double from 12.8us, the
+// first for anything shorter and the last for anything longer
+#define ES_LATENCY_BUCKETS  15
+#define ES_NO_SERVICE       0xFF
+
+// a long pass, with the longest run function call in it
+typedef struct
+{
+  uint32_t Ticks;               // the pass, in CP0 Count ticks
+  uint16_t Stamp;               // ES_Timer_GetTime() as it ended, in ms
+  uint32_t RunTicks;            // the call
+  ES_Event_t Event;             // the event it ran
+  uint8_t Service;              // or ES_NO_SERVICE if it ran none
+  uint8_t NumRuns;              // the calls in the pass
+}ES_Overrun_t;
+
+// how long the passes through ES_Run's loop have taken
+typedef struct
+{
+  uint32_t NumPasses;
+  uint32_t NumOverruns;         // passes over ES_LATENCY_LIMIT_US
+  uint32_t Buckets[ES_LATENCY_BUCKETS];
+  ES_Overrun_t Worst;           // the longest pass
+  ES_Overrun_t Last;            // the last overrun
+}ES_LatencyStats_t;
+
 ES_Return_t ES_Initialize(TimerRate_t NewRate);
 ES_Return_t ES_Run(void);
 bool ES_PostAll(ES_Event_t ThisEvent);
 bool ES_PostToService(uint8_t WhichService, ES_Event_t ThisEvent);
 bool ES_PostToServiceLIFO(uint8_t WhichService, ES_Event_t TheEvent);
+uint8_t ES_GetNumServices(void);
+uint8_t ES_GetQueueDepth(uint8_t WhichService);
+uint32_t ES_GetDispatchCount(uint8_t WhichService);
+void ES_TakeLoopStats(ES_LoopStats_t *pStats);
+const char *ES_GetServiceName(uint8_t WhichService);
+bool ES_GetQueueStats(uint8_t WhichService, ES_QueueStats_t *pStats);
+void ES_PrintQueueStats(void);
+void ES_PrintEventHistory(void);
+void ES_StartTraceDump(void);
+void ES_GetLatencyStats(ES_LatencyStats_t *pStats);
+void ES_PrintLatencyStats(void);
 
 #endif   // ES_Framework_H
@@ -69,6 +69,22 @@ extern  uint8_t _INTCON_temp;
 // For the PIC32, we *can* post from interrupts
 #define POST_FROM_INTS
 
+// uncomment to have ES_Run feed the watchdog at the top of each pass through
+// its loop. The configuration bits in ES_Port.c then give it about 512ms,
+// so a run function or event checker that hangs resets the PIC32, and
+// ES_Initialize reports which service was running when it did.
+//#define ES_WATCHDOG
+
+// _HW_Watchdog_Stop turns it off for good, for the overflow trap and
+// _fassert, whose printouts wait on the UART far longer than the period
+#ifdef ES_WATCHDOG
+#define _HW_Watchdog_Feed() (WDTCONSET = _WDTCON_WDTCLR_MASK)
+#define _HW_Watchdog_Stop() (WDTCONCLR = _WDTCON_ON_MASK)
+#else
+#define _HW_Watchdog_Feed()
+#define _HW_Watchdog_Stop()
+#endif
+
 // in the MIPS architecture, interrupts are not disabled on entry to an ISR
 // the interrupt controller simply prevents interrupts from lower or the
 // same priority. As a result, we can create a critical region by simply
@@ -119,6 +135,10 @@ bool _HW_Process_Pending_Ints(void);
 uint16_t _HW_GetTickCount(void);
 void _HW_ConsoleInit(void);
 void _HW_SysTickIntHandler(void);
+#ifdef ES_WATCHDOG
+void _HW_Watchdog_Init(void);
+bool _HW_WasWatchdogReset(void);
+#endif
 
 // and the one Framework function that we define here
 uint16_t ES_Timer_GetTime(void);
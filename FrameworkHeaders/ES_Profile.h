@@ -0,0 +1,122 @@
+/****************************************************************************
+ Module
+   ES_Profile.h
+
+ Description
+   Where ES_Run's time goes, in CP0 Count ticks (20MHz). The framework
+   times each call of a service's run function, charging it to the
+   service and to the event type it ran, each event checker, and the
+   BinLog_Flush and Terminal_MoveBuffer2UART calls in the idle branch.
+   What is left of each pass through the loop, the timer ticks, dequeues
+   and the probes themselves, is charged to the framework. Passes that
+   ran no service and found no new event are also totalled as idle.
+
+   ES_Profile_Print sends the table to the terminal, largest first, and
+   starts over. The test harness calls it from the keyboard.
+
+ Notes
+   Compiled in only when ES_PROFILE is defined, here or in the project's
+   preprocessor macros. Without it the probes below are empty, so ES_Run
+   is the same code as before they were added, and ES_Profile_Print only
+   says so.
+
+   A probe reads the CP0 Count twice and adds the difference to a 64 bit
+   total, with a count and a maximum. ES_Profile_Print times one on the
+   spot and prints what all of them cost together, as a share of the time
+   profiled, so the numbers say how much they are disturbed.
+
+   Main loop only; the ISRs' time shows up in whatever they interrupted.
+****************************************************************************/
+#ifndef ES_PROFILE_H
+#define ES_PROFILE_H
+
+#include <stdbool.h>
+#include <stdint.h>
+#include "ES_Configure.h"
+
+// uncomment to compile the profiling probes into ES_Run
+//#define ES_PROFILE
+
+// the work in ES_Run's idle branch
+typedef enum
+{
+  ES_PROFILE_FLUSH,     // BinLog_Flush
+  ES_PROFILE_TERMINAL   // Terminal_MoveBuffer2UART
+} ES_ProfileWork_t;
+
+#ifdef ES_PROFILE
+#include <xc.h>
+
+// Start is a uint32_t the caller declares, under #ifdef ES_PROFILE
+#define ES_PROFILE_START(Start) ((Start) = _CP0_GET_COUNT())
+#define ES_PROFILE_SERVICE(WhichService, EventType, Start) \
+  ES_Profile_AddService((WhichService), (EventType),     \
+                        _CP0_GET_COUNT() - (Start))
+#define ES_PROFILE_CHECKER(WhichChecker, IsNewEvent, Start) \
+  ES_Profile_AddChecker((WhichChecker), (IsNewEvent),       \
+                        _CP0_GET_COUNT() - (Start))
+#define ES_PROFILE_WORK(Which, Start) \
+  ES_Profile_AddWork((Which), _CP0_GET_COUNT() - (Start))
+#define ES_PROFILE_PASS(Ticks) ES_Profile_AddPass(Ticks)
+#else
+#define ES_PROFILE_START(Start)
+#define ES_PROFILE_SERVICE(WhichService, EventType, Start)
+#define ES_PROFILE_CHECKER(WhichChecker, IsNewEvent, Start)
+#define ES_PROFILE_WORK(Which, Start)
+#define ES_PROFILE_PASS(Ticks)
+#endif
+
+/****************************************************************************
+ Function
+    ES_Profile_AddService / ES_Profile_AddChecker / ES_Profile_AddWork
+
+ Parameters
+   which service (index into ServDescList) and the event type it ran,
+   which event checker (index into EVENT_CHECK_LIST) and whether it found
+   an event, or which idle branch call; then the ticks it took
+
+ Description
+   Called by the probes above, not directly.
+****************************************************************************/
+void ES_Profile_AddService(uint8_t WhichService, ES_EventType_t EventType,
+                           uint32_t Ticks);
+void ES_Profile_AddChecker(uint8_t WhichChecker, bool IsNewEvent,
+                           uint32_t Ticks);
+void ES_Profile_AddWork(ES_ProfileWork_t Which, uint32_t Ticks);
+
+/****************************************************************************
+ Function
+    ES_Profile_AddPass
+
+ Parameters
+   uint32_t: the ticks the last pass through ES_Run's loop took
+
+ Description
+   Called by ES_Run at the top of each pass. Closes the last pass, idle or
+   not, and starts over here if ES_Profile_Print asked for it, so the time
+   the printing took is not in the next profile.
+****************************************************************************/
+void ES_Profile_AddPass(uint32_t Ticks);
+
+/****************************************************************************
+ Function
+    ES_Profile_Print
+
+ Parameters
+   None
+
+ Returns
+   Nothing
+
+ Description
+   Prints, through DB_printf, the share of the time, the total, the calls
+   and the longest call for each service, event checker and idle branch
+   call, and for the framework, largest first; then the same for each
+   event type the services ran, and the idle time and what the probes
+   cost. Then starts the profile over.
+   Takes about 30 lines; the caller should have the terminal wait for room
+   rather than drop them.
+****************************************************************************/
+void ES_Profile_Print(void);
+
+#endif /* ES_PROFILE_H */
@@ -28,6 +28,7 @@ bool ES_EnQueueLIFO(ES_Event_t *pBlock, ES_Event_t Event2Add);
 uint8_t ES_DeQueue(ES_Event_t *pBlock, ES_Event_t *pReturnEvent);
 //void EF_FlushQueue( unsigned char * pBlock );
 bool ES_IsQueueEmpty(ES_Event_t *pBlock);
+uint8_t ES_GetQueueCount(ES_Event_t *pBlock);
 
 #endif /*ES_Queue_H */
 
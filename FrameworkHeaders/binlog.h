@@ -0,0 +1,258 @@
+/****************************************************************************
+ Module
+   binlog.h
+
+ Description
+   Tokenized logging. A log site written as
+       BINLOG("Score: %d\n", Score);
+   prints through DB_printf as usual, unless BINLOG_TOKENIZED is defined.
+   Then the site only drops a binary record into a RAM ring: a 16 bit site
+   id, the CP0 Count and the raw arguments, a handful of stores. The format
+   string is not even compiled in. BinLog_Flush, called from the idle
+   branch of ES_Run, later sends each record to the terminal as a COBS
+   frame between two zero bytes, and HostTools/BinLog_Decode.c turns the
+   captured stream back into text.
+
+   The site id is the module number in the top 4 bits and the __LINE__ of
+   the call in the low 12, so the decoder builds its string table by
+   reading the format strings straight out of the sources listed in
+   BINLOG_MODULES. Decode against the sources the firmware was built from.
+
+ Notes
+   Arguments may be anything that fits in 32 bits and is printed with %d,
+   %u, %x or %c; there is no %s, since a pointer means nothing on the host.
+   At most BINLOG_MAX_ARGS of them.
+
+   Sites are for the main loop only, not ISRs.
+
+ Levels and masks
+   Sites are normally written at a level, LOG_ERROR, LOG_WARN, LOG_INFO or
+   LOG_DEBUG, with the same arguments as BINLOG. Each file that logs sets
+   itself up before including this header:
+       #define BINLOG_MODULE BINLOG_MODULE_GAME
+       #define BINLOG_LEVEL  BINLOG_LEVEL_DEBUG   // optional
+       #include "binlog.h"
+   Sites above the file's BINLOG_LEVEL, or above BINLOG_MAX_LEVEL, are
+   removed by the preprocessor, so they cost neither code nor flash for
+   their strings at any optimization level. BINLOG_MAX_LEVEL is DEBUG
+   unless the project's preprocessor macros set it, e.g.
+   BINLOG_MAX_LEVEL=BINLOG_LEVEL_WARN for a build with only warnings and
+   errors.
+
+   The sites that are compiled in also check the module's bit in a run
+   time mask, BinLog_SetMask, which the test harness changes from the
+   terminal. A masked site costs a load and a branch.
+****************************************************************************/
+#ifndef BINLOG_H
+#define BINLOG_H
+
+#include <stdint.h>
+#include "dbprintf.h"
+
+// uncomment to send log sites out as binary records, decoded on the host
+//#define BINLOG_TOKENIZED
+
+#define BINLOG_MAX_ARGS 3
+
+#define BINLOG_LEVEL_NONE  0
+#define BINLOG_LEVEL_ERROR 1
+#define BINLOG_LEVEL_WARN  2
+#define BINLOG_LEVEL_INFO  3
+#define BINLOG_LEVEL_DEBUG 4
+
+#ifndef BINLOG_MAX_LEVEL
+#define BINLOG_MAX_LEVEL BINLOG_LEVEL_DEBUG
+#endif
+
+// module number, the name the terminal shows and the source file the
+// decoder reads its sites from; at most 15 modules, BINLOG_MODULE_FRAMES
+// is kept for frames that are not log records
+#define BINLOG_MODULES(X)                                             \
+  X(BINLOG_MODULE_BINLOG, "binlog", "FrameworkSource/binlog.c")       \
+  X(BINLOG_MODULE_GAME,   "game",   "ProjectSource/GameService.c")    \
+  X(BINLOG_MODULE_BUZZ,   "buzz",   "ProjectSource/BuzzService.c")    \
+  X(BINLOG_MODULE_LED,    "led",    "ProjectSource/LEDService.c")     \
+  X(BINLOG_MODULE_SHIFT,  "shift",  "ProjectSource/ShiftService.c")   \
+  X(BINLOG_MODULE_EVENTS, "events", "ProjectSource/EventCheckers.c")  \
+  X(BINLOG_MODULE_ES,     "es",     "FrameworkSource/ES_Framework.c") \
+  X(BINLOG_MODULE_HAPTIC, "haptic", "ProjectSource/HapticService.c")  \
+  BINLOG_HOST_MODULES(X)
+
+// host tools that define BINLOG_HOST_MODULE before including this get a
+// module of their own, after the firmware's so those keep their numbers
+#ifdef BINLOG_HOST_MODULE
+#define BINLOG_HOST_MODULES(X)                                        \
+  X(BINLOG_MODULE_HOST,   "host",   "HostTools/BinLog_Bench.c")
+#else
+#define BINLOG_HOST_MODULES(X)
+#endif
+
+#define BINLOG_MODULE_ENUM(Name, Short, File) Name,
+typedef enum
+{
+  BINLOG_MODULES(BINLOG_MODULE_ENUM)
+  BINLOG_NUM_MODULES
+} BinLogModule_t;
+#undef BINLOG_MODULE_ENUM
+
+#define BINLOG_SITE(Module, Line) \
+  ((uint16_t)(((Module) << 12) | ((Line) & 0x0FFF)))
+
+// other binary records sharing the framing, told apart by the low 12 bits
+#define BINLOG_MODULE_FRAMES  15
+#define BINLOG_SITE_TELEMETRY BINLOG_SITE(BINLOG_MODULE_FRAMES, 1)
+#define BINLOG_SITE_TRACE     BINLOG_SITE(BINLOG_MODULE_FRAMES, 2)
+
+// the most a frame can carry, the site and stamp included
+#define BINLOG_MAX_PAYLOAD 128
+
+// the run time mask, a bit per module, all on at reset
+extern uint16_t BinLogMask;
+
+#define BINLOG_IS_ON(Module) (0 != (BinLogMask & (1U << (Module))))
+
+/****************************************************************************
+ Function
+    BinLog_SetMask / BinLog_GetMask
+
+ Description
+   Which modules' compiled in sites run, bit n for module n.
+****************************************************************************/
+void BinLog_SetMask(uint16_t Mask);
+uint16_t BinLog_GetMask(void);
+
+/****************************************************************************
+ Function
+    BinLog_GetModuleName
+
+ Returns
+   const char *: the short name of a module, or NULL past the last
+****************************************************************************/
+const char *BinLog_GetModuleName(uint8_t Module);
+
+/****************************************************************************
+ Function
+    BinLog_PutVarint
+
+ Parameters
+   uint8_t *: where to put it, room for 5 bytes
+   uint32_t: the value, taken as signed
+
+ Returns
+   uint8_t: the bytes it took, 1 for anything from -64 to 63
+****************************************************************************/
+uint8_t BinLog_PutVarint(uint8_t *pOut, uint32_t Value);
+
+/****************************************************************************
+ Function
+    BinLog_SendFrame
+
+ Parameters
+   const uint8_t *, uint8_t: the payload and its length, at most
+   BINLOG_MAX_PAYLOAD, starting with a site id and a stamp
+
+ Description
+   COBS encodes the payload and puts it in the terminal's transmit buffer
+   between two zero bytes. The caller checks there is room for
+   Length + 3 bytes, or the terminal may drop part of it.
+****************************************************************************/
+void BinLog_SendFrame(const uint8_t *pPayload, uint8_t Length);
+
+#ifdef BINLOG_TOKENIZED
+
+// picks BinLog_WriteN by counting the arguments after the format
+#define BINLOG_NARGS(...) BINLOG_NARGS_(__VA_ARGS__, 3, 2, 1, 0, _)
+#define BINLOG_NARGS_(Format, A0, A1, A2, N, ...) N
+#define BINLOG_CAT(A, B) BINLOG_CAT_(A, B)
+#define BINLOG_CAT_(A, B) A##B
+
+#define BINLOG(...) \
+  BINLOG_CAT(BINLOG_WRITE_, BINLOG_NARGS(__VA_ARGS__))(__VA_ARGS__)
+#define BINLOG_WRITE_0(Format) \
+  BinLog_Write0(BINLOG_SITE(BINLOG_MODULE, __LINE__))
+#define BINLOG_WRITE_1(Format, A0) \
+  BinLog_Write1(BINLOG_SITE(BINLOG_MODULE, __LINE__), (uint32_t)(A0))
+#define BINLOG_WRITE_2(Format, A0, A1)                                 \
+  BinLog_Write2(BINLOG_SITE(BINLOG_MODULE, __LINE__), (uint32_t)(A0), \
+                (uint32_t)(A1))
+#define BINLOG_WRITE_3(Format, A0, A1, A2)                             \
+  BinLog_Write3(BINLOG_SITE(BINLOG_MODULE, __LINE__), (uint32_t)(A0), \
+                (uint32_t)(A1), (uint32_t)(A2))
+
+void BinLog_Write0(uint16_t Site);
+void BinLog_Write1(uint16_t Site, uint32_t A0);
+void BinLog_Write2(uint16_t Site, uint32_t A0, uint32_t A1);
+void BinLog_Write3(uint16_t Site, uint32_t A0, uint32_t A1, uint32_t A2);
+
+/****************************************************************************
+ Function
+    BinLog_Flush
+
+ Description
+   Frames as many queued records as fit in the terminal's transmit buffer,
+   oldest first, and notes how many records were lost to a full ring since
+   the last flush. Call it from the main loop when there is nothing else to
+   do.
+****************************************************************************/
+void BinLog_Flush(void);
+
+/****************************************************************************
+ Function
+    BinLog_GetDropped
+
+ Returns
+   uint16_t: records lost to a full ring and not yet reported
+****************************************************************************/
+uint16_t BinLog_GetDropped(void);
+
+#else
+
+#define BINLOG(...) DB_printf(__VA_ARGS__)
+#define BinLog_Flush()
+
+#endif /* BINLOG_TOKENIZED */
+
+#endif /* BINLOG_H */
+
+// outside the guard: worked out again for each file from its own
+// BINLOG_LEVEL, should one header that logs include another
+#undef LOG_ERROR
+#undef LOG_WARN
+#undef LOG_INFO
+#undef LOG_DEBUG
+#undef BINLOG_FILE_LEVEL
+#if defined(BINLOG_LEVEL) && (BINLOG_LEVEL < BINLOG_MAX_LEVEL)
+#define BINLOG_FILE_LEVEL BINLOG_LEVEL
+#else
+#define BINLOG_FILE_LEVEL BINLOG_MAX_LEVEL
+#endif
+
+#define BINLOG_AT(...)                  \
+  do                                    \
+  {                                     \
+    if (BINLOG_IS_ON(BINLOG_MODULE))    \
+    {                                   \
+      BINLOG(__VA_ARGS__);              \
+    }                                   \
+  } while (0)
+
+#if BINLOG_FILE_LEVEL >= BINLOG_LEVEL_ERROR
+#define LOG_ERROR(...) BINLOG_AT(__VA_ARGS__)
+#else
+#define LOG_ERROR(...) do {} while (0)
+#endif
+#if BINLOG_FILE_LEVEL >= BINLOG_LEVEL_WARN
+#define LOG_WARN(...) BINLOG_AT(__VA_ARGS__)
+#else
+#define LOG_WARN(...) do {} while (0)
+#endif
+#if BINLOG_FILE_LEVEL >= BINLOG_LEVEL_INFO
+#define LOG_INFO(...) BINLOG_AT(__VA_ARGS__)
+#else
+#define LOG_INFO(...) do {} while (0)
+#endif
+#if BINLOG_FILE_LEVEL >= BINLOG_LEVEL_DEBUG
+#define LOG_DEBUG(...) BINLOG_AT(__VA_ARGS__)
+#else
+#define LOG_DEBUG(...) do {} while (0)
+#endif
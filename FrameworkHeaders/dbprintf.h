@@ -1,8 +1,5 @@
 #include "ES_Port.h"
 void DB_printf(const char *Format, ...);
-
-// Note: these definitions are for a little Endian processor
-//#define LOWORD(l) (*((unsigned int *)(&l)))
-//#define HIWORD(l) (*(((unsigned int *)(&l))+1))
+uint16_t DB_snprintf(char *pBuffer, uint16_t Size, const char *Format, ...);
 
 #define printf    DB_printf
\ No newline at end of file
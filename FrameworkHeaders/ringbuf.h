@@ -0,0 +1,124 @@
+/****************************************************************************
+ Module
+   ringbuf.h
+
+ Description
+   A byte ring for one producer and one consumer, e.g. the main loop putting
+   and an ISR taking, with no critical sections. The size is a power of 2
+   and the head and tail run free as 32 bit counts, masked only to index
+   the storage, so every byte of the storage is used and the count is
+   Head - Tail. Only the producer writes Head and only the consumer writes
+   Tail. Put and Get move a block at a time with at most two memcpy calls.
+
+   The caller owns both the RingBuf_t and its storage, so there is no pool
+   of handles to run out of.
+
+ Modes
+   RINGBUF_REJECT: a put stores what fits and drops the rest, counted in
+   NumDropped. Nothing already in the ring is ever touched.
+
+   RINGBUF_OVERWRITE: a put always stores, and the oldest bytes are lost,
+   counted in NumOverwritten. The producer still never writes Tail. It
+   announces the bytes it is about to write by moving Reserve first, and
+   the consumer skips anything Reserve has lapped, before and after it
+   copies, so a put that interrupts a get, or runs during it, never hands
+   the consumer a torn block.
+
+ Notes
+   A single put of more than the size keeps its last bytes and counts the
+   rest as dropped.
+****************************************************************************/
+#ifndef RINGBUF_H
+#define RINGBUF_H
+
+#include <stdint.h>
+#include <stdbool.h>
+
+#define RINGBUF_MAX_SIZE 32768
+
+typedef enum
+{
+  RINGBUF_REJECT,
+  RINGBUF_OVERWRITE
+} RingBufMode_t;
+
+typedef struct
+{
+  uint8_t *pData;
+  uint16_t Mask;                // size - 1
+  RingBufMode_t Mode;
+  volatile uint32_t Head;       // producer: end of the bytes put
+  volatile uint32_t Reserve;    // producer: end of the bytes being put
+  volatile uint32_t Tail;       // consumer: next byte to take
+  volatile uint32_t NumDropped;     // producer
+  volatile uint32_t NumOverwritten; // consumer
+} RingBuf_t;
+
+/****************************************************************************
+ Function
+    RingBuf_Init
+
+ Parameters
+   RingBuf_t *: the ring
+   uint8_t *: its storage
+   uint16_t: the size of the storage, a power of 2 up to RINGBUF_MAX_SIZE
+   RingBufMode_t: what a put does when the ring is full
+
+ Returns
+   bool: false if the size is not a power of 2
+
+ Description
+   Empties the ring and clears its counts. Not to be called while either
+   side may be using it.
+****************************************************************************/
+bool RingBuf_Init(RingBuf_t *pRing, uint8_t *pStorage, uint16_t Size,
+                  RingBufMode_t Mode);
+
+/****************************************************************************
+ Function
+    RingBuf_Put / RingBuf_PutByte
+
+ Parameters
+   RingBuf_t *: the ring
+   const uint8_t *, uint16_t: the bytes to put and how many, or the byte
+
+ Returns
+   uint16_t / bool: how many were stored, or whether the byte was
+
+ Description
+   For the producer only.
+****************************************************************************/
+uint16_t RingBuf_Put(RingBuf_t *pRing, const uint8_t *pSrc, uint16_t Length);
+bool RingBuf_PutByte(RingBuf_t *pRing, uint8_t Byte);
+
+/****************************************************************************
+ Function
+    RingBuf_Get / RingBuf_GetByte
+
+ Parameters
+   RingBuf_t *: the ring
+   uint8_t *, uint16_t: where to put the bytes and the most wanted, or where
+   to put the byte
+
+ Returns
+   uint16_t / bool: how many were taken, or whether there was a byte
+
+ Description
+   For the consumer only.
+****************************************************************************/
+uint16_t RingBuf_Get(RingBuf_t *pRing, uint8_t *pDst, uint16_t Length);
+bool RingBuf_GetByte(RingBuf_t *pRing, uint8_t *pByte);
+
+/****************************************************************************
+ Function
+    RingBuf_GetCount / RingBuf_GetFree
+
+ Returns
+   uint16_t: bytes waiting, and room for more before a put drops or
+   overwrites. The count is for the consumer and the room for the
+   producer; the other side can only make either larger.
+****************************************************************************/
+uint16_t RingBuf_GetCount(const RingBuf_t *pRing);
+uint16_t RingBuf_GetFree(const RingBuf_t *pRing);
+
+#endif /* RINGBUF_H */
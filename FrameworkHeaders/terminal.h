@@ -20,6 +20,13 @@ extern "C" {
 #define clrLine() printf("\x1b[K")
     
 #define XMIT_BUFFER_SIZE 1024
+
+// what a put into a full transmit buffer does
+typedef enum
+{
+  TERMINAL_TX_DROP,   // drop the new byte and count it
+  TERMINAL_TX_BLOCK   // wait, sending by polling, until there is room
+} TerminalTxPolicy_t;
     
 // map the generic functions for testing the serial port to actual functions
 // for this platform.
@@ -31,8 +38,12 @@ extern "C" {
 void Terminal_HWInit(void);
 uint8_t Terminal_ReadByte(void);
 void Terminal_WriteByte(uint8_t txByte);
+void Terminal_WriteBytes(const uint8_t *pBytes, uint16_t Length);
 bool Terminal_IsRxData(void);
 void Terminal_MoveBuffer2UART( void );
+uint16_t Terminal_GetTxFree( void );
+void Terminal_SetTxPolicy( TerminalTxPolicy_t Policy );
+uint32_t Terminal_GetTxDropped( void );
 
 #ifdef __XC16__  // DEPRICATED, USE FOR xc16 of xc32 v1.34 or lower
 int write(int handle, void *buffer, unsigned int len);
@@ -16,6 +16,7 @@
 #include "ES_Events.h"
 #include "ES_General.h"
 #include "ES_CheckEvents.h"
+#include "ES_Profile.h"
 
 // Include the header files for the module(s) with your event checkers.
 // This gets you the prototypes for the event checking functions.
@@ -47,10 +48,17 @@ static CheckFunc *const ES_EventList[] = {
 bool ES_CheckUserEvents(void)
 {
   uint8_t i;
+  bool IsNewEvent;
+#ifdef ES_PROFILE
+  uint32_t ProbeStart;
+#endif
   // loop through the array executing the event checking functions
   for (i = 0; i < ARRAY_SIZE(ES_EventList); i++)
   {
-    if (ES_EventList[i]() == true)
+    ES_PROFILE_START(ProbeStart);
+    IsNewEvent = ES_EventList[i]();
+    ES_PROFILE_CHECKER(i, IsNewEvent, ProbeStart);
+    if (IsNewEvent == true)
     {
       break; // found a new event, so process it first
     }
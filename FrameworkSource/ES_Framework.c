@@ -42,8 +42,15 @@
 #include "EventCheckWrapper.h"
 
 #include "ES_Port.h"          // needed for definition of REENTRANT
+#define BINLOG_MODULE BINLOG_MODULE_ES
+#include "binlog.h"
+#include "ES_Profile.h"
+#include "terminal.h"
+#include "dbprintf.h"
 
 #include <stdio.h>
+#include <string.h>
+#include <assert.h>
 
 #ifndef ES_CONFIGURE_H
 #error "ES_Configure.h was not included"
@@ -70,8 +77,59 @@ typedef struct
   uint8_t Size;         // how big is it
 }ES_QueueDesc_t;
 
+#define ES_STR_(x) #x
+#define ES_STR(x)  ES_STR_(x)
+
+#define TICKS_PER_US 20         // the CP0 Count
+
+#define LATENCY_LIMIT_TICKS (ES_LATENCY_LIMIT_US * TICKS_PER_US)
+#define LATENCY_SHIFT       8   // the first bucket is under 256 ticks
+
+#if (ES_TRACE_LEN & (ES_TRACE_LEN - 1)) != 0
+#error "ES_TRACE_LEN must be a power of 2"
+#endif
+#if ES_HISTORY_LEN > ES_TRACE_LEN
+#error "ES_HISTORY_LEN is more of the trace than it keeps"
+#endif
+
+// the most an entry can take in a trace dump frame, as four varints
+#define TRACE_ENTRY_BYTES  16
+
+typedef enum
+{
+  TRACE_POST,
+  TRACE_DROP,                 // a post the queue turned away
+  TRACE_START,                // a run function called
+  TRACE_END,                  // and returned
+  TRACE_GAP                   // EventParam entries not kept during a dump
+}TraceWhat_t;
+
+// 8 bytes, so ES_TRACE_LEN of them is 2kB
+typedef struct
+{
+  uint32_t Stamp;             // CP0 Count
+  uint16_t EventParam;
+  uint8_t EventType;
+  uint8_t Service : 4;
+  uint8_t What : 4;           // TraceWhat_t
+}TraceEntry_t;
+
 /*---------------------------- Module Functions ---------------------------*/
 //static bool CheckSystemEvents( void );
+static void NotePost(uint8_t WhichService, ES_Event_t ThisEvent,
+                     bool IsPosted);
+static void RecordTrace(TraceWhat_t What, uint8_t WhichService,
+                        ES_Event_t ThisEvent);
+static bool CopyTrace(uint32_t Index, TraceEntry_t *pEntry);
+static void RestoreInts(uint32_t Status);
+static void SendTrace(void);
+#ifdef ES_TRAP_ON_OVERFLOW
+static void TrapOverflow(uint8_t WhichService);
+#endif
+static void NoteRun(uint8_t WhichService, ES_Event_t ThisEvent,
+                    uint32_t Ticks);
+static void NoteLatency(uint32_t Ticks);
+static void PrintOverrun(const char *pWhat, const ES_Overrun_t *pOverrun);
 
 /*---------------------------- Module Variables ---------------------------*/
 /****************************************************************************/
@@ -232,11 +290,110 @@ static ES_QueueDesc_t const EventQueues[NUM_SERVICES] = {
 #endif
 };
 
+/****************************************************************************/
+// the run functions' names, for the diagnostics, in the same order
+
+static const char *const ServiceNames[] =
+{ ES_STR(SERV_0_RUN)
+#if NUM_SERVICES > 1
+  , ES_STR(SERV_1_RUN)
+#endif
+#if NUM_SERVICES > 2
+  , ES_STR(SERV_2_RUN)
+#endif
+#if NUM_SERVICES > 3
+  , ES_STR(SERV_3_RUN)
+#endif
+#if NUM_SERVICES > 4
+  , ES_STR(SERV_4_RUN)
+#endif
+#if NUM_SERVICES > 5
+  , ES_STR(SERV_5_RUN)
+#endif
+#if NUM_SERVICES > 6
+  , ES_STR(SERV_6_RUN)
+#endif
+#if NUM_SERVICES > 7
+  , ES_STR(SERV_7_RUN)
+#endif
+#if NUM_SERVICES > 8
+  , ES_STR(SERV_8_RUN)
+#endif
+#if NUM_SERVICES > 9
+  , ES_STR(SERV_9_RUN)
+#endif
+#if NUM_SERVICES > 10
+  , ES_STR(SERV_10_RUN)
+#endif
+#if NUM_SERVICES > 11
+  , ES_STR(SERV_11_RUN)
+#endif
+#if NUM_SERVICES > 12
+  , ES_STR(SERV_12_RUN)
+#endif
+#if NUM_SERVICES > 13
+  , ES_STR(SERV_13_RUN)
+#endif
+#if NUM_SERVICES > 14
+  , ES_STR(SERV_14_RUN)
+#endif
+#if NUM_SERVICES > 15
+  , ES_STR(SERV_15_RUN)
+#endif
+};
+
 /****************************************************************************/
 // Variable used to keep track of which queues have events in them
 
 uint16_t Ready;
 
+/****************************************************************************/
+// statistics for telemetry: events run by each service, and the time each
+// pass through ES_Run's loop took, since ES_TakeLoopStats last looked
+
+static uint32_t NumDispatched[NUM_SERVICES];
+static ES_LoopStats_t LoopStats;
+
+/****************************************************************************/
+// queue diagnostics: the most events each queue has held, the posts it
+// turned away and the first of them, since reset
+
+static uint8_t HighWater[NUM_SERVICES];
+static uint32_t NumFailedPosts[NUM_SERVICES];
+static ES_Event_t FirstFailedPost[NUM_SERVICES];
+
+/****************************************************************************/
+// the trace: the last ES_TRACE_LEN events posted, turned away, and started
+// and finished by the run functions, entry n at Trace[n % ES_TRACE_LEN];
+// and the dump under way, from DumpNext up to DumpEnd, with the entries
+// that could not be kept while it went
+
+static TraceEntry_t Trace[ES_TRACE_LEN];
+static uint32_t NumTrace;
+static uint32_t DumpNext;
+static uint32_t DumpEnd;
+static uint32_t NumUnkept;
+
+static const char *const TraceNames[] = { "post", "DROP", "run ", "done" };
+
+/****************************************************************************/
+// loop latency: the passes through ES_Run's loop by length, since reset,
+// and the pass under way, with the longest run function call in it so far
+
+static ES_LatencyStats_t Latency;
+static ES_Overrun_t ThisPass = { .Service = ES_NO_SERVICE };
+static bool IsPrintingPass;
+
+#ifdef ES_WATCHDOG
+// what ES_Run is dispatching, kept through a reset so that ES_Initialize
+// can say which service the watchdog caught
+static struct
+{
+  ES_Event_t Event;
+  uint8_t Service;
+} Dispatching __attribute__((persistent));
+#endif
+
 /*------------------------------ Module Code ------------------------------*/
 /****************************************************************************
  Function
@@ -256,6 +413,22 @@ uint16_t Ready;
 ES_Return_t ES_Initialize(TimerRate_t NewRate)
 {
   uint8_t i;
+#ifdef ES_WATCHDOG
+  if (_HW_WasWatchdogReset())
+  {
+    if (Dispatching.Service < NUM_SERVICES)
+    {
+      DB_printf("reset by the watchdog while %s ran event %u param %x\n",
+                ES_GetServiceName(Dispatching.Service),
+                Dispatching.Event.EventType, Dispatching.Event.EventParam);
+    }
+    else
+    {
+      DB_printf("reset by the watchdog between run functions\n");
+    }
+  }
+  Dispatching.Service = ES_NO_SERVICE;
+#endif
   ES_Timer_Init(NewRate);  // start up the timer subsystem
   // loop through the list testing for NULL pointers and
   for (i = 0; i < ARRAY_SIZE(ServDescList); i++)
@@ -302,9 +475,31 @@ ES_Return_t ES_Run(void)
   // make these static to improve speed
   uint8_t         HighestPrior;
   static ES_Event_t ThisEvent;
+  static uint32_t LoopStart;
+  uint32_t        LoopTicks;
+  uint32_t        RunStart;
+#ifdef ES_PROFILE
+  uint32_t        ProbeStart;
+#endif
 
+  LoopStart = _CP0_GET_COUNT();
+#ifdef ES_WATCHDOG
+  _HW_Watchdog_Init();
+#endif
   while (1)  // stay here unless we detect an error condition
-  { // loop through the list executing the run functions for services
+  { // time the last pass, the services it ran and its idle work
+    LoopTicks = _CP0_GET_COUNT() - LoopStart;
+    LoopStart += LoopTicks;
+    LoopStats.NumLoops++;
+    LoopStats.TotalTicks += LoopTicks;
+    if (LoopTicks > LoopStats.MaxTicks)
+    {
+      LoopStats.MaxTicks = LoopTicks;
+    }
+    ES_PROFILE_PASS(LoopTicks);
+    NoteLatency(LoopTicks);
+    _HW_Watchdog_Feed();
+    // loop through the list executing the run functions for services
     // with a non-empty queue. Process any pending ints before testing
     // Ready
     while ((_HW_Process_Pending_Ints()) && (Ready != 0))
@@ -317,11 +512,25 @@ ES_Return_t ES_Run(void)
 #ifdef _INCLUDE_BASIC_FRAMEWORK_DEBUG_
       _HW_DebugSetLine1();
 #endif
+      NumDispatched[HighestPrior]++;
+      RecordTrace(TRACE_START, HighestPrior, ThisEvent);
+#ifdef ES_WATCHDOG
+      Dispatching.Event = ThisEvent;
+      Dispatching.Service = HighestPrior;
+#endif
+      RunStart = _CP0_GET_COUNT();
+      ES_PROFILE_START(ProbeStart);
       if (ServDescList[HighestPrior].RunFunc(ThisEvent).EventType !=
           ES_NO_EVENT)
       {
         return FailedRun;
       }
+      ES_PROFILE_SERVICE(HighestPrior, ThisEvent.EventType, ProbeStart);
+      NoteRun(HighestPrior, ThisEvent, _CP0_GET_COUNT() - RunStart);
+      RecordTrace(TRACE_END, HighestPrior, ThisEvent);
+#ifdef ES_WATCHDOG
+      Dispatching.Service = ES_NO_SERVICE;
+#endif
 #ifdef _INCLUDE_BASIC_FRAMEWORK_DEBUG_
       _HW_DebugClearLine1();
 #endif
@@ -333,7 +542,13 @@ ES_Return_t ES_Run(void)
     // all the queues are empty, so look for new user detected events
     if (!ES_CheckUserEvents()) // no new user events
     {
+      ES_PROFILE_START(ProbeStart);
+      BinLog_Flush();             // frame any binary log records
+      ES_PROFILE_WORK(ES_PROFILE_FLUSH, ProbeStart);
+      SendTrace();                // a frame of a trace dump, if one is on
+      ES_PROFILE_START(ProbeStart);
       Terminal_MoveBuffer2UART(); // try moving bytes, if available, to UART
+      ES_PROFILE_WORK(ES_PROFILE_TERMINAL, ProbeStart);
     }
 #ifdef _INCLUDE_BASIC_FRAMEWORK_DEBUG_
     _HW_DebugClearLine2();
@@ -363,11 +578,13 @@ bool ES_PostAll(ES_Event_t ThisEvent)
   {
     if (ES_EnQueueFIFO(EventQueues[i].pMem, ThisEvent) != true)
     {
+      NotePost(i, ThisEvent, false);
       break; // this is a failed post
     }
     else
     {
       Ready |= BitNum2SetMask[i]; // show queue as non-empty
+      NotePost(i, ThisEvent, true);
     }
   }
   if (i == ARRAY_SIZE(EventQueues))    // if no failures
@@ -402,10 +619,12 @@ bool ES_PostToService(uint8_t WhichService, ES_Event_t TheEvent)
         true))
   {
     Ready |= BitNum2SetMask[WhichService]; // show queue as non-empty
+    NotePost(WhichService, TheEvent, true);
     return true;
   }
   else
   {
+    NotePost(WhichService, TheEvent, false);
     return false;
   }
 }
@@ -432,17 +651,582 @@ bool ES_PostToServiceLIFO(uint8_t WhichService, ES_Event_t TheEvent)
         true))
   {
     Ready |= BitNum2SetMask[WhichService]; // show queue as non-empty
+    NotePost(WhichService, TheEvent, true);
     return true;
   }
   else
   {
+    NotePost(WhichService, TheEvent, false);
     return false;
   }
 }
 
+/****************************************************************************
+ Function
+   ES_GetNumServices
+ Parameters
+   None
+ Returns
+   uint8_t : how many services the framework runs
+****************************************************************************/
+uint8_t ES_GetNumServices(void)
+{
+  return ARRAY_SIZE(ServDescList);
+}
+
+/****************************************************************************
+ Function
+   ES_GetQueueDepth
+ Parameters
+   uint8_t : Which service (index into ServDescList)
+ Returns
+   uint8_t : the events waiting in its queue, 0 for a bad index
+****************************************************************************/
+uint8_t ES_GetQueueDepth(uint8_t WhichService)
+{
+  if (WhichService < ARRAY_SIZE(EventQueues))
+  {
+    return ES_GetQueueCount(EventQueues[WhichService].pMem);
+  }
+  return 0;
+}
+
+/****************************************************************************
+ Function
+   ES_GetDispatchCount
+ Parameters
+   uint8_t : Which service (index into ServDescList)
+ Returns
+   uint32_t : the events it has run since reset, 0 for a bad index
+ Notes
+   wraps; take differences
+****************************************************************************/
+uint32_t ES_GetDispatchCount(uint8_t WhichService)
+{
+  if (WhichService < ARRAY_SIZE(NumDispatched))
+  {
+    return NumDispatched[WhichService];
+  }
+  return 0;
+}
+
+/****************************************************************************
+ Function
+   ES_TakeLoopStats
+ Parameters
+   ES_LoopStats_t * : where to copy the statistics
+ Returns
+   nothing
+ Description
+   copies the loop statistics gathered since the last call and starts them
+   again. Times are in CP0 Count ticks, half the core clock.
+ Notes
+   call from a service, not an ISR; TotalTicks wraps if left for 214s
+****************************************************************************/
+void ES_TakeLoopStats(ES_LoopStats_t *pStats)
+{
+  *pStats = LoopStats;
+  LoopStats.NumLoops = 0;
+  LoopStats.TotalTicks = 0;
+  LoopStats.MaxTicks = 0;
+}
+
+/****************************************************************************
+ Function
+   ES_GetServiceName
+ Parameters
+   uint8_t : Which service (index into ServDescList)
+ Returns
+   const char * : the name of its run function, "?" for a bad index
+****************************************************************************/
+const char *ES_GetServiceName(uint8_t WhichService)
+{
+  if (WhichService < ARRAY_SIZE(ServiceNames))
+  {
+    return ServiceNames[WhichService];
+  }
+  return "?";
+}
+
+/****************************************************************************
+ Function
+   ES_GetQueueStats
+ Parameters
+   uint8_t : Which service (index into ServDescList)
+   ES_QueueStats_t * : where to copy its queue's statistics
+ Returns
+   bool : false for a bad index
+ Description
+   the queue's size and depth now, the most it has held, and the posts it
+   has turned away since reset, with the first of them
+****************************************************************************/
+bool ES_GetQueueStats(uint8_t WhichService, ES_QueueStats_t *pStats)
+{
+  if (WhichService >= ARRAY_SIZE(EventQueues))
+  {
+    return false;
+  }
+  pStats->Size = EventQueues[WhichService].Size - 1;
+  pStats->Depth = ES_GetQueueCount(EventQueues[WhichService].pMem);
+  pStats->HighWater = HighWater[WhichService];
+  pStats->NumFailed = NumFailedPosts[WhichService];
+  pStats->FirstFailed = FirstFailedPost[WhichService];
+  return true;
+}
+
+/****************************************************************************
+ Function
+   ES_PrintQueueStats
+ Parameters
+   None
+ Returns
+   nothing
+ Description
+   prints a line for each service's queue, as ES_GetQueueStats has it
+ Notes
+   a line of 60 or so characters a service; have the terminal wait for
+   room rather than drop them
+****************************************************************************/
+void ES_PrintQueueStats(void)
+{
+  ES_QueueStats_t Stats;
+  uint8_t i;
+
+  DB_printf("queue                   size  now peak  failed  first failed\n");
+  for (i = 0; ES_GetQueueStats(i, &Stats); i++)
+  {
+    if (0 == Stats.NumFailed)
+    {
+      DB_printf("%-24s%4u %4u %4u %7u\n", ES_GetServiceName(i), Stats.Size,
+                Stats.Depth, Stats.HighWater, Stats.NumFailed);
+    }
+    else
+    {
+      DB_printf("%-24s%4u %4u %4u %7u  event %u param %x\n",
+                ES_GetServiceName(i), Stats.Size, Stats.Depth,
+                Stats.HighWater, Stats.NumFailed,
+                Stats.FirstFailed.EventType, Stats.FirstFailed.EventParam);
+    }
+  }
+}
+
+/****************************************************************************
+ Function
+   ES_PrintEventHistory
+ Parameters
+   None
+ Returns
+   nothing
+ Description
+   prints the last ES_HISTORY_LEN entries in the trace, events posted,
+   turned away, and run and done, oldest first, with how long ago each was
+ Notes
+   events posted from an ISR while it prints may overwrite the oldest lines
+****************************************************************************/
+void ES_PrintEventHistory(void)
+{
+  uint32_t Now = _CP0_GET_COUNT();
+  uint32_t i = (NumTrace > ES_HISTORY_LEN) ? NumTrace - ES_HISTORY_LEN : 0;
+  uint32_t End = NumTrace;
+  TraceEntry_t Entry;
+
+  for (; i != End; i++)
+  {
+    if (false == CopyTrace(i, &Entry))
+    {
+      continue;
+    }
+    if (TRACE_GAP == Entry.What)
+    {
+      DB_printf("%8u us ago  %u not kept while the trace was sent\n",
+                (Now - Entry.Stamp) / TICKS_PER_US, Entry.EventParam);
+    }
+    else
+    {
+      DB_printf("%8u us ago  %s %-24s event %u param %x\n",
+                (Now - Entry.Stamp) / TICKS_PER_US, TraceNames[Entry.What],
+                ES_GetServiceName(Entry.Service), Entry.EventType,
+                Entry.EventParam);
+    }
+  }
+}
+
+/****************************************************************************
+ Function
+   ES_StartTraceDump
+ Parameters
+   None
+ Returns
+   nothing
+ Description
+   starts sending the trace, as it is now, to the terminal. ES_Run sends
+   it a frame at a time from its idle branch, as the terminal has room;
+   HostTools/Trace_Decode.c turns the capture into a timeline
+ Notes
+   each frame is a BINLOG_SITE_TRACE payload: the site id and the CP0
+   Count as it was sent, then as varints the number of its first entry and
+   the entry the dump ends before, and for each entry the ticks since the
+   one before (the first since the frame's Count, so negative), what
+   happened times 16 plus the service, the event type and the param.
+   A busy game writes over the whole trace several times in the 100ms or
+   so a dump of the lot, 1.2kB, takes at 115200 baud, so the trace holds
+   still until it is sent, and then notes how many entries it missed
+****************************************************************************/
+void ES_StartTraceDump(void)
+{
+  DumpEnd = NumTrace;
+  DumpNext = (DumpEnd > ES_TRACE_LEN) ? DumpEnd - ES_TRACE_LEN : 0;
+}
+
+/****************************************************************************
+ Function
+   ES_GetLatencyStats
+ Parameters
+   ES_LatencyStats_t * : where to put them
+ Returns
+   nothing
+ Description
+   the passes through ES_Run's loop since reset, by length, the longest
+   of them and the last to take more than ES_LATENCY_LIMIT_US
+****************************************************************************/
+void ES_GetLatencyStats(ES_LatencyStats_t *pStats)
+{
+  *pStats = Latency;
+}
+
+/****************************************************************************
+ Function
+   ES_PrintLatencyStats
+ Parameters
+   None
+ Returns
+   nothing
+ Description
+   prints the non-empty buckets, then the longest pass and the last
+   overrun with the service and event that took longest in each
+ Notes
+   up to 20 lines; have the terminal wait for room rather than drop them.
+   The pass it is printed from is not counted, since the printing is most
+   of it
+****************************************************************************/
+void ES_PrintLatencyStats(void)
+{
+  uint32_t Tenths;
+  uint8_t i;
+
+  DB_printf("%u passes through ES_Run, %u over %u us\n", Latency.NumPasses,
+            Latency.NumOverruns, ES_LATENCY_LIMIT_US);
+  DB_printf("      from      passes\n");
+  for (i = 0; i < ES_LATENCY_BUCKETS; i++)
+  {
+    if (0 != Latency.Buckets[i])
+    {
+      // in tenths of a us, bucket i starting at 2^(i-1) * 256 ticks
+      Tenths = (0 == i) ? 0 :
+               ((1UL << (LATENCY_SHIFT + i - 1)) * 10 / TICKS_PER_US);
+      DB_printf("%8u.%u us %10u\n", Tenths / 10, Tenths % 10,
+                Latency.Buckets[i]);
+    }
+  }
+  PrintOverrun("longest", &Latency.Worst);
+  PrintOverrun("last overrun", &Latency.Last);
+  IsPrintingPass = true;
+}
+
 //*********************************
 // private functions
 //*********************************
+/****************************************************************************
+ Function
+   NotePost
+ Parameters
+   uint8_t : Which service was posted to
+   ES_Event_t : the event
+   bool : whether its queue took it
+ Returns
+   nothing
+ Description
+   keeps the queue diagnostics; with ES_TRAP_ON_OVERFLOW, stops on a post
+   that was turned away
+****************************************************************************/
+static void NotePost(uint8_t WhichService, ES_Event_t ThisEvent,
+                     bool IsPosted)
+{
+  uint8_t Depth;
+
+  if (WhichService >= ARRAY_SIZE(EventQueues))
+  {
+    return;
+  }
+  RecordTrace(IsPosted ? TRACE_POST : TRACE_DROP, WhichService, ThisEvent);
+  if (true == IsPosted)
+  {
+    Depth = ES_GetQueueCount(EventQueues[WhichService].pMem);
+    if (Depth > HighWater[WhichService])
+    {
+      HighWater[WhichService] = Depth;
+    }
+    return;
+  }
+  if (0 == NumFailedPosts[WhichService]++)
+  {
+    FirstFailedPost[WhichService] = ThisEvent;
+  }
+#ifdef ES_TRAP_ON_OVERFLOW
+  TrapOverflow(WhichService);
+#endif
+}
+
+/****************************************************************************
+ Function
+   RecordTrace
+ Description
+   adds an entry to the trace, from the main loop or an ISR, over the
+   oldest once it is full. While a dump is going the trace holds still and
+   only counts the entries; the first one after it is a TRACE_GAP entry
+   saying how many there were
+****************************************************************************/
+static void RecordTrace(TraceWhat_t What, uint8_t WhichService,
+                        ES_Event_t ThisEvent)
+{
+  TraceEntry_t *pEntry;
+  uint32_t Stamp = _CP0_GET_COUNT();
+  uint32_t Status;
+
+  Status = __builtin_disable_interrupts();
+  if (DumpNext != DumpEnd)
+  {
+    NumUnkept++;
+  }
+  else
+  {
+    if (0 != NumUnkept)
+    {
+      pEntry = &Trace[NumTrace++ & (ES_TRACE_LEN - 1)];
+      pEntry->Stamp = Stamp;
+      pEntry->EventParam = (NumUnkept > UINT16_MAX) ? UINT16_MAX : NumUnkept;
+      pEntry->EventType = ES_NO_EVENT;
+      pEntry->Service = 0;
+      pEntry->What = TRACE_GAP;
+      NumUnkept = 0;
+    }
+    pEntry = &Trace[NumTrace++ & (ES_TRACE_LEN - 1)];
+    pEntry->Stamp = Stamp;
+    pEntry->EventParam = ThisEvent.EventParam;
+    pEntry->EventType = (uint8_t)ThisEvent.EventType;
+    pEntry->Service = WhichService;
+    pEntry->What = What;
+  }
+  RestoreInts(Status);
+}
+
+/****************************************************************************
+ Function
+   CopyTrace
+ Description
+   copies out entry Index; false if it has been written over since
+****************************************************************************/
+static bool CopyTrace(uint32_t Index, TraceEntry_t *pEntry)
+{
+  bool IsKept;
+  uint32_t Status;
+
+  Status = __builtin_disable_interrupts();
+  IsKept = (NumTrace - Index <= ES_TRACE_LEN);
+  if (true == IsKept)
+  {
+    *pEntry = Trace[Index & (ES_TRACE_LEN - 1)];
+  }
+  RestoreInts(Status);
+  return IsKept;
+}
+
+/****************************************************************************
+ Function
+   RestoreInts
+ Description
+   turns interrupts back on only if they were on when Status was taken.
+   The trace is written from ISRs and read by TrapOverflow with interrupts
+   off for good, so unlike ExitCritical this has to nest
+****************************************************************************/
+static void RestoreInts(uint32_t Status)
+{
+  if (0 != (Status & _CP0_STATUS_IE_MASK))
+  {
+    __builtin_enable_interrupts();
+  }
+}
+
+/****************************************************************************
+ Function
+   SendTrace
+ Description
+   called from ES_Run's idle branch; sends the next frame of a trace dump
+   if there is one going and the terminal has room for it. The trace holds
+   still until the last frame is sent. See ES_StartTraceDump
+****************************************************************************/
+static void SendTrace(void)
+{
+  uint8_t Payload[BINLOG_MAX_PAYLOAD];
+  uint8_t Length = 0;
+  uint16_t Site = BINLOG_SITE_TRACE;
+  uint32_t Stamp;
+  uint32_t Last;
+  TraceEntry_t Entry;
+
+  if ((DumpNext == DumpEnd) ||
+      (Terminal_GetTxFree() < BINLOG_MAX_PAYLOAD + 3))
+  {
+    return;
+  }
+  Stamp = _CP0_GET_COUNT();
+  Payload[Length++] = (uint8_t)Site;
+  Payload[Length++] = (uint8_t)(Site >> 8);
+  Payload[Length++] = (uint8_t)Stamp;
+  Payload[Length++] = (uint8_t)(Stamp >> 8);
+  Payload[Length++] = (uint8_t)(Stamp >> 16);
+  Payload[Length++] = (uint8_t)(Stamp >> 24);
+  Length += BinLog_PutVarint(&Payload[Length], DumpNext);
+  Length += BinLog_PutVarint(&Payload[Length], DumpEnd);
+  // each stamp as the ticks from the one before, the first from the frame's
+  for (Last = Stamp; (DumpNext != DumpEnd) &&
+       (Length + TRACE_ENTRY_BYTES <= BINLOG_MAX_PAYLOAD); DumpNext++)
+  {
+    Entry = Trace[DumpNext & (ES_TRACE_LEN - 1)];
+    Length += BinLog_PutVarint(&Payload[Length], Entry.Stamp - Last);
+    Length += BinLog_PutVarint(&Payload[Length],
+                               (Entry.What << 4) | Entry.Service);
+    Length += BinLog_PutVarint(&Payload[Length], Entry.EventType);
+    Length += BinLog_PutVarint(&Payload[Length], Entry.EventParam);
+    Last = Entry.Stamp;
+  }
+  BinLog_SendFrame(Payload, Length);
+}
+
+#ifdef ES_TRAP_ON_OVERFLOW
+/****************************************************************************
+ Function
+   TrapOverflow
+ Description
+   prints the queues and the history with interrupts off, waiting on the
+   UART, and stops in the assert handler, which goes on sending what is
+   left in the terminal's buffer. Does not return.
+****************************************************************************/
+static void TrapOverflow(uint8_t WhichService)
+{
+  __builtin_disable_interrupts();   // the history stops here
+  _HW_Watchdog_Stop();              // or it resets part way through
+  Terminal_SetTxPolicy(TERMINAL_TX_BLOCK);
+  DB_printf("\n%s's queue is full, stopping\n",
+            ES_GetServiceName(WhichService));
+  ES_PrintQueueStats();
+  ES_PrintEventHistory();
+  assert(!"event queue overflow");
+}
+#endif
+
+/****************************************************************************
+ Function
+   NoteRun
+ Parameters
+   uint8_t : the service that ran
+   ES_Event_t : the event it ran
+   uint32_t : the CP0 Count ticks its run function took
+ Returns
+   nothing
+ Description
+   keeps the longest run function call in the pass, for NoteLatency
+****************************************************************************/
+static void NoteRun(uint8_t WhichService, ES_Event_t ThisEvent,
+                    uint32_t Ticks)
+{
+  ThisPass.NumRuns++;
+  if ((ES_NO_SERVICE == ThisPass.Service) || (Ticks > ThisPass.RunTicks))
+  {
+    ThisPass.RunTicks = Ticks;
+    ThisPass.Event = ThisEvent;
+    ThisPass.Service = WhichService;
+  }
+}
+
+/****************************************************************************
+ Function
+   NoteLatency
+ Parameters
+   uint32_t : the CP0 Count ticks the last pass through ES_Run's loop took
+ Returns
+   nothing
+ Description
+   counts the pass in its bucket, keeps it if it is the longest or over
+   ES_LATENCY_LIMIT_US, logs the overruns, and starts the next pass
+****************************************************************************/
+static void NoteLatency(uint32_t Ticks)
+{
+  uint32_t Scaled = Ticks >> LATENCY_SHIFT;
+  uint8_t Bucket = (0 == Scaled) ? 0 : 32 - __builtin_clz(Scaled);
+
+  if (true == IsPrintingPass)
+  {
+    IsPrintingPass = false;
+  }
+  else
+  {
+    if (Bucket >= ES_LATENCY_BUCKETS)
+    {
+      Bucket = ES_LATENCY_BUCKETS - 1;
+    }
+    Latency.Buckets[Bucket]++;
+    Latency.NumPasses++;
+    ThisPass.Ticks = Ticks;
+    if ((Ticks > Latency.Worst.Ticks) || (Ticks > LATENCY_LIMIT_TICKS))
+    {
+      ThisPass.Stamp = ES_Timer_GetTime();
+    }
+    if (Ticks > Latency.Worst.Ticks)
+    {
+      Latency.Worst = ThisPass;
+    }
+    if (Ticks > LATENCY_LIMIT_TICKS)
+    {
+      Latency.NumOverruns++;
+      Latency.Last = ThisPass;
+      LOG_WARN("pass of %u us, service %u event %u\n", Ticks / TICKS_PER_US,
+               ThisPass.Service, ThisPass.Event.EventType);
+    }
+  }
+  ThisPass.RunTicks = 0;
+  ThisPass.NumRuns = 0;
+  ThisPass.Service = ES_NO_SERVICE;
+}
+
+/****************************************************************************
+ Function
+   PrintOverrun
+ Description
+   a line for a long pass from the latency statistics
+****************************************************************************/
+static void PrintOverrun(const char *pWhat, const ES_Overrun_t *pOverrun)
+{
+  if (0 == pOverrun->Ticks)
+  {
+    DB_printf("%s: none\n", pWhat);
+  }
+  else if (ES_NO_SERVICE == pOverrun->Service)
+  {
+    DB_printf("%s: %u us at %u ms, in the event checkers or idle work\n",
+              pWhat, pOverrun->Ticks / TICKS_PER_US, pOverrun->Stamp);
+  }
+  else
+  {
+    DB_printf("%s: %u us at %u ms, %u runs, the longest %u us: %s, "
+              "event %u param %x\n", pWhat, pOverrun->Ticks / TICKS_PER_US,
+              pOverrun->Stamp, pOverrun->NumRuns,
+              pOverrun->RunTicks / TICKS_PER_US,
+              ES_GetServiceName(pOverrun->Service),
+              pOverrun->Event.EventType, pOverrun->Event.EventParam);
+  }
+}
+
 #if 0
 /****************************************************************************
  Function
@@ -47,7 +47,7 @@
 #pragma config OSCIOFNC = OFF           // CLKO Output Signal Active on the OSCO Pin (Disabled)
 #pragma config FPBDIV = DIV_2           // Peripheral Clock Divisor (Pb_Clk is Sys_Clk/2)
 #pragma config FCKSM = CSDCMD           // Clock Switching and Monitor Selection (Clock Switch Disable, FSCM Disabled)
-#pragma config WDTPS = PS1048576        // Watchdog Timer Postscaler (1:1048576)
+// WDTPS is below, once ES_Port.h has said whether ES_Run feeds the watchdog
 #pragma config WINDIS = OFF             // Watchdog Timer Window Enable (Watchdog Timer is in Non-Window Mode)
 #pragma config FWDTEN = OFF             // Watchdog Timer Enable (WDT Disabled (SWDTEN Bit Controls))
 #pragma config FWDTWINSZ = WINSZ_25     // Watchdog Timer Window Size (Window Size is 25%)
@@ -76,6 +76,14 @@
 
 #include "terminal.h"       // terminal prototypes for init function
 
+// the watchdog counts 1ms periods of the LPRC, and stays off (FWDTEN = OFF)
+// unless ES_Run turns it on; with ES_WATCHDOG it then times out in 512ms
+#ifdef ES_WATCHDOG
+#pragma config WDTPS = PS512            // Watchdog Timer Postscaler (1:512)
+#else
+#pragma config WDTPS = PS1048576        // Watchdog Timer Postscaler (1:1048576)
+#endif
+
 // TickCount is used to track the number of timer ints that have occurred
 // since the last check. It should really never be more than 1, but just to
 // be sure, we increment it in the interrupt response rather than simply
@@ -337,6 +345,47 @@ void _HW_ConsoleInit(void)
   Terminal_HWInit();
 }
 
+#ifdef ES_WATCHDOG
+/****************************************************************************
+ Function
+     _HW_Watchdog_Init
+ Parameters
+     none
+ Returns
+     none.
+ Description
+     Clears the watchdog and turns it on. ES_Run calls this before its loop
+     and then feeds it with _HW_Watchdog_Feed at the top of each pass.
+ Notes
+     Only the overflow trap and _fassert turn it off again, with
+     _HW_Watchdog_Stop, so anything else that holds up the loop, such as a
+     printout waiting on the UART, must be done within the period.
+****************************************************************************/
+void _HW_Watchdog_Init(void)
+{
+  WDTCONSET = _WDTCON_WDTCLR_MASK;
+  WDTCONbits.ON = 1;
+}
+
+/****************************************************************************
+ Function
+     _HW_WasWatchdogReset
+ Parameters
+     none
+ Returns
+     bool true if the last reset was the watchdog's
+ Description
+     Reads and clears the WDTO flag in RCON, so it is only reported once.
+****************************************************************************/
+bool _HW_WasWatchdogReset(void)
+{
+  bool WasWatchdog = (0 != RCONbits.WDTO);
+
+  RCONCLR = _RCON_WDTO_MASK;
+  return WasWatchdog;
+}
+#endif
+
 #if 0 // moved to terminal.c
 /****************************************************************************
  Function
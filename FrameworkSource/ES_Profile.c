@@ -0,0 +1,346 @@
+/****************************************************************************
+ Module
+     ES_Profile.c
+ Description
+     Tallies and prints ES_Run's profile. See ES_Profile.h.
+ Notes
+     Each service, event checker and idle branch call has a tally, the
+     ticks it took in all, how often it ran and its longest run, and so
+     does each event type. The framework's row is worked out when the
+     table is printed, as what the passes took beyond the rest; its calls
+     are the passes, and it has no longest run.
+
+     The names come from ES_Configure.h, the services' from
+     ES_GetServiceName and the checkers' from EVENT_CHECK_LIST turned into
+     a string, so they follow whatever the project runs. Event
+     types are printed by number, as ES_Configure.h lists them.
+*****************************************************************************/
+/*----------------------------- Include Files -----------------------------*/
+#include "ES_Configure.h"
+#include "ES_Framework.h"
+#include "ES_Profile.h"
+#include "dbprintf.h"
+
+#ifdef ES_PROFILE
+#include <xc.h>
+#include <string.h>
+#include "ES_CheckEvents.h"
+#include "EventCheckWrapper.h"
+
+/*----------------------------- Module Defines ----------------------------*/
+#define ES_STR_(...) #__VA_ARGS__
+#define ES_STR(...)  ES_STR_(__VA_ARGS__)
+
+#define NUM_CHECKERS (sizeof((pCheckFunc[]){ EVENT_CHECK_LIST }) / \
+                      sizeof(pCheckFunc))
+
+// a tally for each service, then each checker, then the idle branch calls
+#define SLOT_CHECKERS  NUM_SERVICES
+#define SLOT_WORK      (SLOT_CHECKERS + NUM_CHECKERS)
+#define SLOT_FRAMEWORK (SLOT_WORK + ES_PROFILE_TERMINAL + 1)
+#define NUM_SLOTS      (SLOT_FRAMEWORK + 1)
+
+#define NUM_EVENT_TYPES 32      // later ones are tallied with the last
+#define NAME_LEN        32
+#define TICKS_PER_US    20
+#define PROBE_ROUNDS    8       // the fastest of these is the probe's cost
+
+typedef struct
+{
+  uint64_t Ticks;
+  uint32_t Count;
+  uint32_t MaxTicks;
+} Tally_t;
+
+/*---------------------------- Module Functions ---------------------------*/
+static void addTicks(Tally_t *pTally, uint32_t Ticks);
+static void restart(void);
+static uint8_t sortTallies(const Tally_t *pTallies, uint8_t NumTallies,
+                           uint8_t *pOrder);
+static void printTally(const Tally_t *pTally, const char *pName);
+static void getSlotName(uint8_t Slot, char *pName);
+static uint32_t timeProbe(void);
+
+/*---------------------------- Module Variables ---------------------------*/
+// "Check4Keystroke, CheckSensorEdges, ...", split up as it is printed
+static const char CheckerNames[] = ES_STR(EVENT_CHECK_LIST);
+
+static const char *const WorkNames[] = {
+  "BinLog_Flush", "Terminal_MoveBuffer2UART"
+};
+
+static Tally_t Slots[NUM_SLOTS];
+static Tally_t EventTypes[NUM_EVENT_TYPES];
+static uint64_t TotalTicks;
+static uint64_t IdleTicks;
+static uint32_t NumPasses;
+static uint32_t NumIdlePasses;
+static uint32_t LongestPass;
+static uint32_t NumProbes;
+static bool IsPassBusy;
+static bool IsRestartPending;
+
+/*------------------------------ Module Code ------------------------------*/
+/****************************************************************************
+ Function
+    ES_Profile_AddService
+****************************************************************************/
+void ES_Profile_AddService(uint8_t WhichService, ES_EventType_t EventType,
+                           uint32_t Ticks)
+{
+  NumProbes++;
+  IsPassBusy = true;
+  addTicks(&Slots[WhichService], Ticks);
+  if (EventType >= NUM_EVENT_TYPES)
+  {
+    EventType = NUM_EVENT_TYPES - 1;
+  }
+  addTicks(&EventTypes[EventType], Ticks);
+}
+
+/****************************************************************************
+ Function
+    ES_Profile_AddChecker
+****************************************************************************/
+void ES_Profile_AddChecker(uint8_t WhichChecker, bool IsNewEvent,
+                           uint32_t Ticks)
+{
+  NumProbes++;
+  if (true == IsNewEvent)
+  {
+    IsPassBusy = true;
+  }
+  addTicks(&Slots[SLOT_CHECKERS + WhichChecker], Ticks);
+}
+
+/****************************************************************************
+ Function
+    ES_Profile_AddWork
+****************************************************************************/
+void ES_Profile_AddWork(ES_ProfileWork_t Which, uint32_t Ticks)
+{
+  NumProbes++;
+  addTicks(&Slots[SLOT_WORK + Which], Ticks);
+}
+
+/****************************************************************************
+ Function
+    ES_Profile_AddPass
+****************************************************************************/
+void ES_Profile_AddPass(uint32_t Ticks)
+{
+  TotalTicks += Ticks;
+  NumPasses++;
+  if (Ticks > LongestPass)
+  {
+    LongestPass = Ticks;
+  }
+  if (false == IsPassBusy)
+  {
+    IdleTicks += Ticks;
+    NumIdlePasses++;
+  }
+  IsPassBusy = false;
+  if (true == IsRestartPending)
+  {
+    restart();
+  }
+}
+
+/****************************************************************************
+ Function
+    ES_Profile_Print
+****************************************************************************/
+void ES_Profile_Print(void)
+{
+  uint8_t Order[(NUM_SLOTS > NUM_EVENT_TYPES) ? NUM_SLOTS : NUM_EVENT_TYPES];
+  char Name[NAME_LEN];
+  uint64_t Measured = 0;
+  uint64_t Overhead;
+  uint32_t ProbeTicks;
+  uint8_t NumRows;
+  uint8_t i;
+
+  if (0 == TotalTicks)
+  {
+    DB_printf("no profile yet\n");
+    return;
+  }
+  for (i = 0; i < SLOT_FRAMEWORK; i++)
+  {
+    Measured += Slots[i].Ticks;
+  }
+  Slots[SLOT_FRAMEWORK].Ticks = (TotalTicks > Measured) ?
+                                TotalTicks - Measured : 0;
+  Slots[SLOT_FRAMEWORK].Count = NumPasses;
+  Slots[SLOT_FRAMEWORK].MaxTicks = 0;
+
+  DB_printf("profile of %llu ms, %u passes, the longest %u us\n",
+            TotalTicks / (TICKS_PER_US * 1000), NumPasses,
+            LongestPass / TICKS_PER_US);
+  DB_printf("  share      total    calls   mean    max\n");
+  NumRows = sortTallies(Slots, NUM_SLOTS, Order);
+  for (i = 0; i < NumRows; i++)
+  {
+    getSlotName(Order[i], Name);
+    printTally(&Slots[Order[i]], Name);
+  }
+  DB_printf("by event type, of the services' time\n");
+  NumRows = sortTallies(EventTypes, NUM_EVENT_TYPES, Order);
+  for (i = 0; i < NumRows; i++)
+  {
+    DB_snprintf(Name, sizeof(Name), "event %u%s", Order[i],
+                (NUM_EVENT_TYPES - 1 == Order[i]) ? " and up" : "");
+    printTally(&EventTypes[Order[i]], Name);
+  }
+  DB_printf("idle %u.%u%% of the time, in %u passes\n",
+            (uint32_t)(IdleTicks * 100 / TotalTicks),
+            (uint32_t)(IdleTicks * 1000 / TotalTicks % 10), NumIdlePasses);
+
+  // timed last, since it disturbs the tallies, which start over anyway
+  Overhead = NumProbes;
+  ProbeTicks = timeProbe();
+  Overhead *= ProbeTicks;
+  DB_printf("%u probes of at most %u ticks, %u.%u%% of the time\n",
+            NumProbes, ProbeTicks, (uint32_t)(Overhead * 100 / TotalTicks),
+            (uint32_t)(Overhead * 1000 / TotalTicks % 10));
+  IsRestartPending = true;
+}
+
+/*--------------------------- private functions ---------------------------*/
+static void addTicks(Tally_t *pTally, uint32_t Ticks)
+{
+  pTally->Ticks += Ticks;
+  pTally->Count++;
+  if (Ticks > pTally->MaxTicks)
+  {
+    pTally->MaxTicks = Ticks;
+  }
+}
+
+static void restart(void)
+{
+  memset(Slots, 0, sizeof(Slots));
+  memset(EventTypes, 0, sizeof(EventTypes));
+  TotalTicks = 0;
+  IdleTicks = 0;
+  NumPasses = 0;
+  NumIdlePasses = 0;
+  LongestPass = 0;
+  NumProbes = 0;
+  IsRestartPending = false;
+}
+
+// fills pOrder with the tallies that ran, most ticks first; returns how many
+static uint8_t sortTallies(const Tally_t *pTallies, uint8_t NumTallies,
+                           uint8_t *pOrder)
+{
+  uint8_t NumRows = 0;
+  uint8_t i;
+  uint8_t j;
+
+  for (i = 0; i < NumTallies; i++)
+  {
+    if (0 == pTallies[i].Count)
+    {
+      continue;
+    }
+    for (j = NumRows; (j > 0) &&
+         (pTallies[pOrder[j - 1]].Ticks < pTallies[i].Ticks); j--)
+    {
+      pOrder[j] = pOrder[j - 1];
+    }
+    pOrder[j] = i;
+    NumRows++;
+  }
+  return NumRows;
+}
+
+static void printTally(const Tally_t *pTally, const char *pName)
+{
+  uint32_t PerMille = (uint32_t)((pTally->Ticks * 1000 + TotalTicks / 2) /
+                                 TotalTicks);
+
+  DB_printf("%3u.%u%% %8llu us %8u %6u %6u  %s\n", PerMille / 10,
+            PerMille % 10, pTally->Ticks / TICKS_PER_US, pTally->Count,
+            (uint32_t)(pTally->Ticks / pTally->Count / TICKS_PER_US),
+            pTally->MaxTicks / TICKS_PER_US, pName);
+}
+
+static void getSlotName(uint8_t Slot, char *pName)
+{
+  const char *pList = CheckerNames;
+  uint8_t Which;
+  uint8_t Length = 0;
+
+  if (Slot < SLOT_CHECKERS)
+  {
+    DB_snprintf(pName, NAME_LEN, "%s", ES_GetServiceName(Slot));
+  }
+  else if (Slot < SLOT_WORK)
+  {
+    // the (Slot - SLOT_CHECKERS)th name in the list
+    for (Which = Slot - SLOT_CHECKERS; Which > 0; pList++)
+    {
+      if (',' == *pList)
+      {
+        Which--;
+      }
+    }
+    while (' ' == *pList)
+    {
+      pList++;
+    }
+    while ((0 != pList[Length]) && (',' != pList[Length]) &&
+           (Length < NAME_LEN - 1))
+    {
+      pName[Length] = pList[Length];
+      Length++;
+    }
+    pName[Length] = 0;
+  }
+  else if (Slot < SLOT_FRAMEWORK)
+  {
+    DB_snprintf(pName, NAME_LEN, "%s", WorkNames[Slot - SLOT_WORK]);
+  }
+  else
+  {
+    DB_snprintf(pName, NAME_LEN, "framework");
+  }
+}
+
+// the ticks the dearest probe, a service's, takes from the loop
+static uint32_t timeProbe(void)
+{
+  uint32_t Best = UINT32_MAX;
+  uint32_t Before;
+  uint32_t Start;
+  uint32_t Ticks;
+  uint8_t i;
+
+  for (i = 0; i < PROBE_ROUNDS; i++)
+  {
+    Before = _CP0_GET_COUNT();
+    ES_PROFILE_START(Start);
+    ES_PROFILE_SERVICE(0, ES_NO_EVENT, Start);
+    Ticks = _CP0_GET_COUNT() - Before;
+    if (Ticks < Best)
+    {
+      Best = Ticks;
+    }
+  }
+  return Best;
+}
+
+#else
+
+/****************************************************************************
+ Function
+    ES_Profile_Print
+****************************************************************************/
+void ES_Profile_Print(void)
+{
+  DB_printf("no profile: ES_PROFILE is not defined, see ES_Profile.h\n");
+}
+
+#endif /* ES_PROFILE */
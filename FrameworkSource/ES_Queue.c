@@ -227,6 +227,27 @@ bool ES_IsQueueEmpty(ES_Event_t *pBlock)
   return pThisQueue->NumEntries == 0;
 }
 
+/****************************************************************************
+ Function
+   ES_GetQueueCount
+ Parameters
+   ES_Event_t * pBlock : pointer to the block of memory in use as the Queue
+ Returns
+   uint8_t : the number of entries waiting in the Queue
+ Description
+   see above
+ Notes
+   for the framework's statistics; a single byte read, so no critical
+   region is needed even with POST_FROM_INTS
+****************************************************************************/
+uint8_t ES_GetQueueCount(ES_Event_t *pBlock)
+{
+  pQueue_t pThisQueue;
+
+  pThisQueue = (pQueue_t)pBlock;
+  return pThisQueue->NumEntries;
+}
+
 #if 0
 /****************************************************************************
  Function
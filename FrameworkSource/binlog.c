@@ -0,0 +1,244 @@
+/****************************************************************************
+ Module
+   binlog.c
+
+ Description
+   The ring and the framing behind the BINLOG macro. See binlog.h.
+
+ Notes
+   The ring holds 32 bit words: a header word with the site id in the low
+   half and the argument count above it, the CP0 Count, then the
+   arguments. Writing a record is a bounds check and 2 to 5 stores, all the
+   work of turning it into bytes is left to BinLog_Flush.
+
+   On the wire a record is the site id (2 bytes, little endian), the stamp
+   (4 bytes, little endian) and each argument zigzag encoded as a base 128
+   varint, so small values of either sign take a byte. That is COBS
+   encoded and sent between two zero bytes, which keeps it apart from any
+   plain text DB_printf is still putting on the terminal. The varints and
+   the framing are there whether or not BINLOG_TOKENIZED is, for other
+   records that share the wire format, such as telemetry.
+****************************************************************************/
+/*----------------------------- Include Files -----------------------------*/
+#include <xc.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include "terminal.h"
+#define BINLOG_MODULE BINLOG_MODULE_BINLOG
+#include "binlog.h"
+
+/*---------------------------- Module Variables ---------------------------*/
+uint16_t BinLogMask = 0xFFFF;
+
+#define BINLOG_MODULE_NAME(Name, Short, File) Short,
+static const char *const ModuleNames[] = {
+  BINLOG_MODULES(BINLOG_MODULE_NAME)
+};
+#undef BINLOG_MODULE_NAME
+
+/*------------------------------ Module Code ------------------------------*/
+/****************************************************************************
+ Function
+    BinLog_SetMask / BinLog_GetMask
+****************************************************************************/
+void BinLog_SetMask(uint16_t Mask)
+{
+  BinLogMask = Mask;
+}
+
+uint16_t BinLog_GetMask(void)
+{
+  return BinLogMask;
+}
+
+/****************************************************************************
+ Function
+    BinLog_GetModuleName
+****************************************************************************/
+const char *BinLog_GetModuleName(uint8_t Module)
+{
+  return (Module < BINLOG_NUM_MODULES) ? ModuleNames[Module] : NULL;
+}
+
+/****************************************************************************
+ Function
+    BinLog_PutVarint
+
+ Description
+   zigzag, so that -1 is 1 and 1 is 2, then 7 bits a byte, low first
+****************************************************************************/
+uint8_t BinLog_PutVarint(uint8_t *pOut, uint32_t Value)
+{
+  uint32_t ZigZag = (Value << 1) ^ (uint32_t)((int32_t)Value >> 31);
+  uint8_t Length = 0;
+
+  while (ZigZag >= 0x80)
+  {
+    pOut[Length++] = (uint8_t)(ZigZag | 0x80);
+    ZigZag >>= 7;
+  }
+  pOut[Length++] = (uint8_t)ZigZag;
+  return Length;
+}
+
+/****************************************************************************
+ Function
+    BinLog_SendFrame
+****************************************************************************/
+void BinLog_SendFrame(const uint8_t *pPayload, uint8_t Length)
+{
+  uint8_t Frame[BINLOG_MAX_PAYLOAD + 3];
+  uint8_t Out = 0;
+  uint8_t CodeAt;
+  uint8_t i;
+
+  Frame[Out++] = 0;
+  CodeAt = Out++;
+  for (i = 0; i < Length; i++)
+  {
+    if (0 == pPayload[i])
+    {
+      Frame[CodeAt] = Out - CodeAt;
+      CodeAt = Out++;
+    }
+    else
+    {
+      Frame[Out++] = pPayload[i];
+    }
+  }
+  Frame[CodeAt] = Out - CodeAt;
+  Frame[Out++] = 0;
+  Terminal_WriteBytes(Frame, Out);
+}
+
+#ifdef BINLOG_TOKENIZED
+
+/*----------------------------- Module Defines ----------------------------*/
+// must be a power of 2
+#define RING_WORDS  256
+#define RING_MASK   (RING_WORDS - 1)
+#define ARGS_SHIFT  16
+
+// a varint of a 32 bit value takes at most 5 bytes
+#define MAX_PAYLOAD (2 + 4 + 5 * BINLOG_MAX_ARGS)
+// a payload under 254 bytes needs one COBS code byte, plus the two zeros
+#define MAX_FRAME   (MAX_PAYLOAD + 3)
+
+/*---------------------------- Module Functions ---------------------------*/
+static inline void putRecord(uint16_t Site, uint8_t NumArgs, uint32_t A0,
+                             uint32_t A1, uint32_t A2);
+
+/*---------------------------- Module Variables ---------------------------*/
+static uint32_t Ring[RING_WORDS];
+static uint16_t Head;        // next word to fill
+static uint16_t Tail;        // next word to send
+static uint16_t NumDropped;
+
+/*------------------------------ Module Code ------------------------------*/
+/****************************************************************************
+ Function
+    BinLog_Write0 ... BinLog_Write3
+
+ Description
+   Called by the BINLOG macro, one for each number of arguments.
+****************************************************************************/
+void BinLog_Write0(uint16_t Site)
+{
+  putRecord(Site, 0, 0, 0, 0);
+}
+
+void BinLog_Write1(uint16_t Site, uint32_t A0)
+{
+  putRecord(Site, 1, A0, 0, 0);
+}
+
+void BinLog_Write2(uint16_t Site, uint32_t A0, uint32_t A1)
+{
+  putRecord(Site, 2, A0, A1, 0);
+}
+
+void BinLog_Write3(uint16_t Site, uint32_t A0, uint32_t A1, uint32_t A2)
+{
+  putRecord(Site, 3, A0, A1, A2);
+}
+
+/****************************************************************************
+ Function
+    BinLog_Flush
+****************************************************************************/
+void BinLog_Flush(void)
+{
+  uint8_t Payload[MAX_PAYLOAD];
+  uint8_t Length;
+  uint32_t Header;
+  uint32_t Stamp;
+  uint8_t NumArgs;
+  uint8_t i;
+
+  // the report of lost records goes in the ring like any other
+  if ((0 != NumDropped) && ((uint16_t)(Head - Tail) <= RING_WORDS - 3))
+  {
+    uint16_t Lost = NumDropped;
+
+    NumDropped = 0;
+    LOG_WARN("binlog: %u records dropped\n", Lost);
+  }
+  while ((Tail != Head) && (Terminal_GetTxFree() >= MAX_FRAME))
+  {
+    Header = Ring[Tail & RING_MASK];
+    Stamp = Ring[(Tail + 1) & RING_MASK];
+    NumArgs = (uint8_t)(Header >> ARGS_SHIFT);
+    Payload[0] = (uint8_t)Header;
+    Payload[1] = (uint8_t)(Header >> 8);
+    Payload[2] = (uint8_t)Stamp;
+    Payload[3] = (uint8_t)(Stamp >> 8);
+    Payload[4] = (uint8_t)(Stamp >> 16);
+    Payload[5] = (uint8_t)(Stamp >> 24);
+    Length = 6;
+    for (i = 0; i < NumArgs; i++)
+    {
+      Length += BinLog_PutVarint(&Payload[Length], Ring[(Tail + 2 + i) & RING_MASK]);
+    }
+    Tail += 2 + NumArgs;
+    BinLog_SendFrame(Payload, Length);
+  }
+}
+
+/****************************************************************************
+ Function
+    BinLog_GetDropped
+****************************************************************************/
+uint16_t BinLog_GetDropped(void)
+{
+  return NumDropped;
+}
+
+/*--------------------------- private functions ---------------------------*/
+static inline void putRecord(uint16_t Site, uint8_t NumArgs, uint32_t A0,
+                             uint32_t A1, uint32_t A2)
+{
+  uint16_t At = Head;
+
+  if ((uint16_t)(At - Tail) > (RING_WORDS - 2 - NumArgs))
+  {
+    NumDropped++;
+    return;
+  }
+  Ring[At & RING_MASK] = Site | ((uint32_t)NumArgs << ARGS_SHIFT);
+  Ring[(At + 1) & RING_MASK] = _CP0_GET_COUNT();
+  if (NumArgs > 0)
+  {
+    Ring[(At + 2) & RING_MASK] = A0;
+  }
+  if (NumArgs > 1)
+  {
+    Ring[(At + 3) & RING_MASK] = A1;
+  }
+  if (NumArgs > 2)
+  {
+    Ring[(At + 4) & RING_MASK] = A2;
+  }
+  Head = At + 2 + NumArgs;
+}
+
+#endif /* BINLOG_TOKENIZED */
@@ -6,17 +6,25 @@
   Description
     This is a module implementing  a printf() like function that has been
     stripped down to reduce its code size & memory usage.  The only format
-    specifiers  recognized are : %d, %x, %u, %c, %s . It can not print
-    floats or longs. If it is called with a format specifier other than
+    specifiers  recognized are : %d, %x, %u, %c, %s, each of which may
+    take a field width, a '-' to left justify or a '0' to pad with zeros,
+    and %d, %x and %u an l (long) or ll (long long, 64 bits). It can not
+    print floats. If it is called with a format specifier other than
     those recognized, it will print BAD. Any values after that are garbage.
     Floats must be explicitly  cast to int before printing.
 
   Notes
     The maximum line length from a single call to DB_printf() is LINE_LEN
     characters. This is the size of an allocated buffer. If you exceed this,
-    you will overrun the stack. The length of any number field in the
+    the line is cut short. The length of any number field in the
     resulting line can not be longer than FIELD_LEN.
 
+    Decimal numbers are converted two digits at a time from a table, and
+    split by multiplying by a reciprocal, not by dividing: the M4K's divider
+    is iterative and takes up to 35 cycles for each divide, where the old
+    conversion did one for every digit. 64 bit values are first split into
+    9 digit pieces the same way.
+
  History
  When           Who     What/Why
  -------------- ---     --------
@@ -31,21 +39,56 @@
 /*----------------------------- Include Files -----------------------------*/
 #include <stdio.h>
 #include <stdarg.h>
+#include <stdbool.h>
 #include "terminal.h"
 #include "dbprintf.h"
 
 /*----------------------------- Module Defines ----------------------------*/
 // increased line length because the assert() lines can get long)
 #define LINE_LEN    120
-// increased FIELD_LEN to accommodate 32 bit values for ints
-#define FIELD_LEN   11
+// a 64 bit value in decimal takes 20 digits; a field can be padded out to
+// as many as fit on the line
+#define FIELD_LEN   20
 
 #define CR 0x0d
 #define LF 0x0a
+
+// Value / 100 is (Value * 0x51EB851F) >> 37 for every 32 bit Value
+#define DIV100_MAGIC  0x51EB851FULL
+#define DIV100_SHIFT  37
+// Value / 10^9 is the high 64 bits of (Value >> 9) * 0x44B82FA09B5A53,
+// shifted right 11, for every 64 bit Value
+#define DIV1E9_MAGIC  0x44B82FA09B5A53ULL
+#define DIV1E9_PRE    9
+#define DIV1E9_SHIFT  11
+#define ONE_E9        1000000000UL
+#define DIGITS_PER_E9 9
+
+typedef struct
+{
+  uint8_t Width;
+  bool IsLeft;     // '-'
+  bool IsZeroPad;  // '0'
+} Field_t;
+
 /*---------------------------- Module Functions ---------------------------*/
-static void uitoa(char **buf, unsigned int i, unsigned int baseNum);
+static char *formatLine(char *pOut, char *pEnd, const char *Format,
+                        va_list Arguments);
+static char *putField(char *pOut, char *pEnd, const Field_t *pField,
+                      char Sign, const char *pText, uint8_t Length);
+static char *putDecimalField(char *pOut, char *pEnd, const Field_t *pField,
+                             char Sign, uint64_t Value);
+static uint8_t countDecimal32(uint32_t Value);
+static uint8_t putDecimal32(char *pEnd, uint32_t Value);
+static uint8_t putDecimal64(char *pEnd, uint64_t Value);
+static uint8_t putHex(char *pEnd, uint64_t Value);
+static uint64_t mulHi64(uint64_t A, uint64_t B);
 
 /*---------------------------- Module Variables ---------------------------*/
+static const char DigitPairs[] =
+  "00010203040506070809101112131415161718192021222324252627282930313233"
+  "34353637383940414243444546474849505152535455565758596061626364656667"
+  "6869707172737475767778798081828384858687888990919293949596979899";
 
 /*------------------------------ Module Code ------------------------------*/
 /****************************************************************************
@@ -61,9 +104,10 @@ static void uitoa(char **buf, unsigned int i, unsigned int baseNum);
  Description
     a printf() like function that has been
     stripped down to reduce its code size & memory usage.  The only format
-    specifiers  recognized are : %d, %x, %u, %c, %s . 
+    specifiers  recognized are : %d, %x, %u, %c, %s, with a width, '-' or
+    '0' and, for numbers, l or ll. 
  Notes
-    It can not print floats or longs. 
+    It can not print floats. 
     If it is called with a format specifier other than those recognized, 
     it will print BAD. Any values after that are garbage.
     Floats must be explicitly  cast to int before printing.
@@ -74,68 +118,15 @@ void DB_printf(const char *Format, ...)
 {
   va_list Arguments;
   char *pBuffer;
-  char *pString;
-  int   i;
-	unsigned int u;
+  char *pLineEnd;
   char  LineBuffer[LINE_LEN+1];
 
   va_start(Arguments,Format);
-  pBuffer = LineBuffer;
-  *pBuffer = 0;                 /* make sure that Line starts out NULL term */
-  while (*Format)               /* step through the format string */
-  {    
-    if (*Format != '%')            /* if not a format specifier */
-    {      
-      *pBuffer++ = *Format++;  /* simply copy to the output buffer */
-    }else
-    {
-       switch (*++Format)         /* otherwise see what kind of format spec */
-       {
-          case 'd':               /* %d, decimal signed number */
-             i = va_arg(Arguments,int);
-             if (i < 0)
-             {
-                *pBuffer++ = '-'; /* add '-' to the buffer for neg. numbers */
-                i = -1*i;         /* and continue with the positive version */
-             }
-             uitoa(&pBuffer, (unsigned int)i, 10);
-             break;
-          case 'x':               /* %x, hexadecimal unsigned number */
-             u = va_arg(Arguments,unsigned int);
-//               *pBuffer++ = '0'; removed to allow cleaner printing of longs
-//               *pBuffer++ = 'x';
-             uitoa(&pBuffer, u, 16);
-             break;
-          case 'u':               /* %u, decimal unsigned number */
-             u = va_arg(Arguments,unsigned int);
-             uitoa(&pBuffer, u, 10);
-             break;
-          case 'c':               /* %c, a single character */
-             *pBuffer++ = (char) va_arg(Arguments,unsigned int);
-             break;
-          case 's':               /* %s, a string of characters */
-             pString = va_arg(Arguments,char *);
-             if (!pString)
-                pString = "(null)";
-             while (*pString)
-                *pBuffer++ = *pString++;
-             break;
-          case '%':               /* quoted % */
-             *pBuffer++ = '%';
-              break;
-          default:                /* anything else is a bad spec. */
-              *pBuffer++ = 'B';
-              *pBuffer++ = 'A';
-              *pBuffer++ = 'D';
-              break;
-       }
-       Format++;
-    }
-  }
-  *pBuffer = 0;                     /* null terminate the output string */
+  pLineEnd = formatLine(LineBuffer, &LineBuffer[LINE_LEN], Format, Arguments);
+  va_end(Arguments);
 
 /* now, spit the built up line out 1 character at a time */
-   for (pBuffer = LineBuffer; *pBuffer != 0; pBuffer++)
+   for (pBuffer = LineBuffer; pBuffer != pLineEnd; pBuffer++)
    {
       if (*pBuffer != '\n')
       {   
@@ -148,36 +139,330 @@ void DB_printf(const char *Format, ...)
    }
    return;
 }
-/* integer to ascii conversion for unsigned numbers  */
-static void uitoa(char **LineBuffer, unsigned int i, unsigned int baseNum)
+
+/****************************************************************************
+ Function
+    DB_snprintf
+
+ Parameters
+    char *: where to put the text
+    uint16_t: the size of that buffer, including the terminating NULL
+    a char * format string, followed by a variable number of arguments
+
+ Returns
+    uint16_t: the number of characters written, not counting the NULL
+
+ Description
+    Formats as DB_printf does, into a buffer rather than to the terminal,
+    and leaves '\n' alone.
+****************************************************************************/
+uint16_t DB_snprintf(char *pBuffer, uint16_t Size, const char *Format, ...)
 {
-  char *s;
-  uint8_t remainder;
-  char FieldBuf[FIELD_LEN + 1];
-
-  FieldBuf[FIELD_LEN] = 0;      /*start by NULL terminating the local buffer */
-  
-  // we treat a value of 0 as a special case, since it would break the
-  // general algorithm
-  if (i == 0)
+  va_list Arguments;
+  char *pLineEnd;
+
+  if (0 == Size)
   {
-    (*LineBuffer)[0] = '0'; // just copy the '0' to the return buffer
-    ++(*LineBuffer);        // and advance the pointer past the '0'
-    return;
+    return 0;
+  }
+  va_start(Arguments,Format);
+  pLineEnd = formatLine(pBuffer, &pBuffer[Size - 1], Format, Arguments);
+  va_end(Arguments);
+  *pLineEnd = 0;
+  return (uint16_t)(pLineEnd - pBuffer);
+}
+
+/***************************************************************************
+ private functions
+ ***************************************************************************/
+// formats into pOut, stopping at pEnd, and returns where the text ends
+static char *formatLine(char *pOut, char *pEnd, const char *Format,
+                        va_list Arguments)
+{
+  char Digits[FIELD_LEN];
+  char *pDigitsEnd = &Digits[FIELD_LEN];
+  Field_t Field;
+  const char *pString;
+  uint8_t NumLongs;
+  uint8_t Length;
+  uint64_t Value;
+  int64_t Signed;
+  char Sign;
+  char c;
+
+  while ((*Format) && (pOut < pEnd)) /* step through the format string */
+  {    
+    if (*Format != '%')            /* if not a format specifier */
+    {      
+      *pOut++ = *Format++;  /* simply copy to the output buffer */
+      continue;
+    }
+    Format++;
+    Field.IsLeft = false;
+    Field.IsZeroPad = false;
+    Field.Width = 0;
+    for (;; Format++)
+    {
+      if ('-' == *Format)
+      {
+        Field.IsLeft = true;
+      }
+      else if ('0' == *Format)
+      {
+        Field.IsZeroPad = true;
+      }
+      else
+      {
+        break;
+      }
+    }
+    while ((*Format >= '0') && (*Format <= '9'))
+    {
+      Field.Width = (uint8_t)(Field.Width * 10 + (*Format++ - '0'));
+    }
+    for (NumLongs = 0; ('l' == *Format) && (NumLongs < 2); NumLongs++)
+    {
+      Format++;
+    }
+    Sign = 0;
+    switch (c = *Format)         /* see what kind of format spec */
+    {
+      case 'd':                  /* %d, decimal signed number */
+        if (2 == NumLongs)
+        {
+          Signed = va_arg(Arguments, long long);
+        }
+        else if (1 == NumLongs)
+        {
+          Signed = va_arg(Arguments, long);
+        }
+        else
+        {
+          Signed = va_arg(Arguments, int);
+        }
+        Value = (uint64_t)Signed;
+        if (Signed < 0)
+        {
+          Sign = '-';            /* and continue with the positive version */
+          Value = 0 - Value;
+        }
+        pOut = putDecimalField(pOut, pEnd, &Field, Sign, Value);
+        break;
+      case 'u':                  /* %u, decimal unsigned number */
+      case 'x':                  /* %x, hexadecimal unsigned number */
+        if (2 == NumLongs)
+        {
+          Value = va_arg(Arguments, unsigned long long);
+        }
+        else if (1 == NumLongs)
+        {
+          Value = va_arg(Arguments, unsigned long);
+        }
+        else
+        {
+          Value = va_arg(Arguments, unsigned int);
+        }
+        if ('u' == c)
+        {
+          pOut = putDecimalField(pOut, pEnd, &Field, 0, Value);
+        }
+        else
+        {
+          Length = putHex(pDigitsEnd, Value);
+          pOut = putField(pOut, pEnd, &Field, 0, pDigitsEnd - Length, Length);
+        }
+        break;
+      case 'c':                  /* %c, a single character */
+        Digits[0] = (char)va_arg(Arguments, unsigned int);
+        Field.IsZeroPad = false;
+        pOut = putField(pOut, pEnd, &Field, 0, Digits, 1);
+        break;
+      case 's':                  /* %s, a string of characters */
+        pString = va_arg(Arguments, char *);
+        if (!pString)
+        {
+          pString = "(null)";
+        }
+        Length = 0;
+        while ((pString[Length]) && (Length < LINE_LEN))
+        {
+          Length++;
+        }
+        Field.IsZeroPad = false;
+        pOut = putField(pOut, pEnd, &Field, 0, pString, Length);
+        break;
+      case '%':                  /* quoted % */
+        *pOut++ = '%';
+        break;
+      default:                   /* anything else is a bad spec. */
+        pOut = putField(pOut, pEnd, &Field, 0, "BAD", 3);
+        if (0 == c)
+        {
+          continue;              /* a '%' ending the format */
+        }
+        break;
+    }
+    Format++;
   }
-  // we will fill the FieldBuf from the LS position
-  s = &FieldBuf[FIELD_LEN];
-  while (i)
+  return pOut;
+}
+
+// copies the text to pOut, padded out to the field's width
+static char *putField(char *pOut, char *pEnd, const Field_t *pField,
+                      char Sign, const char *pText, uint8_t Length)
+{
+  uint8_t Total = Length + ((0 != Sign) ? 1 : 0);
+  uint8_t Pad = 0;
+  char PadChar = pField->IsZeroPad ? '0' : ' ';
+
+  // fields are a few characters, not worth a call to memcpy or memset
+  if (pField->Width > Total)
   {
-    remainder = i % baseNum;
-    *--s = "0123456789abcdef"[remainder];
-    i /= baseNum;
+    Pad = pField->Width - Total;
   }
-  while (*s)                    /* copy local buffer into passed buffer */
+  if ((0 != Sign) && (pOut < pEnd) && ('0' == PadChar))
   {
-    (*LineBuffer)[0] = *s++;
-    ++(*LineBuffer);
+    *pOut++ = Sign;              /* the sign goes before any zeros */
   }
+  if (false == pField->IsLeft)
+  {
+    for (; (Pad > 0) && (pOut < pEnd); Pad--)
+    {
+      *pOut++ = PadChar;
+    }
+  }
+  if ((0 != Sign) && (pOut < pEnd) && (' ' == PadChar))
+  {
+    *pOut++ = Sign;
+  }
+  for (; (Length > 0) && (pOut < pEnd); Length--)
+  {
+    *pOut++ = *pText++;
+  }
+  for (; (Pad > 0) && (pOut < pEnd); Pad--)
+  {
+    *pOut++ = ' ';               /* left justified */
+  }
+  return pOut;
+}
+
+// the usual number, with no width and room to spare, goes straight into
+// the line, and only wider or longer ones are built up and copied
+static char *putDecimalField(char *pOut, char *pEnd, const Field_t *pField,
+                             char Sign, uint64_t Value)
+{
+  char Digits[FIELD_LEN];
+  uint8_t Length;
+
+  if ((0 == pField->Width) && (Value <= 0xFFFFFFFFULL) &&
+      (pEnd - pOut > FIELD_LEN))
+  {
+    if (0 != Sign)
+    {
+      *pOut++ = Sign;
+    }
+    Length = countDecimal32((uint32_t)Value);
+    putDecimal32(pOut + Length, (uint32_t)Value);
+    return pOut + Length;
+  }
+  Length = putDecimal64(&Digits[FIELD_LEN], Value);
+  return putField(pOut, pEnd, pField, Sign, &Digits[FIELD_LEN] - Length,
+                  Length);
+}
+
+// by comparison, as most values printed are short
+static uint8_t countDecimal32(uint32_t Value)
+{
+  static const uint32_t PowersOf10[] = { 10UL, 100UL, 1000UL, 10000UL,
+    100000UL, 1000000UL, 10000000UL, 100000000UL, 1000000000UL };
+  uint8_t Length = 1;
+
+  while ((Length < 10) && (Value >= PowersOf10[Length - 1]))
+  {
+    Length++;
+  }
+  return Length;
+}
+
+// writes the digits so that they end at pEnd, two at a time, and returns
+// how many there are
+static uint8_t putDecimal32(char *pEnd, uint32_t Value)
+{
+  char *pDigit = pEnd;
+  uint32_t Quotient;
+  uint32_t Pair;
+
+  while (Value >= 100)
+  {
+    Quotient = (uint32_t)(((uint64_t)Value * DIV100_MAGIC) >> DIV100_SHIFT);
+    Pair = Value - Quotient * 100;
+    pDigit -= 2;
+    pDigit[0] = DigitPairs[2 * Pair];
+    pDigit[1] = DigitPairs[2 * Pair + 1];
+    Value = Quotient;
+  }
+  if (Value >= 10)
+  {
+    pDigit -= 2;
+    pDigit[0] = DigitPairs[2 * Value];
+    pDigit[1] = DigitPairs[2 * Value + 1];
+  }
+  else
+  {
+    *--pDigit = (char)('0' + Value);
+  }
+  return (uint8_t)(pEnd - pDigit);
+}
+
+// anything over 32 bits is taken 9 digits at a time off the bottom, each
+// piece padded out with zeros, until what is left fits putDecimal32
+static uint8_t putDecimal64(char *pEnd, uint64_t Value)
+{
+  char *pDigit = pEnd;
+  uint64_t Quotient;
+  uint8_t Length;
+
+  while (Value > 0xFFFFFFFFULL)
+  {
+    Quotient = mulHi64(Value >> DIV1E9_PRE, DIV1E9_MAGIC) >> DIV1E9_SHIFT;
+    Length = putDecimal32(pDigit, (uint32_t)(Value - Quotient * ONE_E9));
+    pDigit -= Length;
+    while (Length++ < DIGITS_PER_E9)
+    {
+      *--pDigit = '0';
+    }
+    Value = Quotient;
+  }
+  pDigit -= putDecimal32(pDigit, (uint32_t)Value);
+  return (uint8_t)(pEnd - pDigit);
+}
+
+static uint8_t putHex(char *pEnd, uint64_t Value)
+{
+  char *pDigit = pEnd;
+
+  do
+  {
+    *--pDigit = "0123456789abcdef"[Value & 0x0F];
+    Value >>= 4;
+  } while (0 != Value);
+  return (uint8_t)(pEnd - pDigit);
+}
+
+// the high 64 bits of a 64 x 64 bit product, from four 32 x 32 bit ones,
+// which the M4K multiplier does in a few cycles each
+static uint64_t mulHi64(uint64_t A, uint64_t B)
+{
+  uint64_t ALo = (uint32_t)A;
+  uint64_t AHi = A >> 32;
+  uint64_t BLo = (uint32_t)B;
+  uint64_t BHi = B >> 32;
+  uint64_t LoLo = ALo * BLo;
+  uint64_t HiLo = AHi * BLo;
+  uint64_t LoHi = ALo * BHi;
+  uint64_t Cross = (LoLo >> 32) + (uint32_t)HiLo + LoHi;
+
+  return (AHi * BHi) + (HiLo >> 32) + (Cross >> 32);
 }
 
 
@@ -204,6 +489,7 @@ void main(void)
   char  String[]="Hello World\n";
   float Floater = 1.23;
   unsigned long LongOne = 123456789;
+  long long LongLongOne = -1234567890123456789LL;
 
   Terminal_HWInit();
   DB_printf("\nBeginning DB_printf() test compiled at %s on %s\n\n", __TIME__, __DATE__);
@@ -226,9 +512,10 @@ void main(void)
    DB_printf("Printing a char as a single character: %c\n", c);
    DB_printf("Printing a string w/ embedded NL: %s\n\n", String);
 
-   DB_printf("Attempting to print a long: %l\n",LongOne);
+   DB_printf("Printing a long (%%lu): %lu, Hex mode (%%lx): %lx\n",LongOne,LongOne);
+   DB_printf("Printing a long long (%%lld): %lld\n",LongLongOne);
+   DB_printf("Printing in fields (%%6d|%%-6d|%%06d): %6d|%-6d|%06d\n\n",-42,-42,-42);
    DB_printf("Attempting to print a float: %f\n",Floater);
-//   DB_printf("A way to print a long value: %x%x\n", HIWORD(LongOne),LOWORD(LongOne));
 
 #else
    Terminal_HWInit();
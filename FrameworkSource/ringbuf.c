@@ -0,0 +1,243 @@
+/****************************************************************************
+ Module
+   ringbuf.c
+
+ Description
+   Single producer, single consumer byte ring. See ringbuf.h.
+
+ Notes
+   The barriers keep the compiler from moving the stores to the data past
+   the store that publishes them, and the loads of the data ahead of the
+   load that says they are there. The PIC32's M4K core does not reorder
+   memory accesses itself, so nothing more is needed between an ISR and
+   the main loop.
+****************************************************************************/
+/*----------------------------- Include Files -----------------------------*/
+#include <string.h>
+#include "ringbuf.h"
+
+/*----------------------------- Module Defines ----------------------------*/
+#define BARRIER() __asm__ volatile ("" ::: "memory")
+
+// a get that is overwritten while it copies starts again; from an ISR, or
+// with the producer in an ISR, it never has to
+#define MAX_TRIES 3
+
+/*---------------------------- Module Functions ---------------------------*/
+static void copyIn(RingBuf_t *pRing, uint32_t At, const uint8_t *pSrc,
+                   uint16_t Length);
+static void copyOut(const RingBuf_t *pRing, uint32_t At, uint8_t *pDst,
+                    uint16_t Length);
+static uint32_t skipLapped(RingBuf_t *pRing, uint32_t Tail,
+                           uint32_t Reserve);
+
+/*------------------------------ Module Code ------------------------------*/
+/****************************************************************************
+ Function
+    RingBuf_Init
+****************************************************************************/
+bool RingBuf_Init(RingBuf_t *pRing, uint8_t *pStorage, uint16_t Size,
+                  RingBufMode_t Mode)
+{
+  if ((0 == Size) || (0 != (Size & (Size - 1))) || (Size > RINGBUF_MAX_SIZE))
+  {
+    return false;
+  }
+  pRing->pData = pStorage;
+  pRing->Mask = Size - 1;
+  pRing->Mode = Mode;
+  pRing->Head = 0;
+  pRing->Reserve = 0;
+  pRing->Tail = 0;
+  pRing->NumDropped = 0;
+  pRing->NumOverwritten = 0;
+  return true;
+}
+
+/****************************************************************************
+ Function
+    RingBuf_Put
+****************************************************************************/
+uint16_t RingBuf_Put(RingBuf_t *pRing, const uint8_t *pSrc, uint16_t Length)
+{
+  uint32_t Head = pRing->Head;
+  uint32_t Size = (uint32_t)pRing->Mask + 1;
+  uint32_t Room;
+
+  if (RINGBUF_REJECT == pRing->Mode)
+  {
+    Room = Size - (Head - pRing->Tail);
+    if (Length > Room)
+    {
+      pRing->NumDropped += Length - Room;
+      Length = (uint16_t)Room;
+    }
+  }
+  else if (Length > Size)
+  {
+    pRing->NumDropped += Length - Size;
+    pSrc += Length - Size;
+    Length = (uint16_t)Size;
+  }
+  if (0 == Length)
+  {
+    return 0;
+  }
+  // in reject mode nothing unread is in the way, so this only matters to
+  // an overwriting ring's consumer
+  pRing->Reserve = Head + Length;
+  BARRIER();
+  copyIn(pRing, Head, pSrc, Length);
+  BARRIER();
+  pRing->Head = Head + Length;
+  return Length;
+}
+
+/****************************************************************************
+ Function
+    RingBuf_PutByte
+****************************************************************************/
+bool RingBuf_PutByte(RingBuf_t *pRing, uint8_t Byte)
+{
+  uint32_t Head = pRing->Head;
+
+  if (RINGBUF_OVERWRITE == pRing->Mode)
+  {
+    return 1 == RingBuf_Put(pRing, &Byte, 1);
+  }
+  if ((Head - pRing->Tail) > pRing->Mask)
+  {
+    pRing->NumDropped++;
+    return false;
+  }
+  pRing->pData[Head & pRing->Mask] = Byte;
+  BARRIER();
+  pRing->Reserve = Head + 1;
+  pRing->Head = Head + 1;
+  return true;
+}
+
+/****************************************************************************
+ Function
+    RingBuf_Get
+****************************************************************************/
+uint16_t RingBuf_Get(RingBuf_t *pRing, uint8_t *pDst, uint16_t Length)
+{
+  uint32_t Tail = pRing->Tail;
+  uint32_t Head;
+  uint32_t Reserve;
+  uint32_t Count = 0;
+  uint8_t Tries;
+
+  for (Tries = 0; Tries < MAX_TRIES; Tries++)
+  {
+    // Reserve before Head, so Reserve - size can never be past Head
+    Reserve = pRing->Reserve;
+    BARRIER();
+    Head = pRing->Head;
+    BARRIER();
+    if (RINGBUF_OVERWRITE == pRing->Mode)
+    {
+      Tail = skipLapped(pRing, Tail, Reserve);
+    }
+    Count = Head - Tail;
+    if (Count > Length)
+    {
+      Count = Length;
+    }
+    copyOut(pRing, Tail, pDst, (uint16_t)Count);
+    BARRIER();
+    if ((RINGBUF_REJECT == pRing->Mode) ||
+        ((pRing->Reserve - Tail) <= ((uint32_t)pRing->Mask + 1)))
+    {
+      break;
+    }
+    Count = 0; // a put went over what was copied, so take it again
+  }
+  pRing->Tail = Tail + Count;
+  return (uint16_t)Count;
+}
+
+/****************************************************************************
+ Function
+    RingBuf_GetByte
+****************************************************************************/
+bool RingBuf_GetByte(RingBuf_t *pRing, uint8_t *pByte)
+{
+  uint32_t Tail = pRing->Tail;
+
+  if (RINGBUF_OVERWRITE == pRing->Mode)
+  {
+    return 1 == RingBuf_Get(pRing, pByte, 1);
+  }
+  if (Tail == pRing->Head)
+  {
+    return false;
+  }
+  BARRIER();
+  *pByte = pRing->pData[Tail & pRing->Mask];
+  BARRIER();
+  pRing->Tail = Tail + 1;
+  return true;
+}
+
+/****************************************************************************
+ Function
+    RingBuf_GetCount / RingBuf_GetFree
+****************************************************************************/
+uint16_t RingBuf_GetCount(const RingBuf_t *pRing)
+{
+  uint32_t Count = pRing->Head - pRing->Tail;
+
+  // an overwriting ring the consumer has not caught up with is just full
+  return (Count > pRing->Mask) ? (uint16_t)(pRing->Mask + 1) : (uint16_t)Count;
+}
+
+uint16_t RingBuf_GetFree(const RingBuf_t *pRing)
+{
+  return (uint16_t)(pRing->Mask + 1 - RingBuf_GetCount(pRing));
+}
+
+/*--------------------------- private functions ---------------------------*/
+// at most two copies, one up to the end of the storage and one from its start
+static void copyIn(RingBuf_t *pRing, uint32_t At, const uint8_t *pSrc,
+                   uint16_t Length)
+{
+  uint16_t Index = At & pRing->Mask;
+  uint16_t First = pRing->Mask + 1 - Index;
+
+  if (First > Length)
+  {
+    First = Length;
+  }
+  memcpy(&pRing->pData[Index], pSrc, First);
+  memcpy(pRing->pData, pSrc + First, Length - First);
+}
+
+static void copyOut(const RingBuf_t *pRing, uint32_t At, uint8_t *pDst,
+                    uint16_t Length)
+{
+  uint16_t Index = At & pRing->Mask;
+  uint16_t First = pRing->Mask + 1 - Index;
+
+  if (First > Length)
+  {
+    First = Length;
+  }
+  memcpy(pDst, &pRing->pData[Index], First);
+  memcpy(pDst + First, pRing->pData, Length - First);
+}
+
+// moves the tail past anything the producer has written, or is writing,
+// over, and counts it
+static uint32_t skipLapped(RingBuf_t *pRing, uint32_t Tail, uint32_t Reserve)
+{
+  uint32_t Size = (uint32_t)pRing->Mask + 1;
+
+  if ((Reserve - Tail) > Size)
+  {
+    pRing->NumOverwritten += (Reserve - Size) - Tail;
+    Tail = Reserve - Size;
+  }
+  return Tail;
+}
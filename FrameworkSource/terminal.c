@@ -12,6 +12,20 @@
  Notes
   For the PIC32 port, we are using UART 1
 
+  Characters go into xmitBuffer and the UART1 TX interrupt moves them to
+  the UART FIFO each time it empties, so the terminal keeps the line busy
+  however long the main loop is away. The interrupt is only on while there
+  is something to send. Define TERMINAL_TX_POLLED to go back to moving them
+  only from the idle branch of ES_Run.
+
+  xmitBuffer is a ringbuf.h ring in reject mode: the main loop puts and the
+  TX interrupt takes. The ring is single producer, single consumer, so only
+  the main loop may put; an ISR must not print. A put into a full ring
+  never moves the oldest byte out from under the interrupt. What happens instead is
+  the policy set by Terminal_SetTxPolicy: the new bytes are dropped and
+  counted, which is the default, or the caller waits, sending by polling,
+  until there is room. Terminal_WriteBytes puts a whole block at once.
+
  History
  When           Who     What/Why
  -------------- ---     --------
@@ -23,11 +37,12 @@
 
 // Hardware
 #include <xc.h>
+#include <sys/attribs.h>
 #include <stdio.h>
 
 #include "ES_General.h"
 #include "ES_Port.h"
-#include "circular_buffer.h"
+#include "ringbuf.h"
 #include "dbprintf.h"
 
 //this module
@@ -36,14 +51,25 @@
 #define BAUD_CONST 42 // sets up baud rate for 115200
 //#define BAUD_CONST 21 // sets up baud rate for 230400
 
+// uncomment to move bytes from the idle branch of ES_Run, not the interrupt
+//#define TERMINAL_TX_POLLED
+
+// the lowest; the FIFO holds 8 bytes, which is 690us of slack at 115200
+#define TX_INT_PRIORITY 1
+#define UTXISEL_FIFO_EMPTY 0b10
+
 /*---------------------------- Module Functions ---------------------------*/
 /* prototypes for private functions for this service.They should be functions
    relevant to the behavior of this service
 */
+static void putTx(const uint8_t *pBytes, uint16_t Length);
+static void moveBytes(void);
+static inline void startTx(void);
 
 /*---------------------------- Module Variables ---------------------------*/
 static uint8_t xmitBuffer[XMIT_BUFFER_SIZE];
-static cbuf_handle_t xmitBufferHandle;
+static RingBuf_t xmitRing;
+static TerminalTxPolicy_t txPolicy = TERMINAL_TX_DROP;
 
 /*------------------------------ Module Code ------------------------------*/
 /*******************************************************************************
@@ -92,6 +118,12 @@ void Terminal_HWInit(void)
   U1STA = 0;
   // Set the baud rate based on the constant
   U1BRG = BAUD_CONST;
+  // interrupt when the TX FIFO has emptied, but leave it off until there is
+  // something to send
+  U1STAbits.UTXISEL = UTXISEL_FIFO_EMPTY;
+  IEC1CLR = _IEC1_U1TXIE_MASK;
+  IFS1CLR = _IFS1_U1TXIF_MASK;
+  IPC8bits.U1IP = TX_INT_PRIORITY;
   
   // redirect printf to UART1 using X32 built in cross over
   __XC_UART = 1; 
@@ -101,8 +133,8 @@ void Terminal_HWInit(void)
   U1STAbits.URXEN = 1; // enable receive
   U1MODEbits.ON = 1; // turn peripheral on
   
-  // now initialize the circular buffer for transmitting
-  xmitBufferHandle = circular_buf_init( xmitBuffer, ARRAY_SIZE(xmitBuffer) );
+  // now initialize the ring for transmitting
+  RingBuf_Init(&xmitRing, xmitBuffer, ARRAY_SIZE(xmitBuffer), RINGBUF_REJECT);
   
   return;
 }
@@ -141,10 +173,29 @@ void Terminal_WriteByte(uint8_t txByte)
   // write the byte to the register
   U1TXREG = txByte;
 #else
-  circular_buf_put(xmitBufferHandle, txByte);
+  putTx(&txByte, 1);
 #endif  
   return;
 }
+
+/*******************************************************************************
+ * Function: Terminal_WriteBytes
+ * Arguments: the bytes to write and how many
+ * Returns nothing
+ * 
+ * Description: Writes a block to the transmit buffer in one go
+ ******************************************************************************/
+void Terminal_WriteBytes(const uint8_t *pBytes, uint16_t Length)
+{
+#ifdef NO_BUFFER
+  while (Length-- > 0)
+  {
+    Terminal_WriteByte(*pBytes++);
+  }
+#else
+  putTx(pBytes, Length);
+#endif
+}
 /*******************************************************************************
  * Function: Terminal_IsRxData
  * Arguments: none
@@ -177,7 +228,7 @@ bool Terminal_IsRxData(void)
  ******************************************************************************/
 void _mon_putc (char c)
 {
-  circular_buf_put(xmitBufferHandle, c);
+  putTx((const uint8_t *)&c, 1);
 }
 
 /*******************************************************************************
@@ -189,16 +240,83 @@ void _mon_putc (char c)
  * Description: this functions pulls bytes, if any available, from the
  *              circular buffer and stuffs them into the UART1 buffer
  *              until we either run out of bytes in the circular buffer
- *              or we run out of space in the UART FIFO
+ *              or we run out of space in the UART FIFO.
+ *              With the TX interrupt doing that, it only makes sure the
+ *              interrupt is on while there are bytes waiting, which picks
+ *              up a put made just as the TX interrupt turned itself off.
  ******************************************************************************/
 void Terminal_MoveBuffer2UART( void )
 {
-  while ( (!circular_buf_empty(xmitBufferHandle)) && (!U1STAbits.UTXBF))
+#ifdef TERMINAL_TX_POLLED
+  moveBytes();
+#else
+  if (0 != RingBuf_GetCount(&xmitRing))
+  {
+    startTx();
+  }
+#endif
+}
+
+/*******************************************************************************
+ * Function: Terminal_TxISR
+ * Arguments: none
+ * Returns none
+ * 
+ * Description: refills the UART1 TX FIFO from the circular buffer each time
+ *              it empties, and turns itself off once the buffer is empty
+ ******************************************************************************/
+#ifndef TERMINAL_TX_POLLED
+void __ISR(_UART_1_VECTOR, IPL1AUTO) Terminal_TxISR(void)
+{
+  uint8_t byte2Xmit;
+
+  while ((!U1STAbits.UTXBF) && RingBuf_GetByte(&xmitRing, &byte2Xmit))
   {
-    uint8_t byte2Xmit;
-    circular_buf_get(xmitBufferHandle, &byte2Xmit);
     U1TXREG = byte2Xmit;
   }
+  if (0 == RingBuf_GetCount(&xmitRing))
+  {
+    IEC1CLR = _IEC1_U1TXIE_MASK;
+  }
+  IFS1CLR = _IFS1_U1TXIF_MASK;
+}
+#endif
+
+/*******************************************************************************
+ * Function: Terminal_GetTxFree
+ * Arguments: none
+ * Returns the number of bytes that can be written without overwriting any
+ * 
+ * Description: lets a writer check that a whole message will fit before it
+ *              starts, rather than have the end of it dropped
+ ******************************************************************************/
+uint16_t Terminal_GetTxFree( void )
+{
+  return RingBuf_GetFree(&xmitRing);
+}
+
+/*******************************************************************************
+ * Function: Terminal_SetTxPolicy
+ * Arguments: what to do with a byte put into a full transmit buffer
+ * Returns nothing
+ * 
+ * Description: TERMINAL_TX_DROP throws the new byte away and counts it,
+ *              TERMINAL_TX_BLOCK waits for room, holding up the caller for
+ *              up to 87us a byte at 115200
+ ******************************************************************************/
+void Terminal_SetTxPolicy( TerminalTxPolicy_t Policy )
+{
+  txPolicy = Policy;
+}
+
+/*******************************************************************************
+ * Function: Terminal_GetTxDropped
+ * Arguments: none
+ * Returns the number of bytes dropped on a full transmit buffer since reset
+ ******************************************************************************/
+uint32_t Terminal_GetTxDropped( void )
+{
+  return xmitRing.NumDropped;
 }
 
 void __attribute__((noreturn)) _fassert(int nLineNumber,
@@ -206,17 +324,73 @@ void __attribute__((noreturn)) _fassert(int nLineNumber,
                                         const char * sFailedExpression,
                                         const char * sFunction )
 {
+  // this never returns, so nothing would feed the watchdog again
+  _HW_Watchdog_Stop();
   DB_printf("Assert \"%s\" Failed at Line: %d, in File: %s \n\r", 
             sFailedExpression, nLineNumber, sFileName, sFunction);
-    // now pump the bytes out of the buffer into the UART
+    // now pump the bytes out of the buffer into the UART, whether or not
+    // interrupts are still running
     while(1) 
     {
-        Terminal_MoveBuffer2UART();
+        moveBytes();
     }
 }
 /***************************************************************************
  private functions
  ***************************************************************************/
+static void putTx(const uint8_t *pBytes, uint16_t Length)
+{
+  uint16_t Room;
+
+  if (TERMINAL_TX_BLOCK != txPolicy)
+  {
+    RingBuf_Put(&xmitRing, pBytes, Length); // counts what did not fit
+  }
+  else
+  {
+    // a piece at a time, as room is made
+    while (Length > 0)
+    {
+      while (0 == (Room = RingBuf_GetFree(&xmitRing)))
+      {
+        moveBytes();
+      }
+      Room = RingBuf_Put(&xmitRing, pBytes, (Length < Room) ? Length : Room);
+      pBytes += Room;
+      Length -= Room;
+    }
+  }
+  startTx();
+}
+
+// fills the UART FIFO from the circular buffer by polling, with the TX
+// interrupt held off so that there is only ever one side taking bytes
+static void moveBytes(void)
+{
+  uint8_t byte2Xmit;
+
+#ifndef TERMINAL_TX_POLLED
+  IEC1CLR = _IEC1_U1TXIE_MASK;
+#endif
+  while ((!U1STAbits.UTXBF) && RingBuf_GetByte(&xmitRing, &byte2Xmit))
+  {
+    U1TXREG = byte2Xmit;
+  }
+}
+
+// turns the TX interrupt on if it is off. Setting the flag as well takes
+// the interrupt straight away when the FIFO is already empty; when it is
+// not, the ISR finds it full, does nothing, and is back when it empties.
+static inline void startTx(void)
+{
+#ifndef TERMINAL_TX_POLLED
+  if (0 == (IEC1 & _IEC1_U1TXIE_MASK))
+  {
+    IFS1SET = _IFS1_U1TXIF_MASK;
+    IEC1SET = _IEC1_U1TXIE_MASK;
+  }
+#endif
+}
 // module test harness:
 #ifdef TEST
 int main(void)
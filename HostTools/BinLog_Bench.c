@@ -0,0 +1,262 @@
+/****************************************************************************
+ Module
+   BinLog_Bench.c
+
+ Description
+   Times the GameOn banner, the six lines RunGameService prints on every
+   event while a game is on, through DB_printf and as LOG_DEBUG records,
+   and then with the module turned off in the run time mask. Both
+   go through the real code into a 1024 byte circular buffer like the
+   terminal's: DB_printf formats and puts every character, BINLOG stores a
+   record and BinLog_Flush frames it later. The call sites and the flush
+   are timed apart, since only the first is on the service's path, and
+   the bytes each way puts on the UART are counted.
+
+ Build (from the repository root)
+   gcc -O2 -D__NO_INLINE__ -Wl,--wrap=putchar -DBINLOG_TOKENIZED
+       -IHostTools/include -IHostTools -IFrameworkHeaders
+       HostTools/BinLog_Bench.c FrameworkSource/binlog.c
+       FrameworkSource/dbprintf.c
+       FrameworkSource/circular_buffer_no_modulo_threadsafe.c
+       HostTools/PIC32_HostModel.c -o binlog_bench
+
+ Usage
+   ./binlog_bench [-n events] [-o capture]
+   -o saves the terminal output of the first few tokenized banners, which
+   ./binlog_decode -r . capture turns back into the text.
+
+ Notes
+   --wrap=putchar sends DB_printf's characters to the circular buffer the
+   way _mon_putc does on the PIC32; __NO_INLINE__ stops glibc inlining
+   putchar out of reach of the wrap. Host times only give the ratio.
+****************************************************************************/
+/*----------------------------- Include Files -----------------------------*/
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+#include <unistd.h>
+#include <xc.h>
+#include "circular_buffer.h"
+#define BINLOG_HOST_MODULE
+#define BINLOG_MODULE BINLOG_MODULE_HOST
+#include "binlog.h"
+#include "PIC32_HostModel.h"
+#undef printf // dbprintf.h sends it to DB_printf
+
+/*----------------------------- Module Defines ----------------------------*/
+#define BATCH           4       // banners between drains, fits both buffers
+#define CAPTURED_EVENTS 5
+#define EVENT_SPACING_NS 250000000ULL
+#define US_PER_UART_BYTE 86.8   // 10 bits at 115200 baud
+
+/*---------------------------- Module Functions ---------------------------*/
+static void printfBanner(void);
+static void binlogBanner(void);
+static uint32_t drain(FILE *pCapture);
+static void nextGameState(uint32_t Event);
+static double now_ns(void);
+
+/*---------------------------- Module Variables ---------------------------*/
+static uint8_t XmitBuffer[1024];
+static cbuf_handle_t XmitHandle;
+
+// what the banner shows, moved on a little each event
+static uint8_t Countdown;
+static int16_t Score;
+static int8_t TargetPlanet;
+static bool BlackHole;
+
+/*------------------------------ Module Code ------------------------------*/
+int main(int argc, char *argv[])
+{
+  FILE *pCapture = NULL;
+  int NumEvents = 100000;
+  double Start_ns;
+  double Printf_ns = 0;
+  double Site_ns = 0;
+  double Flush_ns = 0;
+  double Masked_ns = 0;
+  uint64_t PrintfBytes = 0;
+  uint64_t BinLogBytes = 0;
+  int Event;
+  int i;
+  int Opt;
+
+  while ((Opt = getopt(argc, argv, "n:o:")) != -1)
+  {
+    switch (Opt)
+    {
+      case 'n': NumEvents = atoi(optarg); break;
+      case 'o':
+        pCapture = fopen(optarg, "wb");
+        if (NULL == pCapture)
+        {
+          perror(optarg);
+          return 1;
+        }
+        break;
+      default:
+        fprintf(stderr, "usage: %s [-n events] [-o capture]\n", argv[0]);
+        return 1;
+    }
+  }
+  NumEvents -= NumEvents % BATCH;
+  if (NumEvents < BATCH)
+  {
+    NumEvents = BATCH;
+  }
+  HostModel_Reset();
+  XmitHandle = circular_buf_init(XmitBuffer, sizeof(XmitBuffer));
+
+  for (Event = 0; Event < NumEvents; Event += BATCH)
+  {
+    Start_ns = now_ns();
+    for (i = 0; i < BATCH; i++)
+    {
+      nextGameState(Event + i);
+      printfBanner();
+    }
+    Printf_ns += now_ns() - Start_ns;
+    PrintfBytes += drain(NULL);
+  }
+
+  for (Event = 0; Event < NumEvents; Event += BATCH)
+  {
+    Start_ns = now_ns();
+    for (i = 0; i < BATCH; i++)
+    {
+      nextGameState(Event + i);
+      binlogBanner();
+    }
+    Site_ns += now_ns() - Start_ns;
+    Start_ns = now_ns();
+    BinLog_Flush();
+    Flush_ns += now_ns() - Start_ns;
+    BinLogBytes += drain((Event < CAPTURED_EVENTS) ? pCapture : NULL);
+    // spread the stamps out for the capture
+    HostModel_Advance_ns(EVENT_SPACING_NS);
+  }
+
+  BinLog_SetMask(BinLog_GetMask() & ~(1U << BINLOG_MODULE_HOST));
+  for (Event = 0; Event < NumEvents; Event += BATCH)
+  {
+    Start_ns = now_ns();
+    for (i = 0; i < BATCH; i++)
+    {
+      nextGameState(Event + i);
+      binlogBanner();
+    }
+    Masked_ns += now_ns() - Start_ns;
+  }
+
+  printf("%d GameOn banners of 6 lines\n", NumEvents);
+  printf("DB_printf  %7.1f ns/banner in the service, %5.1f UART bytes, "
+         "%6.0f us on the wire\n", Printf_ns / NumEvents,
+         (double)PrintfBytes / NumEvents,
+         US_PER_UART_BYTE * PrintfBytes / NumEvents);
+  printf("BINLOG     %7.1f ns/banner in the service, %5.1f UART bytes, "
+         "%6.0f us on the wire\n", Site_ns / NumEvents,
+         (double)BinLogBytes / NumEvents,
+         US_PER_UART_BYTE * BinLogBytes / NumEvents);
+  printf("           %7.1f ns/banner later in BinLog_Flush, %u dropped\n",
+         Flush_ns / NumEvents, (unsigned)BinLog_GetDropped());
+  printf("masked     %7.1f ns/banner in the service\n",
+         Masked_ns / NumEvents);
+  printf("per call   DB_printf %.1f ns, BINLOG %.1f ns, %.1fx\n",
+         Printf_ns / NumEvents / 6, Site_ns / NumEvents / 6,
+         Printf_ns / Site_ns);
+  if (NULL != pCapture)
+  {
+    fclose(pCapture);
+  }
+  return 0;
+}
+
+/*--------------------------- private functions ---------------------------*/
+// as RunGameService had it
+static void printfBanner(void)
+{
+  DB_printf("---------------------------------\n");
+  DB_printf("GameOn for %d more seconds\n", Countdown * 10);
+  DB_printf("Score: %d\n", Score);
+  DB_printf("Target Planet: %d\n", TargetPlanet + 1);
+  DB_printf("BlackHole: %s\n", BlackHole ? "ON" : "OFF");
+  DB_printf("---------------------------------\n");
+}
+
+// as it has it now
+static void binlogBanner(void)
+{
+  LOG_DEBUG("---------------------------------\n");
+  LOG_DEBUG("GameOn for %d more seconds\n", Countdown * 10);
+  LOG_DEBUG("Score: %d\n", Score);
+  LOG_DEBUG("Target Planet: %d\n", TargetPlanet + 1);
+  if (BlackHole)
+  {
+    LOG_DEBUG("BlackHole: ON\n");
+  }
+  else
+  {
+    LOG_DEBUG("BlackHole: OFF\n");
+  }
+  LOG_DEBUG("---------------------------------\n");
+}
+
+// empties the buffer the way the UART would, counting the bytes
+static uint32_t drain(FILE *pCapture)
+{
+  uint32_t NumBytes = 0;
+  uint8_t Byte;
+
+  while (0 == circular_buf_get(XmitHandle, &Byte))
+  {
+    NumBytes++;
+    if (NULL != pCapture)
+    {
+      fputc(Byte, pCapture);
+    }
+  }
+  return NumBytes;
+}
+
+static void nextGameState(uint32_t Event)
+{
+  Countdown = 6 - (Event / 8) % 6;
+  Score = (int16_t)((Event * 7) % 130) - 15;
+  TargetPlanet = Event % 4;
+  BlackHole = (0 != (Event & 2));
+}
+
+// DB_printf's characters, as _mon_putc puts them on the PIC32
+int __wrap_putchar(int c)
+{
+  circular_buf_put(XmitHandle, (uint8_t)c);
+  return c;
+}
+
+// what binlog.c needs of terminal.c
+void Terminal_WriteBytes(const uint8_t *pBytes, uint16_t Length)
+{
+  while (Length-- > 0)
+  {
+    circular_buf_put(XmitHandle, *pBytes++);
+  }
+}
+
+uint16_t Terminal_GetTxFree(void)
+{
+  if (circular_buf_full(XmitHandle))
+  {
+    return 0;
+  }
+  return circular_buf_capacity(XmitHandle) - 1 -
+         circular_buf_size(XmitHandle);
+}
+
+static double now_ns(void)
+{
+  struct timespec Now;
+
+  clock_gettime(CLOCK_MONOTONIC, &Now);
+  return (double)Now.tv_sec * 1e9 + (double)Now.tv_nsec;
+}
@@ -0,0 +1,492 @@
+/****************************************************************************
+ Module
+   BinLog_Decode.c
+
+ Description
+   Turns a terminal capture from firmware built with BINLOG_TOKENIZED back
+   into text. The string table is generated from the sources: every BINLOG
+   or LOG_ level site in the files listed in BINLOG_MODULES is found by line number and
+   its format string read out, which is exactly what the site id encodes.
+   Plain text between frames, from DB_printf calls that are still plain, is
+   passed through as it is; frames that are not log records, such as
+   telemetry, are left out.
+
+ Build (from the repository root)
+   gcc -IHostTools/include -IFrameworkHeaders HostTools/BinLog_Decode.c
+       -o binlog_decode
+
+ Usage
+   ./binlog_decode [-r source_root] [-t table] [-g] [capture]
+   Reads the capture from stdin if no file is given. -g prints the
+   generated table instead of decoding; save it with the firmware image and
+   pass it back with -t to decode after the sources have moved on.
+
+ Notes
+   Each record is printed with the time since the first record, from the
+   CP0 Count at 20MHz, unwrapped on the way so that the 214s wrap does not
+   show.
+****************************************************************************/
+/*----------------------------- Include Files -----------------------------*/
+#include <ctype.h>
+#include <stdbool.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#define BINLOG_HOST_MODULE // to decode BinLog_Bench captures
+#include "binlog.h"
+#undef printf // dbprintf.h sends it to DB_printf
+
+/*----------------------------- Module Defines ----------------------------*/
+#define NUM_SITES        65536
+#define MAX_FORMAT       256
+#define MAX_FRAME        256
+#define MAX_LINE         1024
+#define MAX_SOURCE_LINES 4096
+#define CORE_COUNTS_PER_MS 20000.0
+
+/*---------------------------- Module Functions ---------------------------*/
+static bool scanSources(const char *pRoot);
+static bool scanFile(const char *pPath, BinLogModule_t Module);
+static bool readLiteral(const char **ppText, char *pOut, size_t *pLength);
+static bool loadTable(const char *pPath);
+static void printTable(void);
+static void decodeStream(FILE *pIn);
+static void decodeFrame(const uint8_t *pFrame, size_t Length);
+static size_t unCOBS(const uint8_t *pIn, size_t Length, uint8_t *pOut);
+static bool getVarint(const uint8_t **ppIn, const uint8_t *pEnd,
+                      uint32_t *pValue);
+static void printRecord(const char *pFormat, const uint32_t *pArgs,
+                        uint8_t NumArgs);
+
+/*---------------------------- Module Variables ---------------------------*/
+#define BINLOG_MODULE_FILE(Name, Short, File) File,
+static const char *ModuleFiles[] = { BINLOG_MODULES(BINLOG_MODULE_FILE) };
+#undef BINLOG_MODULE_FILE
+
+// the names a log site can be written with
+static const char *SiteMacros[] = {
+  "BINLOG", "LOG_ERROR", "LOG_WARN", "LOG_INFO", "LOG_DEBUG"
+};
+
+static char *Formats[NUM_SITES];
+static bool IsFirstRecord = true;
+static uint32_t LastStamp;
+static double Elapsed_ms;
+
+/*------------------------------ Module Code ------------------------------*/
+int main(int argc, char *argv[])
+{
+  const char *pRoot = ".";
+  const char *pTable = NULL;
+  bool IsPrintingTable = false;
+  FILE *pIn = stdin;
+  int Opt;
+
+  while ((Opt = getopt(argc, argv, "r:t:g")) != -1)
+  {
+    switch (Opt)
+    {
+      case 'r': pRoot = optarg; break;
+      case 't': pTable = optarg; break;
+      case 'g': IsPrintingTable = true; break;
+      default:
+        fprintf(stderr, "usage: %s [-r source_root] [-t table] [-g] "
+                "[capture]\n", argv[0]);
+        return 1;
+    }
+  }
+  if ((NULL != pTable) ? !loadTable(pTable) : !scanSources(pRoot))
+  {
+    return 1;
+  }
+  if (true == IsPrintingTable)
+  {
+    printTable();
+    return 0;
+  }
+  if (optind < argc)
+  {
+    pIn = fopen(argv[optind], "rb");
+    if (NULL == pIn)
+    {
+      perror(argv[optind]);
+      return 1;
+    }
+  }
+  decodeStream(pIn);
+  return 0;
+}
+
+/*--------------------------- private functions ---------------------------*/
+static bool scanSources(const char *pRoot)
+{
+  char Path[MAX_LINE];
+  BinLogModule_t Module;
+
+  for (Module = 0; Module < BINLOG_NUM_MODULES; Module++)
+  {
+    snprintf(Path, sizeof(Path), "%s/%s", pRoot, ModuleFiles[Module]);
+    if (false == scanFile(Path, Module))
+    {
+      return false;
+    }
+  }
+  return true;
+}
+
+// finds the sites in one file and reads each one's format string, which
+// may start on a later line than the macro name and be split into
+// several literals
+static bool scanFile(const char *pPath, BinLogModule_t Module)
+{
+  static char Lines[MAX_SOURCE_LINES + 1][MAX_LINE];
+  char Format[MAX_FORMAT];
+  char Joined[MAX_LINE * 4];
+  const char *pAt;
+  size_t Length;
+  int NumLines = 0;
+  int LineNum;
+  int Next;
+  size_t m;
+  FILE *pFile = fopen(pPath, "r");
+
+  if (NULL == pFile)
+  {
+    perror(pPath);
+    return false;
+  }
+  while ((NumLines < MAX_SOURCE_LINES) &&
+         (NULL != fgets(Lines[NumLines + 1], MAX_LINE, pFile)))
+  {
+    NumLines++;
+  }
+  fclose(pFile);
+
+  for (LineNum = 1; LineNum <= NumLines; LineNum++)
+  {
+    for (m = 0; m < sizeof(SiteMacros) / sizeof(SiteMacros[0]); m++)
+    {
+      pAt = strstr(Lines[LineNum], SiteMacros[m]);
+      // skip #defines and longer names that merely contain the macro's
+      if ((NULL == pAt) || ('#' == Lines[LineNum][strspn(Lines[LineNum],
+                                                          " \t")]) ||
+          ((pAt > Lines[LineNum]) && (isalnum((unsigned char)pAt[-1]) ||
+                                      ('_' == pAt[-1]))))
+      {
+        continue;
+      }
+      pAt += strlen(SiteMacros[m]);
+      while (isspace((unsigned char)*pAt))
+      {
+        pAt++;
+      }
+      if ('(' != *pAt)
+      {
+        continue;
+      }
+      // the literal may run onto the next few lines
+      snprintf(Joined, sizeof(Joined), "%s", pAt + 1);
+      for (Next = LineNum + 1; (Next <= NumLines) && (Next < LineNum + 4);
+           Next++)
+      {
+        strncat(Joined, Lines[Next], sizeof(Joined) - strlen(Joined) - 1);
+      }
+      pAt = Joined;
+      Length = 0;
+      Format[0] = 0;
+      while (true == readLiteral(&pAt, Format, &Length))
+      {}
+      if (0 == Length)
+      {
+        continue;
+      }
+      Formats[BINLOG_SITE(Module, LineNum)] = strdup(Format);
+    }
+  }
+  return true;
+}
+
+// appends the next string literal in the text, skipping white space
+static bool readLiteral(const char **ppText, char *pOut, size_t *pLength)
+{
+  const char *pIn = *ppText;
+  char c;
+
+  while (isspace((unsigned char)*pIn))
+  {
+    pIn++;
+  }
+  if ('"' != *pIn)
+  {
+    return false;
+  }
+  for (pIn++; ('"' != *pIn) && (0 != *pIn); pIn++)
+  {
+    c = *pIn;
+    if ('\\' == c)
+    {
+      switch (*++pIn)
+      {
+        case 'n': c = '\n'; break;
+        case 'r': c = '\r'; break;
+        case 't': c = '\t'; break;
+        default: c = *pIn; break;
+      }
+    }
+    if (*pLength < MAX_FORMAT - 1)
+    {
+      pOut[(*pLength)++] = c;
+      pOut[*pLength] = 0;
+    }
+  }
+  *ppText = ('"' == *pIn) ? pIn + 1 : pIn;
+  return true;
+}
+
+// one site a line: the id in hex, a tab, the format with \n escaped
+static bool loadTable(const char *pPath)
+{
+  char Line[MAX_LINE];
+  char Format[MAX_FORMAT];
+  unsigned Site;
+  char *pIn;
+  char *pOut;
+  FILE *pFile = fopen(pPath, "r");
+
+  if (NULL == pFile)
+  {
+    perror(pPath);
+    return false;
+  }
+  while (NULL != fgets(Line, sizeof(Line), pFile))
+  {
+    pIn = strchr(Line, '\t');
+    if ((NULL == pIn) || (1 != sscanf(Line, "%x", &Site)) ||
+        (Site >= NUM_SITES))
+    {
+      continue;
+    }
+    for (pIn++, pOut = Format;
+         (0 != *pIn) && ('\n' != *pIn) && (pOut < &Format[MAX_FORMAT - 1]);
+         pIn++)
+    {
+      if (('\\' == pIn[0]) && ('n' == pIn[1]))
+      {
+        *pOut++ = '\n';
+        pIn++;
+      }
+      else if (('\\' == pIn[0]) && ('\\' == pIn[1]))
+      {
+        *pOut++ = '\\';
+        pIn++;
+      }
+      else
+      {
+        *pOut++ = *pIn;
+      }
+    }
+    *pOut = 0;
+    Formats[Site] = strdup(Format);
+  }
+  fclose(pFile);
+  return true;
+}
+
+static void printTable(void)
+{
+  const char *pIn;
+  unsigned Site;
+
+  for (Site = 0; Site < NUM_SITES; Site++)
+  {
+    if (NULL == Formats[Site])
+    {
+      continue;
+    }
+    printf("%04x\t", Site);
+    for (pIn = Formats[Site]; 0 != *pIn; pIn++)
+    {
+      if ('\n' == *pIn)
+      {
+        fputs("\\n", stdout);
+      }
+      else if ('\\' == *pIn)
+      {
+        fputs("\\\\", stdout);
+      }
+      else
+      {
+        putchar(*pIn);
+      }
+    }
+    putchar('\n');
+  }
+}
+
+// text until a zero, a frame until the next; back to back frames send two
+// zeros between them, and an empty frame is just taken as the start of one
+static void decodeStream(FILE *pIn)
+{
+  uint8_t Frame[MAX_FRAME];
+  size_t Length = 0;
+  bool IsInFrame = false;
+  int c;
+
+  while (EOF != (c = getc(pIn)))
+  {
+    if (false == IsInFrame)
+    {
+      if (0 == c)
+      {
+        IsInFrame = true;
+        Length = 0;
+      }
+      else if ('\r' != c)
+      {
+        putchar(c);
+      }
+    }
+    else if (0 == c)
+    {
+      if (0 != Length)
+      {
+        decodeFrame(Frame, Length);
+        IsInFrame = false;
+      }
+    }
+    else if (Length < MAX_FRAME)
+    {
+      Frame[Length++] = (uint8_t)c;
+    }
+  }
+}
+
+static void decodeFrame(const uint8_t *pFrame, size_t Length)
+{
+  uint8_t Payload[MAX_FRAME];
+  uint32_t Args[BINLOG_MAX_ARGS];
+  const uint8_t *pIn;
+  size_t PayloadLength = unCOBS(pFrame, Length, Payload);
+  uint16_t Site;
+  uint32_t Stamp;
+  uint8_t NumArgs = 0;
+
+  if (PayloadLength < 6)
+  {
+    printf("[bad frame, %u bytes]\n", (unsigned)Length);
+    return;
+  }
+  Site = Payload[0] | (Payload[1] << 8);
+  Stamp = Payload[2] | (Payload[3] << 8) | (Payload[4] << 16) |
+          ((uint32_t)Payload[5] << 24);
+  if (BINLOG_MODULE_FRAMES == (Site >> 12))
+  {
+    return;                    // telemetry and such have their own decoders
+  }
+  pIn = &Payload[6];
+  while ((pIn < &Payload[PayloadLength]) && (NumArgs < BINLOG_MAX_ARGS) &&
+         getVarint(&pIn, &Payload[PayloadLength], &Args[NumArgs]))
+  {
+    NumArgs++;
+  }
+
+  if (false == IsFirstRecord)
+  {
+    Elapsed_ms += (uint32_t)(Stamp - LastStamp) / CORE_COUNTS_PER_MS;
+  }
+  IsFirstRecord = false;
+  LastStamp = Stamp;
+  printf("[%10.3f] ", Elapsed_ms);
+  if (NULL == Formats[Site])
+  {
+    printf("unknown site %04x (module %u, line %u)\n", Site, Site >> 12,
+           Site & 0x0FFF);
+    return;
+  }
+  printRecord(Formats[Site], Args, NumArgs);
+}
+
+// returns the decoded length, 0 if the frame is malformed
+static size_t unCOBS(const uint8_t *pIn, size_t Length, uint8_t *pOut)
+{
+  size_t In = 0;
+  size_t Out = 0;
+  uint8_t Code;
+  uint8_t i;
+
+  while (In < Length)
+  {
+    Code = pIn[In++];
+    if ((0 == Code) || (In + Code - 1 > Length))
+    {
+      return 0;
+    }
+    for (i = 1; i < Code; i++)
+    {
+      pOut[Out++] = pIn[In++];
+    }
+    if ((Code < 0xFF) && (In < Length))
+    {
+      pOut[Out++] = 0;
+    }
+  }
+  return Out;
+}
+
+static bool getVarint(const uint8_t **ppIn, const uint8_t *pEnd,
+                      uint32_t *pValue)
+{
+  uint32_t ZigZag = 0;
+  uint8_t Shift = 0;
+  uint8_t Byte;
+
+  do
+  {
+    if ((*ppIn >= pEnd) || (Shift > 28))
+    {
+      return false;
+    }
+    Byte = *(*ppIn)++;
+    ZigZag |= (uint32_t)(Byte & 0x7F) << Shift;
+    Shift += 7;
+  } while (0 != (Byte & 0x80));
+  *pValue = (ZigZag >> 1) ^ (uint32_t)-(int32_t)(ZigZag & 1);
+  return true;
+}
+
+// the same conversions DB_printf knows
+static void printRecord(const char *pFormat, const uint32_t *pArgs,
+                        uint8_t NumArgs)
+{
+  uint8_t Used = 0;
+
+  for (; 0 != *pFormat; pFormat++)
+  {
+    if ('%' != *pFormat)
+    {
+      putchar(*pFormat);
+      continue;
+    }
+    pFormat++;
+    if ('%' == *pFormat)
+    {
+      putchar('%');
+      continue;
+    }
+    if (Used >= NumArgs)
+    {
+      fputs("(missing)", stdout);
+      continue;
+    }
+    switch (*pFormat)
+    {
+      case 'd': printf("%d", (int32_t)pArgs[Used]); break;
+      case 'u': printf("%u", pArgs[Used]); break;
+      case 'x': printf("%x", pArgs[Used]); break;
+      case 'c': putchar((char)pArgs[Used]); break;
+      default: fputs("BAD", stdout); break;
+    }
+    Used++;
+  }
+}
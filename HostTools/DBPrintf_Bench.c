@@ -0,0 +1,397 @@
+/****************************************************************************
+ Module
+   DBPrintf_Bench.c
+
+ Description
+   Formatting throughput of dbprintf.c against the formatter it replaced,
+   which is kept here as it was, on the lines the game actually prints,
+   and a check of the new one against the C library's snprintf for values
+   at and around every power of 10 and 16, random values, every length
+   modifier, and widths with and without '-' and '0'.
+
+   Both format into a buffer, so only the formatting is timed: the
+   characters then go to the terminal the same way either way. The old
+   formatter's divides are counted as it runs, since on the PIC32 they are
+   what it costs: the M4K's divider takes up to 35 cycles, where the host's
+   takes about 10. The digits table then times %u for each length of value.
+
+ Build (from the repository root)
+   gcc -O2 -IHostTools/include -IFrameworkHeaders HostTools/DBPrintf_Bench.c
+       FrameworkSource/dbprintf.c -o dbprintf_bench
+
+ Usage
+   ./dbprintf_bench [-n calls]
+
+ Notes
+   The old uitoa is kept out of line, as it is on the PIC32 where one copy
+   serves both bases; inlined at -O2, the host compiler would turn its
+   divides by 10 into multiplies itself, which XC32 at -O1 does not.
+
+   The host divides in about the time of two multiplies, so on one run
+   the pairs only pull ahead from 6 digits, 1.7x at 10, and the game's
+   short values format about 10% slower. The old formatter did 5.6
+   divides a line there, up to 195 cycles, or 4.9 us at 40 MHz, on the
+   PIC32, where the new one does a multiply of a few cycles for every two
+   digits instead.
+****************************************************************************/
+/*----------------------------- Include Files -----------------------------*/
+#include <stdarg.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+#include "dbprintf.h"
+#undef printf // dbprintf.h sends it to DB_printf
+
+/*----------------------------- Module Defines ----------------------------*/
+#define LINE_LEN        120
+#define FIELD_LEN       11
+#define BUFFER_LEN      (LINE_LEN + 1)
+#define M4K_DIV_CYCLES  35
+#define PBCLK_MHZ       40
+#define NUM_RANDOM      2000000
+#define NUM_ROUNDS      5
+
+/*---------------------------- Module Functions ---------------------------*/
+static void oldSprintf(char *LineBuffer, const char *Format, ...);
+static void uitoa(char **buf, unsigned int i, unsigned int baseNum)
+                  __attribute__((noinline));
+static double timeLines(bool IsOld, uint32_t NumCalls);
+static double timeDigits(bool IsOld, uint32_t NumCalls, uint32_t Base);
+static uint32_t checkAgainstLibrary(void);
+static uint32_t checkOne(const char *Format, uint64_t Value);
+static uint64_t nextRandom(uint64_t *pSeed);
+static double now_ns(void);
+
+/*---------------------------- Module Variables ---------------------------*/
+static uint32_t NumDivides;
+static volatile char Sink;
+
+/*------------------------------ Module Code ------------------------------*/
+int main(int argc, char *argv[])
+{
+  uint32_t NumCalls = 200000;
+  double Old_ns = 0;
+  double New_ns = 0;
+  double Time_ns;
+  double DividesPerLine;
+  uint8_t Round;
+  uint32_t Base;
+  uint8_t Digits;
+  uint32_t NumBad;
+  int Opt;
+
+  while ((Opt = getopt(argc, argv, "n:")) != -1)
+  {
+    switch (Opt)
+    {
+      case 'n': NumCalls = (uint32_t)atoi(optarg); break;
+      default:
+        fprintf(stderr, "usage: %s [-n calls]\n", argv[0]);
+        return 1;
+    }
+  }
+  // taking turns and keeping the best of each evens out the host's noise
+  for (Round = 0; Round < NUM_ROUNDS; Round++)
+  {
+    NumDivides = 0;
+    Time_ns = timeLines(true, NumCalls);
+    Old_ns = ((0 == Round) || (Time_ns < Old_ns)) ? Time_ns : Old_ns;
+    Time_ns = timeLines(false, NumCalls);
+    New_ns = ((0 == Round) || (Time_ns < New_ns)) ? Time_ns : New_ns;
+  }
+  DividesPerLine = (double)NumDivides / NumCalls;
+  printf("%u game lines, best of %d\n", (unsigned)NumCalls, NUM_ROUNDS);
+  printf("old uitoa       %7.1f ns/line, %4.1f divides/line, up to %.0f "
+         "cycles (%.1f us) of them on the PIC32\n", Old_ns / NumCalls,
+         DividesPerLine, DividesPerLine * M4K_DIV_CYCLES,
+         DividesPerLine * M4K_DIV_CYCLES / PBCLK_MHZ);
+  printf("digit pairs     %7.1f ns/line, no divides, %.1fx\n",
+         New_ns / NumCalls, Old_ns / New_ns);
+
+  printf("%%u of n digits     old ns   new ns\n");
+  for (Base = 1, Digits = 1; Digits <= 10; Base *= 10, Digits++)
+  {
+    for (Round = 0; Round < NUM_ROUNDS; Round++)
+    {
+      Time_ns = timeDigits(true, NumCalls, Base);
+      Old_ns = ((0 == Round) || (Time_ns < Old_ns)) ? Time_ns : Old_ns;
+      Time_ns = timeDigits(false, NumCalls, Base);
+      New_ns = ((0 == Round) || (Time_ns < New_ns)) ? Time_ns : New_ns;
+    }
+    printf("%2u                %8.1f %8.1f  %.1fx\n", (unsigned)Digits,
+           Old_ns / NumCalls, New_ns / NumCalls, Old_ns / New_ns);
+  }
+
+  NumBad = checkAgainstLibrary();
+  printf("against snprintf: %u mismatched\n", (unsigned)NumBad);
+  printf("%s\n", (0 == NumBad) ? "PASS" : "FAIL");
+  return (0 == NumBad) ? 0 : 1;
+}
+
+/*--------------------------- private functions ---------------------------*/
+// the lines RunGameService and the timing traces print, with the values
+// moving on a little each call
+static double timeLines(bool IsOld, uint32_t NumCalls)
+{
+  char Line[BUFFER_LEN];
+  double Start = now_ns();
+  uint32_t i;
+
+  for (i = 0; i < NumCalls; i++)
+  {
+    int Score = (int)((i * 7) % 130) - 15;
+    unsigned Stamp = 1000000u + i * 2731u;
+
+    switch (i & 3)
+    {
+      case 0:
+        if (IsOld) oldSprintf(Line, "GameOn for %d more seconds\n", 60 - i % 60);
+        else DB_snprintf(Line, sizeof(Line), "GameOn for %d more seconds\n",
+                         60 - i % 60);
+        break;
+      case 1:
+        if (IsOld) oldSprintf(Line, "Score: %d\n", Score);
+        else DB_snprintf(Line, sizeof(Line), "Score: %d\n", Score);
+        break;
+      case 2:
+        if (IsOld) oldSprintf(Line, "t=%u dt=%u q=%x\n", Stamp, i % 5000, i);
+        else DB_snprintf(Line, sizeof(Line), "t=%u dt=%u q=%x\n", Stamp,
+                         i % 5000, i);
+        break;
+      default:
+        if (IsOld) oldSprintf(Line, "Target Planet: %d, %s\n", i % 4 + 1,
+                              (i & 8) ? "ON" : "OFF");
+        else DB_snprintf(Line, sizeof(Line), "Target Planet: %d, %s\n",
+                         i % 4 + 1, (i & 8) ? "ON" : "OFF");
+        break;
+    }
+    Sink = Line[7];
+  }
+  return now_ns() - Start;
+}
+
+// a value of the same length each call, Base up to 10 times Base - 1
+static double timeDigits(bool IsOld, uint32_t NumCalls, uint32_t Base)
+{
+  char Line[BUFFER_LEN];
+  uint32_t Span = (Base < 1000000000UL) ? 9 * Base : 3294967295UL;
+  double Start = now_ns();
+  uint32_t i;
+
+  for (i = 0; i < NumCalls; i++)
+  {
+    uint32_t Value = Base + (i * 2654435761UL) % Span;
+
+    if (IsOld)
+    {
+      oldSprintf(Line, "%u", Value);
+    }
+    else
+    {
+      DB_snprintf(Line, sizeof(Line), "%u", Value);
+    }
+    Sink = Line[0];
+  }
+  return now_ns() - Start;
+}
+
+static uint32_t checkAgainstLibrary(void)
+{
+  static const char *const Formats[] = {
+    "%d", "%u", "%x", "%ld", "%lu", "%lx", "%lld", "%llu", "%llx",
+    "%8d", "%-8d|", "%08d", "%12lld", "%-21llu|", "%020llu", "%6x", "%06x",
+    "%1u", "%3d"
+  };
+  uint32_t NumBad = 0;
+  uint64_t Seed = 1;
+  uint64_t Power;
+  uint8_t f;
+  uint32_t i;
+
+  for (f = 0; f < sizeof(Formats) / sizeof(Formats[0]); f++)
+  {
+    NumBad += checkOne(Formats[f], 0);
+    NumBad += checkOne(Formats[f], UINT64_MAX);
+    NumBad += checkOne(Formats[f], (uint64_t)INT64_MIN);
+    for (Power = 10; Power < UINT64_MAX / 10; Power *= 10)
+    {
+      NumBad += checkOne(Formats[f], Power - 1);
+      NumBad += checkOne(Formats[f], Power);
+      NumBad += checkOne(Formats[f], 0 - Power);
+    }
+    for (Power = 16; 0 != Power; Power <<= 4)
+    {
+      NumBad += checkOne(Formats[f], Power - 1);
+      NumBad += checkOne(Formats[f], Power);
+    }
+    for (i = 0; i < NUM_RANDOM; i++)
+    {
+      // all lengths, not just the long ones a uniform value almost always is
+      NumBad += checkOne(Formats[f], nextRandom(&Seed) >> (i % 64));
+    }
+  }
+  NumBad += checkOne("%c|%3c|%-3c|", 'x');
+  NumBad += checkOne("%s|%8s|%-8s|", (uintptr_t)"abc");
+  NumBad += checkOne("100%% %q", 0);
+  return NumBad;
+}
+
+// the value is passed as the width the format asks for, as a caller would
+static uint32_t checkOne(const char *Format, uint64_t Value)
+{
+  char Expected[BUFFER_LEN];
+  char Got[BUFFER_LEN];
+  const char *pLength = Format + strcspn(Format, "l");
+  const char *pBad = strstr(Format, "%q");
+
+  if (NULL != pBad)
+  {
+    DB_snprintf(Got, sizeof(Got), Format);
+    snprintf(Expected, sizeof(Expected), "100%% BAD");
+  }
+  else if (NULL != strchr(Format, 's'))
+  {
+    const char *pString = (const char *)(uintptr_t)Value;
+    DB_snprintf(Got, sizeof(Got), Format, pString, pString, pString);
+    snprintf(Expected, sizeof(Expected), Format, pString, pString, pString);
+  }
+  else if (NULL != strchr(Format, 'c'))
+  {
+    DB_snprintf(Got, sizeof(Got), Format, (int)Value, (int)Value, (int)Value);
+    snprintf(Expected, sizeof(Expected), Format, (int)Value, (int)Value,
+             (int)Value);
+  }
+  else if (0 == strncmp(pLength, "ll", 2))
+  {
+    DB_snprintf(Got, sizeof(Got), Format, (unsigned long long)Value);
+    snprintf(Expected, sizeof(Expected), Format, (unsigned long long)Value);
+  }
+  else if ('l' == *pLength)
+  {
+    DB_snprintf(Got, sizeof(Got), Format, (unsigned long)Value);
+    snprintf(Expected, sizeof(Expected), Format, (unsigned long)Value);
+  }
+  else
+  {
+    DB_snprintf(Got, sizeof(Got), Format, (unsigned)Value);
+    snprintf(Expected, sizeof(Expected), Format, (unsigned)Value);
+  }
+  if (0 != strcmp(Got, Expected))
+  {
+    printf("\"%s\" of %llu: got \"%s\", expected \"%s\"\n", Format,
+           (unsigned long long)Value, Got, Expected);
+    return 1;
+  }
+  return 0;
+}
+
+// dbprintf.c's DB_printf and uitoa as they were, formatting into a buffer
+// in place of putting the line out, and counting divides
+static void oldSprintf(char *LineBuffer, const char *Format, ...)
+{
+  va_list Arguments;
+  char *pBuffer;
+  char *pString;
+  int   i;
+  unsigned int u;
+
+  va_start(Arguments,Format);
+  pBuffer = LineBuffer;
+  *pBuffer = 0;
+  while (*Format)
+  {
+    if (*Format != '%')
+    {
+      *pBuffer++ = *Format++;
+    }else
+    {
+       switch (*++Format)
+       {
+          case 'd':
+             i = va_arg(Arguments,int);
+             if (i < 0)
+             {
+                *pBuffer++ = '-';
+                i = -1*i;
+             }
+             uitoa(&pBuffer, (unsigned int)i, 10);
+             break;
+          case 'x':
+             u = va_arg(Arguments,unsigned int);
+             uitoa(&pBuffer, u, 16);
+             break;
+          case 'u':
+             u = va_arg(Arguments,unsigned int);
+             uitoa(&pBuffer, u, 10);
+             break;
+          case 'c':
+             *pBuffer++ = (char) va_arg(Arguments,unsigned int);
+             break;
+          case 's':
+             pString = va_arg(Arguments,char *);
+             if (!pString)
+                pString = "(null)";
+             while (*pString)
+                *pBuffer++ = *pString++;
+             break;
+          case '%':
+             *pBuffer++ = '%';
+              break;
+          default:
+              *pBuffer++ = 'B';
+              *pBuffer++ = 'A';
+              *pBuffer++ = 'D';
+              break;
+       }
+       Format++;
+    }
+  }
+  *pBuffer = 0;
+  va_end(Arguments);
+}
+
+static void uitoa(char **LineBuffer, unsigned int i, unsigned int baseNum)
+{
+  char *s;
+  uint8_t remainder;
+  char FieldBuf[FIELD_LEN + 1];
+
+  FieldBuf[FIELD_LEN] = 0;
+  if (i == 0)
+  {
+    (*LineBuffer)[0] = '0';
+    ++(*LineBuffer);
+    return;
+  }
+  s = &FieldBuf[FIELD_LEN];
+  while (i)
+  {
+    remainder = i % baseNum;
+    *--s = "0123456789abcdef"[remainder];
+    i /= baseNum;
+    NumDivides++;                // one DIVU gives both
+  }
+  while (*s)
+  {
+    (*LineBuffer)[0] = *s++;
+    ++(*LineBuffer);
+  }
+}
+
+static uint64_t nextRandom(uint64_t *pSeed)
+{
+  *pSeed ^= *pSeed << 13;
+  *pSeed ^= *pSeed >> 7;
+  *pSeed ^= *pSeed << 17;
+  return *pSeed;
+}
+
+static double now_ns(void)
+{
+  struct timespec Now;
+
+  clock_gettime(CLOCK_MONOTONIC, &Now);
+  return (double)Now.tv_sec * 1e9 + (double)Now.tv_nsec;
+}
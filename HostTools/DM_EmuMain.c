@@ -0,0 +1,156 @@
+/****************************************************************************
+ Module
+   DM_EmuMain.c
+
+ Description
+   Runs the dot matrix driver (DM_DisplayStarter.c) against the MAX7219 chain
+   emulator on the host. Initializes the chain, puts a static word on one
+   display and scrolls a message across the other, rendering each frame and
+   reporting how long the bus took to update it.
+
+ Build (from the repository root)
+   gcc -IHostTools/include -IHostTools -IProjectHeaders
+       HostTools/DM_EmuMain.c HostTools/MAX7219_Emu.c HostTools/SPI1_EmuHAL.c
+       ProjectSource/DM_DisplayStarter.c ProjectSource/FontStuff.c
+       -o dm_emu
+   Add -DDM_NUM_MODULES=16 etc. to emulate other chain lengths.
+
+ Usage
+   ./dm_emu [-p dir] [-n frames] [-f frame_ms] [message]
+     -p dir     write every frame to dir/frame_<time in us>.ppm instead of
+                drawing it on the terminal
+     -n frames  number of scroll frames to run (default one full pass)
+     -f ms      scroll frame period (default 60)
+****************************************************************************/
+/*----------------------------- Include Files -----------------------------*/
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include "DM_Display.h"
+#include "MAX7219_Emu.h"
+
+/*----------------------------- Module Defines ----------------------------*/
+#define SPI_BIT_RATE 100000 // matches SPISetup_SetBitTime(SPI_SPI1, 10000)
+#define STATIC_WORD "SCORE!"
+
+/*---------------------------- Module Functions ---------------------------*/
+static void showFrame(const char *pDir);
+static void putWord(const char *pWord, uint8_t WhichDisplay);
+
+/*------------------------------ Module Code ------------------------------*/
+int main(int argc, char *argv[])
+{
+  const char *pDir = NULL;
+  const char *pMsg = "INSERT COINS TO PLAY";
+  int NumFrames = -1;
+  int FrameTime_ms = 60;
+  int Opt;
+  int Frame;
+  uint16_t StripLen;
+  uint64_t Start_us;
+  uint64_t Bus_us;
+  uint64_t WorstBus_us = 0;
+  uint64_t TotalBus_us = 0;
+  uint32_t StartWords;
+  uint32_t TotalWords = 0;
+
+  while ((Opt = getopt(argc, argv, "p:n:f:")) != -1)
+  {
+    switch (Opt)
+    {
+      case 'p': pDir = optarg; break;
+      case 'n': NumFrames = atoi(optarg); break;
+      case 'f': FrameTime_ms = atoi(optarg); break;
+      default:
+        fprintf(stderr, "usage: %s [-p dir] [-n frames] [-f frame_ms] [message]\n",
+                argv[0]);
+        return 1;
+    }
+  }
+  if (optind < argc)
+  {
+    pMsg = argv[optind];
+  }
+
+  MAX7219Emu_Init(DM_NUM_MODULES, SPI_BIT_RATE);
+  while (false == DM_TakeInitDisplayStep()) {}
+  printf("init: %u words, %llu us on the bus\n",
+         (unsigned)MAX7219Emu_GetWordCount(),
+         (unsigned long long)MAX7219Emu_GetTime_us());
+
+  // static word on the last display, marquee on the first
+  putWord(STATIC_WORD, DM_NUM_DISPLAYS);
+  DM_ClearDisplayBuffer(1);
+  while (false == DM_TakeDirtyRowUpdateStep()) {}
+  showFrame(pDir);
+
+  StripLen = DM_LoadScrollStrip(pMsg, 1);
+  if (NumFrames < 0)
+  {
+    NumFrames = StripLen;
+  }
+  for (Frame = 0; Frame < NumFrames; Frame++)
+  {
+    MAX7219Emu_AdvanceTime_us(FrameTime_ms * 1000);
+    DM_TakeScrollStep(1);
+    Start_us = MAX7219Emu_GetTime_us();
+    StartWords = MAX7219Emu_GetWordCount();
+    while (false == DM_TakeDirtyRowUpdateStep()) {}
+    Bus_us = MAX7219Emu_GetTime_us() - Start_us;
+    TotalBus_us += Bus_us;
+    TotalWords += MAX7219Emu_GetWordCount() - StartWords;
+    if (Bus_us > WorstBus_us)
+    {
+      WorstBus_us = Bus_us;
+    }
+    showFrame(pDir);
+  }
+
+  printf("%d frames: %u words, bus time avg %llu us, worst %llu us\n",
+         NumFrames, (unsigned)TotalWords,
+         (unsigned long long)((NumFrames > 0) ? (TotalBus_us / NumFrames) : 0),
+         (unsigned long long)WorstBus_us);
+  if (0 != MAX7219Emu_GetShortLatchCount())
+  {
+    printf("WARNING: %u latches with fewer words than modules\n",
+           (unsigned)MAX7219Emu_GetShortLatchCount());
+    return 1;
+  }
+  return 0;
+}
+
+/*--------------------------- private functions ---------------------------*/
+static void showFrame(const char *pDir)
+{
+  if (NULL == pDir)
+  {
+    MAX7219Emu_RenderTerminal(stdout);
+  }
+  else if (false == MAX7219Emu_RenderPPM(pDir))
+  {
+    fprintf(stderr, "could not write a frame to %s\n", pDir);
+    exit(1);
+  }
+}
+
+// renders a centred word the same way LEDService does for ES_NEW_WORD
+static void putWord(const char *pWord, uint8_t WhichDisplay)
+{
+  uint8_t WordLength = strlen(pWord);
+  uint8_t i;
+
+  DM_ClearDisplayBuffer(WhichDisplay);
+  for (i = 0; i < WordLength; i++)
+  {
+    if (i > 0)
+    {
+      DM_ScrollDisplayBuffer(4, WhichDisplay);
+    }
+    DM_AddChar2DisplayBuffer((unsigned char)pWord[i], WhichDisplay);
+  }
+  if ((WordLength * 4) < DM_COLS_PER_DISPLAY)
+  {
+    DM_ScrollDisplayBuffer((DM_COLS_PER_DISPLAY - (WordLength * 4)) / 2, WhichDisplay);
+  }
+}
@@ -0,0 +1,263 @@
+/****************************************************************************
+ Module
+   Debounce_Bench.c
+
+ Description
+   Checks the vertical counter in Debounce.c against the obvious way of
+   doing it, one counter per pin in a loop, and times the two. Both are fed
+   the same recorded input: 32 pins that each change level every 50 to 550
+   samples, with a burst of chatter at most changes and the odd one sample
+   glitch in between. For every stable count from 1 to DEBOUNCE_MAX_STABLE
+   the two must report the same changes on every sample. Then each is timed
+   over the whole recording, for all 32 pins and for the 7 the sensors use.
+
+ Build (from the repository root)
+   gcc -O2 -IHostTools/include -IProjectHeaders
+       HostTools/Debounce_Bench.c ProjectSource/Debounce.c -o debounce_bench
+
+ Usage
+   ./debounce_bench [-n samples] [-s seed]
+
+ Notes
+   Host timings only give the ratio between the two. On the PIC32 the
+   vertical counter is a fixed 34 logic operations a sample; the per-pin
+   loop costs a load, compare, branch and store for every pin whatever it
+   is doing.
+****************************************************************************/
+/*----------------------------- Include Files -----------------------------*/
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+#include "Debounce.h"
+
+/*----------------------------- Module Defines ----------------------------*/
+#define MAX_SAMPLES      4000000
+#define SENSOR_PIN_MASK  0x000C0724UL // as SensorCapture packs the sensors
+#define TIMED_STABLE     4
+
+typedef struct
+{
+  uint32_t State;
+  uint8_t Count[32];
+  uint8_t StableSamples;
+} PerPin_t;
+
+/*---------------------------- Module Functions ---------------------------*/
+static void recordInput(uint32_t Seed);
+static bool checkStable(uint8_t StableSamples);
+static double timeVertical(uint32_t PinMask);
+static double timePerPin(uint32_t PinMask);
+static void perPinInit(PerPin_t *pPerPin, uint32_t Initial,
+                       uint8_t StableSamples);
+static uint32_t perPinSample(PerPin_t *pPerPin, uint32_t Raw,
+                             uint32_t PinMask);
+static uint32_t nextRandom(uint32_t *pSeed, uint32_t Range);
+static double now_ns(void);
+
+/*---------------------------- Module Variables ---------------------------*/
+static uint32_t *pInput;
+static int NumSamples = 1000000;
+static volatile uint32_t Sink; // keeps the timed loops honest
+
+/*------------------------------ Module Code ------------------------------*/
+int main(int argc, char *argv[])
+{
+  uint32_t Seed = 1957;
+  uint8_t StableSamples;
+  bool IsPassing = true;
+  int Opt;
+
+  while ((Opt = getopt(argc, argv, "n:s:")) != -1)
+  {
+    switch (Opt)
+    {
+      case 'n': NumSamples = atoi(optarg); break;
+      case 's': Seed = (uint32_t)atoi(optarg); break;
+      default:
+        fprintf(stderr, "usage: %s [-n samples] [-s seed]\n", argv[0]);
+        return 1;
+    }
+  }
+  if ((NumSamples < 1) || (NumSamples > MAX_SAMPLES))
+  {
+    NumSamples = MAX_SAMPLES;
+  }
+  pInput = malloc(NumSamples * sizeof(*pInput));
+  if (NULL == pInput)
+  {
+    return 1;
+  }
+  recordInput(Seed);
+
+  for (StableSamples = 1; StableSamples <= DEBOUNCE_MAX_STABLE;
+       StableSamples++)
+  {
+    IsPassing &= checkStable(StableSamples);
+  }
+  printf("%d samples, stable count %d\n", NumSamples, TIMED_STABLE);
+  printf("32 pins  vertical %6.2f ns/sample, per pin %6.2f ns/sample\n",
+         timeVertical(UINT32_MAX), timePerPin(UINT32_MAX));
+  printf(" 7 pins  vertical %6.2f ns/sample, per pin %6.2f ns/sample\n",
+         timeVertical(SENSOR_PIN_MASK), timePerPin(SENSOR_PIN_MASK));
+  printf("%s\n", (true == IsPassing) ? "PASS" : "FAIL");
+  free(pInput);
+  return (true == IsPassing) ? 0 : 1;
+}
+
+/*--------------------------- private functions ---------------------------*/
+static void recordInput(uint32_t Seed)
+{
+  uint32_t Level = 0;
+  uint32_t NextChange[32];
+  uint32_t ChatterLeft[32];
+  uint32_t Raw;
+  int Pin;
+  int i;
+
+  for (Pin = 0; Pin < 32; Pin++)
+  {
+    NextChange[Pin] = 50 + nextRandom(&Seed, 500);
+    ChatterLeft[Pin] = 0;
+  }
+  for (i = 0; i < NumSamples; i++)
+  {
+    Raw = Level;
+    for (Pin = 0; Pin < 32; Pin++)
+    {
+      if ((uint32_t)i == NextChange[Pin])
+      {
+        Level ^= 1UL << Pin;
+        Raw ^= 1UL << Pin;
+        NextChange[Pin] += 50 + nextRandom(&Seed, 500);
+        ChatterLeft[Pin] = nextRandom(&Seed, 12);
+      }
+      else if ((0 != ChatterLeft[Pin]) && (0 != nextRandom(&Seed, 2)))
+      {
+        Raw ^= 1UL << Pin;
+        ChatterLeft[Pin]--;
+      }
+      else if (0 == nextRandom(&Seed, 400))
+      {
+        Raw ^= 1UL << Pin;
+      }
+    }
+    pInput[i] = Raw;
+  }
+}
+
+static bool checkStable(uint8_t StableSamples)
+{
+  Debounce_t Vertical;
+  PerPin_t PerPin;
+  uint32_t NumChanges = 0;
+  uint32_t Changed;
+  int i;
+
+  Debounce_Init(&Vertical, pInput[0], StableSamples);
+  perPinInit(&PerPin, pInput[0], StableSamples);
+  for (i = 1; i < NumSamples; i++)
+  {
+    Changed = Debounce_Sample(&Vertical, pInput[i]);
+    if ((Changed != perPinSample(&PerPin, pInput[i], UINT32_MAX)) ||
+        (Vertical.State != PerPin.State))
+    {
+      printf("stable %2u  differs at sample %d\n", (unsigned)StableSamples,
+             i);
+      return false;
+    }
+    NumChanges += __builtin_popcount(Changed);
+  }
+  printf("stable %2u  %7u changes, same as per pin\n",
+         (unsigned)StableSamples, (unsigned)NumChanges);
+  return true;
+}
+
+static double timeVertical(uint32_t PinMask)
+{
+  Debounce_t Vertical;
+  uint32_t Changes = 0;
+  double Start_ns;
+  int i;
+
+  Debounce_Init(&Vertical, pInput[0] & PinMask, TIMED_STABLE);
+  Start_ns = now_ns();
+  for (i = 1; i < NumSamples; i++)
+  {
+    Changes |= Debounce_Sample(&Vertical, pInput[i] & PinMask);
+  }
+  Sink = Changes;
+  return (now_ns() - Start_ns) / NumSamples;
+}
+
+static double timePerPin(uint32_t PinMask)
+{
+  PerPin_t PerPin;
+  uint32_t Changes = 0;
+  double Start_ns;
+  int i;
+
+  perPinInit(&PerPin, pInput[0] & PinMask, TIMED_STABLE);
+  Start_ns = now_ns();
+  for (i = 1; i < NumSamples; i++)
+  {
+    Changes |= perPinSample(&PerPin, pInput[i] & PinMask, PinMask);
+  }
+  Sink = Changes;
+  return (now_ns() - Start_ns) / NumSamples;
+}
+
+static void perPinInit(PerPin_t *pPerPin, uint32_t Initial,
+                       uint8_t StableSamples)
+{
+  memset(pPerPin, 0, sizeof(*pPerPin));
+  pPerPin->State = Initial;
+  pPerPin->StableSamples = StableSamples;
+}
+
+// the reference: walk the pins, count each one that disagrees
+static uint32_t perPinSample(PerPin_t *pPerPin, uint32_t Raw,
+                             uint32_t PinMask)
+{
+  uint32_t Changed = 0;
+  uint32_t Bit;
+  int Pin;
+
+  for (Pin = 0; Pin < 32; Pin++)
+  {
+    Bit = 1UL << Pin;
+    if (0 == (PinMask & Bit))
+    {
+      continue;
+    }
+    if ((Raw ^ pPerPin->State) & Bit)
+    {
+      if (++pPerPin->Count[Pin] == pPerPin->StableSamples)
+      {
+        pPerPin->State ^= Bit;
+        pPerPin->Count[Pin] = 0;
+        Changed |= Bit;
+      }
+    }
+    else
+    {
+      pPerPin->Count[Pin] = 0;
+    }
+  }
+  return Changed;
+}
+
+static uint32_t nextRandom(uint32_t *pSeed, uint32_t Range)
+{
+  *pSeed = *pSeed * 1103515245UL + 12345UL;
+  return (*pSeed >> 8) % Range;
+}
+
+static double now_ns(void)
+{
+  struct timespec Now;
+
+  clock_gettime(CLOCK_MONOTONIC, &Now);
+  return (double)Now.tv_sec * 1e9 + (double)Now.tv_nsec;
+}
@@ -0,0 +1,292 @@
+/****************************************************************************
+ Module
+   Latency_Bench.c
+
+ Description
+   Runs the real ES_Framework.c's ES_Run, with stand ins for the services
+   and the event checkers that take time on the PIC32 model's CP0 Count,
+   through the stalls the loop latency monitor is for: LEDService spinning
+   3ms in Send16Wait, with GameService running after it in the same pass,
+   and an event checker taking 2.5ms with no service run. The rest of the
+   passes are idle ones of a few us.
+
+   It checks ES_GetLatencyStats against them: the passes in each bucket,
+   the two overruns, the longest pass with LEDService and its event in
+   it, and the last overrun with no service. The test harness stand in
+   prints the statistics from its run function and then takes 50ms, as
+   the real one does waiting on the UART, and that pass must not be
+   counted. The printout and the overrun warnings are shown.
+
+ Build (from the repository root)
+   gcc -D__NO_INLINE__ -Wl,--wrap=putchar
+       -IHostTools/include -IHostTools -IFrameworkHeaders -IProjectHeaders
+       HostTools/Latency_Bench.c FrameworkSource/ES_Framework.c
+       FrameworkSource/ES_Queue.c FrameworkSource/ES_LookupTables.c
+       FrameworkSource/dbprintf.c FrameworkSource/binlog.c
+       HostTools/PIC32_HostModel.c
+       -o latency_bench
+
+ Usage
+   ./latency_bench
+
+ Notes
+   __NO_INLINE__ stops glibc inlining putchar out of reach of the wrap.
+****************************************************************************/
+/*----------------------------- Include Files -----------------------------*/
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <xc.h>
+#include "ES_Configure.h"
+#include "ES_Framework.h"
+#include "ES_ServiceHeaders.h"
+#include "PIC32_HostModel.h"
+#include "terminal.h"
+#undef printf // dbprintf.h sends it to DB_printf
+
+/*----------------------------- Module Defines ----------------------------*/
+#define SERVICE_HARNESS 0
+#define SERVICE_GAME    1
+#define SERVICE_LED     2
+#define NUM_IDLE        1000    // idle passes before the stalls
+#define IDLE_NS         5000ULL
+#define LED_NS          3000000ULL
+#define GAME_NS         100000ULL
+#define CHECKER_NS      2500000ULL
+#define PRINT_NS        50000000ULL
+#define PRINT_KEY       'W'
+#define STOP_KEY        'X'
+#define MAX_OUTPUT      4096
+
+// each service's init and run, the run functions taking the time they are
+// given
+#define STUB_SERVICE(n)                                   \
+  bool SERV_##n##_INIT(uint8_t Priority)                  \
+  {                                                       \
+    (void)Priority;                                       \
+    return true;                                          \
+  }                                                       \
+  ES_Event_t SERV_##n##_RUN(ES_Event_t ThisEvent)         \
+  {                                                       \
+    return runService(n, ThisEvent);                      \
+  }
+
+/*---------------------------- Module Functions ---------------------------*/
+static ES_Event_t runService(uint8_t WhichService, ES_Event_t ThisEvent);
+static void post(uint8_t WhichService, ES_EventType_t EventType,
+                 uint16_t EventParam);
+static uint32_t checkOverrun(const char *pWhat, const ES_Overrun_t *pOverrun,
+                             uint32_t MinUs, uint32_t MaxUs,
+                             uint8_t WhichService, uint8_t NumRuns);
+
+/*---------------------------- Module Variables ---------------------------*/
+static uint32_t NumChecks;
+static char Output[MAX_OUTPUT];
+static size_t OutputLength;
+
+/*------------------------------ Module Code ------------------------------*/
+STUB_SERVICE(0)
+STUB_SERVICE(1)
+STUB_SERVICE(2)
+STUB_SERVICE(3)
+STUB_SERVICE(4)
+STUB_SERVICE(5)
+STUB_SERVICE(6)
+
+int main(void)
+{
+  ES_LatencyStats_t Stats;
+  uint32_t NumBad = 0;
+  uint32_t NumCounted = 0;
+  uint8_t i;
+
+  HostModel_Reset();
+  if (Success != ES_Initialize(ES_Timer_RATE_1mS))
+  {
+    fprintf(stderr, "ES_Initialize failed\n");
+    return 1;
+  }
+  // the harness stops ES_Run when the stop key comes round
+  if (FailedRun != ES_Run())
+  {
+    printf("ES_Run did not stop at the stop key\n");
+    NumBad++;
+  }
+  Output[OutputLength] = 0;
+  fputs(Output, stdout);
+
+  ES_GetLatencyStats(&Stats);
+  for (i = 0; i < ES_LATENCY_BUCKETS; i++)
+  {
+    NumCounted += Stats.Buckets[i];
+  }
+  // a pass for each check, less the printing one, plus the first, which
+  // is counted as it starts
+  if ((NumCounted != Stats.NumPasses) || (NumChecks != Stats.NumPasses) ||
+      (Stats.Buckets[0] < NUM_IDLE))
+  {
+    printf("  %u passes, %u in the buckets, %u idle, %u checks\n",
+           (unsigned)Stats.NumPasses, (unsigned)NumCounted,
+           (unsigned)Stats.Buckets[0], (unsigned)NumChecks);
+    NumBad++;
+  }
+  if (2 != Stats.NumOverruns)
+  {
+    printf("  %u overruns\n", (unsigned)Stats.NumOverruns);
+    NumBad++;
+  }
+  NumBad += checkOverrun("longest", &Stats.Worst, 3100, 3110, SERVICE_LED, 2);
+  NumBad += checkOverrun("last overrun", &Stats.Last, 2500, 2510,
+                         ES_NO_SERVICE, 0);
+  if ((Stats.Worst.Event.EventType != ES_ROWUPDATE) ||
+      (Stats.Worst.RunTicks / 20 != LED_NS / 1000))
+  {
+    printf("  the longest run was event %u for %u us\n",
+           Stats.Worst.Event.EventType, (unsigned)Stats.Worst.RunTicks / 20);
+    NumBad++;
+  }
+  if (NULL == strstr(Output, "pass of 3105 us"))
+  {
+    printf("  no warning for the first overrun\n");
+    NumBad++;
+  }
+  printf("%u checks failed\n", (unsigned)NumBad);
+  return (0 == NumBad) ? 0 : 1;
+}
+
+/*--------------------------- private functions ---------------------------*/
+static ES_Event_t runService(uint8_t WhichService, ES_Event_t ThisEvent)
+{
+  ES_Event_t ReturnEvent;
+
+  ReturnEvent.EventType = ES_NO_EVENT;
+  switch (WhichService)
+  {
+    case SERVICE_LED:
+      HostModel_Advance_ns(LED_NS);
+      break;
+    case SERVICE_GAME:
+      HostModel_Advance_ns(GAME_NS);
+      break;
+    case SERVICE_HARNESS:
+      if (PRINT_KEY == ThisEvent.EventParam)
+      {
+        ES_PrintLatencyStats();
+        HostModel_Advance_ns(PRINT_NS);
+      }
+      else if (STOP_KEY == ThisEvent.EventParam)
+      {
+        ReturnEvent.EventType = ES_ERROR;
+      }
+      break;
+    default:
+      break;
+  }
+  return ReturnEvent;
+}
+
+static void post(uint8_t WhichService, ES_EventType_t EventType,
+                 uint16_t EventParam)
+{
+  ES_Event_t ThisEvent;
+
+  ThisEvent.EventType = EventType;
+  ThisEvent.EventParam = EventParam;
+  ES_PostToService(WhichService, ThisEvent);
+}
+
+// 1 if the pass kept is not the one expected
+static uint32_t checkOverrun(const char *pWhat, const ES_Overrun_t *pOverrun,
+                             uint32_t MinUs, uint32_t MaxUs,
+                             uint8_t WhichService, uint8_t NumRuns)
+{
+  uint32_t Us = pOverrun->Ticks / 20;
+
+  if ((Us < MinUs) || (Us > MaxUs) || (pOverrun->Service != WhichService) ||
+      (pOverrun->NumRuns != NumRuns))
+  {
+    printf("  %s: %u us, service %u, %u runs\n", pWhat, (unsigned)Us,
+           pOverrun->Service, pOverrun->NumRuns);
+    return 1;
+  }
+  return 0;
+}
+
+/*------------------------------- the stubs -------------------------------*/
+// the event checkers, called once a pass: a run of idle passes, then a
+// pass that runs LEDService and GameService, one that stalls in here,
+// one that prints and one that stops
+bool ES_CheckUserEvents(void)
+{
+  NumChecks++;
+  if (NumChecks <= NUM_IDLE)
+  {
+    HostModel_Advance_ns(IDLE_NS);
+    return false;
+  }
+  switch (NumChecks - NUM_IDLE)
+  {
+    case 1:
+      post(SERVICE_LED, ES_ROWUPDATE, 0x1234);
+      post(SERVICE_GAME, ES_TIMEOUT, 1);
+      return true;
+    case 3:
+      HostModel_Advance_ns(CHECKER_NS);
+      return false;
+    case 4:
+      post(SERVICE_HARNESS, ES_NEW_KEY, PRINT_KEY);
+      return true;
+    case 6:
+      post(SERVICE_HARNESS, ES_NEW_KEY, STOP_KEY);
+      return true;
+    default:
+      HostModel_Advance_ns(IDLE_NS);
+      return false;
+  }
+}
+
+void ES_Timer_Init(TimerRate_t Rate)
+{
+  (void)Rate;
+}
+
+uint16_t ES_Timer_GetTime(void)
+{
+  return (uint16_t)(HostModel_GetCoreCount() / 20000);
+}
+
+bool _HW_Process_Pending_Ints(void)
+{
+  return true;
+}
+
+void Terminal_MoveBuffer2UART(void)
+{
+}
+
+void Terminal_SetTxPolicy(TerminalTxPolicy_t Policy)
+{
+  (void)Policy;
+}
+
+// no trace dumps here
+uint16_t Terminal_GetTxFree(void)
+{
+  return 0;
+}
+
+void Terminal_WriteBytes(const uint8_t *pBytes, uint16_t Length)
+{
+  (void)pBytes;
+  (void)Length;
+}
+
+// DB_printf's characters, collected to be read back
+int __wrap_putchar(int c)
+{
+  if (OutputLength < MAX_OUTPUT - 1)
+  {
+    Output[OutputLength++] = (char)c;
+  }
+  return c;
+}
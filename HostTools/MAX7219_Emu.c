@@ -0,0 +1,266 @@
+/****************************************************************************
+ Module
+   MAX7219_Emu.c
+
+ Description
+   Host emulator of a daisy chain of MAX7219 LED matrix controllers.
+   See MAX7219_Emu.h.
+****************************************************************************/
+/*----------------------------- Include Files -----------------------------*/
+#include <string.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include "MAX7219_Emu.h"
+
+/*----------------------------- Module Defines ----------------------------*/
+#define REG_NOOP        0x0
+#define REG_DIGIT_FIRST 0x1
+#define REG_DIGIT_LAST  0x8
+#define REG_DECODE      0x9
+#define REG_INTENSITY   0xA
+#define REG_SCAN_LIMIT  0xB
+#define REG_SHUTDOWN    0xC
+#define REG_TEST        0xF
+
+#define BITS_PER_WORD   16
+#define PPM_CELL        8 // pixels per LED in the PPM output
+
+/*---------------------------- Module Functions ---------------------------*/
+static void decodeWord(MAX7219Emu_Module_t *pModule, uint16_t Word);
+
+/*---------------------------- Module Variables ---------------------------*/
+static MAX7219Emu_Module_t Modules[MAX7219_EMU_MAX_MODULES];
+// the 16-bit shift register inside each module, index 0 is nearest the PIC
+static uint16_t ShiftRegs[MAX7219_EMU_MAX_MODULES];
+static uint8_t NumModules;
+static uint32_t WordTime_ns;
+static uint64_t Time_ns;
+static uint32_t NumLatches;
+static uint32_t NumWords;
+static uint32_t NumShortLatches;
+static uint32_t WordsSinceLatch;
+
+/*------------------------------ Module Code ------------------------------*/
+/****************************************************************************
+ Function
+   MAX7219Emu_Init
+****************************************************************************/
+bool MAX7219Emu_Init(uint8_t HowMany, uint32_t BitRate_Hz)
+{
+  uint8_t i;
+
+  if ((0 == HowMany) || (HowMany > MAX7219_EMU_MAX_MODULES) || (0 == BitRate_Hz))
+  {
+    return false;
+  }
+  NumModules = HowMany;
+  WordTime_ns = (uint32_t)((BITS_PER_WORD * 1000000000ULL) / BitRate_Hz);
+  memset(Modules, 0, sizeof(Modules));
+  memset(ShiftRegs, 0, sizeof(ShiftRegs));
+  for (i = 0; i < MAX7219_EMU_MAX_MODULES; i++)
+  {
+    Modules[i].IsShutdown = true; // power-on state
+  }
+  Time_ns = 0;
+  NumLatches = 0;
+  NumWords = 0;
+  NumShortLatches = 0;
+  WordsSinceLatch = 0;
+  return true;
+}
+
+void MAX7219Emu_AdvanceTime_us(uint32_t Delta_us)
+{
+  Time_ns += (uint64_t)Delta_us * 1000;
+}
+
+uint64_t MAX7219Emu_GetTime_us(void)
+{
+  return Time_ns / 1000;
+}
+
+uint32_t MAX7219Emu_GetLatchCount(void)
+{
+  return NumLatches;
+}
+
+uint32_t MAX7219Emu_GetWordCount(void)
+{
+  return NumWords;
+}
+
+uint32_t MAX7219Emu_GetShortLatchCount(void)
+{
+  return NumShortLatches;
+}
+
+const MAX7219Emu_Module_t *MAX7219Emu_GetModule(uint8_t WhichModule)
+{
+  if (WhichModule >= NumModules)
+  {
+    return NULL;
+  }
+  return &Modules[WhichModule];
+}
+
+/****************************************************************************
+ Function
+   MAX7219Emu_GetPixel
+****************************************************************************/
+uint8_t MAX7219Emu_GetPixel(uint16_t Col, uint8_t Row)
+{
+  const MAX7219Emu_Module_t *pModule;
+  uint8_t Digit;
+
+  if ((Col >= (NumModules * 8)) || (Row >= 8))
+  {
+    return 0;
+  }
+  pModule = &Modules[Col / 8];
+  if (true == pModule->IsDisplayTest)
+  {
+    return 16; // test mode overrides shutdown and lights everything fully
+  }
+  Digit = 7 - Row; // digit register 8 is the top row
+  if ((true == pModule->IsShutdown) || (Digit > pModule->ScanLimit))
+  {
+    return 0;
+  }
+  if (0 == (pModule->Digits[Digit] & (1 << (Col % 8))))
+  {
+    return 0;
+  }
+  return pModule->Intensity + 1;
+}
+
+/****************************************************************************
+ Function
+   MAX7219Emu_RenderTerminal
+****************************************************************************/
+void MAX7219Emu_RenderTerminal(FILE *pOut)
+{
+  uint8_t Row;
+  uint16_t Col;
+
+  fprintf(pOut, "t=%llu us, %u latches\n",
+          (unsigned long long)MAX7219Emu_GetTime_us(), (unsigned)NumLatches);
+  for (Row = 0; Row < 8; Row++)
+  {
+    for (Col = 0; Col < (NumModules * 8); Col++)
+    {
+      fputc((0 != MAX7219Emu_GetPixel(Col, Row)) ? '#' : '.', pOut);
+    }
+    fputc('\n', pOut);
+  }
+}
+
+/****************************************************************************
+ Function
+   MAX7219Emu_RenderPPM
+****************************************************************************/
+bool MAX7219Emu_RenderPPM(const char *pDir)
+{
+  char FileName[256];
+  FILE *pFile;
+  uint16_t Width = NumModules * 8 * PPM_CELL;
+  uint16_t Height = 8 * PPM_CELL;
+  uint16_t x;
+  uint16_t y;
+  uint8_t Level;
+  uint8_t Pixel[3];
+
+  snprintf(FileName, sizeof(FileName), "%s/frame_%010llu.ppm", pDir,
+           (unsigned long long)MAX7219Emu_GetTime_us());
+  pFile = fopen(FileName, "wb");
+  if (NULL == pFile)
+  {
+    return false;
+  }
+  fprintf(pFile, "P6\n%u %u\n255\n", Width, Height);
+  for (y = 0; y < Height; y++)
+  {
+    for (x = 0; x < Width; x++)
+    {
+      // leave a 1 pixel dark border round each dot
+      Level = 0;
+      if (((x % PPM_CELL) != 0) && ((x % PPM_CELL) != (PPM_CELL - 1)) &&
+          ((y % PPM_CELL) != 0) && ((y % PPM_CELL) != (PPM_CELL - 1)))
+      {
+        Level = MAX7219Emu_GetPixel(x / PPM_CELL, y / PPM_CELL);
+      }
+      Pixel[0] = (0 == Level) ? 24 : (uint8_t)(40 + ((215 * Level) / 16));
+      Pixel[1] = (0 == Level) ? 8 : 0;
+      Pixel[2] = (0 == Level) ? 8 : 0;
+      fwrite(Pixel, 1, sizeof(Pixel), pFile);
+    }
+  }
+  fclose(pFile);
+  return true;
+}
+
+/****************************************************************************
+ Function
+    MAX7219Emu_ShiftIn
+****************************************************************************/
+void MAX7219Emu_ShiftIn(uint16_t Word)
+{
+  memmove(&ShiftRegs[1], &ShiftRegs[0], (NumModules - 1) * sizeof(ShiftRegs[0]));
+  ShiftRegs[0] = Word;
+  Time_ns += WordTime_ns;
+  NumWords++;
+  WordsSinceLatch++;
+}
+
+/****************************************************************************
+ Function
+    MAX7219Emu_Latch
+****************************************************************************/
+void MAX7219Emu_Latch(void)
+{
+  uint8_t i;
+
+  if (WordsSinceLatch < NumModules)
+  {
+    NumShortLatches++; // the far modules latch stale words
+  }
+  for (i = 0; i < NumModules; i++)
+  {
+    decodeWord(&Modules[i], ShiftRegs[i]);
+  }
+  WordsSinceLatch = 0;
+  NumLatches++;
+}
+
+/*--------------------------- private functions ---------------------------*/
+static void decodeWord(MAX7219Emu_Module_t *pModule, uint16_t Word)
+{
+  uint8_t Reg = (Word >> 8) & 0x0F;
+  uint8_t Data = Word & 0xFF;
+
+  if ((Reg >= REG_DIGIT_FIRST) && (Reg <= REG_DIGIT_LAST))
+  {
+    pModule->Digits[Reg - REG_DIGIT_FIRST] = Data;
+    return;
+  }
+  switch (Reg)
+  {
+    case REG_DECODE:
+      pModule->DecodeMode = Data;
+      break;
+    case REG_INTENSITY:
+      pModule->Intensity = Data & 0x0F;
+      break;
+    case REG_SCAN_LIMIT:
+      pModule->ScanLimit = Data & 0x07;
+      break;
+    case REG_SHUTDOWN:
+      pModule->IsShutdown = (0 == (Data & 0x01));
+      break;
+    case REG_TEST:
+      pModule->IsDisplayTest = (0 != (Data & 0x01));
+      break;
+    case REG_NOOP:
+    default:
+      break;
+  }
+}
@@ -0,0 +1,184 @@
+/****************************************************************************
+ Module
+   MAX7219_Emu.h
+
+ Description
+   Host emulator of a daisy chain of MAX7219 LED matrix controllers, so that
+   DM_DisplayStarter.c can be run unchanged on Linux. It is driven either by
+   SPI1_EmuHAL.c, which replaces the SPI1 functions of the PIC32 SPI HAL
+   outright, or by the SPI1 model in PIC32_HostModel.c, which runs the real
+   HAL against modelled registers.
+
+   Every 16-bit word written shifts the chain along by one module. When the
+   SS line rises each module latches the word it holds and decodes it: no-op,
+   digit rows 1-8, decode mode, intensity, scan limit, shutdown and display
+   test. Bus time is accounted at the configured bit rate so that frame
+   update latency can be measured.
+
+ Notes
+   Module 0 is the one nearest the PIC, and is the left-most on the cabinet.
+   Digit register 8 is the top row, bit 0 of a digit is the left-most column.
+****************************************************************************/
+#ifndef MAX7219_EMU_H
+#define MAX7219_EMU_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stdio.h>
+
+#define MAX7219_EMU_MAX_MODULES 16
+
+typedef struct
+{
+  uint8_t Digits[8];     // digit register RAM, index 0 is digit register 1
+  uint8_t Intensity;     // 0-15
+  uint8_t ScanLimit;     // 0-7, number of digits scanned - 1
+  uint8_t DecodeMode;
+  bool    IsShutdown;
+  bool    IsDisplayTest;
+} MAX7219Emu_Module_t;
+
+/****************************************************************************
+ Function
+   MAX7219Emu_Init
+
+ Parameters
+   uint8_t: number of modules in the chain (1..MAX7219_EMU_MAX_MODULES)
+   uint32_t: SPI bit rate in Hz, used to account bus time
+
+ Returns
+   bool: true for a legal number of modules; false otherwise
+
+ Description
+   Puts every module into its power-on state (shutdown, RAM cleared) and
+   zeroes the bus clock and statistics.
+****************************************************************************/
+bool MAX7219Emu_Init(uint8_t NumModules, uint32_t BitRate_Hz);
+
+/****************************************************************************
+ Function
+   MAX7219Emu_AdvanceTime_us
+
+ Parameters
+   uint32_t: microseconds to add to the emulated clock
+
+ Returns
+   Nothing
+
+ Description
+   Lets the caller account for time spent between bus transfers, e.g. the
+   frame period of a scroll.
+****************************************************************************/
+void MAX7219Emu_AdvanceTime_us(uint32_t Delta_us);
+
+/****************************************************************************
+ Function
+   MAX7219Emu_GetTime_us
+
+ Returns
+   uint64_t: the emulated clock in microseconds, including bus time
+****************************************************************************/
+uint64_t MAX7219Emu_GetTime_us(void);
+
+/****************************************************************************
+ Function
+   MAX7219Emu_GetLatchCount / MAX7219Emu_GetWordCount /
+   MAX7219Emu_GetShortLatchCount
+
+ Returns
+   uint32_t: number of SS rises, words shifted in, and SS rises that came
+   after fewer words than there are modules (a driver bug on real hardware)
+****************************************************************************/
+uint32_t MAX7219Emu_GetLatchCount(void);
+uint32_t MAX7219Emu_GetWordCount(void);
+uint32_t MAX7219Emu_GetShortLatchCount(void);
+
+/****************************************************************************
+ Function
+   MAX7219Emu_ShiftIn
+
+ Parameters
+   uint16_t: the word clocked out of the PIC
+
+ Returns
+   Nothing
+
+ Description
+   Shifts one word into the chain, pushing the others one module along, and
+   accounts one word time on the bus clock.
+****************************************************************************/
+void MAX7219Emu_ShiftIn(uint16_t Word);
+
+/****************************************************************************
+ Function
+   MAX7219Emu_Latch
+
+ Returns
+   Nothing
+
+ Description
+   SS has risen: every module decodes the word it holds.
+****************************************************************************/
+void MAX7219Emu_Latch(void);
+
+/****************************************************************************
+ Function
+   MAX7219Emu_GetModule
+
+ Parameters
+   uint8_t: which module, 0 is nearest the PIC
+
+ Returns
+   const MAX7219Emu_Module_t *: the module state, NULL for an illegal module
+****************************************************************************/
+const MAX7219Emu_Module_t *MAX7219Emu_GetModule(uint8_t WhichModule);
+
+/****************************************************************************
+ Function
+   MAX7219Emu_GetPixel
+
+ Parameters
+   uint16_t: column across the whole chain, 0 is the left-most
+   uint8_t: row, 0 is the top
+
+ Returns
+   uint8_t: the intensity (1-16) the LED is lit at, 0 when it is dark
+
+ Description
+   Applies shutdown, display test and scan limit the way the part does.
+****************************************************************************/
+uint8_t MAX7219Emu_GetPixel(uint16_t Col, uint8_t Row);
+
+/****************************************************************************
+ Function
+   MAX7219Emu_RenderTerminal
+
+ Parameters
+   FILE *: stream to draw the frame on
+
+ Returns
+   Nothing
+
+ Description
+   Draws the whole chain as text, '#' for lit and '.' for dark, headed by the
+   emulated time stamp.
+****************************************************************************/
+void MAX7219Emu_RenderTerminal(FILE *pOut);
+
+/****************************************************************************
+ Function
+   MAX7219Emu_RenderPPM
+
+ Parameters
+   const char *: directory the frame is written to
+
+ Returns
+   bool: true if the file was written; false otherwise
+
+ Description
+   Writes the frame as a binary PPM named frame_<time in us>.ppm, one 8x8
+   pixel red dot per LED, brightness scaled by the module intensity.
+****************************************************************************/
+bool MAX7219Emu_RenderPPM(const char *pDir);
+
+#endif /* MAX7219_EMU_H */
@@ -0,0 +1,173 @@
+/****************************************************************************
+ Module
+   PCMPlayer_Bench.c
+
+ Description
+   Checks the PCM sample feeder against the register model. The real
+   PCMPlayer.c runs with Timer3 modelled in PIC32_HostModel.c. Timer2 and
+   OC1 are first set up as BuzzService leaves them for a tone. Then each
+   clip is played, and OC1RS is read once per sample period. It must hold
+   every sample in order, one period each. When the clip ends the done
+   function must run exactly once, OC1RS must be 0, and Timer2's prescale
+   and period must be the buzzer's again. A clip cut off by another, and
+   PCM_Stop part way through, are checked the same way.
+
+ Build (from the repository root)
+   gcc -IHostTools/include -IHostTools -IProjectHeaders
+       HostTools/PCMPlayer_Bench.c HostTools/PIC32_HostModel.c
+       ProjectSource/PCMPlayer.c ProjectSource/PCMSamples.c
+       -o pcm_bench
+
+ Usage
+   ./pcm_bench
+
+ Notes
+   ISR time is an estimate, ISR_ENTRY_CYCLES and ISR_BODY_CYCLES of SYSCLK
+   per Timer3 interrupt, as in SPIQueue_Bench.
+****************************************************************************/
+/*----------------------------- Include Files -----------------------------*/
+#include <stdio.h>
+#include <xc.h>
+#include "PCMPlayer.h"
+#include "PIC32_HostModel.h"
+
+/*----------------------------- Module Defines ----------------------------*/
+#define SYSCLK_HZ        40000000UL
+#define ISR_ENTRY_CYCLES 60 // IPLnAUTO prologue and epilogue
+#define ISR_BODY_CYCLES  15 // flag clear, compare, load and store
+#define PBCLK_NS         (1000000000UL / HOST_MODEL_PBCLK_HZ)
+
+// what BuzzService leaves on Timer2 and OC1 for a 1kHz tone
+#define TONE_PRESCALE    0b011
+#define TONE_PERIOD      2500
+#define TONE_PULSE_WIDTH 250
+
+/*---------------------------- Module Functions ---------------------------*/
+static void setupTone(void);
+static bool checkClip(const char *pName, const PCMClip_t *pClip);
+static bool checkCutOff(void);
+static bool isToneRestored(void);
+static void clipDone(void);
+
+/*---------------------------- Module Variables ---------------------------*/
+static uint32_t NumDone;
+
+/*------------------------------ Module Code ------------------------------*/
+int main(void)
+{
+  bool IsPassing = true;
+
+  HostModel_Reset();
+  setupTone();
+  PCM_Init(clipDone);
+
+  IsPassing &= checkClip("zap", &PCMClip_Zap);
+  IsPassing &= checkClip("boom", &PCMClip_Boom);
+  IsPassing &= checkClip("chime", &PCMClip_Chime);
+  IsPassing &= checkCutOff();
+
+  printf("%s\n", (true == IsPassing) ? "PASS" : "FAIL");
+  return (true == IsPassing) ? 0 : 1;
+}
+
+/*--------------------------- private functions ---------------------------*/
+// as PWMSetup_BasicConfig and BuzzService's first note leave things
+static void setupTone(void)
+{
+  T2CONbits.TCS = 0;
+  T2CONbits.TCKPS = TONE_PRESCALE;
+  PR2 = TONE_PERIOD;
+  OC1CONbits.OCM = 0b110;
+  OC1CONbits.ON = 1;
+  OC1RS = TONE_PULSE_WIDTH;
+  T2CONbits.ON = 1;
+}
+
+static bool checkClip(const char *pName, const PCMClip_t *pClip)
+{
+  const HostModel_Stats_t *pStats = HostModel_GetStats();
+  uint64_t Period_ns = (uint64_t)pClip->SamplePeriod * PBCLK_NS;
+  uint64_t Isr_ns;
+  uint64_t Poll_ns = pStats->Poll_ns;
+  uint32_t IsrCalls = pStats->T3IsrCalls;
+  uint32_t NumMismatches = 0;
+  uint16_t i;
+  bool IsPassing;
+
+  NumDone = 0;
+  if (false == PCM_Play(pClip))
+  {
+    printf("%-6s PCM_Play refused the clip\n", pName);
+    return false;
+  }
+  if ((0 != T2CONbits.TCKPS) || (255 != PR2))
+  {
+    printf("%-6s Timer2 not switched to the PCM carrier\n", pName);
+    return false;
+  }
+  for (i = 0; i < pClip->NumSamples; i++)
+  {
+    if (OC1RS != pClip->pSamples[i])
+    {
+      NumMismatches++;
+    }
+    HostModel_Advance_ns(Period_ns);
+  }
+  IsrCalls = pStats->T3IsrCalls - IsrCalls;
+  Isr_ns = ((uint64_t)IsrCalls * (ISR_ENTRY_CYCLES + ISR_BODY_CYCLES) *
+            1000000000ULL) / SYSCLK_HZ;
+
+  IsPassing = (0 == NumMismatches) && (1 == NumDone) &&
+              (false == PCM_IsPlaying()) && (0 == OC1RS) &&
+              (true == isToneRestored()) && (Poll_ns == pStats->Poll_ns);
+  printf("%-6s %5u samples at %5lu Hz, %5u ISRs, %u OC1RS mismatches, "
+         "done %u time(s), est. ISR load %.2f%%, main loop blocked %llu ns"
+         " %s\n",
+         pName, (unsigned)pClip->NumSamples,
+         (unsigned long)(HOST_MODEL_PBCLK_HZ / pClip->SamplePeriod),
+         (unsigned)IsrCalls, (unsigned)NumMismatches, (unsigned)NumDone,
+         100.0 * (double)Isr_ns / (double)(Period_ns * pClip->NumSamples),
+         (unsigned long long)(pStats->Poll_ns - Poll_ns),
+         (true == IsPassing) ? "ok" : "FAILED");
+  return IsPassing;
+}
+
+// a clip started over another takes over at once, and the first never
+// reports done; PCM_Stop hands Timer2 back without reporting done either,
+// and leaves interrupts off if it was called with them off
+static bool checkCutOff(void)
+{
+  uint64_t Period_ns = (uint64_t)PCMClip_Boom.SamplePeriod * PBCLK_NS;
+  bool IsPassing;
+
+  NumDone = 0;
+  PCM_Play(&PCMClip_Boom);
+  HostModel_Advance_ns(Period_ns * (PCMClip_Boom.NumSamples / 2));
+  PCM_Play(&PCMClip_Zap);
+  IsPassing = (OC1RS == PCMClip_Zap.pSamples[0]);
+  HostModel_Advance_ns(Period_ns * 10);
+  IsPassing &= (OC1RS == PCMClip_Zap.pSamples[10]);
+  PCM_Stop();
+  IsPassing &= (0 == OC1RS) && (true == isToneRestored());
+  HostModel_Advance_ns(Period_ns * PCMClip_Boom.NumSamples);
+  IsPassing &= (0 == NumDone) && (false == PCM_IsPlaying());
+  __builtin_disable_interrupts();
+  PCM_Stop();
+  IsPassing &= (0 == (__builtin_disable_interrupts() & _CP0_STATUS_IE_MASK));
+  __builtin_enable_interrupts();
+
+  printf("cut off and stop %s\n", (true == IsPassing) ? "ok" : "FAILED");
+  return IsPassing;
+}
+
+static bool isToneRestored(void)
+{
+  return (TONE_PRESCALE == T2CONbits.TCKPS) && (TONE_PERIOD == PR2) &&
+         (1 == T2CONbits.ON) && (0 == T3CONbits.ON);
+}
+
+// counts the end of clip reports
+static void clipDone(void)
+{
+  NumDone++;
+}
@@ -0,0 +1,939 @@
+/****************************************************************************
+ Module
+   PIC32_HostModel.c
+
+ Description
+   Register storage and peripheral models behind the host xc.h. See
+   PIC32_HostModel.h.
+****************************************************************************/
+/*----------------------------- Include Files -----------------------------*/
+#include <stddef.h>
+#include <string.h>
+#include <xc.h>
+#include "PIC32_HostModel.h"
+
+/*----------------------------- Module Defines ----------------------------*/
+#define SPI_FIFO_DEPTH   8  // enhanced buffer, 16 bit words
+#define BITS_PER_WORD    16
+#define NUM_BUF_SLOTS    64
+#define BUF_SLOT_EMPTY   0xFFFFFFFFUL // no 16 bit write can look like this
+#define MAX_ISR_ROUNDS   1000 // an ISR that never clears its flag
+#define PBCLK_PERIOD_NS  (1000000000UL / HOST_MODEL_PBCLK_HZ)
+#define CORE_COUNT_NS    (2000000000UL / HOST_MODEL_SYSCLK_HZ)
+#define MAX_PIN_CHANGES  8192
+#define CNCON_ON         0x00008000
+#define ADC_RESULT_MASK  0x03FF
+#define AD1CON2_BUFS     0x00000080
+
+#define UART_FIFO_DEPTH  8
+#define BITS_PER_BYTE    10 // start, 8 data, stop
+
+#define UTXISEL_NOT_FULL      0b00
+#define UTXISEL_ALL_SENT      0b01
+#define UTXISEL_FIFO_EMPTY    0b10
+
+#define STXISEL_SR_EMPTY      0b00
+#define STXISEL_FIFO_EMPTY    0b01
+#define STXISEL_HALF_EMPTY    0b10
+#define STXISEL_NOT_FULL      0b11
+
+#define SFR(name) volatile uint32_t name, name##SET, name##CLR, name##INV;
+#define SFR_ALIAS(name) { &name, &name##SET, &name##CLR, &name##INV }
+
+typedef struct
+{
+  uint64_t At_ns;
+  HostModel_Port_t Port;
+  uint32_t Mask;
+  bool IsHigh;
+} PinChange_t;
+
+// a Type B timer counting from PBCLK, Timer3 or Timer4
+typedef struct
+{
+  volatile uint32_t *pCon;
+  volatile uint32_t *pTmr;
+  volatile uint32_t *pPr;
+  uint32_t IFSMask;  // its flag in IFS0
+  bool IsRunning;
+  uint64_t Left_ns;  // to the next period match
+} HostTimer_t;
+
+typedef struct
+{
+  volatile uint32_t *pReg;
+  volatile uint32_t *pSet;
+  volatile uint32_t *pClr;
+  volatile uint32_t *pInv;
+} SfrAlias_t;
+
+/*------------------------------ ISRs modelled ----------------------------*/
+// weak, so that a bench only links the firmware it is exercising; an ISR
+// that is not linked in is never taken
+void SPI1_TxISR(void) __attribute__((weak));
+void SS1_RiseISR(void) __attribute__((weak));
+void PCM_SampleISR(void) __attribute__((weak));
+void SensorCapture_CNISR(void) __attribute__((weak));
+void SensorCapture_SampleISR(void) __attribute__((weak));
+void PotSampler_ADCISR(void) __attribute__((weak));
+void Terminal_TxISR(void) __attribute__((weak));
+
+/*---------------------------- Module Functions ---------------------------*/
+static void syncPeripherals(void);
+static void foldAliases(void);
+static void updateTimers(void);
+static void applyPinChange(const PinChange_t *pChange);
+static void updateADC(void);
+static void finishConversion(void);
+static void consumeBufSlots(void);
+static void loadShifter(void);
+static void updateStatus(void);
+static void consumeU1TxSlots(void);
+static void loadU1Shifter(void);
+static void updateU1Status(void);
+static void deliverInterrupts(void);
+static void runFor(uint64_t Delta_ns);
+static uint32_t bitTime_ns(void);
+static uint64_t u1ByteTime_ns(void);
+static uint64_t timerPeriod_ns(const HostTimer_t *pTimer);
+static uint64_t conversionTime_ns(void);
+
+/*--------------------------- Register storage ----------------------------*/
+SFR(INTCON) SFR(IFS0) SFR(IFS1) SFR(IEC0) SFR(IEC1)
+SFR(IPC0) SFR(IPC2) SFR(IPC3) SFR(IPC4) SFR(IPC5) SFR(IPC7)
+SFR(TRISA) SFR(TRISB) SFR(LATA) SFR(LATB) SFR(PORTA) SFR(PORTB)
+SFR(ANSELA) SFR(ANSELB)
+SFR(CNCONA) SFR(CNCONB) SFR(CNENA) SFR(CNENB) SFR(CNSTATA) SFR(CNSTATB)
+SFR(IPC8)
+SFR(T2CON) SFR(T3CON) SFR(TMR2) SFR(TMR3) SFR(PR2) SFR(PR3)
+SFR(T4CON) SFR(TMR4) SFR(PR4)
+SFR(OC1CON) SFR(OC1R) SFR(OC1RS)
+SFR(AD1CON1) SFR(AD1CON2) SFR(AD1CON3) SFR(AD1CHS) SFR(AD1CSSL)
+volatile uint32_t HostADC1BUF[16 * 4];
+SFR(SPI1CON) SFR(SPI1CON2) SFR(SPI1STAT) SFR(SPI1BRG)
+SFR(SPI2CON) SFR(SPI2CON2) SFR(SPI2STAT) SFR(SPI2BRG)
+volatile uint32_t SPI2BUF;
+SFR(U1MODE) SFR(U1STA) SFR(U1BRG)
+volatile uint32_t U1RXREG;
+int __XC_UART;
+volatile uint32_t RPA0R, RPA1R, RPA2R, RPA3R, RPA4R;
+volatile uint32_t RPB0R, RPB1R, RPB2R, RPB3R, RPB4R, RPB5R, RPB6R, RPB7R,
+  RPB8R, RPB9R, RPB10R, RPB11R, RPB12R, RPB13R, RPB14R, RPB15R;
+volatile uint32_t INT1R, INT4R, SDI1R, SDI2R, SS1R, SS2R, U1RXR;
+
+static const SfrAlias_t SfrAliases[] = {
+  SFR_ALIAS(INTCON), SFR_ALIAS(IFS0), SFR_ALIAS(IFS1), SFR_ALIAS(IEC0),
+  SFR_ALIAS(IEC1), SFR_ALIAS(IPC0), SFR_ALIAS(IPC2), SFR_ALIAS(IPC3),
+  SFR_ALIAS(IPC4), SFR_ALIAS(IPC5), SFR_ALIAS(IPC7), SFR_ALIAS(TRISA), SFR_ALIAS(TRISB),
+  SFR_ALIAS(LATA), SFR_ALIAS(LATB), SFR_ALIAS(PORTA), SFR_ALIAS(PORTB),
+  SFR_ALIAS(ANSELA), SFR_ALIAS(ANSELB), SFR_ALIAS(T2CON), SFR_ALIAS(T3CON),
+  SFR_ALIAS(TMR2), SFR_ALIAS(TMR3), SFR_ALIAS(PR2), SFR_ALIAS(PR3),
+  SFR_ALIAS(T4CON), SFR_ALIAS(TMR4), SFR_ALIAS(PR4),
+  SFR_ALIAS(OC1CON), SFR_ALIAS(OC1R), SFR_ALIAS(OC1RS),
+  SFR_ALIAS(AD1CON1), SFR_ALIAS(AD1CON2), SFR_ALIAS(AD1CON3),
+  SFR_ALIAS(AD1CHS), SFR_ALIAS(AD1CSSL),
+  SFR_ALIAS(CNCONA), SFR_ALIAS(CNCONB), SFR_ALIAS(CNENA), SFR_ALIAS(CNENB),
+  SFR_ALIAS(CNSTATA), SFR_ALIAS(CNSTATB), SFR_ALIAS(IPC8),
+  SFR_ALIAS(SPI1CON), SFR_ALIAS(SPI1CON2),
+  SFR_ALIAS(SPI1STAT), SFR_ALIAS(SPI1BRG), SFR_ALIAS(SPI2CON),
+  SFR_ALIAS(SPI2CON2), SFR_ALIAS(SPI2STAT), SFR_ALIAS(SPI2BRG),
+  SFR_ALIAS(U1MODE), SFR_ALIAS(U1STA), SFR_ALIAS(U1BRG)
+};
+
+/*---------------------------- Module Variables ---------------------------*/
+// SPI1BUF writes not yet seen by the model, oldest first
+static volatile uint32_t BufSlots[NUM_BUF_SLOTS];
+static bool BufSlotInIsr[NUM_BUF_SLOTS];
+static uint8_t NumBufSlots;
+
+static uint16_t Fifo[SPI_FIFO_DEPTH];
+static uint8_t FifoHead;
+static uint8_t FifoCount;
+static bool IsShifting;
+static uint16_t ShiftWord;
+static uint64_t ShiftLeft_ns;
+
+// U1TXREG writes not yet seen by the model, and the UART behind them
+static volatile uint32_t U1TxSlots[NUM_BUF_SLOTS];
+static uint8_t NumU1TxSlots;
+static uint8_t U1Fifo[UART_FIFO_DEPTH];
+static uint8_t U1FifoHead;
+static uint8_t U1FifoCount;
+static bool IsU1Shifting;
+static uint8_t U1ShiftByte;
+static uint64_t U1ShiftLeft_ns;
+
+static HostTimer_t Timers[] = {
+  { &T3CON, &TMR3, &PR3, _IFS0_T3IF_MASK, false, 0 },
+  { &T4CON, &TMR4, &PR4, _IFS0_T4IF_MASK, false, 0 }
+};
+
+// the ADC, converting whenever it is on with ASAM set
+static bool IsADCRunning;
+static uint64_t ADCLeft_ns;   // to the end of the conversion under way
+static uint8_t ADCNumDone;    // conversions since the last interrupt
+static uint8_t ADCBufHalf;    // 1 while filling ADC1BUF8-F
+static HostModel_ADCSourceFunc_t pADCSource;
+
+// pin changes still to come, soonest first
+static PinChange_t PinChanges[MAX_PIN_CHANGES];
+static uint16_t NumPinChanges;
+
+static bool AreIntsEnabled = true;
+static bool IsInIsr;
+static uint64_t Time_ns;
+static HostModel_Stats_t Stats;
+static HostModel_SinkWordFunc_t pSinkWord;
+static HostModel_SinkLatchFunc_t pSinkLatch;
+static HostModel_SinkByteFunc_t pSinkByte;
+
+/*------------------------------ Module Code ------------------------------*/
+/****************************************************************************
+ Function
+   HostModel_Reset
+****************************************************************************/
+void HostModel_Reset(void)
+{
+  uint8_t i;
+
+  for (i = 0; i < (sizeof(SfrAliases) / sizeof(SfrAliases[0])); i++)
+  {
+    *SfrAliases[i].pReg = 0;
+    *SfrAliases[i].pSet = 0;
+    *SfrAliases[i].pClr = 0;
+    *SfrAliases[i].pInv = 0;
+  }
+  NumBufSlots = 0;
+  FifoHead = 0;
+  FifoCount = 0;
+  IsShifting = false;
+  ShiftLeft_ns = 0;
+  NumU1TxSlots = 0;
+  U1FifoHead = 0;
+  U1FifoCount = 0;
+  IsU1Shifting = false;
+  U1ShiftLeft_ns = 0;
+  for (i = 0; i < (sizeof(Timers) / sizeof(Timers[0])); i++)
+  {
+    Timers[i].IsRunning = false;
+    Timers[i].Left_ns = 0;
+  }
+  IsADCRunning = false;
+  ADCLeft_ns = 0;
+  ADCNumDone = 0;
+  ADCBufHalf = 0;
+  memset((void *)HostADC1BUF, 0, sizeof(HostADC1BUF));
+  NumPinChanges = 0;
+  AreIntsEnabled = true;
+  IsInIsr = false;
+  Time_ns = 0;
+  memset(&Stats, 0, sizeof(Stats));
+}
+
+void HostModel_SetSPI1Sink(HostModel_SinkWordFunc_t pWordFunc,
+                           HostModel_SinkLatchFunc_t pLatchFunc)
+{
+  pSinkWord = pWordFunc;
+  pSinkLatch = pLatchFunc;
+}
+
+void HostModel_SetUART1Sink(HostModel_SinkByteFunc_t pByteFunc)
+{
+  pSinkByte = pByteFunc;
+}
+
+void HostModel_SetADCSource(HostModel_ADCSourceFunc_t pSourceFunc)
+{
+  pADCSource = pSourceFunc;
+}
+
+void HostModel_Advance_ns(uint64_t Delta_ns)
+{
+  runFor(Delta_ns);
+}
+
+/****************************************************************************
+ Function
+   HostModel_RunUntilIdle
+****************************************************************************/
+uint64_t HostModel_RunUntilIdle(uint64_t Limit_ns)
+{
+  uint64_t Start_ns = Time_ns;
+  uint64_t Step_ns;
+
+  while ((Time_ns - Start_ns) < Limit_ns)
+  {
+    foldAliases();
+    consumeBufSlots();
+    if ((false == IsShifting) && (0 == FifoCount) &&
+        (0 == (IEC1 & _IEC1_SPI1TXIE_MASK)) &&
+        (0 == (IFS0 & IEC0 & _IEC0_INT4IE_MASK)))
+    {
+      break;
+    }
+    Step_ns = bitTime_ns();
+    if (Step_ns > (Limit_ns - (Time_ns - Start_ns)))
+    {
+      Step_ns = Limit_ns - (Time_ns - Start_ns);
+    }
+    runFor(Step_ns);
+  }
+  return Time_ns - Start_ns;
+}
+
+/****************************************************************************
+ Function
+   HostModel_SchedulePinChange
+****************************************************************************/
+bool HostModel_SchedulePinChange(uint64_t At_ns, HostModel_Port_t Port,
+                                 uint32_t Mask, bool IsHigh)
+{
+  uint16_t i;
+
+  if ((MAX_PIN_CHANGES == NumPinChanges) || (At_ns < Time_ns))
+  {
+    return false;
+  }
+  // insert behind any change due at the same time, so they keep their order
+  for (i = NumPinChanges; (i > 0) && (PinChanges[i - 1].At_ns > At_ns); i--)
+  {
+    PinChanges[i] = PinChanges[i - 1];
+  }
+  PinChanges[i].At_ns = At_ns;
+  PinChanges[i].Port = Port;
+  PinChanges[i].Mask = Mask;
+  PinChanges[i].IsHigh = IsHigh;
+  NumPinChanges++;
+  return true;
+}
+
+uint64_t HostModel_GetTime_ns(void)
+{
+  return Time_ns;
+}
+
+const HostModel_Stats_t *HostModel_GetStats(void)
+{
+  return &Stats;
+}
+
+/*------------------------- hooks used by host xc.h -----------------------*/
+// CP0 Count, which ticks at SYSCLK/2
+uint32_t HostModel_GetCoreCount(void)
+{
+  return (uint32_t)(Time_ns / CORE_COUNT_NS);
+}
+
+/****************************************************************************
+ Function
+   HostModel_Sync
+
+ Description
+   Brings the register at pReg up to date before firmware reads it. A read
+   from main line code is a trip round a poll loop, so time moves on.
+****************************************************************************/
+volatile uint32_t *HostModel_Sync(volatile uint32_t *pReg)
+{
+  if (false == IsInIsr)
+  {
+    Stats.Poll_ns += HOST_MODEL_POLL_NS;
+    runFor(HOST_MODEL_POLL_NS);
+  }
+  else
+  {
+    syncPeripherals();
+  }
+  return pReg;
+}
+
+/****************************************************************************
+ Function
+   HostModel_SPI1BufSlot
+
+ Description
+   Hands out a fresh slot for each evaluation of SPI1BUF. The previous slot
+   has always been written by the time the next is asked for, so when the
+   slots run out they can all be handed to the FIFO. A slot that is still
+   empty when consumed was a read (e.g. the dummy read that clears the
+   receive buffer) and is dropped.
+****************************************************************************/
+volatile uint32_t *HostModel_SPI1BufSlot(void)
+{
+  if (NUM_BUF_SLOTS == NumBufSlots)
+  {
+    consumeBufSlots();
+  }
+  BufSlots[NumBufSlots] = BUF_SLOT_EMPTY;
+  BufSlotInIsr[NumBufSlots] = IsInIsr;
+  return &BufSlots[NumBufSlots++];
+}
+
+// as HostModel_SPI1BufSlot, for U1TXREG
+volatile uint32_t *HostModel_U1TxSlot(void)
+{
+  if (NUM_BUF_SLOTS == NumU1TxSlots)
+  {
+    consumeU1TxSlots();
+  }
+  U1TxSlots[NumU1TxSlots] = BUF_SLOT_EMPTY;
+  return &U1TxSlots[NumU1TxSlots++];
+}
+
+// returns the Status register as __builtin_disable_interrupts does, which
+// here is only the IE bit
+uint32_t HostModel_DisableInts(void)
+{
+  uint32_t Status = AreIntsEnabled ? _CP0_STATUS_IE_MASK : 0;
+
+  syncPeripherals();
+  AreIntsEnabled = false;
+  return Status;
+}
+
+void HostModel_EnableInts(void)
+{
+  AreIntsEnabled = true;
+  deliverInterrupts();
+}
+
+/*--------------------------- private functions ---------------------------*/
+// brings every modelled peripheral up to date with what firmware has written
+static void syncPeripherals(void)
+{
+  foldAliases();
+  updateTimers();
+  updateADC();
+  consumeBufSlots();
+  loadShifter();
+  updateStatus();
+  consumeU1TxSlots();
+  loadU1Shifter();
+  updateU1Status();
+}
+
+// SET, CLR and INV writes are only seen here, so their order is lost; CLR
+// goes first because firmware turns a thing off and then back on within one
+// routine far more often than the other way round
+static void foldAliases(void)
+{
+  uint8_t i;
+  const SfrAlias_t *pAlias;
+
+  for (i = 0; i < (sizeof(SfrAliases) / sizeof(SfrAliases[0])); i++)
+  {
+    pAlias = &SfrAliases[i];
+    *pAlias->pReg &= ~*pAlias->pClr;
+    *pAlias->pReg |= *pAlias->pSet;
+    *pAlias->pReg ^= *pAlias->pInv;
+    *pAlias->pSet = 0;
+    *pAlias->pClr = 0;
+    *pAlias->pInv = 0;
+  }
+}
+
+static void consumeBufSlots(void)
+{
+  uint8_t i;
+
+  for (i = 0; i < NumBufSlots; i++)
+  {
+    if (BUF_SLOT_EMPTY == BufSlots[i])
+    {
+      continue;
+    }
+    Stats.WordsWritten++;
+    if (true == BufSlotInIsr[i])
+    {
+      Stats.WordsInIsr++;
+    }
+    if (SPI_FIFO_DEPTH == FifoCount)
+    {
+      Stats.Overflows++; // the part drops the write and sets SPITBF
+      continue;
+    }
+    Fifo[(FifoHead + FifoCount) % SPI_FIFO_DEPTH] = (uint16_t)BufSlots[i];
+    FifoCount++;
+  }
+  NumBufSlots = 0;
+}
+
+// starts the count when firmware turns a timer on, from whatever it left
+// in TMRx. TMRx itself is not kept up to date while the timer runs.
+static void updateTimers(void)
+{
+  HostTimer_t *pTimer;
+  uint8_t i;
+
+  for (i = 0; i < (sizeof(Timers) / sizeof(Timers[0])); i++)
+  {
+    pTimer = &Timers[i];
+    if (0 == ((volatile __T2CONbits_t *)pTimer->pCon)->ON)
+    {
+      pTimer->IsRunning = false;
+    }
+    else if (false == pTimer->IsRunning)
+    {
+      pTimer->IsRunning = true;
+      pTimer->Left_ns = timerPeriod_ns(pTimer);
+      if (*pTimer->pTmr <= *pTimer->pPr)
+      {
+        pTimer->Left_ns -= (uint64_t)*pTimer->pTmr *
+                           (timerPeriod_ns(pTimer) / (*pTimer->pPr + 1));
+      }
+    }
+  }
+}
+
+// starts converting when firmware sets ON and ASAM; turning the ADC off
+// also resets the buffer fill position, as on the part
+static void updateADC(void)
+{
+  if (0 == AD1CON1bits.ON)
+  {
+    IsADCRunning = false;
+    ADCNumDone = 0;
+    ADCBufHalf = 0;
+    AD1CON2 &= ~AD1CON2_BUFS;
+  }
+  else if (0 == AD1CON1bits.ASAM)
+  {
+    IsADCRunning = false;
+  }
+  else if (false == IsADCRunning)
+  {
+    IsADCRunning = true;
+    ADCLeft_ns = conversionTime_ns();
+  }
+}
+
+// stores a result from the source and, after SMPI + 1 of them, raises
+// AD1IF and, with BUFM set, swaps buffer halves. Scanning steps through
+// the AD1CSSL inputs in order, starting again after each interrupt.
+static void finishConversion(void)
+{
+  uint8_t Channel = (AD1CHS >> 16) & 0x0F;
+  uint8_t Slot = ADCNumDone;
+  uint32_t Scan = AD1CSSL;
+  uint8_t i;
+
+  if ((0 != AD1CON2bits.CSCNA) && (0 != Scan))
+  {
+    for (i = 0; i < (ADCNumDone % __builtin_popcount(Scan)); i++)
+    {
+      Scan &= Scan - 1;
+    }
+    Channel = __builtin_ctz(Scan);
+  }
+  if ((0 != AD1CON2bits.BUFM) && (1 == ADCBufHalf))
+  {
+    Slot += 8;
+  }
+  HostADC1BUF[(Slot & 0x0F) * 4] =
+    (NULL != pADCSource) ? (pADCSource(Channel) & ADC_RESULT_MASK) : 0;
+  Stats.Conversions++;
+  ADCNumDone++;
+  if (ADCNumDone > AD1CON2bits.SMPI)
+  {
+    ADCNumDone = 0;
+    IFS0 |= _IFS0_AD1IF_MASK;
+    if (0 != AD1CON2bits.BUFM)
+    {
+      ADCBufHalf ^= 1;
+      AD1CON2 = (AD1CON2 & ~AD1CON2_BUFS) | (ADCBufHalf ? AD1CON2_BUFS : 0);
+    }
+  }
+  ADCLeft_ns = conversionTime_ns();
+}
+
+// drives the pins and raises a change notification on any enabled pin
+// that actually changed; the mismatch flags stay set until firmware clears
+// them, as reading the port would
+static void applyPinChange(const PinChange_t *pChange)
+{
+  volatile uint32_t *pPort = (HOST_PORT_A == pChange->Port) ? &PORTA : &PORTB;
+  uint32_t Was = *pPort;
+  uint32_t Changed;
+
+  if (true == pChange->IsHigh)
+  {
+    *pPort |= pChange->Mask;
+  }
+  else
+  {
+    *pPort &= ~pChange->Mask;
+  }
+  Changed = Was ^ *pPort;
+  if (HOST_PORT_A == pChange->Port)
+  {
+    if ((0 != (CNCONA & CNCON_ON)) && (0 != (Changed & CNENA)))
+    {
+      CNSTATA |= Changed & CNENA;
+      IFS1 |= _IFS1_CNAIF_MASK;
+    }
+  }
+  else if ((0 != (CNCONB & CNCON_ON)) && (0 != (Changed & CNENB)))
+  {
+    CNSTATB |= Changed & CNENB;
+    IFS1 |= _IFS1_CNBIF_MASK;
+  }
+}
+
+static void loadShifter(void)
+{
+  if ((true == IsShifting) || (0 == FifoCount) || (0 == SPI1CONbits.ON))
+  {
+    return;
+  }
+  ShiftWord = Fifo[FifoHead];
+  FifoHead = (FifoHead + 1) % SPI_FIFO_DEPTH;
+  FifoCount--;
+  ShiftLeft_ns = (uint64_t)BITS_PER_WORD * bitTime_ns();
+  IsShifting = true; // SS1 is low, or stays low, from here
+}
+
+static void updateStatus(void)
+{
+  __SPI1STATbits_t *pStat = (__SPI1STATbits_t *)&SPI1STAT;
+  bool IsTxIntCondition;
+
+  pStat->SPITBF = (SPI_FIFO_DEPTH == FifoCount);
+  pStat->SPITBE = (0 == FifoCount);
+  pStat->SRMT = (false == IsShifting) && (0 == FifoCount);
+  pStat->SPIBUSY = (true == IsShifting) || (0 != FifoCount);
+  pStat->TXBUFELM = FifoCount;
+
+  switch (SPI1CONbits.STXISEL)
+  {
+    case STXISEL_SR_EMPTY:
+      IsTxIntCondition = pStat->SRMT;
+      break;
+    case STXISEL_FIFO_EMPTY:
+      IsTxIntCondition = (0 == FifoCount);
+      break;
+    case STXISEL_HALF_EMPTY:
+      IsTxIntCondition = (FifoCount <= (SPI_FIFO_DEPTH / 2));
+      break;
+    default:
+      IsTxIntCondition = (FifoCount < SPI_FIFO_DEPTH);
+      break;
+  }
+  if (true == IsTxIntCondition)
+  {
+    IFS1 |= _IFS1_SPI1TXIF_MASK;
+  }
+}
+
+static void consumeU1TxSlots(void)
+{
+  uint8_t i;
+
+  for (i = 0; i < NumU1TxSlots; i++)
+  {
+    if (BUF_SLOT_EMPTY == U1TxSlots[i])
+    {
+      continue;
+    }
+    if (UART_FIFO_DEPTH == U1FifoCount)
+    {
+      Stats.U1Overflows++; // lost, as on the part
+      continue;
+    }
+    U1Fifo[(U1FifoHead + U1FifoCount) % UART_FIFO_DEPTH] =
+      (uint8_t)U1TxSlots[i];
+    U1FifoCount++;
+  }
+  NumU1TxSlots = 0;
+}
+
+static void loadU1Shifter(void)
+{
+  if ((true == IsU1Shifting) || (0 == U1FifoCount) ||
+      (0 == U1MODEbits.ON) ||
+      (0 == ((volatile __U1STAbits_t *)&U1STA)->UTXEN))
+  {
+    return;
+  }
+  U1ShiftByte = U1Fifo[U1FifoHead];
+  U1FifoHead = (U1FifoHead + 1) % UART_FIFO_DEPTH;
+  U1FifoCount--;
+  U1ShiftLeft_ns = u1ByteTime_ns();
+  IsU1Shifting = true;
+}
+
+static void updateU1Status(void)
+{
+  __U1STAbits_t *pStat = (__U1STAbits_t *)&U1STA;
+  bool IsTxIntCondition;
+
+  pStat->UTXBF = (UART_FIFO_DEPTH == U1FifoCount);
+  pStat->TRMT = (false == IsU1Shifting) && (0 == U1FifoCount);
+  if ((0 == U1MODEbits.ON) || (0 == pStat->UTXEN))
+  {
+    return;
+  }
+  switch (pStat->UTXISEL)
+  {
+    case UTXISEL_NOT_FULL:
+      IsTxIntCondition = (U1FifoCount < UART_FIFO_DEPTH);
+      break;
+    case UTXISEL_ALL_SENT:
+      IsTxIntCondition = pStat->TRMT;
+      break;
+    default:
+      IsTxIntCondition = (0 == U1FifoCount);
+      break;
+  }
+  if (true == IsTxIntCondition)
+  {
+    IFS1 |= _IFS1_U1TXIF_MASK;
+  }
+}
+
+/****************************************************************************
+ Function
+   deliverInterrupts
+
+ Description
+   Runs every pending, enabled interrupt, highest priority first, until none
+   is left. ISRs do not nest.
+****************************************************************************/
+static void deliverInterrupts(void)
+{
+  uint16_t Rounds;
+  void (*pISR)(void);
+  uint32_t *pCalls;
+  uint8_t Priority;
+
+  if ((false == AreIntsEnabled) || (true == IsInIsr))
+  {
+    return;
+  }
+  for (Rounds = 0; Rounds < MAX_ISR_ROUNDS; Rounds++)
+  {
+    syncPeripherals();
+    pISR = NULL;
+    pCalls = NULL;
+    Priority = 0;
+    // checked in natural order, so a tie goes to the lower vector
+    if ((0 != (IEC1 & IFS1 & _IEC1_SPI1TXIE_MASK)) && (NULL != SPI1_TxISR))
+    {
+      pISR = SPI1_TxISR;
+      pCalls = &Stats.TxIsrCalls;
+      Priority = IPC7bits.SPI1IP;
+    }
+    if ((0 != (IEC0 & IFS0 & _IEC0_INT4IE_MASK)) && (NULL != SS1_RiseISR) &&
+        ((NULL == pISR) || (IPC4bits.INT4IP > Priority)))
+    {
+      pISR = SS1_RiseISR;
+      pCalls = &Stats.SSIsrCalls;
+      Priority = IPC4bits.INT4IP;
+    }
+    if ((0 != (IEC0 & IFS0 & _IEC0_T3IE_MASK)) && (NULL != PCM_SampleISR) &&
+        ((NULL == pISR) || (IPC3bits.T3IP > Priority)))
+    {
+      pISR = PCM_SampleISR;
+      pCalls = &Stats.T3IsrCalls;
+      Priority = IPC3bits.T3IP;
+    }
+    if ((0 != (IEC0 & IFS0 & _IEC0_T4IE_MASK)) &&
+        (NULL != SensorCapture_SampleISR) &&
+        ((NULL == pISR) || (IPC4bits.T4IP > Priority)))
+    {
+      pISR = SensorCapture_SampleISR;
+      pCalls = &Stats.T4IsrCalls;
+      Priority = IPC4bits.T4IP;
+    }
+    if ((0 != (IEC0 & IFS0 & _IEC0_AD1IE_MASK)) &&
+        (NULL != PotSampler_ADCISR) &&
+        ((NULL == pISR) || (IPC5bits.AD1IP > Priority)))
+    {
+      pISR = PotSampler_ADCISR;
+      pCalls = &Stats.ADCIsrCalls;
+      Priority = IPC5bits.AD1IP;
+    }
+    if ((0 != (IEC1 & IFS1 & (_IEC1_CNAIE_MASK | _IEC1_CNBIE_MASK))) &&
+        (NULL != SensorCapture_CNISR) &&
+        ((NULL == pISR) || (IPC8bits.CNIP > Priority)))
+    {
+      pISR = SensorCapture_CNISR;
+      pCalls = &Stats.CNIsrCalls;
+      Priority = IPC8bits.CNIP;
+    }
+    if ((0 != (IEC1 & IFS1 & _IEC1_U1TXIE_MASK)) && (NULL != Terminal_TxISR) &&
+        ((NULL == pISR) || (IPC8bits.U1IP > Priority)))
+    {
+      pISR = Terminal_TxISR;
+      pCalls = &Stats.U1IsrCalls;
+      Priority = IPC8bits.U1IP;
+    }
+    if (NULL == pISR)
+    {
+      return;
+    }
+    IsInIsr = true;
+    (*pCalls)++;
+    pISR();
+    IsInIsr = false;
+  }
+}
+
+/****************************************************************************
+ Function
+   runFor
+
+ Description
+   Moves the model clock on, shifting words out and raising SS1 as they
+   finish, and taking interrupts as they come due.
+****************************************************************************/
+static void runFor(uint64_t Delta_ns)
+{
+  uint64_t Step_ns;
+  uint8_t i;
+
+  for (;;)
+  {
+    deliverInterrupts();
+    syncPeripherals();
+    Step_ns = Delta_ns;
+    if ((true == IsShifting) && (ShiftLeft_ns < Step_ns))
+    {
+      Step_ns = ShiftLeft_ns;
+    }
+    for (i = 0; i < (sizeof(Timers) / sizeof(Timers[0])); i++)
+    {
+      if ((true == Timers[i].IsRunning) && (Timers[i].Left_ns < Step_ns))
+      {
+        Step_ns = Timers[i].Left_ns;
+      }
+    }
+    if ((true == IsU1Shifting) && (U1ShiftLeft_ns < Step_ns))
+    {
+      Step_ns = U1ShiftLeft_ns;
+    }
+    if ((true == IsADCRunning) && (ADCLeft_ns < Step_ns))
+    {
+      Step_ns = ADCLeft_ns;
+    }
+    if ((0 != NumPinChanges) && ((PinChanges[0].At_ns - Time_ns) < Step_ns))
+    {
+      Step_ns = PinChanges[0].At_ns - Time_ns;
+    }
+    if ((false == IsU1Shifting) && (0 != U1MODEbits.ON))
+    {
+      Stats.U1Idle_ns += Step_ns;
+    }
+    Time_ns += Step_ns;
+    Delta_ns -= Step_ns;
+
+    while ((0 != NumPinChanges) && (PinChanges[0].At_ns <= Time_ns))
+    {
+      applyPinChange(&PinChanges[0]);
+      NumPinChanges--;
+      memmove(&PinChanges[0], &PinChanges[1],
+              NumPinChanges * sizeof(PinChanges[0]));
+    }
+
+    for (i = 0; i < (sizeof(Timers) / sizeof(Timers[0])); i++)
+    {
+      if (true == Timers[i].IsRunning)
+      {
+        Timers[i].Left_ns -= Step_ns;
+        if (0 == Timers[i].Left_ns)
+        {
+          IFS0 |= Timers[i].IFSMask;
+          Timers[i].Left_ns = timerPeriod_ns(&Timers[i]);
+        }
+      }
+    }
+
+    if (true == IsADCRunning)
+    {
+      ADCLeft_ns -= Step_ns;
+      if (0 == ADCLeft_ns)
+      {
+        finishConversion();
+      }
+    }
+
+    if (true == IsShifting)
+    {
+      ShiftLeft_ns -= Step_ns;
+    }
+    if ((true == IsShifting) && (0 == ShiftLeft_ns))
+    {
+      IsShifting = false;
+      Stats.WordsShifted++;
+      if (NULL != pSinkWord)
+      {
+        pSinkWord(ShiftWord);
+      }
+      loadShifter();
+      if (false == IsShifting)
+      {
+        // nothing queued behind it, so SS1 rises and the chain latches
+        Stats.SSRises++;
+        if (NULL != pSinkLatch)
+        {
+          pSinkLatch();
+        }
+        IFS0 |= _IFS0_INT4IF_MASK;
+      }
+    }
+
+    if (true == IsU1Shifting)
+    {
+      U1ShiftLeft_ns -= Step_ns;
+      if (0 == U1ShiftLeft_ns)
+      {
+        IsU1Shifting = false;
+        Stats.U1BytesSent++;
+        if (NULL != pSinkByte)
+        {
+          pSinkByte(U1ShiftByte);
+        }
+        loadU1Shifter();
+      }
+    }
+
+    if (0 == Delta_ns)
+    {
+      deliverInterrupts();
+      return;
+    }
+  }
+}
+
+// SPI clock is PBCLK / (2 * (BRG + 1))
+static uint32_t bitTime_ns(void)
+{
+  return (uint32_t)((2ULL * (SPI1BRG + 1) * 1000000000ULL) / HOST_MODEL_PBCLK_HZ);
+}
+
+// a byte is 10 bits of PBCLK / (4 * (BRG + 1)) with BRGH, or / 16 without
+static uint64_t u1ByteTime_ns(void)
+{
+  uint32_t Divide = (0 != U1MODEbits.BRGH) ? 4 : 16;
+
+  return ((uint64_t)BITS_PER_BYTE * Divide * (U1BRG + 1) * 1000000000ULL) /
+         HOST_MODEL_PBCLK_HZ;
+}
+
+// a timer matches every (PRx + 1) prescaled PBCLK ticks
+static uint64_t timerPeriod_ns(const HostTimer_t *pTimer)
+{
+  static const uint16_t Prescales[] = { 1, 2, 4, 8, 16, 32, 64, 256 };
+
+  return (uint64_t)(*pTimer->pPr + 1) *
+         Prescales[((volatile __T2CONbits_t *)pTimer->pCon)->TCKPS] *
+         PBCLK_PERIOD_NS;
+}
+
+// a conversion is SAMC TAD of sampling and 12 TAD of converting, with TAD
+// 2 * (ADCS + 1) PBCLK periods
+static uint64_t conversionTime_ns(void)
+{
+  uint32_t Samc = (0 != AD1CON3bits.SAMC) ? AD1CON3bits.SAMC : 1;
+
+  return (uint64_t)(Samc + 12) * 2 * (AD1CON3bits.ADCS + 1) *
+         PBCLK_PERIOD_NS;
+}
@@ -0,0 +1,198 @@
+/****************************************************************************
+ Module
+   PIC32_HostModel.h
+
+ Description
+   Register storage and peripheral models behind the host xc.h, so that
+   register level firmware such as PIC32_SPI_HAL_Starter.c can be compiled
+   unchanged with gcc and run on Linux.
+
+   SPI1 is modelled as an 8 word transmit FIFO (enhanced buffer, 16 bit
+   mode) feeding a shifter clocked at the rate set in SPI1BRG, with SS1
+   held low while words are back to back and raised, setting INT4IF, when
+   the shifter and FIFO run dry. SPI1TXIF follows the STXISEL condition.
+   UART1 transmit is an 8 byte FIFO feeding a shifter that takes 10 bit
+   times a byte at the rate set by U1BRG and BRGH, with TRMT, UTXBF and
+   U1TXIF (following UTXISEL) kept up to date; nothing is received.
+   Timer3 and Timer4 count from PBCLK through their prescalers and set T3IF
+   and T4IF at each period match. The SPI1 TX, INT4, Timer3, Timer4 and
+   UART1 TX interrupts are delivered to SPI1_TxISR, SS1_RiseISR,
+   PCM_SampleISR, SensorCapture_SampleISR and Terminal_TxISR, highest
+   priority first, whenever they are enabled and interrupts are not
+   globally disabled.
+   Pins on ports A and B can be scheduled to change at set times; a change
+   on a pin enabled for change notification, with CNCONx.ON set, raises
+   CNAIF or CNBIF, delivered to SensorCapture_CNISR. The CP0 Count follows
+   the model clock at SYSCLK/2. The ADC converts one input after another
+   while ON and ASAM are set, taking its results from a source function,
+   raises AD1IF every SMPI + 1 conversions and alternates buffer halves
+   with BUFM; AD1IF is delivered to PotSampler_ADCISR.
+   An ISR that is not linked in is never taken.
+
+ Notes
+   Model time only moves when the caller advances it, or when the firmware
+   polls a status register (IFS0bits, IFS1bits, SPI1STATbits) from main
+   line code; each such poll costs HOST_MODEL_POLL_NS. U1STAbits counts as
+   one of these. Polls made inside an
+   ISR cost nothing. Time spent polling is reported separately so a caller
+   can tell how long the main loop was held up by the bus.
+****************************************************************************/
+#ifndef PIC32_HOST_MODEL_H
+#define PIC32_HOST_MODEL_H
+
+#include <stdint.h>
+#include <stdbool.h>
+
+#define HOST_MODEL_PBCLK_HZ 20000000UL // matches the 20MHz PBCLK on the board
+#define HOST_MODEL_SYSCLK_HZ 40000000UL
+#define HOST_MODEL_POLL_NS  250        // one trip round a register poll loop
+
+typedef enum
+{
+  HOST_PORT_A,
+  HOST_PORT_B
+} HostModel_Port_t;
+
+typedef void (*HostModel_SinkWordFunc_t)(uint16_t Word);
+typedef uint16_t (*HostModel_ADCSourceFunc_t)(uint8_t Channel);
+typedef void (*HostModel_SinkLatchFunc_t)(void);
+typedef void (*HostModel_SinkByteFunc_t)(uint8_t Byte);
+
+typedef struct
+{
+  uint64_t Poll_ns;      // main line time spent spinning on status registers
+  uint32_t TxIsrCalls;   // SPI1_TxISR entries
+  uint32_t SSIsrCalls;   // SS1_RiseISR entries
+  uint32_t T3IsrCalls;   // PCM_SampleISR entries
+  uint32_t CNIsrCalls;   // SensorCapture_CNISR entries
+  uint32_t T4IsrCalls;   // SensorCapture_SampleISR entries
+  uint32_t ADCIsrCalls;  // PotSampler_ADCISR entries
+  uint32_t U1IsrCalls;   // Terminal_TxISR entries
+  uint32_t Conversions;  // ADC results stored
+  uint32_t WordsWritten; // words written to SPI1BUF, from any context
+  uint32_t WordsInIsr;   // of which written by an ISR
+  uint32_t WordsShifted; // words clocked out of the shifter
+  uint32_t SSRises;      // frames latched by the chain
+  uint32_t Overflows;    // SPI1BUF writes made while the FIFO was full
+  uint32_t U1BytesSent;  // bytes clocked out of the UART1 shifter
+  uint32_t U1Overflows;  // U1TXREG writes made while its FIFO was full
+  uint64_t U1Idle_ns;    // time UART1 was on with nothing to send
+} HostModel_Stats_t;
+
+/****************************************************************************
+ Function
+   HostModel_Reset
+
+ Returns
+   Nothing
+
+ Description
+   Clears every register, the SPI1 FIFO and shifter, the timers, the statistics
+   and the model clock. Interrupts are left globally enabled, as they are once the
+   framework is running.
+****************************************************************************/
+void HostModel_Reset(void);
+
+/****************************************************************************
+ Function
+   HostModel_SetSPI1Sink
+
+ Parameters
+   HostModel_SinkWordFunc_t: called with each word as it finishes shifting
+   HostModel_SinkLatchFunc_t: called each time SS1 rises
+
+ Returns
+   Nothing
+
+ Description
+   Connects whatever is on the far end of SPI1, e.g. the MAX7219 emulator.
+   Either may be NULL.
+****************************************************************************/
+void HostModel_SetSPI1Sink(HostModel_SinkWordFunc_t pWordFunc,
+                           HostModel_SinkLatchFunc_t pLatchFunc);
+
+/****************************************************************************
+ Function
+   HostModel_SetUART1Sink
+
+ Parameters
+   HostModel_SinkByteFunc_t: called with each byte as it finishes shifting
+   out of U1TX, or NULL
+
+ Returns
+   Nothing
+****************************************************************************/
+void HostModel_SetUART1Sink(HostModel_SinkByteFunc_t pByteFunc);
+
+/****************************************************************************
+ Function
+   HostModel_SetADCSource
+
+ Parameters
+   HostModel_ADCSourceFunc_t: called with the ANx number at the end of each
+   conversion, returns the 10 bit result
+
+ Returns
+   Nothing
+
+ Description
+   Connects whatever drives the analog inputs. Results are 0 if it is NULL.
+****************************************************************************/
+void HostModel_SetADCSource(HostModel_ADCSourceFunc_t pSourceFunc);
+
+/****************************************************************************
+ Function
+   HostModel_Advance_ns
+
+ Parameters
+   uint64_t: nanoseconds of time to let pass
+
+ Returns
+   Nothing
+
+ Description
+   Runs the peripherals, and any interrupts they raise, for the given time.
+   Stands for the main loop doing other work.
+****************************************************************************/
+void HostModel_Advance_ns(uint64_t Delta_ns);
+
+/****************************************************************************
+ Function
+   HostModel_RunUntilIdle
+
+ Parameters
+   uint64_t: the most nanoseconds to wait
+
+ Returns
+   uint64_t: the nanoseconds it took for SPI1 to go idle (SS1 high, FIFO
+   empty, nothing more written by an ISR), or the limit if it did not
+ ****************************************************************************/
+uint64_t HostModel_RunUntilIdle(uint64_t Limit_ns);
+
+/****************************************************************************
+ Function
+   HostModel_SchedulePinChange
+
+ Parameters
+   uint64_t: model time at which the pins change, not before now
+   HostModel_Port_t: which port
+   uint32_t: the pins that change
+   bool: true to drive them high, false low
+
+ Returns
+   bool: false if the change is in the past or too many are waiting
+ ****************************************************************************/
+bool HostModel_SchedulePinChange(uint64_t At_ns, HostModel_Port_t Port,
+                                 uint32_t Mask, bool IsHigh);
+
+/****************************************************************************
+ Function
+   HostModel_GetTime_ns / HostModel_GetStats
+
+ Returns
+   The model clock, and the statistics gathered since HostModel_Reset
+****************************************************************************/
+uint64_t HostModel_GetTime_ns(void);
+const HostModel_Stats_t *HostModel_GetStats(void);
+
+#endif /* PIC32_HOST_MODEL_H */
@@ -0,0 +1,238 @@
+/****************************************************************************
+ Module
+   PotSampler_Bench.c
+
+ Description
+   Counts ES_NEW_POT events from the difficulty knob, the old way and the
+   new. The real PotSampler.c runs against the ADC in the register model,
+   with AN5 fed from a knob position plus Gaussian noise and, now and then,
+   a spike such as the buzzer or motor switching might put on the supply.
+   Alongside, the old CheckPotSensor is replayed: one raw reading a pass of
+   the main loop, posting when it is more than 10 counts from the last one
+   posted. The new checker posts whenever PotSampler_GetLevel changes.
+
+   First the knob is left alone for a minute at a few positions, one of
+   them right on a level boundary, and events per minute are reported.
+   Then it is swept from 20% to 80% over a second and held, to check that
+   the level follows and how long it takes to settle.
+
+ Build (from the repository root)
+   gcc -IHostTools/include -IHostTools -IProjectHeaders
+       HostTools/PotSampler_Bench.c HostTools/PIC32_HostModel.c
+       ProjectSource/PotSampler.c -lm -o pot_bench
+
+ Usage
+   ./pot_bench [-n noise_counts] [-s seed]
+   -n sets the standard deviation of the noise, 3 counts by default.
+
+ Notes
+   POT_HYSTERESIS is sized for a few counts of noise. Much past 5 counts
+   the first block, which seeds the level unfiltered, can land a level off
+   and the filter then moves it once, which shows up as one event.
+****************************************************************************/
+/*----------------------------- Include Files -----------------------------*/
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <unistd.h>
+#include <xc.h>
+#include "PotSampler.h"
+#include "PIC32_HostModel.h"
+
+/*----------------------------- Module Defines ----------------------------*/
+#define PASS_NS          25000ULL     // one trip round the main loop
+#define MINUTE_NS        60000000000ULL
+#define SPIKE_ODDS       1000         // one conversion in this many
+#define SPIKE_COUNTS     40
+#define OLD_THRESHOLD    10
+#define SWEEP_NS         1000000000ULL
+#define HOLD_NS          1000000000ULL
+
+typedef struct
+{
+  uint32_t OldEvents;
+  uint32_t NewEvents;
+  uint8_t Level;            // last level posted by the new checker
+  uint64_t LastChange_ns;   // when it was posted
+} Count_t;
+
+/*---------------------------- Module Functions ---------------------------*/
+static bool runStill(double Percent);
+static bool runSweep(void);
+static void startModel(double Position);
+static void runPasses(uint64_t Duration_ns, double EndPosition,
+                      Count_t *pCount);
+static uint16_t potSource(uint8_t Channel);
+static uint16_t noisyReading(void);
+static bool oldCheck(uint16_t Reading);
+static uint8_t expectedLevel(double Position);
+static double gaussian(void);
+
+/*---------------------------- Module Variables ---------------------------*/
+static double NoiseCounts = 3.0;
+static uint32_t Seed = 77;
+static double Position;      // knob, in ADC counts
+static bool IsOldFirst;
+static uint16_t OldLast;
+
+/*------------------------------ Module Code ------------------------------*/
+int main(int argc, char *argv[])
+{
+  bool IsPassing = true;
+  int Opt;
+
+  while ((Opt = getopt(argc, argv, "n:s:")) != -1)
+  {
+    switch (Opt)
+    {
+      case 'n': NoiseCounts = atof(optarg); break;
+      case 's': Seed = (uint32_t)atoi(optarg); break;
+      default:
+        fprintf(stderr, "usage: %s [-n noise_counts] [-s seed]\n", argv[0]);
+        return 1;
+    }
+  }
+  printf("noise %.1f counts rms, a %d count spike 1 conversion in %d\n",
+         NoiseCounts, SPIKE_COUNTS, SPIKE_ODDS);
+  IsPassing &= runStill(5.0);
+  IsPassing &= runStill(37.3);
+  IsPassing &= runStill(50.0 + 50.0 / 99.0); // between levels 50 and 51
+  IsPassing &= runStill(82.0);
+  IsPassing &= runSweep();
+  printf("%s\n", (true == IsPassing) ? "PASS" : "FAIL");
+  return (true == IsPassing) ? 0 : 1;
+}
+
+/*--------------------------- private functions ---------------------------*/
+// a minute with the knob untouched; the new checker must post nothing
+static bool runStill(double Percent)
+{
+  Count_t Count = { 0 };
+  double Start = Percent * 1023.0 / 100.0;
+
+  startModel(Start);
+  Count.Level = PotSampler_GetLevel();
+  runPasses(MINUTE_NS, Start, &Count);
+  printf("still at %5.1f%%  old %5u events/min, new %u events/min, "
+         "level %u\n", Percent, (unsigned)Count.OldEvents,
+         (unsigned)Count.NewEvents, (unsigned)Count.Level);
+  return (0 == Count.NewEvents) &&
+         (abs((int)Count.Level - (int)expectedLevel(Start)) <= 1);
+}
+
+// 20% to 80% in a second, then a second still
+static bool runSweep(void)
+{
+  Count_t Count = { 0 };
+  double End = 0.8 * 1023.0;
+  uint64_t SweepEnd_ns;
+  bool IsPassing;
+
+  startModel(0.2 * 1023.0);
+  Count.Level = PotSampler_GetLevel();
+  runPasses(SWEEP_NS, End, &Count);
+  SweepEnd_ns = HostModel_GetTime_ns();
+  runPasses(HOLD_NS, End, &Count);
+  IsPassing = (Count.Level == expectedLevel(End));
+  printf("sweep 20%%-80%%   old %5u events, new %u events, ends at level %u "
+         "(%u expected), settled %llu ms after the knob stopped %s\n",
+         (unsigned)Count.OldEvents, (unsigned)Count.NewEvents,
+         (unsigned)Count.Level, (unsigned)expectedLevel(End),
+         (unsigned long long)((Count.LastChange_ns > SweepEnd_ns) ?
+                              (Count.LastChange_ns - SweepEnd_ns) / 1000000 :
+                              0),
+         (true == IsPassing) ? "ok" : "FAILED");
+  return IsPassing;
+}
+
+static void startModel(double Start)
+{
+  HostModel_Reset();
+  HostModel_SetADCSource(potSource);
+  Position = Start;
+  IsOldFirst = true;
+  PotSampler_Init();
+}
+
+// the main loop, with the knob moving in a straight line to EndPosition
+static void runPasses(uint64_t Duration_ns, double EndPosition,
+                      Count_t *pCount)
+{
+  double Step = (EndPosition - Position) / (double)(Duration_ns / PASS_NS);
+  uint64_t Elapsed_ns;
+  uint8_t Level;
+
+  for (Elapsed_ns = 0; Elapsed_ns < Duration_ns; Elapsed_ns += PASS_NS)
+  {
+    Position += Step;
+    if (true == oldCheck(noisyReading()))
+    {
+      pCount->OldEvents++;
+    }
+    Level = PotSampler_GetLevel();
+    if (Level != pCount->Level)
+    {
+      pCount->NewEvents++;
+      pCount->Level = Level;
+      pCount->LastChange_ns = HostModel_GetTime_ns();
+    }
+    HostModel_Advance_ns(PASS_NS);
+  }
+  Position = EndPosition;
+}
+
+static uint16_t potSource(uint8_t Channel)
+{
+  return (5 == Channel) ? noisyReading() : 0;
+}
+
+static uint16_t noisyReading(void)
+{
+  double Reading = Position + NoiseCounts * gaussian();
+
+  Seed = Seed * 1103515245UL + 12345UL;
+  if (0 == (Seed >> 8) % SPIKE_ODDS)
+  {
+    Reading += (Seed & 0x80000000UL) ? SPIKE_COUNTS : -SPIKE_COUNTS;
+  }
+  if (Reading < 0.0)
+  {
+    return 0;
+  }
+  return (Reading > 1023.0) ? 1023 : (uint16_t)lround(Reading);
+}
+
+// the old CheckPotSensor, less the ADC access
+static bool oldCheck(uint16_t Reading)
+{
+  if (true == IsOldFirst)
+  {
+    IsOldFirst = false;
+    OldLast = Reading;
+    return false;
+  }
+  if ((Reading != OldLast) && (abs(Reading - OldLast) > OLD_THRESHOLD))
+  {
+    OldLast = Reading;
+    return true;
+  }
+  return false;
+}
+
+static uint8_t expectedLevel(double Counts)
+{
+  return (uint8_t)(POT_MIN_LEVEL + lround(Counts * 99.0 / 1023.0));
+}
+
+// Box-Muller from the bench's LCG
+static double gaussian(void)
+{
+  double U1;
+  double U2;
+
+  Seed = Seed * 1103515245UL + 12345UL;
+  U1 = ((Seed >> 8) + 1.0) / 16777217.0;
+  Seed = Seed * 1103515245UL + 12345UL;
+  U2 = (Seed >> 8) / 16777216.0;
+  return sqrt(-2.0 * log(U1)) * cos(2.0 * M_PI * U2);
+}
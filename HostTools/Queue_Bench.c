@@ -0,0 +1,268 @@
+/****************************************************************************
+ Module
+   Queue_Bench.c
+
+ Description
+   Runs the real ES_Framework.c and ES_Queue.c, with stand ins for the
+   services, through the overflow the queue diagnostics are for: five
+   ES_BUZZ events posted at BuzzService's queue of 3, two for GameService,
+   and an ES_NEW_KEY for everyone while Buzz is still full. ES_Run then
+   runs what was taken, and the bench checks ES_GetQueueStats against
+   what it posted: the peaks, the posts turned away and the first of
+   them, and the queues empty at the end. The ES_PrintQueueStats table is
+   shown.
+
+   Built with -DES_TRAP_ON_OVERFLOW it must stop at the fourth ES_BUZZ
+   instead. It checks that the queue table and the three posts before it
+   were printed before the assert, with interrupts still off.
+
+ Build (from the repository root)
+   gcc -D__NO_INLINE__ -Wl,--wrap=putchar [-DES_TRAP_ON_OVERFLOW]
+       -IHostTools/include -IHostTools -IFrameworkHeaders -IProjectHeaders
+       HostTools/Queue_Bench.c FrameworkSource/ES_Framework.c
+       FrameworkSource/ES_Queue.c FrameworkSource/ES_LookupTables.c
+       FrameworkSource/dbprintf.c FrameworkSource/binlog.c
+       HostTools/PIC32_HostModel.c
+       -o queue_bench
+
+ Usage
+   ./queue_bench
+
+ Notes
+   __NO_INLINE__ stops glibc inlining putchar out of reach of the wrap.
+****************************************************************************/
+/*----------------------------- Include Files -----------------------------*/
+#include <signal.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include <xc.h>
+#include "ES_Configure.h"
+#include "ES_Framework.h"
+#include "ES_ServiceHeaders.h"
+#include "terminal.h"
+#undef printf // dbprintf.h sends it to DB_printf
+
+/*----------------------------- Module Defines ----------------------------*/
+#define SERVICE_HARNESS 0
+#define SERVICE_GAME    1
+#define SERVICE_BUZZ    4
+#define NUM_BUZZ        5
+#define NUM_GAME        2
+#define MAX_OUTPUT      4096
+
+// each service's init and run, the run functions counting what they get
+#define STUB_SERVICE(n)                                   \
+  bool SERV_##n##_INIT(uint8_t Priority)                  \
+  {                                                       \
+    (void)Priority;                                       \
+    return true;                                          \
+  }                                                       \
+  ES_Event_t SERV_##n##_RUN(ES_Event_t ThisEvent)         \
+  {                                                       \
+    return runService(n, ThisEvent);                      \
+  }
+
+/*---------------------------- Module Functions ---------------------------*/
+static ES_Event_t runService(uint8_t WhichService, ES_Event_t ThisEvent);
+static uint32_t check(uint8_t WhichService, uint8_t HighWater,
+                      uint32_t NumFailed, uint16_t FirstParam);
+static void onAbort(int Signal);
+
+/*---------------------------- Module Variables ---------------------------*/
+static uint32_t NumRun[NUM_SERVICES];
+static char Output[MAX_OUTPUT];
+static size_t OutputLength;
+
+/*------------------------------ Module Code ------------------------------*/
+STUB_SERVICE(0)
+STUB_SERVICE(1)
+STUB_SERVICE(2)
+STUB_SERVICE(3)
+STUB_SERVICE(4)
+STUB_SERVICE(5)
+STUB_SERVICE(6)
+
+int main(void)
+{
+  ES_Event_t ThisEvent;
+  ES_QueueStats_t Stats;
+  uint32_t NumBad = 0;
+  uint8_t i;
+
+  signal(SIGABRT, onAbort);
+  if (Success != ES_Initialize(ES_Timer_RATE_1mS))
+  {
+    fprintf(stderr, "ES_Initialize failed\n");
+    return 1;
+  }
+
+  ThisEvent.EventType = ES_BUZZ;
+  for (i = 1; i <= NUM_BUZZ; i++)
+  {
+    ThisEvent.EventParam = i;
+    ES_PostToService(SERVICE_BUZZ, ThisEvent);
+  }
+#ifdef ES_TRAP_ON_OVERFLOW
+  printf("the fourth ES_BUZZ did not stop it\n");
+  return 1;
+#endif
+  ThisEvent.EventType = ES_TIMEOUT;
+  for (i = 1; i <= NUM_GAME; i++)
+  {
+    ThisEvent.EventParam = i;
+    ES_PostToService(SERVICE_GAME, ThisEvent);
+  }
+  // stops at Buzz, so LEDSeq and Haptic never see it
+  ThisEvent.EventType = ES_NEW_KEY;
+  ThisEvent.EventParam = 'Q';
+  if (true == ES_PostAll(ThisEvent))
+  {
+    printf("ES_PostAll went through a full queue\n");
+    NumBad++;
+  }
+
+  OutputLength = 0;
+  ES_PrintQueueStats();
+  Output[OutputLength] = 0;
+  fputs(Output, stdout);
+
+  NumBad += check(SERVICE_BUZZ, 3, NUM_BUZZ - 3 + 1, 4);
+  NumBad += check(SERVICE_GAME, NUM_GAME + 1, 0, 0);
+  NumBad += check(NUM_SERVICES - 1, 0, 0, 0);
+
+  // the harness, lowest priority, stops ES_Run when its key comes round
+  if (FailedRun != ES_Run())
+  {
+    NumBad++;
+  }
+  for (i = 0; ES_GetQueueStats(i, &Stats); i++)
+  {
+    if (0 != Stats.Depth)
+    {
+      printf("  %s still has %u\n", ES_GetServiceName(i), Stats.Depth);
+      NumBad++;
+    }
+  }
+  if ((3 != NumRun[SERVICE_BUZZ]) || (NUM_GAME + 1 != NumRun[SERVICE_GAME]))
+  {
+    printf("  ran %u buzz and %u game events\n",
+           (unsigned)NumRun[SERVICE_BUZZ], (unsigned)NumRun[SERVICE_GAME]);
+    NumBad++;
+  }
+  printf("%u checks failed\n", (unsigned)NumBad);
+  return (0 == NumBad) ? 0 : 1;
+}
+
+/*--------------------------- private functions ---------------------------*/
+static ES_Event_t runService(uint8_t WhichService, ES_Event_t ThisEvent)
+{
+  ES_Event_t ReturnEvent;
+
+  NumRun[WhichService]++;
+  ReturnEvent.EventType = ES_NO_EVENT;
+  if ((SERVICE_HARNESS == WhichService) && (ES_NEW_KEY == ThisEvent.EventType))
+  {
+    ReturnEvent.EventType = ES_ERROR;
+  }
+  return ReturnEvent;
+}
+
+// 1 if the service's queue statistics are not as posted
+static uint32_t check(uint8_t WhichService, uint8_t HighWater,
+                      uint32_t NumFailed, uint16_t FirstParam)
+{
+  ES_QueueStats_t Stats;
+
+  ES_GetQueueStats(WhichService, &Stats);
+  if ((Stats.HighWater != HighWater) || (Stats.NumFailed != NumFailed) ||
+      ((0 != NumFailed) && (Stats.FirstFailed.EventParam != FirstParam)))
+  {
+    printf("  %s: peak %u, %u failed, first param %u\n",
+           ES_GetServiceName(WhichService), Stats.HighWater,
+           (unsigned)Stats.NumFailed, Stats.FirstFailed.EventParam);
+    return 1;
+  }
+  return 0;
+}
+
+// where ES_TRAP_ON_OVERFLOW's assert ends up
+static void onAbort(int Signal)
+{
+  const char *pDrop;
+  const char *pLine;
+  uint32_t NumPosts = 0;
+  bool IsOff;
+  bool IsGood;
+
+  (void)Signal;
+  Output[OutputLength] = 0;
+  fputs(Output, stdout);
+  pDrop = strstr(Output, "DROP RunBuzzService");
+  for (pLine = Output; NULL != (pLine = strstr(pLine, "post RunBuzzService"));
+       pLine++)
+  {
+    NumPosts++;
+  }
+  // the printout must not have turned interrupts back on
+  IsOff = (0 == (__builtin_disable_interrupts() & _CP0_STATUS_IE_MASK));
+  IsGood = (NULL != strstr(Output, "queue is full")) && (NULL != pDrop) &&
+           (3 == NumPosts) && IsOff;
+  printf("%s\n", IsGood ? "trapped at the fourth ES_BUZZ" :
+                          "the trap did not print what it should");
+  fflush(stdout);
+  _exit(IsGood ? 0 : 1);
+}
+
+/*------------------------------- the stubs -------------------------------*/
+void ES_Timer_Init(TimerRate_t Rate)
+{
+  (void)Rate;
+}
+
+uint16_t ES_Timer_GetTime(void)
+{
+  return 0;
+}
+
+bool _HW_Process_Pending_Ints(void)
+{
+  return true;
+}
+
+bool ES_CheckUserEvents(void)
+{
+  return false;
+}
+
+void Terminal_MoveBuffer2UART(void)
+{
+}
+
+void Terminal_SetTxPolicy(TerminalTxPolicy_t Policy)
+{
+  (void)Policy;
+}
+
+// no trace dumps here
+uint16_t Terminal_GetTxFree(void)
+{
+  return 0;
+}
+
+void Terminal_WriteBytes(const uint8_t *pBytes, uint16_t Length)
+{
+  (void)pBytes;
+  (void)Length;
+}
+
+// DB_printf's characters, collected to be read back
+int __wrap_putchar(int c)
+{
+  if (OutputLength < MAX_OUTPUT - 1)
+  {
+    Output[OutputLength++] = (char)c;
+  }
+  return c;
+}
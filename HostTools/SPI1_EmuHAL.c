@@ -0,0 +1,60 @@
+/****************************************************************************
+ Module
+   SPI1_EmuHAL.c
+
+ Description
+   Stands in for the blocking SPI1 functions of PIC32_SPI_HAL_Starter.c,
+   feeding each word straight into the MAX7219 chain emulator. Link this in
+   place of the HAL when only the display driver is under test; link the
+   real HAL with PIC32_HostModel.c to exercise the register level code.
+****************************************************************************/
+/*----------------------------- Include Files -----------------------------*/
+#include <stdint.h>
+#include <stdbool.h>
+#include "PIC32_SPI_HAL.h"
+#include "MAX7219_Emu.h"
+
+/*------------------------------ Module Code ------------------------------*/
+/****************************************************************************
+ Function
+    SPIOperate_SPI1_Send16
+
+ Description
+   Shifts one word into the chain, pushing the others one module along
+****************************************************************************/
+void SPIOperate_SPI1_Send16( uint16_t TheData)
+{
+  MAX7219Emu_ShiftIn(TheData);
+}
+
+/****************************************************************************
+ Function
+    SPIOperate_SPI1_Send16Wait
+
+ Description
+   Shifts in the last word of a frame and raises SS, latching the chain
+****************************************************************************/
+void SPIOperate_SPI1_Send16Wait( uint16_t TheData)
+{
+  MAX7219Emu_ShiftIn(TheData);
+  MAX7219Emu_Latch();
+}
+
+bool SPIOperate_SPI1_HasRoom(void)
+{
+  return true; // the emulated bus never backs up
+}
+
+bool SPIOperate_HasSS1_Risen(void)
+{
+  return true; // every frame is latched as soon as it is sent
+}
+
+/*------------------------ transaction queue stubs ------------------------*/
+// the emulated bus is synchronous, so DM_SetQueuedOutput is never turned on
+bool SPIQueue_SPI1_AddFrame(const uint16_t *pWords, uint8_t NumWords)
+{
+  (void)pWords;
+  (void)NumWords;
+  return false;
+}
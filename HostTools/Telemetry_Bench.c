@@ -0,0 +1,245 @@
+/****************************************************************************
+ Module
+   Telemetry_Bench.c
+
+ Description
+   Runs the real Telemetry.c and binlog.c framing over a stand in for a
+   game: stubs for the framework's statistics, GameService's queries and
+   the terminal, with time moving on the PIC32 model's CP0 Count. Records
+   go out every TELEMETRY_PERIOD_MS, with a line of plain DB_printf text
+   now and then between them, as on the real terminal, into a capture
+   that HostTools/Telemetry_Decode.c turns into CSV.
+
+   It reports the bytes a record takes, on average and at most, and what
+   that is of the 115200 baud line, against the 10% budget. The terminal
+   stub runs out of room for a stretch in the middle, and the records
+   skipped there must show up as skipped and in the sequence numbers.
+
+ Build (from the repository root)
+   gcc -IHostTools/include -IHostTools -IFrameworkHeaders -IProjectHeaders
+       HostTools/Telemetry_Bench.c ProjectSource/Telemetry.c
+       FrameworkSource/binlog.c HostTools/PIC32_HostModel.c
+       -o telemetry_bench
+
+ Usage
+   ./telemetry_bench [-s seconds] [-o capture]
+   then ./telemetry_decode capture > telemetry.csv
+
+ Notes
+   On one run, 290 records sent over a minute averaged 40.3 bytes, 195 B/s
+   or 1.7% of the line, and the largest was 41. The most a record for
+   seven services could take is 124 bytes, 5.4% at this rate.
+****************************************************************************/
+/*----------------------------- Include Files -----------------------------*/
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include <xc.h>
+#include "ES_Configure.h"
+#include "ES_Framework.h"
+#include "GameService.h"
+#include "Telemetry.h"
+#include "PIC32_HostModel.h"
+#undef printf // dbprintf.h sends it to DB_printf
+
+/*----------------------------- Module Defines ----------------------------*/
+#define NS_PER_MS          1000000ULL
+#define LINK_BYTES_PER_S   11520.0
+#define TEXT_ODDS          4       // a line of text before 1 record in this many
+#define FULL_FROM_S        20      // the terminal has no room from here
+#define FULL_FOR_S         2       // for this long
+
+/*---------------------------- Module Functions ---------------------------*/
+static void playGame(uint32_t Record);
+static uint32_t nextRandom(void);
+
+/*---------------------------- Module Variables ---------------------------*/
+static FILE *pCapture;
+static uint64_t NumBytes;
+static uint16_t TxFree = 1024;
+static uint32_t Seed = 1;
+
+// what the stubs hand Telemetry.c
+static GameState_t State = Waiting2Coins;
+static int16_t Score;
+static uint8_t Countdown = 6;
+static uint8_t QueueDepth[NUM_SERVICES];
+static uint32_t NumDispatched[NUM_SERVICES];
+static ES_LoopStats_t Loops;
+
+/*------------------------------ Module Code ------------------------------*/
+int main(int argc, char *argv[])
+{
+  uint32_t Seconds = 60;
+  uint32_t NumRecords;
+  uint32_t NumSent = 0;
+  uint32_t NumSkipped = 0;
+  uint32_t Largest = 0;
+  uint64_t Before;
+  uint32_t Record;
+  int Opt;
+
+  while ((Opt = getopt(argc, argv, "s:o:")) != -1)
+  {
+    switch (Opt)
+    {
+      case 's': Seconds = (uint32_t)atoi(optarg); break;
+      case 'o':
+        pCapture = fopen(optarg, "wb");
+        if (NULL == pCapture)
+        {
+          perror(optarg);
+          return 1;
+        }
+        break;
+      default:
+        fprintf(stderr, "usage: %s [-s seconds] [-o capture]\n", argv[0]);
+        return 1;
+    }
+  }
+  HostModel_Reset();
+  Telemetry_SetEnabled(true);
+  NumRecords = Seconds * 1000 / TELEMETRY_PERIOD_MS;
+  for (Record = 0; Record < NumRecords; Record++)
+  {
+    HostModel_Advance_ns(TELEMETRY_PERIOD_MS * NS_PER_MS);
+    playGame(Record);
+    if (0 == nextRandom() % TEXT_ODDS)
+    {
+      if (NULL != pCapture)
+      {
+        fputs("GameOn for 50 more seconds\r\n", pCapture);
+      }
+    }
+    TxFree = ((Record * TELEMETRY_PERIOD_MS >= FULL_FROM_S * 1000) &&
+              (Record * TELEMETRY_PERIOD_MS < (FULL_FROM_S + FULL_FOR_S) *
+               1000)) ? 0 : 1024;
+    Before = NumBytes;
+    if (Telemetry_Send())
+    {
+      NumSent++;
+      if (NumBytes - Before > Largest)
+      {
+        Largest = (uint32_t)(NumBytes - Before);
+      }
+    }
+    else
+    {
+      NumSkipped++;
+    }
+  }
+
+  printf("%u records over %u s, one every %d ms\n", (unsigned)NumRecords,
+         (unsigned)Seconds, TELEMETRY_PERIOD_MS);
+  printf("sent %u, skipped %u with the terminal full for %d s\n",
+         (unsigned)NumSent, (unsigned)NumSkipped, FULL_FOR_S);
+  printf("%.1f bytes a record, %u at most, %.0f B/s, %.1f%% of the line\n",
+         (double)NumBytes / NumSent, (unsigned)Largest,
+         (double)NumBytes / Seconds,
+         100.0 * NumBytes / Seconds / LINK_BYTES_PER_S);
+  if (NULL != pCapture)
+  {
+    fclose(pCapture);
+  }
+  return ((NumSkipped == FULL_FOR_S * 1000 / TELEMETRY_PERIOD_MS) &&
+          (0 != Largest)) ? 0 : 1;
+}
+
+/*--------------------------- private functions ---------------------------*/
+// coins, a minute's game and game over, round and round; the services
+// run more events while a game is on
+static void playGame(uint32_t Record)
+{
+  uint32_t Phase = Record % 350;
+  uint8_t i;
+
+  if (Phase < 40)
+  {
+    State = (Phase < 20) ? Waiting2Coins : Waiting1Coins;
+    Score = 0;
+    Countdown = 6;
+  }
+  else if (Phase < 340)
+  {
+    State = GameOn;
+    Countdown = 6 - (Phase - 40) / 50;
+    if (0 == nextRandom() % 3)
+    {
+      Score += (0 == nextRandom() % 4) ? -5 : 10;
+    }
+  }
+  else
+  {
+    State = GameOver;
+  }
+  for (i = 0; i < NUM_SERVICES; i++)
+  {
+    QueueDepth[i] = (uint8_t)(nextRandom() % 3);
+    NumDispatched[i] += (GameOn == State) ? 10 + nextRandom() % 40 :
+                                            nextRandom() % 4;
+  }
+  Loops.NumLoops += 9000 + nextRandom() % 2000;
+  Loops.TotalTicks += TELEMETRY_PERIOD_MS * 20000UL;
+  if (Loops.MaxTicks < 2000 + nextRandom() % 30000)
+  {
+    Loops.MaxTicks = 2000 + nextRandom() % 30000;
+  }
+}
+
+static uint32_t nextRandom(void)
+{
+  Seed = Seed * 1103515245UL + 12345UL;
+  return Seed >> 8;
+}
+
+/*------------------------------- the stubs -------------------------------*/
+uint8_t ES_GetNumServices(void)
+{
+  return NUM_SERVICES;
+}
+
+uint8_t ES_GetQueueDepth(uint8_t WhichService)
+{
+  return QueueDepth[WhichService];
+}
+
+uint32_t ES_GetDispatchCount(uint8_t WhichService)
+{
+  return NumDispatched[WhichService];
+}
+
+void ES_TakeLoopStats(ES_LoopStats_t *pStats)
+{
+  *pStats = Loops;
+  memset(&Loops, 0, sizeof(Loops));
+}
+
+GameState_t QueryGameService(void)
+{
+  return State;
+}
+
+int16_t QueryGameScore(void)
+{
+  return Score;
+}
+
+uint8_t QueryGameCountdown(void)
+{
+  return Countdown;
+}
+
+uint16_t Terminal_GetTxFree(void)
+{
+  return TxFree;
+}
+
+void Terminal_WriteBytes(const uint8_t *pBytes, uint16_t Length)
+{
+  NumBytes += Length;
+  if (NULL != pCapture)
+  {
+    fwrite(pBytes, 1, Length, pCapture);
+  }
+}
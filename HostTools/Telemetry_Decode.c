@@ -0,0 +1,319 @@
+/****************************************************************************
+ Module
+   Telemetry_Decode.c
+
+ Description
+   Turns a terminal capture into CSV, a row for each telemetry record (see
+   ProjectHeaders/Telemetry.h) and nothing else: plain text and log
+   records in the same capture are skipped. The columns are
+
+     time_s      since the first record, from the CP0 Count at 20MHz
+     seq         the record's sequence number
+     missed      records before this one that are not in the capture,
+                 skipped by the firmware or lost on the line
+     state       the GameState_t name
+     score, countdown_s
+     q0..qn      each service's queue depth, service 0 first
+     run0..runn  events each service ran in the period
+     loops       passes through ES_Run's loop in the period
+     loop_mean_us, loop_max_us
+     skipped     records the firmware has not sent since reset
+
+   The header is written from the first record, which says how many
+   services there are.
+
+ Build (from the repository root)
+   gcc -IHostTools/include -IFrameworkHeaders HostTools/Telemetry_Decode.c
+       -o telemetry_decode
+
+ Usage
+   ./telemetry_decode [capture] > telemetry.csv
+   Reads the capture from stdin if no file is given; a summary of records,
+   bad frames and the link time they took goes to stderr.
+****************************************************************************/
+/*----------------------------- Include Files -----------------------------*/
+#include <stdbool.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include "binlog.h"
+#undef printf // dbprintf.h sends it to DB_printf
+
+/*----------------------------- Module Defines ----------------------------*/
+#define MAX_FRAME          256
+#define MAX_SERVICES       16
+#define CORE_COUNTS_PER_S  20000000.0
+#define CORE_COUNTS_PER_US 20.0
+#define LINK_BYTES_PER_S   11520.0
+
+typedef struct
+{
+  uint32_t Stamp;
+  uint32_t Sequence;
+  uint32_t State;
+  int32_t Score;
+  uint32_t Countdown_s;
+  uint32_t NumServices;
+  uint32_t QueueDepth[MAX_SERVICES];
+  uint32_t NumRun[MAX_SERVICES];
+  uint32_t NumLoops;
+  uint32_t MaxTicks;
+  uint32_t TotalTicks;
+  uint32_t NumSkipped;
+} Record_t;
+
+/*---------------------------- Module Functions ---------------------------*/
+static void decodeStream(FILE *pIn);
+static void decodeFrame(const uint8_t *pFrame, size_t Length);
+static bool parseRecord(const uint8_t *pIn, const uint8_t *pEnd,
+                        Record_t *pRecord);
+static void printRecord(const Record_t *pRecord);
+static size_t unCOBS(const uint8_t *pIn, size_t Length, uint8_t *pOut);
+static bool getVarint(const uint8_t **ppIn, const uint8_t *pEnd,
+                      uint32_t *pValue);
+
+/*---------------------------- Module Variables ---------------------------*/
+// as GameState_t has them
+static const char *const StateNames[] = {
+  "Waiting2Coins", "Waiting1Coins", "Waiting", "GameOn", "GameOver"
+};
+
+static bool IsFirstRecord = true;
+static uint32_t NumServices;
+static uint32_t LastStamp;
+static uint32_t LastSequence;
+static double Elapsed_s;
+static uint32_t NumRecords;
+static uint32_t NumBad;
+static uint64_t NumFrameBytes;
+
+/*------------------------------ Module Code ------------------------------*/
+int main(int argc, char *argv[])
+{
+  FILE *pIn = stdin;
+
+  if (argc > 2)
+  {
+    fprintf(stderr, "usage: %s [capture]\n", argv[0]);
+    return 1;
+  }
+  if (argc == 2)
+  {
+    pIn = fopen(argv[1], "rb");
+    if (NULL == pIn)
+    {
+      perror(argv[1]);
+      return 1;
+    }
+  }
+  decodeStream(pIn);
+  fprintf(stderr, "%u records, %u bad", (unsigned)NumRecords,
+          (unsigned)NumBad);
+  if (Elapsed_s > 0)
+  {
+    fprintf(stderr, ", %.0f B/s, %.1f%% of the line", NumFrameBytes /
+            Elapsed_s, 100.0 * NumFrameBytes / Elapsed_s / LINK_BYTES_PER_S);
+  }
+  fputc('\n', stderr);
+  return 0;
+}
+
+/*--------------------------- private functions ---------------------------*/
+// as BinLog_Decode: text until a zero, a frame until the next
+static void decodeStream(FILE *pIn)
+{
+  uint8_t Frame[MAX_FRAME];
+  size_t Length = 0;
+  bool IsInFrame = false;
+  int c;
+
+  while (EOF != (c = getc(pIn)))
+  {
+    if (false == IsInFrame)
+    {
+      if (0 == c)
+      {
+        IsInFrame = true;
+        Length = 0;
+      }
+    }
+    else if (0 == c)
+    {
+      if (0 != Length)
+      {
+        decodeFrame(Frame, Length);
+        IsInFrame = false;
+      }
+    }
+    else if (Length < MAX_FRAME)
+    {
+      Frame[Length++] = (uint8_t)c;
+    }
+  }
+}
+
+static void decodeFrame(const uint8_t *pFrame, size_t Length)
+{
+  uint8_t Payload[MAX_FRAME];
+  size_t PayloadLength = unCOBS(pFrame, Length, Payload);
+  Record_t Record;
+
+  if ((PayloadLength < 6) ||
+      (BINLOG_SITE_TELEMETRY != (Payload[0] | (Payload[1] << 8))))
+  {
+    return;                    // log records, or not a frame at all
+  }
+  Record.Stamp = Payload[2] | (Payload[3] << 8) | (Payload[4] << 16) |
+                 ((uint32_t)Payload[5] << 24);
+  if (false == parseRecord(&Payload[6], &Payload[PayloadLength], &Record))
+  {
+    NumBad++;
+    return;
+  }
+  NumFrameBytes += Length + 2;
+  printRecord(&Record);
+}
+
+static bool parseRecord(const uint8_t *pIn, const uint8_t *pEnd,
+                        Record_t *pRecord)
+{
+  uint32_t Score;
+  uint32_t i;
+
+  if (!getVarint(&pIn, pEnd, &pRecord->Sequence) ||
+      !getVarint(&pIn, pEnd, &pRecord->State) ||
+      !getVarint(&pIn, pEnd, &Score) ||
+      !getVarint(&pIn, pEnd, &pRecord->Countdown_s) ||
+      !getVarint(&pIn, pEnd, &pRecord->NumServices) ||
+      (pRecord->NumServices > MAX_SERVICES))
+  {
+    return false;
+  }
+  pRecord->Score = (int32_t)Score;
+  for (i = 0; i < pRecord->NumServices; i++)
+  {
+    if (!getVarint(&pIn, pEnd, &pRecord->QueueDepth[i]))
+    {
+      return false;
+    }
+  }
+  for (i = 0; i < pRecord->NumServices; i++)
+  {
+    if (!getVarint(&pIn, pEnd, &pRecord->NumRun[i]))
+    {
+      return false;
+    }
+  }
+  return getVarint(&pIn, pEnd, &pRecord->NumLoops) &&
+         getVarint(&pIn, pEnd, &pRecord->MaxTicks) &&
+         getVarint(&pIn, pEnd, &pRecord->TotalTicks) &&
+         getVarint(&pIn, pEnd, &pRecord->NumSkipped);
+}
+
+static void printRecord(const Record_t *pRecord)
+{
+  uint32_t Missed = 0;
+  uint32_t i;
+
+  if ((false == IsFirstRecord) && (pRecord->NumServices != NumServices))
+  {
+    NumBad++;                  // a different build, the columns no longer fit
+    return;
+  }
+  if (true == IsFirstRecord)
+  {
+    NumServices = pRecord->NumServices;
+    printf("time_s,seq,missed,state,score,countdown_s");
+    for (i = 0; i < NumServices; i++)
+    {
+      printf(",q%u", (unsigned)i);
+    }
+    for (i = 0; i < NumServices; i++)
+    {
+      printf(",run%u", (unsigned)i);
+    }
+    printf(",loops,loop_mean_us,loop_max_us,skipped\n");
+  }
+  else
+  {
+    // unwrapped on the way, as the count wraps every 214s
+    Elapsed_s += (uint32_t)(pRecord->Stamp - LastStamp) / CORE_COUNTS_PER_S;
+    Missed = pRecord->Sequence - LastSequence - 1;
+  }
+  IsFirstRecord = false;
+  LastStamp = pRecord->Stamp;
+  LastSequence = pRecord->Sequence;
+  NumRecords++;
+
+  printf("%.3f,%u,%u,", Elapsed_s, (unsigned)pRecord->Sequence,
+         (unsigned)Missed);
+  if (pRecord->State < sizeof(StateNames) / sizeof(StateNames[0]))
+  {
+    printf("%s", StateNames[pRecord->State]);
+  }
+  else
+  {
+    printf("%u", (unsigned)pRecord->State);
+  }
+  printf(",%d,%u", (int)pRecord->Score, (unsigned)pRecord->Countdown_s);
+  for (i = 0; i < NumServices; i++)
+  {
+    printf(",%u", (unsigned)pRecord->QueueDepth[i]);
+  }
+  for (i = 0; i < NumServices; i++)
+  {
+    printf(",%u", (unsigned)pRecord->NumRun[i]);
+  }
+  printf(",%u,%.1f,%.1f,%u\n", (unsigned)pRecord->NumLoops,
+         (0 == pRecord->NumLoops) ? 0.0 :
+         pRecord->TotalTicks / CORE_COUNTS_PER_US / pRecord->NumLoops,
+         pRecord->MaxTicks / CORE_COUNTS_PER_US,
+         (unsigned)pRecord->NumSkipped);
+}
+
+// returns the decoded length, 0 if the frame is malformed
+static size_t unCOBS(const uint8_t *pIn, size_t Length, uint8_t *pOut)
+{
+  size_t In = 0;
+  size_t Out = 0;
+  uint8_t Code;
+  uint8_t i;
+
+  while (In < Length)
+  {
+    Code = pIn[In++];
+    if ((0 == Code) || (In + Code - 1 > Length))
+    {
+      return 0;
+    }
+    for (i = 1; i < Code; i++)
+    {
+      pOut[Out++] = pIn[In++];
+    }
+    if ((Code < 0xFF) && (In < Length))
+    {
+      pOut[Out++] = 0;
+    }
+  }
+  return Out;
+}
+
+static bool getVarint(const uint8_t **ppIn, const uint8_t *pEnd,
+                      uint32_t *pValue)
+{
+  uint32_t ZigZag = 0;
+  uint8_t Shift = 0;
+  uint8_t Byte;
+
+  do
+  {
+    if ((*ppIn >= pEnd) || (Shift > 28))
+    {
+      return false;
+    }
+    Byte = *(*ppIn)++;
+    ZigZag |= (uint32_t)(Byte & 0x7F) << Shift;
+    Shift += 7;
+  } while (0 != (Byte & 0x80));
+  *pValue = (ZigZag >> 1) ^ (uint32_t)-(int32_t)(ZigZag & 1);
+  return true;
+}
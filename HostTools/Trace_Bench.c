@@ -0,0 +1,333 @@
+/****************************************************************************
+ Module
+   Trace_Bench.c
+
+ Description
+   Runs the real ES_Framework.c's ES_Run, with stand ins for the services
+   that take time on the PIC32 model's CP0 Count, through a game's worth
+   of traffic: a timer event for GameService every ms, which posts a row
+   update to LEDService (400us in Send16Wait) and a shift register update
+   to ShiftService, and a buzz to BuzzService now and then. After a while
+   the test harness stand in gets the dump key and calls
+   ES_StartTraceDump, and ES_Run sends the trace to a terminal stand in
+   that drains at 115200 baud, while the game goes on.
+
+   It checks that the dump went out in whole frames, within the room the
+   terminal had, while the game went on, and reports the bytes and the
+   time on the line it took.
+   With -o the frames are written to a capture for HostTools/Trace_Decode.c.
+
+ Build (from the repository root)
+   gcc -D__NO_INLINE__ -Wl,--wrap=putchar
+       -IHostTools/include -IHostTools -IFrameworkHeaders -IProjectHeaders
+       HostTools/Trace_Bench.c FrameworkSource/ES_Framework.c
+       FrameworkSource/ES_Queue.c FrameworkSource/ES_LookupTables.c
+       FrameworkSource/dbprintf.c FrameworkSource/binlog.c
+       HostTools/PIC32_HostModel.c -o trace_bench
+
+ Usage
+   ./trace_bench [-o capture]
+   then ./trace_decode capture > trace.json
+
+ Notes
+   __NO_INLINE__ stops glibc inlining putchar out of reach of the wrap.
+****************************************************************************/
+/*----------------------------- Include Files -----------------------------*/
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include <xc.h>
+#include "ES_Configure.h"
+#include "ES_Framework.h"
+#include "ES_ServiceHeaders.h"
+#include "PIC32_HostModel.h"
+#include "terminal.h"
+#undef printf // dbprintf.h sends it to DB_printf
+
+/*----------------------------- Module Defines ----------------------------*/
+#define SERVICE_HARNESS 0
+#define SERVICE_GAME    1
+#define SERVICE_LED     2
+#define SERVICE_SHIFT   3
+#define SERVICE_BUZZ    4
+#define NS_PER_MS       1000000ULL
+#define IDLE_NS         5000ULL
+#define GAME_NS         30000ULL
+#define LED_NS          400000ULL
+#define SHIFT_NS        50000ULL
+#define BUZZ_NS         20000ULL
+#define BUZZ_EVERY_MS   7
+#define DUMP_AT_MS      200
+#define STOP_AT_MS      600
+#define DUMP_KEY        'D'
+#define STOP_KEY        'X'
+#define TX_BUFFER       1024
+#define NS_PER_BYTE     86806ULL   // 10 bits at 115200 baud
+
+// each service's init and run, the run functions taking the time they are
+// given
+#define STUB_SERVICE(n)                                   \
+  bool SERV_##n##_INIT(uint8_t Priority)                  \
+  {                                                       \
+    (void)Priority;                                       \
+    return true;                                          \
+  }                                                       \
+  ES_Event_t SERV_##n##_RUN(ES_Event_t ThisEvent)         \
+  {                                                       \
+    return runService(n, ThisEvent);                      \
+  }
+
+/*---------------------------- Module Functions ---------------------------*/
+static ES_Event_t runService(uint8_t WhichService, ES_Event_t ThisEvent);
+static void post(uint8_t WhichService, ES_EventType_t EventType,
+                 uint16_t EventParam);
+static void spend(uint64_t Delta_ns);
+static void drain(void);
+
+/*---------------------------- Module Variables ---------------------------*/
+static FILE *pCapture;
+static uint64_t Now_ns;
+static uint64_t NextTick_ns = NS_PER_MS;
+static uint32_t NumTicks;
+static bool IsDumpAsked;
+static bool IsStopAsked;
+
+// the terminal stand in: bytes waiting, and the UART's progress on them
+static uint32_t TxPending;
+static uint64_t Drained_ns;
+static uint32_t NumFrames;
+static uint32_t NumBytes;
+static uint64_t FirstFrame_ns;
+static uint64_t LastFrame_ns;
+static uint32_t NumTicksDuringDump;
+
+/*------------------------------ Module Code ------------------------------*/
+STUB_SERVICE(0)
+STUB_SERVICE(1)
+STUB_SERVICE(2)
+STUB_SERVICE(3)
+STUB_SERVICE(4)
+STUB_SERVICE(5)
+STUB_SERVICE(6)
+
+int main(int argc, char *argv[])
+{
+  uint32_t NumBad = 0;
+  int Opt;
+
+  while ((Opt = getopt(argc, argv, "o:")) != -1)
+  {
+    switch (Opt)
+    {
+      case 'o':
+        pCapture = fopen(optarg, "wb");
+        if (NULL == pCapture)
+        {
+          perror(optarg);
+          return 1;
+        }
+        break;
+      default:
+        fprintf(stderr, "usage: %s [-o capture]\n", argv[0]);
+        return 1;
+    }
+  }
+  HostModel_Reset();
+  if (Success != ES_Initialize(ES_Timer_RATE_1mS))
+  {
+    fprintf(stderr, "ES_Initialize failed\n");
+    return 1;
+  }
+  if (FailedRun != ES_Run())
+  {
+    printf("ES_Run did not stop at the stop key\n");
+    NumBad++;
+  }
+  drain();
+
+  printf("dump of %u entries: %u frames, %u bytes, on the line for %.1f ms\n",
+         ES_TRACE_LEN, (unsigned)NumFrames, (unsigned)NumBytes,
+         (LastFrame_ns - FirstFrame_ns) / 1e6);
+  printf("%u ticks of the game, %u of them during the dump\n",
+         (unsigned)NumTicks, (unsigned)NumTicksDuringDump);
+  if ((0 == NumFrames) || (LastFrame_ns > (STOP_AT_MS - 100) * NS_PER_MS))
+  {
+    printf("  the dump did not finish well before the end\n");
+    NumBad++;
+  }
+  if (0 == NumTicksDuringDump)
+  {
+    printf("  the game stopped while the trace was dumped\n");
+    NumBad++;
+  }
+  if (NULL != pCapture)
+  {
+    fclose(pCapture);
+  }
+  printf("%u checks failed\n", (unsigned)NumBad);
+  return (0 == NumBad) ? 0 : 1;
+}
+
+/*--------------------------- private functions ---------------------------*/
+static ES_Event_t runService(uint8_t WhichService, ES_Event_t ThisEvent)
+{
+  ES_Event_t ReturnEvent;
+
+  ReturnEvent.EventType = ES_NO_EVENT;
+  switch (WhichService)
+  {
+    case SERVICE_GAME:
+      spend(GAME_NS);
+      post(SERVICE_LED, ES_ROWUPDATE, ThisEvent.EventParam & 7);
+      post(SERVICE_SHIFT, ES_UPDATE_SHIFT, ThisEvent.EventParam & 0xFF);
+      if (0 == ThisEvent.EventParam % BUZZ_EVERY_MS)
+      {
+        post(SERVICE_BUZZ, ES_BUZZ, 1);
+      }
+      break;
+    case SERVICE_LED:
+      spend(LED_NS);
+      break;
+    case SERVICE_SHIFT:
+      spend(SHIFT_NS);
+      break;
+    case SERVICE_BUZZ:
+      spend(BUZZ_NS);
+      break;
+    case SERVICE_HARNESS:
+      if (DUMP_KEY == ThisEvent.EventParam)
+      {
+        ES_StartTraceDump();
+      }
+      else if (STOP_KEY == ThisEvent.EventParam)
+      {
+        ReturnEvent.EventType = ES_ERROR;
+      }
+      break;
+    default:
+      break;
+  }
+  return ReturnEvent;
+}
+
+static void post(uint8_t WhichService, ES_EventType_t EventType,
+                 uint16_t EventParam)
+{
+  ES_Event_t ThisEvent;
+
+  ThisEvent.EventType = EventType;
+  ThisEvent.EventParam = EventParam;
+  ES_PostToService(WhichService, ThisEvent);
+}
+
+static void spend(uint64_t Delta_ns)
+{
+  HostModel_Advance_ns(Delta_ns);
+  Now_ns += Delta_ns;
+}
+
+// the bytes the UART has sent since the last look
+static void drain(void)
+{
+  uint32_t NumSent = (uint32_t)((Now_ns - Drained_ns) / NS_PER_BYTE);
+
+  if (NumSent >= TxPending)
+  {
+    TxPending = 0;
+    Drained_ns = Now_ns;
+  }
+  else
+  {
+    TxPending -= NumSent;
+    Drained_ns += NumSent * NS_PER_BYTE;
+  }
+}
+
+/*------------------------------- the stubs -------------------------------*/
+// the event checkers, called once a pass: the game's timer every ms, and
+// the keys
+bool ES_CheckUserEvents(void)
+{
+  spend(IDLE_NS);
+  if (Now_ns < NextTick_ns)
+  {
+    return false;
+  }
+  NextTick_ns += NS_PER_MS;
+  NumTicks++;
+  if ((0 != NumFrames) && (Now_ns < LastFrame_ns))
+  {
+    NumTicksDuringDump++;
+  }
+  post(SERVICE_GAME, ES_TIMEOUT, (uint16_t)NumTicks);
+  if ((DUMP_AT_MS == NumTicks) && (false == IsDumpAsked))
+  {
+    IsDumpAsked = true;
+    post(SERVICE_HARNESS, ES_NEW_KEY, DUMP_KEY);
+  }
+  if ((STOP_AT_MS <= NumTicks) && (false == IsStopAsked))
+  {
+    IsStopAsked = true;
+    post(SERVICE_HARNESS, ES_NEW_KEY, STOP_KEY);
+  }
+  return true;
+}
+
+void ES_Timer_Init(TimerRate_t Rate)
+{
+  (void)Rate;
+}
+
+uint16_t ES_Timer_GetTime(void)
+{
+  return (uint16_t)(Now_ns / NS_PER_MS);
+}
+
+bool _HW_Process_Pending_Ints(void)
+{
+  return true;
+}
+
+void Terminal_MoveBuffer2UART(void)
+{
+}
+
+void Terminal_SetTxPolicy(TerminalTxPolicy_t Policy)
+{
+  (void)Policy;
+}
+
+uint16_t Terminal_GetTxFree(void)
+{
+  drain();
+  return (uint16_t)(TX_BUFFER - TxPending);
+}
+
+void Terminal_WriteBytes(const uint8_t *pBytes, uint16_t Length)
+{
+  drain();
+  if (TxPending + Length > TX_BUFFER)
+  {
+    printf("  a frame of %u bytes overran the terminal\n", Length);
+    exit(1);
+  }
+  if (0 == NumFrames)
+  {
+    FirstFrame_ns = Now_ns;
+  }
+  TxPending += Length;
+  NumFrames++;
+  NumBytes += Length;
+  LastFrame_ns = Now_ns + TxPending * NS_PER_BYTE;
+  if (NULL != pCapture)
+  {
+    fwrite(pBytes, 1, Length, pCapture);
+  }
+}
+
+// DB_printf's characters, not wanted here
+int __wrap_putchar(int c)
+{
+  return c;
+}
@@ -0,0 +1,593 @@
+/****************************************************************************
+ Module
+   Trace_Decode.c
+
+ Description
+   Turns the event trace dumps in a terminal capture (the test harness's
+   'D' key, see ES_StartTraceDump in ES_Framework.c) into Chrome trace
+   event JSON, for chrome://tracing or ui.perfetto.dev. Each service is a
+   row, highest priority at the top, with a slice for every run function
+   call, from the framework's dispatch to its return, and above it the
+   time each event waited in the queue, from its post to that dispatch.
+   Posts a full queue turned away are marked where they happened. Plain
+   text, log records and telemetry in the same capture are skipped.
+
+   The service and event names are read from ES_Configure.h, the
+   SERV_n_RUN defines and the ES_EventType_t list, so decode against the
+   sources the firmware was built from. A summary of each service's calls
+   and waits goes to stderr.
+
+ Build (from the repository root)
+   gcc -IHostTools/include -IFrameworkHeaders HostTools/Trace_Decode.c
+       -o trace_decode
+
+ Usage
+   ./trace_decode [-r source_root] [capture] > trace.json
+   Reads the capture from stdin if no file is given.
+
+ Notes
+   Several dumps in one capture make one timeline: entries already seen
+   are left out, and entries missing between two dumps, or not kept while
+   the last dump was sent, are marked as lost, with the waits and calls
+   that spanned them dropped. Times are from the first entry, unwrapped on the way, so
+   the 214s wrap of the CP0 Count does not show as long as no more than
+   that passes between two entries in the capture.
+
+   A post is matched to the first dispatch of the same event and param to
+   the same service after it, which is the queue's order for
+   ES_PostToService and ES_PostAll. Events posted with
+   ES_PostToServiceLIFO can be matched out of turn.
+****************************************************************************/
+/*----------------------------- Include Files -----------------------------*/
+#include <ctype.h>
+#include <stdarg.h>
+#include <stdbool.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include "binlog.h"
+#undef printf // dbprintf.h sends it to DB_printf
+
+/*----------------------------- Module Defines ----------------------------*/
+#define MAX_FRAME          256
+#define MAX_SERVICES       16
+#define MAX_EVENT_TYPES    256
+#define MAX_NAME           48
+#define MAX_PENDING        32      // posts waiting in one queue
+#define MAX_SOURCE         65536
+#define CORE_COUNTS_PER_US 20.0
+#define CONFIGURE_FILE     "FrameworkHeaders/ES_Configure.h"
+
+// as TraceWhat_t in ES_Framework.c
+typedef enum
+{
+  TRACE_POST,
+  TRACE_DROP,
+  TRACE_START,
+  TRACE_END,
+  TRACE_GAP
+} TraceWhat_t;
+
+typedef struct
+{
+  uint64_t Ticks;
+  uint32_t EventType;
+  uint32_t EventParam;
+} Post_t;
+
+typedef struct
+{
+  Post_t Pending[MAX_PENDING];  // posted and not yet run, oldest first
+  uint8_t NumPending;
+  bool IsRunning;
+  uint64_t StartTicks;          // of the call under way
+  uint64_t WaitTicks;           // that its event spent in the queue
+  bool IsWaitKnown;
+  bool IsSeen;
+  // for the summary
+  uint32_t NumCalls;
+  uint64_t RunTicks;
+  uint64_t MaxRunTicks;
+  uint32_t NumWaits;
+  uint64_t WaitTotal;
+  uint64_t MaxWaitTicks;
+  uint32_t NumDropped;
+} Service_t;
+
+/*---------------------------- Module Functions ---------------------------*/
+static void readNames(const char *pRoot);
+static void readEventNames(const char *pSource);
+static void decodeStream(FILE *pIn);
+static void decodeFrame(const uint8_t *pFrame, size_t Length);
+static void addEntry(uint32_t Index, uint32_t Stamp, uint32_t WhatService,
+                     uint32_t EventType, uint32_t EventParam);
+static void markLost(uint32_t NumLost);
+static void printEvent(const char *pPhase, uint32_t Service, uint64_t Ticks,
+                       const char *pFormat, ...);
+static const char *eventName(uint32_t EventType);
+static size_t unCOBS(const uint8_t *pIn, size_t Length, uint8_t *pOut);
+static bool getVarint(const uint8_t **ppIn, const uint8_t *pEnd,
+                      uint32_t *pValue);
+
+/*---------------------------- Module Variables ---------------------------*/
+static char ServiceNames[MAX_SERVICES][MAX_NAME];
+static char EventNames[MAX_EVENT_TYPES][MAX_NAME];
+static Service_t Services[MAX_SERVICES];
+
+static bool IsFirstEntry = true;
+static uint32_t NextIndex;
+static uint32_t LastStamp;
+static uint64_t NowTicks;       // of the last entry, from the first
+static uint32_t NumEntries;
+static uint32_t NumLost;
+static uint32_t NumBad;
+static uint32_t NumAsync;       // ids for the queue waits
+static bool IsFirstEvent = true;
+
+/*------------------------------ Module Code ------------------------------*/
+int main(int argc, char *argv[])
+{
+  FILE *pIn = stdin;
+  const char *pRoot = ".";
+  const Service_t *pService;
+  uint32_t i;
+  int Opt;
+
+  while ((Opt = getopt(argc, argv, "r:")) != -1)
+  {
+    switch (Opt)
+    {
+      case 'r': pRoot = optarg; break;
+      default:
+        fprintf(stderr, "usage: %s [-r source_root] [capture]\n", argv[0]);
+        return 1;
+    }
+  }
+  if (optind < argc)
+  {
+    pIn = fopen(argv[optind], "rb");
+    if (NULL == pIn)
+    {
+      perror(argv[optind]);
+      return 1;
+    }
+  }
+  readNames(pRoot);
+
+  printf("{\"displayTimeUnit\":\"ns\",\"traceEvents\":[\n");
+  decodeStream(pIn);
+  for (i = 0; i < MAX_SERVICES; i++)
+  {
+    if (true == Services[i].IsSeen)
+    {
+      printEvent("M", i, 0, "\"name\":\"thread_name\",\"args\":{\"name\":"
+                 "\"%u %s\"}", (unsigned)i, ServiceNames[i]);
+      printEvent("M", i, 0, "\"name\":\"thread_sort_index\",\"args\":"
+                 "{\"sort_index\":%d}", -(int)i);
+    }
+  }
+  printf("\n]}\n");
+
+  fprintf(stderr, "%u entries, %u lost, %u bad frames, %.3f ms\n",
+          (unsigned)NumEntries, (unsigned)NumLost, (unsigned)NumBad,
+          NowTicks / CORE_COUNTS_PER_US / 1000.0);
+  fprintf(stderr, "%-24s %6s %9s %9s %9s %9s %5s\n", "service", "calls",
+          "mean_us", "max_us", "wait_us", "max_wait", "drops");
+  for (i = 0; i < MAX_SERVICES; i++)
+  {
+    pService = &Services[i];
+    if (true == pService->IsSeen)
+    {
+      fprintf(stderr, "%-24s %6u %9.1f %9.1f %9.1f %9.1f %5u\n",
+              ServiceNames[i], (unsigned)pService->NumCalls,
+              (0 == pService->NumCalls) ? 0.0 : pService->RunTicks /
+              CORE_COUNTS_PER_US / pService->NumCalls,
+              pService->MaxRunTicks / CORE_COUNTS_PER_US,
+              (0 == pService->NumWaits) ? 0.0 : pService->WaitTotal /
+              CORE_COUNTS_PER_US / pService->NumWaits,
+              pService->MaxWaitTicks / CORE_COUNTS_PER_US,
+              (unsigned)pService->NumDropped);
+    }
+  }
+  return 0;
+}
+
+/*--------------------------- private functions ---------------------------*/
+// the SERV_n_RUN names and the event types from ES_Configure.h, or numbers
+// if it cannot be read
+static void readNames(const char *pRoot)
+{
+  static char Source[MAX_SOURCE];
+  char Path[1024];
+  const char *pLine;
+  FILE *pFile;
+  size_t Length;
+  unsigned Service;
+  char Name[MAX_NAME];
+  uint32_t i;
+
+  for (i = 0; i < MAX_SERVICES; i++)
+  {
+    snprintf(ServiceNames[i], MAX_NAME, "service %u", (unsigned)i);
+  }
+  for (i = 0; i < MAX_EVENT_TYPES; i++)
+  {
+    snprintf(EventNames[i], MAX_NAME, "event %u", (unsigned)i);
+  }
+  snprintf(Path, sizeof(Path), "%s/%s", pRoot, CONFIGURE_FILE);
+  pFile = fopen(Path, "r");
+  if (NULL == pFile)
+  {
+    perror(Path);
+    return;
+  }
+  Length = fread(Source, 1, MAX_SOURCE - 1, pFile);
+  fclose(pFile);
+  Source[Length] = 0;
+
+  for (pLine = Source; NULL != pLine; pLine = strchr(pLine, '\n'))
+  {
+    while ('\n' == *pLine)
+    {
+      pLine++;
+    }
+    if ((2 == sscanf(pLine, " #define SERV_%u_RUN %47s", &Service, Name)) &&
+        (Service < MAX_SERVICES))
+    {
+      snprintf(ServiceNames[Service], MAX_NAME, "%s", Name);
+    }
+  }
+  readEventNames(Source);
+}
+
+// the names in the enum that ends in ES_EventType_t, in order, with any
+// comments and explicit values taken into account
+static void readEventNames(const char *pSource)
+{
+  const char *pEnd = strstr(pSource, "}ES_EventType_t");
+  const char *pIn;
+  char Name[MAX_NAME];
+  size_t Length;
+  long Value = 0;
+
+  if (NULL == pEnd)
+  {
+    pEnd = strstr(pSource, "} ES_EventType_t");
+  }
+  if (NULL == pEnd)
+  {
+    return;
+  }
+  for (pIn = pEnd; (pIn > pSource) && ('{' != *pIn); pIn--)
+  {
+  }
+  while (++pIn < pEnd)
+  {
+    if (('/' == pIn[0]) && ('*' == pIn[1]))
+    {
+      pIn = strstr(pIn + 2, "*/");
+      if ((NULL == pIn) || (pIn > pEnd))
+      {
+        return;
+      }
+      pIn++;
+    }
+    else if (('/' == pIn[0]) && ('/' == pIn[1]))
+    {
+      while ((pIn < pEnd) && ('\n' != *pIn))
+      {
+        pIn++;
+      }
+    }
+    else if (isalpha((unsigned char)*pIn) || ('_' == *pIn))
+    {
+      for (Length = 0; (isalnum((unsigned char)pIn[Length]) ||
+                        ('_' == pIn[Length])) && (Length < MAX_NAME - 1);
+           Length++)
+      {
+        Name[Length] = pIn[Length];
+      }
+      Name[Length] = 0;
+      pIn += Length;
+      while (isspace((unsigned char)*pIn))
+      {
+        pIn++;
+      }
+      if ('=' == *pIn)
+      {
+        Value = strtol(pIn + 1, NULL, 0);
+      }
+      if ((Value >= 0) && (Value < MAX_EVENT_TYPES))
+      {
+        snprintf(EventNames[Value], MAX_NAME, "%s", Name);
+      }
+      Value++;
+      // on to the comma, or the end
+      while ((pIn < pEnd) && (',' != *pIn))
+      {
+        pIn++;
+      }
+    }
+  }
+}
+
+// as BinLog_Decode: text until a zero, a frame until the next
+static void decodeStream(FILE *pIn)
+{
+  uint8_t Frame[MAX_FRAME];
+  size_t Length = 0;
+  bool IsInFrame = false;
+  int c;
+
+  while (EOF != (c = getc(pIn)))
+  {
+    if (false == IsInFrame)
+    {
+      if (0 == c)
+      {
+        IsInFrame = true;
+        Length = 0;
+      }
+    }
+    else if (0 == c)
+    {
+      if (0 != Length)
+      {
+        decodeFrame(Frame, Length);
+        IsInFrame = false;
+      }
+    }
+    else if (Length < MAX_FRAME)
+    {
+      Frame[Length++] = (uint8_t)c;
+    }
+  }
+}
+
+static void decodeFrame(const uint8_t *pFrame, size_t Length)
+{
+  uint8_t Payload[MAX_FRAME];
+  size_t PayloadLength = unCOBS(pFrame, Length, Payload);
+  const uint8_t *pIn = &Payload[6];
+  const uint8_t *pEnd = &Payload[PayloadLength];
+  uint32_t Stamp;
+  uint32_t Index;
+  uint32_t DumpEnd;
+  uint32_t Delta;
+  uint32_t WhatService;
+  uint32_t EventType;
+  uint32_t EventParam;
+
+  if ((PayloadLength < 6) ||
+      (BINLOG_SITE_TRACE != (Payload[0] | (Payload[1] << 8))))
+  {
+    return;                    // other records, or not a frame at all
+  }
+  Stamp = Payload[2] | (Payload[3] << 8) | (Payload[4] << 16) |
+          ((uint32_t)Payload[5] << 24);
+  if (!getVarint(&pIn, pEnd, &Index) || !getVarint(&pIn, pEnd, &DumpEnd))
+  {
+    NumBad++;
+    return;
+  }
+  while (pIn < pEnd)
+  {
+    if (!getVarint(&pIn, pEnd, &Delta) ||
+        !getVarint(&pIn, pEnd, &WhatService) ||
+        !getVarint(&pIn, pEnd, &EventType) ||
+        !getVarint(&pIn, pEnd, &EventParam) || (Index == DumpEnd))
+    {
+      NumBad++;
+      return;
+    }
+    Stamp += Delta;
+    addEntry(Index++, Stamp, WhatService, EventType, EventParam);
+  }
+}
+
+static void addEntry(uint32_t Index, uint32_t Stamp, uint32_t WhatService,
+                     uint32_t EventType, uint32_t EventParam)
+{
+  uint32_t Which = WhatService & 0x0F;
+  Service_t *pService = &Services[Which];
+  uint64_t RunTicks;
+  uint8_t i;
+
+  if (false == IsFirstEntry)
+  {
+    if ((int32_t)(Index - NextIndex) < 0)
+    {
+      return;                  // sent in an earlier dump
+    }
+    NowTicks += (uint32_t)(Stamp - LastStamp);
+    if (Index != NextIndex)
+    {
+      markLost(Index - NextIndex);
+    }
+  }
+  IsFirstEntry = false;
+  NextIndex = Index + 1;
+  LastStamp = Stamp;
+  NumEntries++;
+  pService->IsSeen = true;
+
+  switch (WhatService >> 4)
+  {
+    case TRACE_POST:
+      if (pService->NumPending == MAX_PENDING)
+      {
+        memmove(&pService->Pending[0], &pService->Pending[1],
+                sizeof(Post_t) * (MAX_PENDING - 1));
+        pService->NumPending--;
+      }
+      pService->Pending[pService->NumPending].Ticks = NowTicks;
+      pService->Pending[pService->NumPending].EventType = EventType;
+      pService->Pending[pService->NumPending].EventParam = EventParam;
+      pService->NumPending++;
+      break;
+
+    case TRACE_DROP:
+      pService->NumDropped++;
+      printEvent("i", Which, NowTicks, "\"name\":\"DROP %s\",\"s\":\"t\","
+                 "\"args\":{\"param\":\"0x%x\"}", eventName(EventType),
+                 (unsigned)EventParam);
+      break;
+
+    case TRACE_START:
+      pService->IsRunning = true;
+      pService->StartTicks = NowTicks;
+      pService->IsWaitKnown = false;
+      for (i = 0; i < pService->NumPending; i++)
+      {
+        if ((pService->Pending[i].EventType == EventType) &&
+            (pService->Pending[i].EventParam == EventParam))
+        {
+          pService->WaitTicks = NowTicks - pService->Pending[i].Ticks;
+          pService->IsWaitKnown = true;
+          pService->NumWaits++;
+          pService->WaitTotal += pService->WaitTicks;
+          if (pService->WaitTicks > pService->MaxWaitTicks)
+          {
+            pService->MaxWaitTicks = pService->WaitTicks;
+          }
+          NumAsync++;
+          printEvent("b", Which, pService->Pending[i].Ticks,
+                     "\"name\":\"%s\",\"cat\":\"queue\",\"id\":%u",
+                     eventName(EventType), (unsigned)NumAsync);
+          printEvent("e", Which, NowTicks,
+                     "\"name\":\"%s\",\"cat\":\"queue\",\"id\":%u",
+                     eventName(EventType), (unsigned)NumAsync);
+          pService->NumPending--;
+          memmove(&pService->Pending[i], &pService->Pending[i + 1],
+                  sizeof(Post_t) * (pService->NumPending - i));
+          break;
+        }
+      }
+      break;
+
+    case TRACE_END:
+      if (false == pService->IsRunning)
+      {
+        break;                 // started before the trace
+      }
+      pService->IsRunning = false;
+      RunTicks = NowTicks - pService->StartTicks;
+      pService->NumCalls++;
+      pService->RunTicks += RunTicks;
+      if (RunTicks > pService->MaxRunTicks)
+      {
+        pService->MaxRunTicks = RunTicks;
+      }
+      if (true == pService->IsWaitKnown)
+      {
+        printEvent("X", Which, pService->StartTicks, "\"name\":\"%s\","
+                   "\"dur\":%.2f,\"args\":{\"param\":\"0x%x\",\"wait_us\":"
+                   "%.2f}", eventName(EventType),
+                   RunTicks / CORE_COUNTS_PER_US, (unsigned)EventParam,
+                   pService->WaitTicks / CORE_COUNTS_PER_US);
+      }
+      else
+      {
+        printEvent("X", Which, pService->StartTicks, "\"name\":\"%s\","
+                   "\"dur\":%.2f,\"args\":{\"param\":\"0x%x\"}",
+                   eventName(EventType), RunTicks / CORE_COUNTS_PER_US,
+                   (unsigned)EventParam);
+      }
+      break;
+
+    case TRACE_GAP:
+      markLost(EventParam);
+      break;
+
+    default:
+      NumBad++;
+      break;
+  }
+}
+
+// forgets the posts and calls the missing entries would have finished
+static void markLost(uint32_t NumMissing)
+{
+  uint32_t i;
+
+  NumLost += NumMissing;
+  printf("%s{\"name\":\"%u entries lost\",\"ph\":\"i\",\"s\":\"g\","
+         "\"pid\":1,\"tid\":0,\"ts\":%.2f}", IsFirstEvent ? "" : ",\n",
+         (unsigned)NumMissing, NowTicks / CORE_COUNTS_PER_US);
+  IsFirstEvent = false;
+  for (i = 0; i < MAX_SERVICES; i++)
+  {
+    Services[i].NumPending = 0;
+    Services[i].IsRunning = false;
+  }
+}
+
+// one trace event; pFormat gives the fields after ph, pid, tid and ts
+static void printEvent(const char *pPhase, uint32_t Service, uint64_t Ticks,
+                       const char *pFormat, ...)
+{
+  va_list Args;
+
+  printf("%s{\"ph\":\"%s\",\"pid\":1,\"tid\":%u,\"ts\":%.2f,",
+         IsFirstEvent ? "" : ",\n", pPhase, (unsigned)Service,
+         Ticks / CORE_COUNTS_PER_US);
+  IsFirstEvent = false;
+  va_start(Args, pFormat);
+  vprintf(pFormat, Args);
+  va_end(Args);
+  putchar('}');
+}
+
+static const char *eventName(uint32_t EventType)
+{
+  return (EventType < MAX_EVENT_TYPES) ? EventNames[EventType] : "event ?";
+}
+
+// returns the decoded length, 0 if the frame is malformed
+static size_t unCOBS(const uint8_t *pIn, size_t Length, uint8_t *pOut)
+{
+  size_t In = 0;
+  size_t Out = 0;
+  uint8_t Code;
+  uint8_t i;
+
+  while (In < Length)
+  {
+    Code = pIn[In++];
+    if ((0 == Code) || (In + Code - 1 > Length))
+    {
+      return 0;
+    }
+    for (i = 1; i < Code; i++)
+    {
+      pOut[Out++] = pIn[In++];
+    }
+    if ((Code < 0xFF) && (In < Length))
+    {
+      pOut[Out++] = 0;
+    }
+  }
+  return Out;
+}
+
+static bool getVarint(const uint8_t **ppIn, const uint8_t *pEnd,
+                      uint32_t *pValue)
+{
+  uint32_t ZigZag = 0;
+  uint8_t Shift = 0;
+  uint8_t Byte;
+
+  do
+  {
+    if ((*ppIn >= pEnd) || (Shift > 28))
+    {
+      return false;
+    }
+    Byte = *(*ppIn)++;
+    ZigZag |= (uint32_t)(Byte & 0x7F) << Shift;
+    Shift += 7;
+  } while (0 != (Byte & 0x80));
+  *pValue = (ZigZag >> 1) ^ (uint32_t)-(int32_t)(ZigZag & 1);
+  return true;
+}
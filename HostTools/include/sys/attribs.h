@@ -0,0 +1,14 @@
+/****************************************************************************
+ Module
+   sys/attribs.h (host build)
+
+ Description
+   On the host an ISR is an ordinary function, called by the peripheral
+   model in HostTools/PIC32_HostModel.c.
+****************************************************************************/
+#ifndef HOST_SYS_ATTRIBS_H
+#define HOST_SYS_ATTRIBS_H
+
+#define __ISR(vector, ...)
+
+#endif /* HOST_SYS_ATTRIBS_H */
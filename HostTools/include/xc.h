@@ -0,0 +1,350 @@
+/****************************************************************************
+ Module
+   xc.h (host build)
+
+ Description
+   Stand-in for the XC32 device header so that firmware modules, and their
+   TEST harnesses, can be compiled with the host gcc. Put HostTools/include
+   ahead of the project headers on the include path.
+
+   Modules that only need the basic types get nothing more. Modules that
+   touch SFRs must be linked with HostTools/PIC32_HostModel.c, which holds
+   the register storage and models the peripherals that have behaviour
+   (currently SPI1 with SS1 on INT4, UART1 transmit, Timer3 and Timer4,
+   change notification on ports A and B, the ADC, the CP0 Count, and the
+   interrupt controller).
+
+ Notes
+   SET/CLR/INV registers are separate write slots that the model folds into
+   their base register at every sync point. Reads of the status registers
+   that firmware polls go through HostModel_Sync so that the peripheral
+   model runs while the firmware spins.
+****************************************************************************/
+#ifndef HOST_XC_H
+#define HOST_XC_H
+
+#include <stdint.h>
+#include <stdbool.h>
+
+/*------------------------- interrupt controller --------------------------*/
+uint32_t HostModel_DisableInts(void);
+void HostModel_EnableInts(void);
+volatile uint32_t *HostModel_Sync(volatile uint32_t *pReg);
+volatile uint32_t *HostModel_SPI1BufSlot(void);
+volatile uint32_t *HostModel_U1TxSlot(void);
+uint32_t HostModel_GetCoreCount(void);
+
+#define __builtin_disable_interrupts() HostModel_DisableInts()
+#define __builtin_enable_interrupts()  HostModel_EnableInts()
+#define _CP0_GET_COUNT()               HostModel_GetCoreCount()
+#define _CP0_STATUS_IE_MASK            0x00000001
+
+#define HOST_SFR(name) \
+  extern volatile uint32_t name, name##SET, name##CLR, name##INV;
+
+HOST_SFR(INTCON)
+HOST_SFR(IFS0)
+HOST_SFR(IFS1)
+HOST_SFR(IEC0)
+HOST_SFR(IEC1)
+HOST_SFR(IPC0)
+HOST_SFR(IPC2)
+HOST_SFR(IPC3)
+HOST_SFR(IPC4)
+HOST_SFR(IPC5)
+HOST_SFR(IPC7)
+HOST_SFR(IPC8)
+
+// the bits views alias the uint32_t registers, so they are may_alias to
+// stay correct, and quiet, under -O2's strict aliasing
+typedef struct {
+  unsigned INT0EP:1; unsigned INT1EP:1; unsigned INT2EP:1; unsigned INT3EP:1;
+  unsigned INT4EP:1; unsigned :3; unsigned TPC:3; unsigned :1;
+  unsigned MVEC:1; unsigned :19;
+} __attribute__((may_alias)) __INTCONbits_t;
+
+typedef struct {
+  unsigned CTIF:1; unsigned CS0IF:1; unsigned CS1IF:1; unsigned INT0IF:1;
+  unsigned T1IF:1; unsigned IC1EIF:1; unsigned IC1IF:1; unsigned OC1IF:1;
+  unsigned INT1IF:1; unsigned T2IF:1; unsigned IC2EIF:1; unsigned IC2IF:1;
+  unsigned OC2IF:1; unsigned INT2IF:1; unsigned T3IF:1; unsigned IC3EIF:1;
+  unsigned IC3IF:1; unsigned OC3IF:1; unsigned INT3IF:1; unsigned T4IF:1;
+  unsigned IC4EIF:1; unsigned IC4IF:1; unsigned OC4IF:1; unsigned INT4IF:1;
+  unsigned T5IF:1; unsigned IC5EIF:1; unsigned IC5IF:1; unsigned OC5IF:1;
+  unsigned AD1IF:1; unsigned FSCMIF:1; unsigned RTCCIF:1; unsigned FCEIF:1;
+} __attribute__((may_alias)) __IFS0bits_t;
+
+typedef struct {
+  unsigned CTIE:1; unsigned CS0IE:1; unsigned CS1IE:1; unsigned INT0IE:1;
+  unsigned T1IE:1; unsigned IC1EIE:1; unsigned IC1IE:1; unsigned OC1IE:1;
+  unsigned INT1IE:1; unsigned T2IE:1; unsigned IC2EIE:1; unsigned IC2IE:1;
+  unsigned OC2IE:1; unsigned INT2IE:1; unsigned T3IE:1; unsigned IC3EIE:1;
+  unsigned IC3IE:1; unsigned OC3IE:1; unsigned INT3IE:1; unsigned T4IE:1;
+  unsigned IC4EIE:1; unsigned IC4IE:1; unsigned OC4IE:1; unsigned INT4IE:1;
+  unsigned T5IE:1; unsigned IC5EIE:1; unsigned IC5IE:1; unsigned OC5IE:1;
+  unsigned AD1IE:1; unsigned FSCMIE:1; unsigned RTCCIE:1; unsigned FCEIE:1;
+} __attribute__((may_alias)) __IEC0bits_t;
+
+typedef struct {
+  unsigned CMP1IF:1; unsigned CMP2IF:1; unsigned CMP3IF:1; unsigned USBIF:1;
+  unsigned SPI1EIF:1; unsigned SPI1RXIF:1; unsigned SPI1TXIF:1; unsigned U1EIF:1;
+  unsigned U1RXIF:1; unsigned U1TXIF:1; unsigned I2C1BIF:1; unsigned I2C1SIF:1;
+  unsigned I2C1MIF:1; unsigned CNAIF:1; unsigned CNBIF:1; unsigned CNCIF:1;
+  unsigned PMPIF:1; unsigned PMPEIF:1; unsigned SPI2EIF:1; unsigned SPI2RXIF:1;
+  unsigned SPI2TXIF:1; unsigned U2EIF:1; unsigned U2RXIF:1; unsigned U2TXIF:1;
+  unsigned I2C2BIF:1; unsigned I2C2SIF:1; unsigned I2C2MIF:1; unsigned CTMUIF:1;
+  unsigned DMA0IF:1; unsigned DMA1IF:1; unsigned DMA2IF:1; unsigned DMA3IF:1;
+} __attribute__((may_alias)) __IFS1bits_t;
+
+typedef struct {
+  unsigned CMP1IE:1; unsigned CMP2IE:1; unsigned CMP3IE:1; unsigned USBIE:1;
+  unsigned SPI1EIE:1; unsigned SPI1RXIE:1; unsigned SPI1TXIE:1; unsigned U1EIE:1;
+  unsigned U1RXIE:1; unsigned U1TXIE:1; unsigned I2C1BIE:1; unsigned I2C1SIE:1;
+  unsigned I2C1MIE:1; unsigned CNAIE:1; unsigned CNBIE:1; unsigned CNCIE:1;
+  unsigned PMPIE:1; unsigned PMPEIE:1; unsigned SPI2EIE:1; unsigned SPI2RXIE:1;
+  unsigned SPI2TXIE:1; unsigned U2EIE:1; unsigned U2RXIE:1; unsigned U2TXIE:1;
+  unsigned I2C2BIE:1; unsigned I2C2SIE:1; unsigned I2C2MIE:1; unsigned CTMUIE:1;
+  unsigned DMA0IE:1; unsigned DMA1IE:1; unsigned DMA2IE:1; unsigned DMA3IE:1;
+} __attribute__((may_alias)) __IEC1bits_t;
+
+typedef struct { unsigned CS0IS:2; unsigned CS0IP:3; unsigned :3; unsigned CS1IS:2;
+  unsigned CS1IP:3; unsigned :3; unsigned CTIS:2; unsigned CTIP:3; unsigned :11;
+} __attribute__((may_alias)) __IPC0bits_t;
+typedef struct { unsigned T4IS:2; unsigned T4IP:3; unsigned :19;
+  unsigned INT4IS:2; unsigned INT4IP:3; unsigned :3;
+} __attribute__((may_alias)) __IPC4bits_t;
+typedef struct { unsigned :24; unsigned AD1IS:2; unsigned AD1IP:3; unsigned :3;
+} __attribute__((may_alias)) __IPC5bits_t;
+typedef struct { unsigned :24; unsigned SPI1IS:2; unsigned SPI1IP:3; unsigned :3;
+} __attribute__((may_alias)) __IPC7bits_t;
+typedef struct { unsigned U1IS:2; unsigned U1IP:3; unsigned :11;
+  unsigned CNIS:2; unsigned CNIP:3; unsigned :11;
+} __attribute__((may_alias)) __IPC8bits_t;
+typedef struct { unsigned T2IS:2; unsigned T2IP:3; unsigned :27;
+} __attribute__((may_alias)) __IPC2bits_t;
+typedef struct { unsigned T3IS:2; unsigned T3IP:3; unsigned :27;
+} __attribute__((may_alias)) __IPC3bits_t;
+
+#define INTCONbits (*(volatile __INTCONbits_t *)&INTCON)
+#define IFS0bits   (*(volatile __IFS0bits_t *)HostModel_Sync(&IFS0))
+#define IFS1bits   (*(volatile __IFS1bits_t *)HostModel_Sync(&IFS1))
+#define IEC0bits   (*(volatile __IEC0bits_t *)&IEC0)
+#define IEC1bits   (*(volatile __IEC1bits_t *)&IEC1)
+#define IPC0bits   (*(volatile __IPC0bits_t *)&IPC0)
+#define IPC2bits   (*(volatile __IPC2bits_t *)&IPC2)
+#define IPC3bits   (*(volatile __IPC3bits_t *)&IPC3)
+#define IPC4bits   (*(volatile __IPC4bits_t *)&IPC4)
+#define IPC5bits   (*(volatile __IPC5bits_t *)&IPC5)
+#define IPC7bits   (*(volatile __IPC7bits_t *)&IPC7)
+#define IPC8bits   (*(volatile __IPC8bits_t *)&IPC8)
+
+#define _IFS0_CTIF_MASK     0x00000001
+#define _IFS0_INT1IF_MASK   0x00000100
+#define _IFS0_T2IF_MASK     0x00000200
+#define _IFS0_T3IF_MASK     0x00004000
+#define _IEC0_T3IE_MASK     0x00004000
+#define _IFS0_T4IF_MASK     0x00080000
+#define _IEC0_T4IE_MASK     0x00080000
+#define _IFS0_INT4IF_MASK   0x00800000
+#define _IEC0_INT4IE_MASK   0x00800000
+#define _IFS0_AD1IF_MASK    0x10000000
+#define _IEC0_AD1IE_MASK    0x10000000
+#define _IFS1_SPI1TXIF_MASK 0x00000040
+#define _IEC1_SPI1TXIE_MASK 0x00000040
+#define _IFS1_U1TXIF_MASK   0x00000200
+#define _IEC1_U1TXIE_MASK   0x00000200
+#define _IFS1_CNAIF_MASK    0x00002000
+#define _IFS1_CNBIF_MASK    0x00004000
+#define _IEC1_CNAIE_MASK    0x00002000
+#define _IEC1_CNBIE_MASK    0x00004000
+
+/*------------------------------- I/O ports --------------------------------*/
+HOST_SFR(TRISA)
+HOST_SFR(TRISB)
+HOST_SFR(LATA)
+HOST_SFR(LATB)
+HOST_SFR(PORTA)
+HOST_SFR(PORTB)
+HOST_SFR(ANSELA)
+HOST_SFR(ANSELB)
+HOST_SFR(CNCONA)
+HOST_SFR(CNCONB)
+HOST_SFR(CNENA)
+HOST_SFR(CNENB)
+HOST_SFR(CNSTATA)
+HOST_SFR(CNSTATB)
+
+extern volatile uint32_t RPA0R, RPA1R, RPA2R, RPA3R, RPA4R;
+extern volatile uint32_t RPB0R, RPB1R, RPB2R, RPB3R, RPB4R, RPB5R, RPB6R,
+  RPB7R, RPB8R, RPB9R, RPB10R, RPB11R, RPB12R, RPB13R, RPB14R, RPB15R;
+extern volatile uint32_t INT1R, INT4R, SDI1R, SDI2R, SS1R, SS2R, U1RXR;
+
+typedef struct {
+  unsigned LATB0:1; unsigned LATB1:1; unsigned LATB2:1; unsigned LATB3:1;
+  unsigned LATB4:1; unsigned LATB5:1; unsigned LATB6:1; unsigned LATB7:1;
+  unsigned LATB8:1; unsigned LATB9:1; unsigned LATB10:1; unsigned LATB11:1;
+  unsigned LATB12:1; unsigned LATB13:1; unsigned LATB14:1; unsigned LATB15:1;
+  unsigned :16;
+} __attribute__((may_alias)) __LATBbits_t;
+
+typedef struct {
+  unsigned TRISB0:1; unsigned TRISB1:1; unsigned TRISB2:1; unsigned TRISB3:1;
+  unsigned TRISB4:1; unsigned TRISB5:1; unsigned TRISB6:1; unsigned TRISB7:1;
+  unsigned TRISB8:1; unsigned TRISB9:1; unsigned TRISB10:1; unsigned TRISB11:1;
+  unsigned TRISB12:1; unsigned TRISB13:1; unsigned TRISB14:1; unsigned TRISB15:1;
+  unsigned :16;
+} __attribute__((may_alias)) __TRISBbits_t;
+
+#define LATBbits  (*(volatile __LATBbits_t *)&LATB)
+#define TRISBbits (*(volatile __TRISBbits_t *)&TRISB)
+
+/*------------------------- timers, output compare -------------------------*/
+HOST_SFR(T2CON)
+HOST_SFR(T3CON)
+HOST_SFR(TMR2)
+HOST_SFR(TMR3)
+HOST_SFR(PR2)
+HOST_SFR(PR3)
+HOST_SFR(T4CON)
+HOST_SFR(TMR4)
+HOST_SFR(PR4)
+HOST_SFR(OC1CON)
+HOST_SFR(OC1R)
+HOST_SFR(OC1RS)
+
+typedef struct {
+  unsigned :1; unsigned TCS:1; unsigned :1; unsigned T32:1;
+  unsigned TCKPS:3; unsigned TGATE:1; unsigned :5; unsigned SIDL:1;
+  unsigned :1; unsigned ON:1; unsigned :16;
+} __attribute__((may_alias)) __T2CONbits_t;
+
+typedef struct {
+  unsigned OCM:3; unsigned OCTSEL:1; unsigned OCFLT:1; unsigned OC32:1;
+  unsigned :7; unsigned SIDL:1; unsigned :1; unsigned ON:1; unsigned :16;
+} __attribute__((may_alias)) __OC1CONbits_t;
+
+#define T2CONbits  (*(volatile __T2CONbits_t *)&T2CON)
+#define T3CONbits  (*(volatile __T2CONbits_t *)&T3CON)
+#define T4CONbits  (*(volatile __T2CONbits_t *)&T4CON)
+#define OC1CONbits (*(volatile __OC1CONbits_t *)&OC1CON)
+
+/*---------------------------------- ADC -----------------------------------*/
+HOST_SFR(AD1CON1)
+HOST_SFR(AD1CON2)
+HOST_SFR(AD1CON3)
+HOST_SFR(AD1CHS)
+HOST_SFR(AD1CSSL)
+
+// the result buffers are 16 bytes apart, as on the part
+extern volatile uint32_t HostADC1BUF[16 * 4];
+#define ADC1BUF0 HostADC1BUF[0 * 4]
+#define ADC1BUF1 HostADC1BUF[1 * 4]
+#define ADC1BUF2 HostADC1BUF[2 * 4]
+#define ADC1BUF3 HostADC1BUF[3 * 4]
+#define ADC1BUF4 HostADC1BUF[4 * 4]
+#define ADC1BUF5 HostADC1BUF[5 * 4]
+#define ADC1BUF6 HostADC1BUF[6 * 4]
+#define ADC1BUF7 HostADC1BUF[7 * 4]
+#define ADC1BUF8 HostADC1BUF[8 * 4]
+#define ADC1BUF9 HostADC1BUF[9 * 4]
+#define ADC1BUFA HostADC1BUF[10 * 4]
+#define ADC1BUFB HostADC1BUF[11 * 4]
+#define ADC1BUFC HostADC1BUF[12 * 4]
+#define ADC1BUFD HostADC1BUF[13 * 4]
+#define ADC1BUFE HostADC1BUF[14 * 4]
+#define ADC1BUFF HostADC1BUF[15 * 4]
+
+typedef struct {
+  unsigned DONE:1; unsigned SAMP:1; unsigned ASAM:1; unsigned :1;
+  unsigned CLRASAM:1; unsigned SSRC:3; unsigned FORM:3; unsigned :2;
+  unsigned SIDL:1; unsigned :1; unsigned ON:1; unsigned :16;
+} __attribute__((may_alias)) __AD1CON1bits_t;
+
+typedef struct {
+  unsigned BUFM:1; unsigned ALTS:1; unsigned SMPI:4; unsigned :1;
+  unsigned BUFS:1; unsigned :2; unsigned CSCNA:1; unsigned :1;
+  unsigned OFFCAL:1; unsigned VCFG:3; unsigned :16;
+} __attribute__((may_alias)) __AD1CON2bits_t;
+
+typedef struct {
+  unsigned ADCS:8; unsigned SAMC:5; unsigned :2; unsigned ADRC:1;
+  unsigned :16;
+} __attribute__((may_alias)) __AD1CON3bits_t;
+
+#define AD1CON1bits (*(volatile __AD1CON1bits_t *)&AD1CON1)
+#define AD1CON2bits (*(volatile __AD1CON2bits_t *)&AD1CON2)
+#define AD1CON3bits (*(volatile __AD1CON3bits_t *)&AD1CON3)
+
+/*--------------------------------- UART -----------------------------------*/
+HOST_SFR(U1MODE)
+HOST_SFR(U1STA)
+HOST_SFR(U1BRG)
+extern volatile uint32_t U1RXREG;
+extern int __XC_UART; // which UART the XC32 library's stdio uses
+
+typedef struct {
+  unsigned STSEL:1; unsigned PDSEL:2; unsigned BRGH:1; unsigned RXINV:1;
+  unsigned ABAUD:1; unsigned LPBACK:1; unsigned WAKE:1; unsigned UEN:2;
+  unsigned :1; unsigned RTSMD:1; unsigned IREN:1; unsigned SIDL:1;
+  unsigned :1; unsigned ON:1; unsigned :16;
+} __attribute__((may_alias)) __U1MODEbits_t;
+
+typedef struct {
+  unsigned URXDA:1; unsigned OERR:1; unsigned FERR:1; unsigned PERR:1;
+  unsigned RIDLE:1; unsigned ADDEN:1; unsigned URXISEL:2; unsigned TRMT:1;
+  unsigned UTXBF:1; unsigned UTXEN:1; unsigned UTXBRK:1; unsigned URXEN:1;
+  unsigned UTXINV:1; unsigned UTXISEL:2; unsigned :16;
+} __attribute__((may_alias)) __U1STAbits_t;
+
+// a fresh write slot for every evaluation, as for SPI1BUF below
+#define U1TXREG (*HostModel_U1TxSlot())
+
+#define U1MODEbits (*(volatile __U1MODEbits_t *)&U1MODE)
+#define U1STAbits  (*(volatile __U1STAbits_t *)HostModel_Sync(&U1STA))
+
+/*---------------------------------- SPI -----------------------------------*/
+HOST_SFR(SPI1CON)
+HOST_SFR(SPI1CON2)
+HOST_SFR(SPI1STAT)
+HOST_SFR(SPI1BRG)
+HOST_SFR(SPI2CON)
+HOST_SFR(SPI2CON2)
+HOST_SFR(SPI2STAT)
+HOST_SFR(SPI2BRG)
+extern volatile uint32_t SPI2BUF;
+
+typedef struct {
+  unsigned SRXISEL:2; unsigned STXISEL:2; unsigned DISSDI:1; unsigned MSTEN:1;
+  unsigned CKP:1; unsigned SSEN:1; unsigned CKE:1; unsigned SMP:1;
+  unsigned MODE16:1; unsigned MODE32:1; unsigned DISSDO:1; unsigned SIDL:1;
+  unsigned :1; unsigned ON:1; unsigned ENHBUF:1; unsigned SPIFE:1;
+  unsigned :5; unsigned MCLKSEL:1; unsigned FRMCNT:3; unsigned FRMSYPW:1;
+  unsigned MSSEN:1; unsigned FRMPOL:1; unsigned FRMSYNC:1; unsigned FRMEN:1;
+} __attribute__((may_alias)) __SPI1CONbits_t;
+
+typedef struct {
+  unsigned AUDMOD:2; unsigned :1; unsigned AUDMONO:1; unsigned :3;
+  unsigned AUDEN:1; unsigned IGNTUR:1; unsigned IGNROV:1; unsigned SPITUREN:1;
+  unsigned SPIROVEN:1; unsigned FRMERREN:1; unsigned :2; unsigned SPISGNEXT:1;
+  unsigned :16;
+} __attribute__((may_alias)) __SPI1CON2bits_t;
+
+typedef struct {
+  unsigned SPIRBF:1; unsigned SPITBF:1; unsigned :1; unsigned SPITBE:1;
+  unsigned :1; unsigned SPIRBE:1; unsigned SPIROV:1; unsigned SRMT:1;
+  unsigned SPITUR:1; unsigned :2; unsigned SPIBUSY:1; unsigned FRMERR:1;
+  unsigned :3; unsigned TXBUFELM:5; unsigned :3; unsigned RXBUFELM:5;
+  unsigned :3;
+} __attribute__((may_alias)) __SPI1STATbits_t;
+
+// every evaluation of SPI1BUF gets a fresh write slot, so back to back
+// writes with no register read in between are all seen by the model
+#define SPI1BUF (*HostModel_SPI1BufSlot())
+
+#define SPI1CONbits  (*(volatile __SPI1CONbits_t *)&SPI1CON)
+#define SPI1CON2bits (*(volatile __SPI1CON2bits_t *)&SPI1CON2)
+#define SPI1STATbits (*(volatile __SPI1STATbits_t *)HostModel_Sync(&SPI1STAT))
+#define SPI2CONbits  (*(volatile __SPI1CONbits_t *)&SPI2CON)
+#define SPI2STATbits (*(volatile __SPI1STATbits_t *)&SPI2STAT)
+
+#endif /* HOST_XC_H */
@@ -8,14 +8,29 @@
 #ifndef BuzzService_H
 #define BuzzService_H
 
+#include "ES_Configure.h" /* gets us event definitions */
 #include "ES_Types.h"
 
 // Public Function Prototypes
 
+// Sounds that can be played, post ES_BUZZ with one of these as the EventParam
+typedef enum{
+    BUZZ_NONE,
+    BUZZ_PLANET,
+    BUZZ_ASTEROID,
+    BUZZ_BLACK_HOLE,
+    BUZZ_COIN,
+    BUZZ_START_TUNE,
+    BUZZ_END_TUNE,
+    BUZZ_ZAP,           // sampled sounds, played by PCMPlayer
+    BUZZ_BOOM,
+    BUZZ_CHIME,
+    NUM_BUZZ_SOUNDS
+} BuzzSound_t;
+
 bool InitBuzzService(uint8_t Priority);
 bool PostBuzzService(ES_Event_t ThisEvent);
 ES_Event_t RunBuzzService(ES_Event_t ThisEvent);
-void SoundBuzzer(uint32_t freq, uint32_t duration);
 
 #endif /* ServTemplate_H */
 
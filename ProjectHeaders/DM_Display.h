@@ -9,6 +9,35 @@
 #ifndef DM_DISPLAY_H
 #define	DM_DISPLAY_H
 
+#include <stdint.h>
+#include <stdbool.h>
+
+// Chain configuration. DM_NUM_MODULES MAX7219 modules are daisy chained on
+// SPI1 and split evenly into DM_NUM_DISPLAYS logical displays, numbered from
+// 1. Either can be overridden from the compiler command line.
+#ifndef DM_NUM_MODULES
+#define DM_NUM_MODULES 8
+#endif
+#ifndef DM_NUM_DISPLAYS
+#define DM_NUM_DISPLAYS 2
+#endif
+#define DM_MODULES_PER_DISPLAY (DM_NUM_MODULES / DM_NUM_DISPLAYS)
+#define DM_COLS_PER_DISPLAY (DM_MODULES_PER_DISPLAY * 8)
+
+#if (DM_NUM_MODULES % DM_NUM_DISPLAYS) != 0
+#error DM_NUM_MODULES must split evenly across DM_NUM_DISPLAYS
+#endif
+#if DM_MODULES_PER_DISPLAY > 8
+#error A display row is held in a uint64_t, at most 8 modules per display
+#endif
+
+// intensity register range, and the level set at init
+#define DM_MAX_BRIGHTNESS 15
+#define DM_DEFAULT_BRIGHTNESS 10
+
+// longest message that DM_LoadScrollStrip will render
+#define DM_SCROLL_MAX_CHARS 40
+
 /****************************************************************************
  Function
   DM_TakeInitDisplayStep
@@ -21,7 +50,7 @@
         while there still more steps to be taken
 
  Description
-  Initializes the MAX7219 4-module display performing 1 step for each call:
+  Initializes the MAX7219 module chain performing 1 step for each call:
     First, bring put it in shutdown to disable all displays, return false
     Next fill the display RAM with Zeros to insure blanked, return false
     Then Disable Code B decoding for all digits, return false
@@ -42,7 +71,7 @@ bool DM_TakeInitDisplayStep( void );
   DM_ClearDisplayBuffer
 
  Parameter
-  None
+  uint8_t: The display (1..DM_NUM_DISPLAYS) to be cleared
 
  Returns
  Nothing (void)
@@ -51,7 +80,7 @@ bool DM_TakeInitDisplayStep( void );
   Clears the contents of the display buffer.
    
 Example
-   BDM_ClearDisplayBuffer();
+   DM_ClearDisplayBuffer(1);
 ****************************************************************************/
 void DM_ClearDisplayBuffer( uint8_t WhichDisplay );
 
@@ -61,6 +90,7 @@ void DM_ClearDisplayBuffer( uint8_t WhichDisplay );
 
  Parameter
   uint8_t: The number of Columns to scroll
+  uint8_t: The display (1..DM_NUM_DISPLAYS) to be scrolled
 
  Returns
  Nothing (void)
@@ -70,7 +100,7 @@ void DM_ClearDisplayBuffer( uint8_t WhichDisplay );
   columns.
    
 Example
-   DM_ScrollDisplayBuffer(4);
+   DM_ScrollDisplayBuffer(4, 1);
 ****************************************************************************/
 void DM_ScrollDisplayBuffer( uint8_t NumCols2Scroll, uint8_t WhichDisplay);
 
@@ -94,6 +124,211 @@ Example
 ****************************************************************************/
 bool DM_TakeDisplayUpdateStep( void );
 
+/****************************************************************************
+ Function
+  DM_SetBrightness
+
+ Parameter
+  uint8_t: The intensity (0->DM_MAX_BRIGHTNESS), larger values are clipped
+  uint8_t: The display (1..DM_NUM_DISPLAYS) to set, 0 for all displays
+  
+ Returns
+  bool: true for a legal display number; false otherwise
+
+ Description
+  Records the new intensity. It is sent by the next call to
+  DM_TakeBrightnessUpdateStep, so several displays can change together in
+  a single command frame.
+   
+Example
+   DM_SetBrightness(4, 2);
+   DM_TakeBrightnessUpdateStep();
+****************************************************************************/
+bool DM_SetBrightness( uint8_t Level, uint8_t WhichDisplay );
+
+/****************************************************************************
+ Function
+  DM_GetBrightness
+
+ Parameter
+  uint8_t: The display (1..DM_NUM_DISPLAYS) to query
+  
+ Returns
+  uint8_t: the intensity last set for that display, 0 for an illegal display
+****************************************************************************/
+uint8_t DM_GetBrightness( uint8_t WhichDisplay );
+
+/****************************************************************************
+ Function
+  DM_SetShutdown
+
+ Parameter
+  bool: true to blank the display, false to light it again
+  uint8_t: The display (1..DM_NUM_DISPLAYS) to set, 0 for all displays
+  
+ Returns
+  bool: true for a legal display number; false otherwise
+
+ Description
+  Records the new 0x0C shutdown state. Intensity 0 is only the dimmest
+  level, shutdown is the only way to turn a display fully off. The display
+  RAM and intensity are kept, and the change is sent by the next call to
+  DM_TakeBrightnessUpdateStep.
+   
+Example
+   DM_SetShutdown(true, 1);
+   DM_TakeBrightnessUpdateStep();
+****************************************************************************/
+bool DM_SetShutdown( bool IsShutdown, uint8_t WhichDisplay );
+
+/****************************************************************************
+ Function
+  DM_TakeBrightnessUpdateStep
+
+ Parameter
+  None
+
+ Returns
+  bool: true once no intensity or shutdown change is left to send; false if
+        the SPI1 queue had no room
+
+ Description
+  Sends one 0x0A intensity command to every module, each carrying the level
+  of its own display, then likewise one 0x0C shutdown command, each frame
+  only if something in it changed. No display RAM is re-sent, so an
+  intensity effect costs one command frame per step rather than a full
+  8-row flush.
+   
+Example
+   DM_TakeBrightnessUpdateStep();
+****************************************************************************/
+bool DM_TakeBrightnessUpdateStep( void );
+
+/****************************************************************************
+ Function
+  DM_SetQueuedOutput
+
+ Parameter
+  bool: true to send frames through the SPI1 transaction queue, false to
+        send them with the blocking SPI1 functions (the default)
+  
+ Returns
+  Nothing (void)
+
+ Description
+  With queued output every Take...Step function returns as soon as its frame
+  is queued. A step whose frame does not fit is not taken, and reports that
+  work remains, so it can be retried once the queue drains. SPIQueue_SPI1_Init
+  must have been called first.
+   
+Example
+   SPIQueue_SPI1_Init(MyDoneFunction);
+   DM_SetQueuedOutput(true);
+****************************************************************************/
+void DM_SetQueuedOutput( bool IsQueued );
+
+/****************************************************************************
+ Function
+  DM_TakeDirtyRowUpdateStep
+
+ Parameter
+  None
+
+ Returns
+  bool: true when no changed rows remain to be sent; false otherwise
+
+ Description
+  Sends the next row that has changed since it was last sent to the MAX7219
+  controllers, 1 row per call. Rows that did not change are skipped.
+   
+Example
+   while (false == DM_TakeDirtyRowUpdateStep())
+   {} // note this example is for non-event-driven code
+****************************************************************************/
+bool DM_TakeDirtyRowUpdateStep( void );
+
+/****************************************************************************
+ Function
+  DM_AreRowsDirty
+
+ Parameter
+  None
+
+ Returns
+  bool: true if any row has changed since it was last sent; false otherwise
+
+ Description
+  Lets a caller skip a flush when nothing it did changed the display.
+   
+Example
+   DM_TakeScrollStep(1);
+   if (true == DM_AreRowsDirty())
+   {
+     PostLEDService(UpdateEvent);
+   }
+****************************************************************************/
+bool DM_AreRowsDirty( void );
+
+/****************************************************************************
+ Function
+  DM_MarkAllRowsDirty
+
+ Parameter
+  None
+
+ Returns
+  None
+
+ Description
+  Marks every row as changed, so DM_TakeDirtyRowUpdateStep sends the whole
+  frame again. For when what reached the chain can no longer be trusted.
+   
+Example
+   DM_MarkAllRowsDirty();
+****************************************************************************/
+void DM_MarkAllRowsDirty( void );
+
+/****************************************************************************
+ Function
+  DM_LoadScrollStrip
+
+ Parameter
+  const char *: The message to be scrolled (up to DM_SCROLL_MAX_CHARS)
+  uint8_t: The display (1..DM_NUM_DISPLAYS) that the message will scroll across
+  
+ Returns
+  uint16_t: the length of the strip in columns, 0 for an illegal display
+
+ Description
+  Renders the message, followed by a blank display width, into an off-screen
+  bitmap strip and rewinds the scroll position. The font is decoded here,
+  once per message, never per frame.
+   
+Example
+   DM_LoadScrollStrip("INSERT COINS", 1);
+****************************************************************************/
+uint16_t DM_LoadScrollStrip( const char *pMsg, uint8_t WhichDisplay );
+
+/****************************************************************************
+ Function
+  DM_TakeScrollStep
+
+ Parameter
+  uint8_t: The display (1..DM_NUM_DISPLAYS) to be scrolled
+  
+ Returns
+  bool: true when the strip has wrapped back to its start; false otherwise
+
+ Description
+  Shifts the display buffer left one column and pulls the next column of the
+  scroll strip in on the right. Rows that change are marked for
+  DM_TakeDirtyRowUpdateStep.
+   
+Example
+   DM_TakeScrollStep(1);
+****************************************************************************/
+bool DM_TakeScrollStep( uint8_t WhichDisplay );
+
 
 /****************************************************************************
  Function
@@ -101,6 +336,7 @@ bool DM_TakeDisplayUpdateStep( void );
 
  Parameter
   unsigned char: The character to be added to the display
+  uint8_t: The display (1..DM_NUM_DISPLAYS) to add it to
   
  Returns
   Nothing (void)
@@ -110,7 +346,7 @@ bool DM_TakeDisplayUpdateStep( void );
   at the right-most character position in the buffer  
    
 Example
-   DM_AddChar2DisplayBuffer('A');
+   DM_AddChar2DisplayBuffer('A', 1);
 ****************************************************************************/
 void DM_AddChar2DisplayBuffer( unsigned char Char2Display, uint8_t WhichDisplay);
 
@@ -119,20 +355,22 @@ void DM_AddChar2DisplayBuffer( unsigned char Char2Display, uint8_t WhichDisplay)
   DM_PutDataIntoBufferRow
 
  Parameter
-  uint32_t: The new row data to be stored in the display buffer
+  uint64_t: The new row data to be stored in the display buffer, bits past
+            DM_COLS_PER_DISPLAY are dropped
   uint8_t:  The row (0->7) into which the data will be stored.
+  uint8_t:  The display (1..DM_NUM_DISPLAYS) to store it in
   
  Returns
-  bool: true for a legal row number; false otherwise
+  bool: true for a legal row & display number; false otherwise
 
  Description
   Copies the raw data from the Data2Insert parameter into the specified row 
   of the frame buffer 
    
 Example
-   DM_PutDataInBufferRow(0x00000001, 0);
+   DM_PutDataIntoBufferRow(0x00000001, 0, 1);
 ****************************************************************************/
-bool DM_PutDataIntoBufferRow( uint32_t Data2Insert, uint8_t WhichRow, uint8_t WhichDisplay);
+bool DM_PutDataIntoBufferRow( uint64_t Data2Insert, uint8_t WhichRow, uint8_t WhichDisplay);
 
 /****************************************************************************
  Function
@@ -140,19 +378,20 @@ bool DM_PutDataIntoBufferRow( uint32_t Data2Insert, uint8_t WhichRow, uint8_t Wh
 
  Parameter
   uint8_t: The row of the display buffer to be queried
-  uint32_t *: pointer to variable to hold the data from the buffer 
+  uint64_t *: pointer to variable to hold the data from the buffer 
+  uint8_t: The display (1..DM_NUM_DISPLAYS) to be queried
   
  Returns
-  bool: true for a legal row number; false otherwise
+  bool: true for a legal row & display number; false otherwise
 
  Description
   copies the contents of the specified row of the frame buffer into the
  location pointed to by pReturnValue
    
 Example
-   DM_QueryRowData(0,&ReturnedValue);
+   DM_QueryRowData(0, &ReturnedValue, 1);
 ****************************************************************************/
-bool DM_QueryRowData( uint8_t RowToQuery, uint32_t * pReturnValue);
+bool DM_QueryRowData( uint8_t RowToQuery, uint64_t * pReturnValue, uint8_t WhichDisplay);
 
 #endif	/* DM_DISPLAY_H */
 
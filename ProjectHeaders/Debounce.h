@@ -0,0 +1,79 @@
+/****************************************************************************
+ Module
+   Debounce.h
+
+ Description
+   Debounces up to 32 digital inputs at once with a vertical counter. Each
+   input has a small counter whose bits are spread across
+   DEBOUNCE_COUNTER_BITS words, one bit plane per word, so every input is
+   counted by the same handful of word-wide logic operations. An input's
+   counter runs while its raw level disagrees with its debounced level and
+   is cleared the moment they agree again. When it reaches StableSamples the
+   debounced level flips.
+
+ Notes
+   The caller picks the sample rate by how often it calls Debounce_Sample;
+   an input must hold a new level for StableSamples samples in a row.
+****************************************************************************/
+#ifndef DEBOUNCE_H
+#define DEBOUNCE_H
+
+#include <stdbool.h>
+#include <stdint.h>
+
+// bit planes in each counter, which caps StableSamples
+#define DEBOUNCE_COUNTER_BITS 4
+#define DEBOUNCE_MAX_STABLE   ((1 << DEBOUNCE_COUNTER_BITS) - 1)
+
+typedef struct
+{
+  uint32_t State;                          // debounced level of each input
+  uint32_t Count[DEBOUNCE_COUNTER_BITS];   // bit plane k of every counter
+  uint32_t Target[DEBOUNCE_COUNTER_BITS];  // StableSamples, spread the same
+} Debounce_t;
+
+/****************************************************************************
+ Function
+    Debounce_Init
+
+ Parameters
+   Debounce_t *: the debouncer to set up
+   uint32_t: debounced level to start from, usually a first raw sample
+   uint8_t: samples in a row a new level must hold, 1 to DEBOUNCE_MAX_STABLE
+
+ Returns
+   bool: false if StableSamples is out of range; otherwise, true
+****************************************************************************/
+bool Debounce_Init(Debounce_t *pDebounce, uint32_t Initial,
+                   uint8_t StableSamples);
+
+/****************************************************************************
+ Function
+    Debounce_Sample
+
+ Parameters
+   Debounce_t *: the debouncer
+   uint32_t: the raw level of every input
+
+ Returns
+   uint32_t: the inputs whose debounced level changed on this sample; the
+   new levels are in pDebounce->State
+
+ Description
+   Counts one sample. Costs 2 + 8 * DEBOUNCE_COUNTER_BITS logic operations,
+   34 with 4 bit planes, whatever the inputs are doing.
+****************************************************************************/
+uint32_t Debounce_Sample(Debounce_t *pDebounce, uint32_t Raw);
+
+/****************************************************************************
+ Function
+    Debounce_Busy
+
+ Returns
+   uint32_t: the inputs with a count running, that is, the ones that
+   disagreed with their debounced level on the last sample and have not yet
+   flipped. 0 means every input is settled.
+****************************************************************************/
+uint32_t Debounce_Busy(const Debounce_t *pDebounce);
+
+#endif /* DEBOUNCE_H */
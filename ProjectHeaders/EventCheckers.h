@@ -23,7 +23,7 @@
 
 bool Check4Keystroke(void);
 
-bool CheckHallEffect(void);
+bool CheckSensorEdges(void);
 
 bool CheckPotSensor(void);
 
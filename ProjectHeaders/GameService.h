@@ -12,10 +12,10 @@
 #include "ES_Configure.h" /* gets us event definitions */
 #include "ES_Types.h"     /* gets bool type for returns */
 
-// Public Function Prototypes
+// ms from the end of a game to the restart, the game over effects fill it
+#define GAME_OVER_TIME 7000
 
-// Public variables
-extern uint8_t ShiftRegisterVals[];
+// Public Function Prototypes
 
 typedef enum{
     Waiting2Coins,
@@ -29,11 +29,15 @@ typedef enum{
 bool InitGameService(uint8_t Priority);
 bool PostGameService(ES_Event_t ThisEvent);
 ES_Event_t RunGameService(ES_Event_t ThisEvent);
+GameState_t QueryGameService(void);
+int16_t QueryGameScore(void);
+uint8_t QueryGameCountdown(void);
 
 // Private Functions
 void GetNewPlanet(void);
 void UpdateScore(int16_t DeltaScore);
 void UpdateDisplay(uint8_t WhichDisplay, char *Msg);
+void ScrollDisplay(uint8_t WhichDisplay, char *Msg);
 
 #endif /* ServTemplate_H */
 
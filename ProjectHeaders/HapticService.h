@@ -0,0 +1,33 @@
+/****************************************************************************
+
+  Header file for haptic pattern service
+  based on the Gen 2 Events and Services Framework
+
+ ****************************************************************************/
+
+#ifndef HapticService_H
+#define HapticService_H
+
+#include "ES_Configure.h" /* gets us event definitions */
+#include "ES_Types.h"     /* gets bool type for returns */
+
+// Public Function Prototypes
+
+// Patterns that can be played on the vibration motor, post ES_HAPTIC with
+// one of these as the EventParam. HAPTIC_OFF stops whatever is playing.
+typedef enum{
+    HAPTIC_OFF,
+    HAPTIC_PULSE,         // single short buzz
+    HAPTIC_DOUBLE_PULSE,  // two short buzzes
+    HAPTIC_STUTTER,       // long buzz with a gap near the end
+    HAPTIC_RUMBLE_RAMP,   // builds from a flutter to full on, three times
+    HAPTIC_RUMBLE_FADE,   // full on dying away to a flutter
+    NUM_HAPTIC_PATTERNS
+} HapticPattern_t;
+
+// Service Functions
+bool InitHapticService(uint8_t Priority);
+bool PostHapticService(ES_Event_t ThisEvent);
+ES_Event_t RunHapticService(ES_Event_t ThisEvent);
+
+#endif /* HapticService_H */
@@ -0,0 +1,29 @@
+/****************************************************************************
+
+  Header file for LED sequencer service
+  based on the Gen 2 Events and Services Framework
+
+ ****************************************************************************/
+
+#ifndef LEDSeqService_H
+#define LEDSeqService_H
+
+#include "ES_Configure.h" /* gets us event definitions */
+#include "ES_Types.h"     /* gets bool type for returns */
+
+// Public Function Prototypes
+
+// Sequences that can be played, post ES_PLAY_LED_SEQ / ES_STOP_LED_SEQ with
+// one of these as the EventParam
+typedef enum{
+    LED_SEQ_GAME_OVER,   // whole chain alternates odd/even outputs
+    LED_SEQ_BLACK_HOLE,  // black hole LED blinks until stopped
+    NUM_LED_SEQS
+} LEDSeq_t;
+
+// Service Functions
+bool InitLEDSeqService(uint8_t Priority);
+bool PostLEDSeqService(ES_Event_t ThisEvent);
+ES_Event_t RunLEDSeqService(ES_Event_t ThisEvent);
+
+#endif /* LEDSeqService_H */
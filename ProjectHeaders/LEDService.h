@@ -19,6 +19,15 @@
 bool InitLEDService(uint8_t Priority);
 bool PostLEDService(ES_Event_t ThisEvent);
 ES_Event_t RunLEDService(ES_Event_t ThisEvent);
+void LED_SetScrollFrameTime(uint16_t FrameTime);
+
+// Intensity effects, WhichDisplay of 0 means all displays. Each step sends a
+// single intensity command (shutdown command for a flash), the display
+// contents are not redrawn.
+bool LED_FadeBrightness(uint8_t WhichDisplay, uint8_t TargetLevel, uint16_t Duration);
+bool LED_PulseBrightness(uint8_t WhichDisplay, uint8_t LowLevel, uint8_t HighLevel, uint16_t Period);
+bool LED_FlashBrightness(uint8_t WhichDisplay, uint8_t NumFlashes, uint16_t Period);
+void LED_StopBrightnessEffect(uint8_t WhichDisplay);
 
 typedef enum{
 	IDLE,
@@ -0,0 +1,102 @@
+/****************************************************************************
+ Module
+   PCMPlayer.h
+
+ Description
+   Plays 8 bit sampled sound through the buzzer's PWM output (OC1 on
+   Timer2). While a clip plays, Timer2 runs at PBCLK with an 8 bit period,
+   so the carrier is far above hearing, and the Timer3 interrupt writes one
+   sample into OC1RS per sample period. Nothing runs in the main loop until
+   the clip ends.
+
+ Notes
+   Timer3 belongs to the player, so no PWM channel may be assigned to it.
+   Timer2's prescale and period are put back when a clip ends or is stopped,
+   but the OC1 pulse width is left at 0, so a tone that was sounding must be
+   restarted by its owner.
+****************************************************************************/
+#ifndef PCM_PLAYER_H
+#define PCM_PLAYER_H
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#define PCM_PBCLK_HZ 20000000L
+
+// Timer3 reload for a sample rate, for filling in PCMClip_t
+#define PCM_SAMPLE_PERIOD(Hz) ((uint16_t)(PCM_PBCLK_HZ / (Hz)))
+
+typedef struct
+{
+  const uint8_t *pSamples; // unsigned, 0x80 is the mid point
+  uint16_t NumSamples;
+  uint16_t SamplePeriod;   // PBCLK ticks per sample, see PCM_SAMPLE_PERIOD
+} PCMClip_t;
+
+// called from the Timer3 ISR when a clip plays to its end
+typedef void (*PCM_DoneFunc_t)(void);
+
+// clips held in PCMSamples.c
+extern const PCMClip_t PCMClip_Zap;
+extern const PCMClip_t PCMClip_Boom;
+extern const PCMClip_t PCMClip_Chime;
+
+/****************************************************************************
+ Function
+    PCM_Init
+
+ Parameters
+   PCM_DoneFunc_t: function called (from the ISR) each time a clip finishes,
+                   may be NULL
+
+ Returns
+   bool: true
+
+ Description
+   Takes over Timer3 as the sample clock. Call after the buzzer's PWM
+   channel has been set up on Timer2.
+
+Example
+   PCM_Init(MyDoneFunction);
+****************************************************************************/
+bool PCM_Init(PCM_DoneFunc_t pDoneFunc);
+
+/****************************************************************************
+ Function
+    PCM_Play
+
+ Parameters
+   const PCMClip_t *: the clip to play, must stay valid while it plays
+
+ Returns
+   bool: false if the clip is empty or its sample period is too short to
+   service; otherwise, true
+
+ Description
+   Starts a clip, cutting off any clip already playing. Returns at once.
+
+Example
+   PCM_Play(&PCMClip_Zap);
+****************************************************************************/
+bool PCM_Play(const PCMClip_t *pClip);
+
+/****************************************************************************
+ Function
+    PCM_Stop
+
+ Description
+   Silences the output and hands Timer2 back. The done function is not
+   called.
+****************************************************************************/
+void PCM_Stop(void);
+
+/****************************************************************************
+ Function
+    PCM_IsPlaying
+
+ Returns
+   bool: true while a clip is playing
+****************************************************************************/
+bool PCM_IsPlaying(void);
+
+#endif /* PCM_PLAYER_H */
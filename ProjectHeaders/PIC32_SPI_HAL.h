@@ -2,6 +2,7 @@
 #define PIC32_SPI_HAL
 
 #include <stdbool.h> 
+#include <stdint.h>
 
 typedef enum { 
     SPI_SPI1 = 0, 
@@ -54,6 +55,9 @@ typedef enum {
     SPI_32BIT = 2
 } SPI_XferWidth_t;
 
+// called from the SS1 ISR when the SPI1 transaction queue has drained
+typedef void (*SPI_FrameDoneFunc_t)(void);
+
 /****************************************************************************
  Function
     SPISetup_BasicConfig
@@ -581,5 +585,88 @@ Example
 ****************************************************************************/
 bool SPIOperate_HasSS2_Risen(void);
 
+/****************************************************************************
+ Function
+    SPIOperate_SPI1_HasRoom
+
+ Parameters
+ None
+
+ Returns
+   bool: true if the SPI1 transmit buffer can accept another word; otherwise,
+   false
+
+ Description
+   Tests the transmit buffer full flag for SPI1. Used when more words need to
+   be sent in one frame than the enhanced buffer can hold.
+   
+Example
+   while (false == SPIOperate_SPI1_HasRoom()){}
+   SPIOperate_SPI1_Send16(0);
+****************************************************************************/
+bool SPIOperate_SPI1_HasRoom(void);
+
+/****************************************************************************
+ Function
+    SPIQueue_SPI1_Init
+
+ Parameters
+   SPI_FrameDoneFunc_t: function called (from the ISR) each time the queue
+                        drains, may be NULL
+
+ Returns
+   bool: true if SPI1 is in enhanced buffer mode and the queue was started;
+   otherwise, false
+
+ Description
+   Switches SPI1 to interrupt driven transmission through a queue of SS framed
+   transfers. SPI1 must already be set up, with SS1 mapped, in enhanced buffer
+   mode. After this call SPIOperate_SPI1_SendxxWait and SPIOperate_HasSS1_Risen
+   must no longer be used.
+   
+Example
+   SPIQueue_SPI1_Init(MyDoneFunction);
+****************************************************************************/
+bool SPIQueue_SPI1_Init(SPI_FrameDoneFunc_t pDoneFunc);
+
+/****************************************************************************
+ Function
+    SPIQueue_SPI1_AddFrame
+
+ Parameters
+   const uint16_t *: the words to send, in order, in a single SS frame
+   uint8_t:          the number of words
+
+ Returns
+   bool: true if the frame was queued; false if it did not fit (nothing is
+   queued in that case)
+
+ Description
+   Copies the frame into the queue and returns at once. The words are clocked
+   out by the SPI1 TX interrupt, SS1 rising marks the frame complete.
+   
+Example
+   SPIQueue_SPI1_AddFrame(Words, 8);
+****************************************************************************/
+bool SPIQueue_SPI1_AddFrame(const uint16_t *pWords, uint8_t NumWords);
+
+/****************************************************************************
+ Function
+    SPIQueue_SPI1_IsIdle
+
+ Returns
+   bool: true when every queued frame has been sent and latched
+****************************************************************************/
+bool SPIQueue_SPI1_IsIdle(void);
+
+/****************************************************************************
+ Function
+    SPIQueue_SPI1_GetUnderruns
+
+ Returns
+   uint16_t: count of frames that SS1 split because the FIFO ran dry
+****************************************************************************/
+uint16_t SPIQueue_SPI1_GetUnderruns(void);
+
 
 #endif //PIC32_SPI_HAL defined
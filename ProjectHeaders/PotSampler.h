@@ -0,0 +1,64 @@
+/****************************************************************************
+ Module
+   PotSampler.h
+
+ Description
+   Background sampling of the difficulty knob (the pot on RB3, AN5). The ADC
+   converts AN5 on its own at a fixed rate and interrupts after every
+   POT_SAMPLES_PER_INT conversions. The ISR averages the block, runs it
+   through a first order IIR low pass and turns the result into a level
+   from 1 to 100 with hysteresis, so the level only moves when the knob
+   has really been turned. Nothing on the main loop touches the ADC.
+
+ Notes
+   Owns the ADC. A conversion takes (POT_SAMC + 12) TAD with TAD = 512
+   PBCLK periods, 1.1ms, so the ISR runs every 8.8ms, about 114 times a
+   second.
+****************************************************************************/
+#ifndef POT_SAMPLER_H
+#define POT_SAMPLER_H
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#define POT_MIN_LEVEL 1
+#define POT_MAX_LEVEL 100
+
+/****************************************************************************
+ Function
+    PotSampler_Init
+
+ Parameters
+   None
+
+ Returns
+   bool: true
+
+ Description
+   Sets the ADC up to convert AN5 continuously and waits, about 9ms, for
+   the first block so that PotSampler_GetLevel is good as soon as this
+   returns. Then hands over to the ADC interrupt. RB3 must already be an
+   analog input.
+****************************************************************************/
+bool PotSampler_Init(void);
+
+/****************************************************************************
+ Function
+    PotSampler_GetLevel
+
+ Returns
+   uint8_t: the knob position, POT_MIN_LEVEL to POT_MAX_LEVEL
+****************************************************************************/
+uint8_t PotSampler_GetLevel(void);
+
+/****************************************************************************
+ Function
+    PotSampler_GetFiltered
+
+ Returns
+   uint16_t: the filtered ADC reading before quantizing, 0 to 1023 with 6
+   bits of fraction (0 to 65472), for tuning and test
+****************************************************************************/
+uint16_t PotSampler_GetFiltered(void);
+
+#endif /* POT_SAMPLER_H */
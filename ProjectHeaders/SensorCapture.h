@@ -0,0 +1,112 @@
+/****************************************************************************
+ Module
+   SensorCapture.h
+
+ Description
+   Debounced falling edge capture for the Hall effect sensors and the coin
+   IR sensor. The sensor pins are debounced together with a vertical
+   counter (Debounce.c): a pin has to read low for SENSOR_STABLE_SAMPLES
+   samples in a row, SENSOR_SAMPLE_PERIOD_US apart, before its edge is
+   reported. Two backends sit behind one interface:
+     SENSOR_CAPTURE_POLL  the pins are sampled when the event checker asks
+                          for an edge and a sample period has gone by. A
+                          pulse that starts and ends while the main loop is
+                          busy is missed.
+     SENSOR_CAPTURE_CN    the change notification interrupt stamps the
+                          first fall on a pin the moment it happens and
+                          starts Timer4, which samples the pins until every
+                          one has settled and then stops again.
+   Either way edges come out of SensorCapture_GetEdge in the order they
+   were confirmed, stamped with when the pin first fell.
+
+ Notes
+   CP0 Count runs at SYSCLK/2, 20MHz, so stamps are in 50ns ticks and wrap
+   every 214s; take differences, not absolute values. CN mode owns Timer4.
+****************************************************************************/
+#ifndef SENSOR_CAPTURE_H
+#define SENSOR_CAPTURE_H
+
+#include <stdbool.h>
+#include <stdint.h>
+
+// capture backend used by the game
+#define SENSOR_CAPTURE_DEFAULT_MODE SENSOR_CAPTURE_CN
+
+// debouncing, a new level must hold for the product of these, 1ms
+#define SENSOR_SAMPLE_PERIOD_US 250 // 3 to 26000
+#define SENSOR_STABLE_SAMPLES   4   // 1 to DEBOUNCE_MAX_STABLE
+
+typedef enum
+{
+  SENSOR_CAPTURE_POLL,
+  SENSOR_CAPTURE_CN
+} SensorCaptureMode_t;
+
+// the sensors, Hall effect sensors first in the order the game numbers them
+typedef enum
+{
+  SENSOR_PLANET_1,   // RB5
+  SENSOR_PLANET_2,   // RB8
+  SENSOR_PLANET_3,   // RA2
+  SENSOR_PLANET_4,   // RA3
+  SENSOR_ASTEROID,   // RB9
+  SENSOR_BLACK_HOLE, // RB10
+  SENSOR_COIN,       // RB2, IR break beam
+  NUM_SENSORS
+} Sensor_t;
+
+typedef struct
+{
+  Sensor_t WhichSensor;
+  uint32_t Stamp; // CP0 Count when the pin first fell
+} SensorEdge_t;
+
+/****************************************************************************
+ Function
+    SensorCapture_Init
+
+ Parameters
+   SensorCaptureMode_t: which backend to use
+
+ Returns
+   bool: false if the mode is not legal; otherwise, true
+
+ Description
+   Starts capturing with the chosen backend, dropping any edges not yet
+   collected, and takes the pins' present levels as settled. May be called
+   again to switch backends. The sensor pins must already be set up as
+   digital inputs.
+
+Example
+   SensorCapture_Init(SENSOR_CAPTURE_CN);
+****************************************************************************/
+bool SensorCapture_Init(SensorCaptureMode_t Mode);
+
+/****************************************************************************
+ Function
+    SensorCapture_GetEdge
+
+ Parameters
+   SensorEdge_t *: where to put the edge
+
+ Returns
+   bool: true if an edge was returned, false if there are none waiting
+
+ Description
+   Hands back the oldest debounced falling edge not yet collected. In
+   polled mode this is also where the pins are sampled.
+****************************************************************************/
+bool SensorCapture_GetEdge(SensorEdge_t *pEdge);
+
+/****************************************************************************
+ Function
+    SensorCapture_GetMode / SensorCapture_GetOverruns
+
+ Returns
+   The backend in use, and the number of edges dropped because the ring
+   buffer was full since SensorCapture_Init
+****************************************************************************/
+SensorCaptureMode_t SensorCapture_GetMode(void);
+uint16_t SensorCapture_GetOverruns(void);
+
+#endif /* SENSOR_CAPTURE_H */
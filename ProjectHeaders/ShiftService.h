@@ -14,8 +14,17 @@
 
 // Public Function Prototypes
 
+// LED state words have one bit per shift register output, bit n is output n
+#define SHIFT_ALL_LEDS 0x1FFF
+
+// Outputs of the shift register chain
+#define PLANET_LED 0     // planets 1-4 on outputs 0-3
+#define BLACKHOLE_LED 4
+#define COIN_LED 5
+#define TIMING_LED 7     // countdown bar on outputs 7-12
+
 typedef enum{
-    Waiting
+    WaitingShift,
     UpdatingShift
 } ShiftState_t;
 
@@ -24,5 +33,12 @@ bool InitShiftService(uint8_t Priority);
 bool PostShiftService(ES_Event_t ThisEvent);
 ES_Event_t RunShiftService(ES_Event_t ThisEvent);
 
+// Public Functions
+void Shift_SetLEDs(uint16_t NewLEDs);
+void Shift_SetLED(uint8_t WhichLED, bool IsOn);
+void Shift_SetOverlay(uint16_t Mask, uint16_t LEDs);
+uint16_t Shift_GetLEDs(void);
+void Shift_SetBurstMode(bool IsBurst);
+
 #endif /* ServTemplate_H */
 
@@ -0,0 +1,67 @@
+/****************************************************************************
+ Module
+   Telemetry.h
+
+ Description
+   A binary record of the game and the framework, sent on the terminal
+   every TELEMETRY_PERIOD_MS for the dashboards: the game state, score and
+   countdown, each service's queue depth and the events it ran, and how
+   long the passes through ES_Run's loop took. Records use binlog's wire
+   format, a COBS frame between two zero bytes with the site id
+   BINLOG_SITE_TELEMETRY, so they mix with log records and plain text, and
+   HostTools/Telemetry_Decode.c turns a capture of them into CSV.
+
+ Record
+   After the site id and the CP0 Count, zigzag varints in this order:
+     sequence number, counting every record, sent or not
+     game state (GameState_t), score, countdown in seconds
+     number of services, n
+     n queue depths, lowest priority first
+     n counts of events run since the last record
+     loop passes since the last record, the longest and their total, in
+     CP0 Count ticks (20MHz)
+     records not sent since reset because the terminal had no room
+   A decoder that finds fewer fields than it expects drops the record.
+
+ Notes
+   About 40 bytes a record with the game running, under 2% of the 115200
+   baud line at 5 a second; the worst case is checked against 10% when
+   this builds.
+****************************************************************************/
+#ifndef TELEMETRY_H
+#define TELEMETRY_H
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#define TELEMETRY_PERIOD_MS 200
+
+/****************************************************************************
+ Function
+    Telemetry_Send
+
+ Parameters
+   None
+
+ Returns
+   bool: false if the terminal had no room and the record was skipped
+
+ Description
+   Gathers and sends one record. Called from a service when its telemetry
+   timer runs out, not from an ISR.
+****************************************************************************/
+bool Telemetry_Send(void);
+
+/****************************************************************************
+ Function
+    Telemetry_SetEnabled / Telemetry_IsEnabled
+
+ Description
+   Whether Telemetry_Send sends anything. Off at reset, since the records
+   are noise on a plain terminal; the test harness turns them on and off
+   from the keyboard.
+****************************************************************************/
+void Telemetry_SetEnabled(bool IsEnabled);
+bool Telemetry_IsEnabled(void);
+
+#endif /* TELEMETRY_H */
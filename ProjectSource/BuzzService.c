@@ -6,10 +6,20 @@ Revision
     1.0.1
 
 Description
-    This is a source file to control piezo buzzer and vibration motor
+    This is a source file to control piezo buzzer
     sequences during gameplay.
 
 Notes
+    Sounds are constant tables of notes. Each note holds the Timer2 period
+    and OC1 pulse width for its pitch, worked out by the compiler from the
+    frequency, so starting a note is two register writes and no divide.
+    One tune plays at a time, stepped by BUZZER_TIMER; a new ES_BUZZ
+    replaces whatever is playing. New sounds only need a table and an
+    entry in Tunes[].
+
+    A sound can instead be a sampled clip, which PCMPlayer streams into the
+    PWM from the Timer3 interrupt. Nothing happens here while it plays.
+    The vibration motor belongs to HapticService.
 
 History
 When           Who     What/Why
@@ -22,55 +32,115 @@ When           Who     What/Why
 #include "ES_Framework.h"
 #include "BuzzService.h"
 #include "PWM_PIC32.h"
-#include "dbprintf.h"
+#include "PCMPlayer.h"
+#define BINLOG_MODULE BINLOG_MODULE_BUZZ
+#include "binlog.h"
 
 /*----------------------------- Module Defines ----------------------------*/
-#define VOLUME 10
-#define VIB_MOTOR  LATBbits.LATB15
+#define ARRAY_LEN(x) (sizeof(x) / sizeof((x)[0]))
+
+#define VOLUME 10 // duty cycle in percent
+#define BUZZ_CHANNEL 1
+#define PWM_TICK_HZ 2500000L // Timer2 runs at 0.4us per tick
+
+#define NOTE_PERIOD(Hz) ((uint16_t)(PWM_TICK_HZ / (Hz)))
+#define NOTE(Hz, ms) \
+    { NOTE_PERIOD(Hz), (uint16_t)(NOTE_PERIOD(Hz) * VOLUME / 100), (ms) }
+#define REST(ms)   { 0, 0, (ms) }
+
+typedef struct
+{
+    uint16_t Period;     // Timer2 ticks, 0 for a rest
+    uint16_t PulseWidth; // OC1 high time in Timer2 ticks
+    uint16_t Duration_ms;
+} BuzzNote_t;
+
+typedef struct
+{
+    const BuzzNote_t *pNotes;
+    uint8_t NumNotes;
+    uint8_t LoopStart;   // note to go back to at the end of the table
+    uint8_t NumRepeats;  // extra times through from LoopStart
+    const PCMClip_t *pClip; // played instead of notes if not NULL
+} BuzzTune_t;
 
 /*---------------------------- Module Functions ---------------------------*/
-void SoundBuzzer(uint32_t freq, uint32_t duration);
+static void PlayNote(void);
+static void StopTune(void);
 
 /*---------------------------- Module Variables ---------------------------*/
 static uint8_t MyPriority;
-static uint8_t BuzzCount = 0;
-static uint32_t BuzzTime = 0;
-static uint8_t BuzzInterval = 15;
-static uint8_t BuzzStep = 50;
-static uint8_t BuzzType = 0;
-static uint32_t BuzzFreq = 1000;
-static uint8_t BlackHoleCycle = 0;
-static uint8_t TuneCycle = 0;
+
+// note tables, these live in flash
+// planet hit: rising arpeggio
+static const BuzzNote_t PlanetNotes[] = {
+    NOTE(1000, 33), NOTE(1050, 33), NOTE(1100, 33), NOTE(1150, 33),
+    NOTE(1200, 33), NOTE(1250, 33), NOTE(1300, 33), NOTE(1350, 33),
+    NOTE(1400, 33), NOTE(1450, 33), NOTE(1500, 33), NOTE(1550, 33),
+    NOTE(1600, 33), NOTE(1650, 33), NOTE(1700, 33), NOTE(1750, 33)
+};
+
+// asteroid hit: falling arpeggio
+static const BuzzNote_t AsteroidNotes[] = {
+    NOTE(800, 33), NOTE(750, 33), NOTE(700, 33), NOTE(650, 33),
+    NOTE(600, 33), NOTE(550, 33), NOTE(500, 33), NOTE(450, 33),
+    NOTE(400, 33), NOTE(350, 33), NOTE(300, 33), NOTE(250, 33),
+    NOTE(200, 33), NOTE(150, 33), NOTE(100, 33), NOTE(50, 33)
+};
+
+// black hole hit: quick rise, then a fall and a rise played twice
+static const BuzzNote_t BlackHoleNotes[] = {
+    NOTE(600, 6), NOTE(650, 6), NOTE(700, 6), NOTE(750, 6),
+    NOTE(800, 6), NOTE(850, 6), NOTE(900, 6), NOTE(950, 6),
+    NOTE(1000, 6), NOTE(1050, 6), NOTE(1100, 6), NOTE(1150, 6),
+    NOTE(1200, 6), NOTE(1250, 6), NOTE(1300, 6), NOTE(1350, 6),
+    NOTE(1350, 33), NOTE(1300, 33), NOTE(1250, 33), NOTE(1200, 33),
+    NOTE(1150, 33), NOTE(1100, 33), NOTE(1050, 33), NOTE(1000, 33),
+    NOTE(950, 33), NOTE(900, 33), NOTE(850, 33), NOTE(800, 33),
+    NOTE(750, 33), NOTE(700, 33), NOTE(650, 33), NOTE(600, 33),
+    NOTE(600, 33), NOTE(650, 33), NOTE(700, 33), NOTE(750, 33),
+    NOTE(800, 33), NOTE(850, 33), NOTE(900, 33), NOTE(950, 33),
+    NOTE(1000, 33), NOTE(1050, 33), NOTE(1100, 33), NOTE(1150, 33),
+    NOTE(1200, 33), NOTE(1250, 33), NOTE(1300, 33), NOTE(1350, 33)
+};
+
+// coin inserted
+static const BuzzNote_t CoinNotes[] = {
+    NOTE(1200, 200)
+};
 
 // tune to play at the start of the game
-uint16_t start_tune_frequencies[] = {
-    1300,  // First note (1300 Hz)
-    1500,  // Second note (1500 Hz)
-    1800,  // Third note (1800 Hz)
-    2200,  // Fourth note (2200 Hz)
-    2500,  // Fifth note (2500 Hz)
-    2200,  // Sixth note (2200 Hz)
-    1800,  // Seventh note (1800 Hz)
-    1500   // Eighth note (1500 Hz)
+static const BuzzNote_t StartNotes[] = {
+    NOTE(1300, 106), NOTE(1500, 106), NOTE(1800, 106), NOTE(2200, 106),
+    NOTE(2500, 106), NOTE(2200, 106), NOTE(1800, 106), NOTE(1500, 106)
 };
 
 // tune to play at the end of the game
-uint16_t end_tune_frequencies[] = {
-    2000,  // First note (2000 Hz)
-    1800,  // Second note (1800 Hz)
-    1600,  // Third note (1600 Hz)
-    1400,  // Fourth note (1400 Hz)
-    1200,  // Fifth note (1200 Hz)
-    1500,  // Sixth note (1500 Hz - a small rise for contrast)
-    1000,  // Seventh note (1000 Hz)
-    1200,  // Eighth note (1200 Hz - small rise again)
-    800,   // Ninth note (800 Hz)
-    600,   // Tenth note (600 Hz)
-    400,   // Eleventh note (400 Hz)
-    300,   // Twelfth note (300 Hz)
-    200    // Thirteenth note (200 Hz) - final low note
+static const BuzzNote_t EndNotes[] = {
+    NOTE(2000, 160), NOTE(1800, 160), NOTE(1600, 160), NOTE(1400, 160),
+    NOTE(1200, 160), NOTE(1500, 160), NOTE(1000, 160), NOTE(1200, 160),
+    NOTE(800, 160), NOTE(600, 160), NOTE(400, 160), NOTE(300, 160),
+    NOTE(200, 160)
 };
 
+// indexed by BuzzSound_t
+static const BuzzTune_t Tunes[NUM_BUZZ_SOUNDS] = {
+    [BUZZ_PLANET]     = { PlanetNotes, ARRAY_LEN(PlanetNotes), 0, 0 },
+    [BUZZ_ASTEROID]   = { AsteroidNotes, ARRAY_LEN(AsteroidNotes), 0, 0 },
+    [BUZZ_BLACK_HOLE] = { BlackHoleNotes, ARRAY_LEN(BlackHoleNotes), 16, 1 },
+    [BUZZ_COIN]       = { CoinNotes, ARRAY_LEN(CoinNotes), 0, 0 },
+    [BUZZ_START_TUNE] = { StartNotes, ARRAY_LEN(StartNotes), 0, 0 },
+    [BUZZ_END_TUNE]   = { EndNotes, ARRAY_LEN(EndNotes), 0, 0 },
+    [BUZZ_ZAP]        = { .pClip = &PCMClip_Zap },
+    [BUZZ_BOOM]       = { .pClip = &PCMClip_Boom },
+    [BUZZ_CHIME]      = { .pClip = &PCMClip_Chime }
+};
+
+// playback state
+static const BuzzTune_t *pPlaying = NULL;
+static uint8_t NoteIndex;
+static uint8_t RepeatsLeft;
+
 /*------------------------------ Module Code ------------------------------*/
 /****************************************************************************
 Function
@@ -91,19 +161,16 @@ bool InitBuzzService(uint8_t Priority)
     // Init PWM Channel 1
     PWMSetup_BasicConfig(2); // configure 1 pwm pin 
     PWMSetup_SetFreqOnTimer(80, _Timer2_); // frequency of timer (50Hz)
-    PWMSetup_AssignChannelToTimer(1, _Timer2_); // sets 1 pwm pin to a timer name
-    PWMSetup_MapChannelToOutputPin(1, PWM_RPB4); // sets channel 1 to a legal pin (need to change!!)
-    PWMOperate_SetDutyOnChannel(0,1); // set volume to zero
-    
-    // Vibration motor
-    TRISBbits.TRISB15 = 0;   //output
+    PWMSetup_AssignChannelToTimer(BUZZ_CHANNEL, _Timer2_); // sets 1 pwm pin to a timer name
+    PWMSetup_MapChannelToOutputPin(BUZZ_CHANNEL, PWM_RPB4); // sets channel 1 to a legal pin (need to change!!)
+    PWMOperate_SetPulseWidthOnChannel(0, BUZZ_CHANNEL); // set volume to zero
+    PCM_Init(NULL); // sample clock on Timer3
     
     ES_Event_t ThisEvent;
 
     MyPriority = Priority;
-    /********************************************
-    in here you write your initialization code
-     *******************************************/
+    pPlaying = NULL;
+
     // post the initial transition event
     ThisEvent.EventType = ES_INIT;
     if (ES_PostToService(MyPriority, ThisEvent) == true)
@@ -145,7 +212,8 @@ Returns
     ES_Event, ES_NO_EVENT if no error ES_ERROR otherwise
 
 Description
-    Handles various buzz events from GameService
+    Starts the tune named by an ES_BUZZ from GameService, and steps the
+    playing tune to its next note each time BUZZER_TIMER expires.
 ****************************************************************************/
 ES_Event_t RunBuzzService(ES_Event_t ThisEvent)
 {
@@ -161,114 +229,37 @@ ES_Event_t RunBuzzService(ES_Event_t ThisEvent)
         break;
         case ES_TIMEOUT:
         {
-            if(ThisEvent.EventParam == 8){ //BUZZER_TIMER
-                if (BuzzCount == 0){ // buzzer is over
-                    PWMOperate_SetDutyOnChannel(0,1); // set volume to zero
-                    BuzzType = 0;
-                    
-                    VIB_MOTOR = 0; // turn off vibration motors
-                    
-                    if (BlackHoleCycle > 0){ // if blackhole cycle is non zero restart
-                        BlackHoleCycle--;
-
-                        BuzzType = BlackHoleCycle % 2 + 1; // alternate arpeggio
-                        BuzzCount = BuzzInterval;
-                        BuzzTime = 500;
-                        
-                        VIB_MOTOR = 1; // turn on vibration motors
-                        
-                        SoundBuzzer(BuzzFreq, BuzzTime/BuzzInterval);
-                    }
-                } else if (BuzzType == 1){ // Arpeggio pitch up
-                    BuzzFreq = BuzzFreq+BuzzStep;
-                    SoundBuzzer(BuzzFreq, BuzzTime/BuzzInterval);
-                    BuzzCount--;
-                } else if (BuzzType == 2){ // Arpeggio pitch down
-                    BuzzFreq = BuzzFreq-BuzzStep;
-                    SoundBuzzer(BuzzFreq, BuzzTime/BuzzInterval);
-                    
-                    if (BuzzCount % 8 == 0){
-                        VIB_MOTOR = 0;
-                    } else if (BuzzCount % 8 == 4){
-                        VIB_MOTOR = 1;
+            if ((ThisEvent.EventParam == BUZZER_TIMER) && (NULL != pPlaying)){
+                NoteIndex++;
+                if (NoteIndex >= pPlaying->NumNotes){
+                    if (0 == RepeatsLeft){ // tune is over
+                        StopTune();
+                        break;
                     }
-                    
-                    BuzzCount--;
-                } else if (BuzzType == 3){ // Play start tune
-                    SoundBuzzer(start_tune_frequencies[8-BuzzCount], BuzzTime/BuzzInterval);
-                    BuzzCount--;
-                } else if (BuzzType == 4){ // Play end tune
-                    SoundBuzzer(end_tune_frequencies[13-BuzzCount], BuzzTime/BuzzInterval);
-                    BuzzCount--;
-                } else { // Turn off
-                    PWMOperate_SetDutyOnChannel(0,1); // set volume to zero
-                    VIB_MOTOR = 0;
+                    RepeatsLeft--;
+                    NoteIndex = pPlaying->LoopStart;
                 }
+                PlayNote();
             }
         }
         break;
         case ES_BUZZ:
         {
-            DB_printf("ES_BUZZ\n");
-            if(ThisEvent.EventParam == 1){ // planet
-                BuzzCount = BuzzInterval;
-                BuzzTime = 500;
-                BuzzType = 1;
-                BuzzFreq = 1000;
-                BlackHoleCycle = 0;
-
-                SoundBuzzer(BuzzFreq, BuzzTime/BuzzInterval);
-                
-                VIB_MOTOR = 1;
-            } else if(ThisEvent.EventParam == 2){ // asteroid
-                BuzzCount = BuzzInterval;
-                BuzzTime = 500;
-                BuzzType = 2;
-                BuzzFreq = 800;
-                BlackHoleCycle = 0;
-
-                SoundBuzzer(BuzzFreq, BuzzTime/BuzzInterval);
-                
-                VIB_MOTOR = 1;
-            } else if(ThisEvent.EventParam == 3){ // blackhole
-                BuzzCount = BuzzInterval;
-                BuzzTime = 100;
-                BuzzFreq = 600;
-                
-                BlackHoleCycle = 4;
-                BuzzType = BlackHoleCycle % 2 + 1;
-
-                SoundBuzzer(BuzzFreq, BuzzTime/BuzzInterval);
-                
-                VIB_MOTOR = 1;
-            } else if(ThisEvent.EventParam == 4){ // coin
-                BuzzTime = 200;
-                BuzzType = 0;
-                BuzzFreq = 1200;
-
-                SoundBuzzer(BuzzFreq, BuzzTime);
-                
-                VIB_MOTOR = 1;
-            } else if(ThisEvent.EventParam == 5){ // start tune
-                BuzzTime = 1600;
-                BuzzType = 3;
-                
-                BuzzCount = 8;
-
-                SoundBuzzer(start_tune_frequencies[12-BuzzCount], BuzzTime/BuzzInterval);
-                BuzzCount--;
-                
-                VIB_MOTOR = 1;
-            } else if(ThisEvent.EventParam == 6){ // end tune
-                BuzzTime = 2400;
-                BuzzType = 4;
-                
-                BuzzCount = 12;
-
-                SoundBuzzer(end_tune_frequencies[13-BuzzCount], BuzzTime/BuzzInterval);
-                BuzzCount--;
-                
-                VIB_MOTOR = 1;
+            LOG_DEBUG("ES_BUZZ %u\n", ThisEvent.EventParam);
+            if ((ThisEvent.EventParam < NUM_BUZZ_SOUNDS) &&
+                (NULL != Tunes[ThisEvent.EventParam].pClip)){
+                StopTune();
+                PCM_Play(Tunes[ThisEvent.EventParam].pClip);
+            } else if ((ThisEvent.EventParam < NUM_BUZZ_SOUNDS) &&
+                (NULL != Tunes[ThisEvent.EventParam].pNotes)){
+                PCM_Stop();
+                pPlaying = &Tunes[ThisEvent.EventParam];
+                NoteIndex = 0;
+                RepeatsLeft = pPlaying->NumRepeats;
+                PlayNote();
+            } else {
+                // logged rather than returned, an ES_ERROR would stop ES_Run
+                LOG_ERROR("no buzz sound %u\n", ThisEvent.EventParam);
             }
         }
         break;
@@ -283,11 +274,36 @@ ES_Event_t RunBuzzService(ES_Event_t ThisEvent)
 /***************************************************************************
  private functions
  ***************************************************************************/
-void SoundBuzzer(uint32_t freq, uint32_t duration){
-    PWMSetup_SetFreqOnTimer(freq, _Timer2_);
-    PWMOperate_SetDutyOnChannel(VOLUME,1);
-    ES_Timer_InitTimer(BUZZER_TIMER, duration);
+/****************************************************************************
+Function
+    PlayNote
+
+Description
+    Loads the current note into Timer2 and OC1 and times it
+****************************************************************************/
+static void PlayNote(void)
+{
+    const BuzzNote_t *pNote = &pPlaying->pNotes[NoteIndex];
+
+    if (0 != pNote->Period){
+        PWMSetup_SetPeriodOnTimer(pNote->Period, _Timer2_);
+    }
+    PWMOperate_SetPulseWidthOnChannel(pNote->PulseWidth, BUZZ_CHANNEL);
+    ES_Timer_InitTimer(BUZZER_TIMER, pNote->Duration_ms);
 }
 
-/*------------------------------ End of file ------------------------------*/
+/****************************************************************************
+Function
+    StopTune
 
+Description
+    Silences the buzzer
+****************************************************************************/
+static void StopTune(void)
+{
+    ES_Timer_StopTimer(BUZZER_TIMER);
+    pPlaying = NULL;
+    PWMOperate_SetPulseWidthOnChannel(0, BUZZ_CHANNEL); // set volume to zero
+}
+
+/*------------------------------ End of file ------------------------------*/
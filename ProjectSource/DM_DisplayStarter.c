@@ -15,12 +15,13 @@
 /*----------------------------- Include Files -----------------------------*/
 #include <xc.h>
 #include <stdbool.h>
+#include <stddef.h>
+#include <string.h>
 #include "PIC32_SPI_HAL.h"
 #include "DM_Display.h"
 #include "FontStuff.h"
 
 /*----------------------------- Module Defines ----------------------------*/
-#define NumModules 8
 #define NUM_ROWS   8
 #define NUM_ROWS_IN_FONT 5
 #define DM_START_SHUTDOWN 0x0C00
@@ -30,14 +31,26 @@
 #define DM_SET_BRIGHT     0x0A00
 #define DM_SET_BRIGHTNESS(level)  (0x0A00 | (level & 0x0F))// level should be between 0 and 15
 
+// depth of the SPI1 enhanced transmit buffer in 16-bit mode, longer chains
+// have to wait for room part way through a frame
+#define SPI_FIFO_DEPTH 8
+
+#define COLS_PER_CHAR 4
+// only the low DM_COLS_PER_DISPLAY bits of a row are ever shown
+#define ROW_MASK (~0ULL >> (64 - DM_COLS_PER_DISPLAY))
+// the strip holds the rendered message followed by a blank display width so
+// that the message scrolls fully off before it wraps around
+#define SCROLL_STRIP_COLS ((DM_SCROLL_MAX_CHARS * COLS_PER_CHAR) + DM_COLS_PER_DISPLAY)
+#define SCROLL_STRIP_WORDS ((SCROLL_STRIP_COLS + 31) / 32)
+
 /*------------------------------ Module Types -----------------------------*/
-// this union definition assumes that the display is made up of 4 modules
-// 4 modules x 8 bits/module = 32 bits total
-// this union allows us to easily scroll the whole buffer, using the uint32_t
-// while picking out the individual bytes to send them to the controllers
+// One row of one logical display. Up to 8 modules x 8 bits/module = 64 bits.
+// This union allows us to easily scroll the whole row, using the uint64_t
+// while picking out the individual bytes to send them to the controllers.
+// ByBytes[0] holds the right-most 8 columns.
 typedef union{
-    uint32_t FullRow;
-    uint8_t ByBytes[NumModules];
+    uint64_t FullRow;
+    uint8_t ByBytes[8];
 }DM_Row_t;
 
 typedef enum { DM_StepStartShutdown = 0, DM_StepFillBufferZeros, 
@@ -46,14 +59,40 @@ typedef enum { DM_StepStartShutdown = 0, DM_StepFillBufferZeros,
 }InitStep_t;
 
 /*---------------------------- Module Functions ---------------------------*/
-static void sendCmd( uint16_t Cmd2Send );
-static void sendRow( uint8_t RowNum, DM_Row_t RowData_1 ,  DM_Row_t RowData_2);
+static bool sendFrame( void );
+static bool sendCmd( uint16_t Cmd2Send );
+static bool sendRow( uint8_t RowNum );
+static bool sendBrightness( void );
+static bool sendShutdown( void );
+static bool isDisplayLegal( uint8_t WhichDisplay );
 
 /*---------------------------- Module Variables ---------------------------*/
 // We make the display buffer from an array of these unions, one for each 
-// row in the display
-static DM_Row_t DM_Display_1[NUM_ROWS];
-static DM_Row_t DM_Display_2[NUM_ROWS];
+// row in each display
+static DM_Row_t DM_DisplayBuffer[DM_NUM_DISPLAYS][NUM_ROWS];
+
+// one bit per row, set when the buffer row differs from what was last sent
+static uint8_t DirtyRows = 0;
+
+// Off-screen scroll strips, one per display. Column 0 of the strip is the
+// MSB of word 0, so a column is pulled out with a shift and a mask. Each
+// message is rendered from the font once, when it is loaded.
+static uint32_t ScrollStrip[DM_NUM_DISPLAYS][NUM_ROWS][SCROLL_STRIP_WORDS];
+static uint16_t ScrollStripLen[DM_NUM_DISPLAYS];
+static uint16_t ScrollCol[DM_NUM_DISPLAYS];
+
+// intensity of each display, and whether it has changed since last sent
+static uint8_t Brightness[DM_NUM_DISPLAYS];
+static bool IsBrightnessPending = false;
+static bool IsBrightnessInitialized = false;
+// displays held in shutdown, and whether that has changed since last sent
+static bool IsShutdown[DM_NUM_DISPLAYS];
+static bool IsShutdownPending = false;
+
+// one word per module, built up before the frame is sent
+static uint16_t FrameWords[DM_NUM_MODULES];
+// when true frames go to the SPI1 transaction queue rather than blocking
+static bool IsQueuedOutput = false;
 
 // this is the state variable for tracking init steps
 static InitStep_t CurrentInitStep =  DM_StepStartShutdown;
@@ -86,13 +125,14 @@ static const uint8_t BitReverseTable256[] =
 };
 
 
+
 /*------------------------------ Module Code ------------------------------*/
 /****************************************************************************
  Function
   DM_TakeInitDisplayStep
 
   Description
-  Initializes the MAX7219 4-module display performing 1 step for each call:
+  Initializes the MAX7219 module chain performing 1 step for each call:
     First, bring put it in shutdown to disable all displays, return false
     Next fill the display RAM with Zeros to insure blanked, return false
     Then Disable Code B decoding for all digits, return false
@@ -103,45 +143,56 @@ static const uint8_t BitReverseTable256[] =
 ****************************************************************************/
 bool DM_TakeInitDisplayStep( void )
 {
-    static uint8_t rowIndex = 0;
     bool ReturnVal = false;
+    uint8_t WhichDisplay;
     
     switch (CurrentInitStep)
     {
     case DM_StepStartShutdown:
       // First, bring put it in shutdown to disable all displays
-      sendCmd(DM_START_SHUTDOWN);
-      // move on to next step
-      CurrentInitStep++;
+      if (true == sendCmd(DM_START_SHUTDOWN))
+      {
+        CurrentInitStep++; // move on to next step
+      }
       break;
       
     case DM_StepFillBufferZeros:
       // fill the buffer with Zeros
-      DM_ClearDisplayBuffer(1);
-      DM_ClearDisplayBuffer(2);
+      for (WhichDisplay = 1; WhichDisplay <= DM_NUM_DISPLAYS; WhichDisplay++)
+      {
+        DM_ClearDisplayBuffer(WhichDisplay);
+      }
       // move on to next step
       CurrentInitStep++;
       break;
       
     case DM_StepDisableCodeB:
       // Next Disable Code B decoding for all digits
-      sendCmd(DM_DISABLE_CODEB);
-      // move on to next step
-      CurrentInitStep++;
+      if (true == sendCmd(DM_DISABLE_CODEB))
+      {
+        CurrentInitStep++; // move on to next step
+      }
       break;
 
     case DM_StepEnableScanAll:
       // Then, enable scanning for all digits
-      sendCmd(DM_ENABLE_SCAN);
-      // move on to next step
-      CurrentInitStep++;
+      if (true == sendCmd(DM_ENABLE_SCAN))
+      {
+        CurrentInitStep++; // move on to next step
+      }
       break;
 
     case DM_StepSetBrighness:
-      // The next setup step is to set the brightness to minimum
-      sendCmd(DM_SET_BRIGHTNESS(10));
-      // move on to next step
-      CurrentInitStep++;
+      // The next setup step is to set the brightness, the default unless
+      // one has already been chosen
+      if (false == IsBrightnessInitialized)
+      {
+        DM_SetBrightness(DM_DEFAULT_BRIGHTNESS, 0);
+      }
+      if (true == sendBrightness())
+      {
+        CurrentInitStep++; // move on to next step
+      }
       break;
 
     case DM_StepCopyBuffer2Display: // copy our display buffer to the display
@@ -155,11 +206,18 @@ bool DM_TakeInitDisplayStep( void )
       
     case DM_StepEndShutdown:  
       // Finally, bring it out of shutdown
-      sendCmd(DM_END_SHUTDOWN);
-      // prepare for a re-init
-      CurrentInitStep = DM_StepStartShutdown;
-      // let the caller know that we are done
-      ReturnVal = true;
+      if (true == sendCmd(DM_END_SHUTDOWN))
+      {
+        for (WhichDisplay = 1; WhichDisplay <= DM_NUM_DISPLAYS; WhichDisplay++)
+        {
+          IsShutdown[WhichDisplay - 1] = false;
+        }
+        IsShutdownPending = false;
+        // prepare for a re-init
+        CurrentInitStep = DM_StepStartShutdown;
+        // let the caller know that we are done
+        ReturnVal = true;
+      }
       break;
       
     default:
@@ -175,15 +233,19 @@ bool DM_TakeInitDisplayStep( void )
 
  Description
   Copies the contents of the display buffer to the MAX7219 controllers 1 row
-  per call.
+  per call. A row that could not be queued is tried again on the next call.
 ****************************************************************************/
 bool DM_TakeDisplayUpdateStep( void )
 {
     bool ReturnVal = false;
-    static int8_t WhichRow = 0;
+    static uint8_t WhichRow = 0;
     
-    sendRow(WhichRow, DM_Display_1[WhichRow], DM_Display_2[WhichRow]);
-    if (WhichRow++ >= NUM_ROWS)
+    if (false == sendRow(WhichRow))
+    {
+      return false;
+    }
+    DirtyRows &= ~(1 << WhichRow);
+    if (++WhichRow >= NUM_ROWS)
     {
       ReturnVal = true; // show we are done
       WhichRow = 0; // set up for next update
@@ -191,6 +253,262 @@ bool DM_TakeDisplayUpdateStep( void )
     return ReturnVal;
 }
 
+/****************************************************************************
+ Function
+  DM_SetBrightness
+
+ Description
+  Records a new intensity for one display, or all of them when WhichDisplay
+  is 0. Nothing is sent until DM_TakeBrightnessUpdateStep.
+****************************************************************************/
+bool DM_SetBrightness( uint8_t Level, uint8_t WhichDisplay )
+{
+    uint8_t Index;
+
+    if ((0 != WhichDisplay) && (false == isDisplayLegal(WhichDisplay)))
+    {
+      return false;
+    }
+    if (Level > DM_MAX_BRIGHTNESS)
+    {
+      Level = DM_MAX_BRIGHTNESS;
+    }
+    for (Index = 0; Index < DM_NUM_DISPLAYS; Index++)
+    {
+      if ((0 == WhichDisplay) || (Index == (WhichDisplay - 1)))
+      {
+        if (Brightness[Index] != Level)
+        {
+          Brightness[Index] = Level;
+          IsBrightnessPending = true;
+        }
+      }
+    }
+    IsBrightnessInitialized = true;
+    return true;
+}
+
+/****************************************************************************
+ Function
+  DM_GetBrightness
+
+ Description
+  Returns the intensity last set for the display, 0 for an illegal display
+****************************************************************************/
+uint8_t DM_GetBrightness( uint8_t WhichDisplay )
+{
+    if (false == isDisplayLegal(WhichDisplay))
+    {
+      return 0;
+    }
+    return Brightness[WhichDisplay - 1];
+}
+
+/****************************************************************************
+ Function
+  DM_SetShutdown
+
+ Description
+  Records a new shutdown state for one display, or all of them when
+  WhichDisplay is 0. Nothing is sent until DM_TakeBrightnessUpdateStep.
+****************************************************************************/
+bool DM_SetShutdown( bool IsShutdownNow, uint8_t WhichDisplay )
+{
+    uint8_t Index;
+
+    if ((0 != WhichDisplay) && (false == isDisplayLegal(WhichDisplay)))
+    {
+      return false;
+    }
+    for (Index = 0; Index < DM_NUM_DISPLAYS; Index++)
+    {
+      if ((0 == WhichDisplay) || (Index == (WhichDisplay - 1)))
+      {
+        if (IsShutdown[Index] != IsShutdownNow)
+        {
+          IsShutdown[Index] = IsShutdownNow;
+          IsShutdownPending = true;
+        }
+      }
+    }
+    return true;
+}
+
+/****************************************************************************
+ Function
+  DM_TakeBrightnessUpdateStep
+
+ Description
+  If any intensity has changed, sends a single intensity command frame
+  carrying every display's level, then the same for the shutdown states.
+  Returns true once nothing is left to send.
+****************************************************************************/
+bool DM_TakeBrightnessUpdateStep( void )
+{
+    if ((true == IsBrightnessPending) && (false == sendBrightness()))
+    {
+      return false;
+    }
+    if ((true == IsShutdownPending) && (false == sendShutdown()))
+    {
+      return false;
+    }
+    return true;
+}
+
+/****************************************************************************
+ Function
+  DM_SetQueuedOutput
+
+ Description
+  Chooses between blocking output and the interrupt driven SPI1 queue
+****************************************************************************/
+void DM_SetQueuedOutput( bool IsQueued )
+{
+    IsQueuedOutput = IsQueued;
+}
+
+/****************************************************************************
+ Function
+  DM_TakeDirtyRowUpdateStep
+
+ Description
+  Sends the lowest numbered row that has changed since it was last sent.
+  Returns true once no changed rows remain. A row that could not be queued
+  stays dirty.
+****************************************************************************/
+bool DM_TakeDirtyRowUpdateStep( void )
+{
+    uint8_t WhichRow = 0;
+
+    if (0 == DirtyRows)
+    {
+      return true; // nothing changed, nothing to send
+    }
+    while (0 == (DirtyRows & (1 << WhichRow)))
+    {
+      WhichRow++;
+    }
+    if (true == sendRow(WhichRow))
+    {
+      DirtyRows &= ~(1 << WhichRow);
+    }
+    return (0 == DirtyRows);
+}
+
+/****************************************************************************
+ Function
+  DM_AreRowsDirty
+
+ Description
+  Returns true if any row has changed since it was last sent.
+****************************************************************************/
+bool DM_AreRowsDirty( void )
+{
+    return (0 != DirtyRows);
+}
+
+/****************************************************************************
+ Function
+  DM_MarkAllRowsDirty
+
+ Description
+  Marks every row as changed, so the whole frame is sent again.
+****************************************************************************/
+void DM_MarkAllRowsDirty( void )
+{
+    DirtyRows = 0xFF;
+}
+
+/****************************************************************************
+ Function
+  DM_LoadScrollStrip
+
+ Description
+  Renders the message into the off-screen strip for the display and rewinds
+  the scroll position. Characters past DM_SCROLL_MAX_CHARS are dropped.
+****************************************************************************/
+uint16_t DM_LoadScrollStrip( const char *pMsg, uint8_t WhichDisplay )
+{
+    uint8_t Index;
+    uint8_t WhichChar;
+    uint8_t WhichRow;
+    uint8_t Word;
+    uint8_t Shift;
+    uint8_t FontLine;
+
+    if (false == isDisplayLegal(WhichDisplay))
+    {
+      return 0;
+    }
+    Index = WhichDisplay - 1;
+    memset(ScrollStrip[Index], 0, sizeof(ScrollStrip[Index]));
+
+    for (WhichChar = 0; (WhichChar < DM_SCROLL_MAX_CHARS) && 
+                        (pMsg[WhichChar] != '\0'); WhichChar++)
+    {
+      // glyphs are 4 columns wide and 4-column aligned so never straddle words
+      Word = (WhichChar * COLS_PER_CHAR) >> 5;
+      Shift = 28 - ((WhichChar * COLS_PER_CHAR) & 31);
+      // font lines land one row down, as in DM_AddChar2DisplayBuffer
+      for (WhichRow = 0; WhichRow < (NUM_ROWS - 1); WhichRow++)
+      {
+        FontLine = getFontLine((unsigned char)pMsg[WhichChar], WhichRow);
+        ScrollStrip[Index][WhichRow + 1][Word] |= ((uint32_t)FontLine << Shift);
+      }
+    }
+    ScrollStripLen[Index] = (WhichChar * COLS_PER_CHAR) + DM_COLS_PER_DISPLAY;
+    ScrollCol[Index] = 0;
+    return ScrollStripLen[Index];
+}
+
+/****************************************************************************
+ Function
+  DM_TakeScrollStep
+
+ Description
+  Shifts the display buffer left one column and pulls the next strip column
+  in on the right. Only rows whose contents change are marked dirty. Returns
+  true when the strip wraps back to its first column.
+****************************************************************************/
+bool DM_TakeScrollStep( uint8_t WhichDisplay )
+{
+    DM_Row_t *pDisplay;
+    uint8_t Index;
+    uint8_t WhichRow;
+    uint8_t Word;
+    uint8_t Shift;
+    uint64_t NewRow;
+    bool ReturnVal = false;
+
+    if ((false == isDisplayLegal(WhichDisplay)) || 
+        (0 == ScrollStripLen[WhichDisplay - 1]))
+    {
+      return false;
+    }
+    Index = WhichDisplay - 1;
+    pDisplay = DM_DisplayBuffer[Index];
+    Word = ScrollCol[Index] >> 5;
+    Shift = 31 - (ScrollCol[Index] & 31);
+
+    for (WhichRow = 0; WhichRow < NUM_ROWS; WhichRow++)
+    {
+      NewRow = ((pDisplay[WhichRow].FullRow << 1) |
+                ((ScrollStrip[Index][WhichRow][Word] >> Shift) & 1)) & ROW_MASK;
+      if (NewRow != pDisplay[WhichRow].FullRow)
+      {
+        pDisplay[WhichRow].FullRow = NewRow;
+        DirtyRows |= (1 << WhichRow);
+      }
+    }
+
+    if (++ScrollCol[Index] >= ScrollStripLen[Index])
+    {
+      ScrollCol[Index] = 0;
+      ReturnVal = true;
+    }
+    return ReturnVal;
+}
 
 /****************************************************************************
  Function
@@ -202,14 +520,25 @@ bool DM_TakeDisplayUpdateStep( void )
 void DM_ScrollDisplayBuffer( uint8_t NumCols2Scroll, uint8_t WhichDisplay)
 {
     uint8_t WhichRow;
+
+    if (false == isDisplayLegal(WhichDisplay))
+    {
+      return;
+    }
     for (WhichRow = 0; WhichRow < NUM_ROWS; WhichRow++)
     {
-        if (WhichDisplay == 1){
-            DM_Display_1[WhichRow].FullRow <<= NumCols2Scroll; //shift left
-        } else if (WhichDisplay == 2){
-            DM_Display_2[WhichRow].FullRow <<= NumCols2Scroll; //shift left
+        if (NumCols2Scroll >= 64) // a 64-bit shift is undefined in C
+        {
+            DM_DisplayBuffer[WhichDisplay - 1][WhichRow].FullRow = 0;
+        }
+        else
+        {
+            DM_DisplayBuffer[WhichDisplay - 1][WhichRow].FullRow = 
+              (DM_DisplayBuffer[WhichDisplay - 1][WhichRow].FullRow << NumCols2Scroll) 
+                & ROW_MASK; //shift left
         }
     }
+    DirtyRows = 0xFF;
 }
 
 /****************************************************************************
@@ -223,15 +552,18 @@ void DM_ScrollDisplayBuffer( uint8_t NumCols2Scroll, uint8_t WhichDisplay)
 void DM_AddChar2DisplayBuffer( unsigned char Char2Display, uint8_t WhichDisplay)
 {
     uint8_t WhichRow;
-    for (WhichRow = 0; WhichRow < NUM_ROWS; WhichRow++)
+
+    if (false == isDisplayLegal(WhichDisplay))
     {
-        if (WhichDisplay == 1){
-            DM_Display_1[WhichRow+1].ByBytes[0]  |= getFontLine(Char2Display, WhichRow);
-        } else if (WhichDisplay == 2){
-            DM_Display_2[WhichRow+1].ByBytes[0]  |= getFontLine(Char2Display, WhichRow);
-        }
+      return;
     }
-    
+    // font lines land one row down, so stop before running off the buffer
+    for (WhichRow = 0; WhichRow < (NUM_ROWS - 1); WhichRow++)
+    {
+        DM_DisplayBuffer[WhichDisplay - 1][WhichRow+1].ByBytes[0] |= 
+          getFontLine(Char2Display, WhichRow);
+    }
+    DirtyRows = 0xFF;
 }
 
 /****************************************************************************
@@ -244,15 +576,17 @@ void DM_AddChar2DisplayBuffer( unsigned char Char2Display, uint8_t WhichDisplay)
 void DM_ClearDisplayBuffer( uint8_t WhichDisplay )
 {
   uint8_t rowIndex;
+
+  if (false == isDisplayLegal(WhichDisplay))
+  {
+    return;
+  }
   // Now fill the display RAM with Zeros to insure blanked
   for (rowIndex = 0; rowIndex < NUM_ROWS; rowIndex++)
   {
-        if (WhichDisplay == 1){
-            DM_Display_1[rowIndex].FullRow = 0;
-        } else if (WhichDisplay == 2){
-            DM_Display_2[rowIndex].FullRow = 0;
-        }
+    DM_DisplayBuffer[WhichDisplay - 1][rowIndex].FullRow = 0;
   }
+  DirtyRows = 0xFF;
 }
 
 /****************************************************************************
@@ -263,16 +597,15 @@ void DM_ClearDisplayBuffer( uint8_t WhichDisplay )
   Copies the raw data from the Data2Insert parameter into the specified row 
   of the frame buffer 
 ****************************************************************************/
-bool DM_PutDataIntoBufferRow( uint32_t Data2Insert, uint8_t WhichRow, uint8_t WhichDisplay)
+bool DM_PutDataIntoBufferRow( uint64_t Data2Insert, uint8_t WhichRow, uint8_t WhichDisplay)
 {
   bool ReturnVal = true;
-  if (WhichRow < NUM_ROWS) //test for legal row
+  //test for legal row & display
+  if ((WhichRow < NUM_ROWS) && (true == isDisplayLegal(WhichDisplay)))
   {
-        if (WhichDisplay == 1){
-            DM_Display_1[WhichRow].FullRow = Data2Insert; // legal row, so stuff the data into the buffer
-        } else if (WhichDisplay == 2){
-            DM_Display_2[WhichRow].FullRow = Data2Insert; // legal row, so stuff the data into the buffer
-        }
+    // legal row, so stuff the data into the buffer
+    DM_DisplayBuffer[WhichDisplay - 1][WhichRow].FullRow = Data2Insert & ROW_MASK;
+    DirtyRows |= (1 << WhichRow);
   }
   else //Row is not legal
   {
@@ -289,13 +622,14 @@ bool DM_PutDataIntoBufferRow( uint32_t Data2Insert, uint8_t WhichRow, uint8_t Wh
   copies the contents of the specified row of the frame buffer into the
  location pointed to by pReturnValue
 ****************************************************************************/
-bool DM_QueryRowData( uint8_t RowToQuery, uint32_t * pReturnValue)
+bool DM_QueryRowData( uint8_t RowToQuery, uint64_t * pReturnValue, uint8_t WhichDisplay)
 {
   bool ReturnVal = true;
-  // test for legal row
-  if (RowToQuery < NUM_ROWS)
+  // test for legal row & display
+  if ((RowToQuery < NUM_ROWS) && (true == isDisplayLegal(WhichDisplay)))
   {
-      *pReturnValue = DM_Display_1[RowToQuery].FullRow; // legal row, so get data from buffer
+    // legal row, so get data from buffer
+    *pReturnValue = DM_DisplayBuffer[WhichDisplay - 1][RowToQuery].FullRow;
   }
   else //Row not legal
   {
@@ -309,22 +643,125 @@ bool DM_QueryRowData( uint8_t RowToQuery, uint32_t * pReturnValue)
 // private functions
 //*********************************
 
+/****************************************************************************
+ Function
+ isDisplayLegal
+
+ Description
+  Tests that the logical display number is in the range 1..DM_NUM_DISPLAYS
+****************************************************************************/
+static bool isDisplayLegal( uint8_t WhichDisplay )
+{
+    return ((WhichDisplay >= 1) && (WhichDisplay <= DM_NUM_DISPLAYS));
+}
+
+/****************************************************************************
+ Function
+ sendFrame
+
+ Description
+  Sends FrameWords, one word per module, as a single SS frame. The first word
+  ends up in the module furthest down the chain. When queued, returns false
+  if the SPI1 queue has no room, otherwise blocks until SS rises. Chains
+  longer than the transmit buffer wait for room part way through.
+****************************************************************************/
+static bool sendFrame( void )
+{
+    uint8_t index;
+
+    if (true == IsQueuedOutput)
+    {
+        return SPIQueue_SPI1_AddFrame(FrameWords, DM_NUM_MODULES);
+    }
+    for (index = 0; index < (DM_NUM_MODULES - 1); index++)
+    {
+#if DM_NUM_MODULES > SPI_FIFO_DEPTH
+        while (false == SPIOperate_SPI1_HasRoom()){}
+#endif
+        SPIOperate_SPI1_Send16( FrameWords[index] );
+    }
+#if DM_NUM_MODULES > SPI_FIFO_DEPTH
+    while (false == SPIOperate_SPI1_HasRoom()){}
+#endif
+    // then send the final word and wait for the SS line to rise
+    SPIOperate_SPI1_Send16Wait( FrameWords[DM_NUM_MODULES - 1] );
+    return true;
+}
+
 /****************************************************************************
  Function
  sendCmd
 
  Description
-  Send a single command to all 4 modules and waits for the SS to rise to
-  indicate completion.
+  Send a single command to all modules
 ****************************************************************************/
-static void sendCmd( uint16_t Cmd2Send )
+static bool sendCmd( uint16_t Cmd2Send )
 {
     uint8_t index;
-    for (index = 0; index <= (NumModules-2); index++)
+    for (index = 0; index < DM_NUM_MODULES; index++)
     {
-        SPIOperate_SPI1_Send16( Cmd2Send );
+        FrameWords[index] = Cmd2Send;
     }
-    SPIOperate_SPI1_Send16Wait(  Cmd2Send );
+    return sendFrame();
+}
+
+/****************************************************************************
+ Function
+ sendBrightness
+
+ Description
+  Sends one intensity command frame, each module getting the level of the
+  display that it belongs to.
+****************************************************************************/
+static bool sendBrightness( void )
+{
+    uint8_t WhichDisplay;
+    uint8_t WhichModule;
+    uint8_t index = 0;
+
+    for (WhichDisplay = DM_NUM_DISPLAYS; WhichDisplay > 0; WhichDisplay--)
+    {
+        for (WhichModule = 0; WhichModule < DM_MODULES_PER_DISPLAY; WhichModule++)
+        {
+            FrameWords[index++] = DM_SET_BRIGHTNESS(Brightness[WhichDisplay - 1]);
+        }
+    }
+    if (false == sendFrame())
+    {
+        return false;
+    }
+    IsBrightnessPending = false;
+    return true;
+}
+
+/****************************************************************************
+ Function
+ sendShutdown
+
+ Description
+  Sends one shutdown command frame, each module getting the state of the
+  display that it belongs to.
+****************************************************************************/
+static bool sendShutdown( void )
+{
+    uint8_t WhichDisplay;
+    uint8_t WhichModule;
+    uint8_t index = 0;
+
+    for (WhichDisplay = DM_NUM_DISPLAYS; WhichDisplay > 0; WhichDisplay--)
+    {
+        for (WhichModule = 0; WhichModule < DM_MODULES_PER_DISPLAY; WhichModule++)
+        {
+            FrameWords[index++] = (true == IsShutdown[WhichDisplay - 1]) ?
+                                    DM_START_SHUTDOWN : DM_END_SHUTDOWN;
+        }
+    }
+    if (false == sendFrame())
+    {
+        return false;
+    }
+    IsShutdownPending = false;
+    return true;
 }
 
 /****************************************************************************
@@ -332,27 +769,199 @@ static void sendCmd( uint16_t Cmd2Send )
  sendRow
 
  Description
-  Sends a row of data to the 4-module cluster. Translates from the logical
- row number to the MAX7219 row numbers (mirrors)
+  Sends a row of data to the whole module chain. Translates from the logical
+ row number to the MAX7219 row numbers (mirrors). The displays are sent last
+ to first, each starting with its right-most byte.
 ****************************************************************************/
-static void sendRow( uint8_t RowNum, DM_Row_t RowData_1 ,  DM_Row_t RowData_2)
+static bool sendRow( uint8_t RowNum )
 {
-     uint8_t index;
+    uint8_t WhichDisplay;
+    uint8_t WhichByte;
+    uint16_t RowCmd;
+    uint8_t index = 0;
     // The rows on the display are mirrored relative to the rows in the memory
-    RowNum = NUM_ROWS - (RowNum+1); // this will swap them top to bottom
-    // loop through, sending the first 3 values as fast as possible
-    for (index = 0; index <= (NumModules-2); index++)
-    {
-        if (index < 4){
-            SPIOperate_SPI1_Send16( ((((uint16_t)RowNum+1)<<8) | 
-                              BitReverseTable256[(RowData_2.ByBytes[index])]));
-        } else if (index < 7){
-            SPIOperate_SPI1_Send16( ((((uint16_t)RowNum+1)<<8) | 
-                              BitReverseTable256[(RowData_1.ByBytes[index-4])]));
+    // this will swap them top to bottom
+    RowCmd = ((uint16_t)(NUM_ROWS - RowNum)) << 8;
+
+    for (WhichDisplay = DM_NUM_DISPLAYS; WhichDisplay > 0; WhichDisplay--)
+    {
+        for (WhichByte = 0; WhichByte < DM_MODULES_PER_DISPLAY; WhichByte++)
+        {
+            FrameWords[index++] = RowCmd | BitReverseTable256[
+                        DM_DisplayBuffer[WhichDisplay - 1][RowNum].ByBytes[WhichByte]];
         }
     }
-    // then send the final byte and wait for the SS line to rise
-    SPIOperate_SPI1_Send16Wait( 
-                      ((((uint16_t)RowNum+1)<<8) | 
-                          BitReverseTable256[(RowData_1.ByBytes[3])]));
+    return sendFrame();
+}
+
+/*------------------------------- Test Harness ----------------------------*/
+#ifdef TEST
+/* Host test of the SPI word stream emitted for a given chain length. The
+   SPI HAL is replaced by a capture buffer. Build and run once per length:
+   gcc -DTEST -DDM_NUM_MODULES=4 -DDM_NUM_DISPLAYS=1 -IHostTools/include 
+       -IProjectHeaders ProjectSource/DM_DisplayStarter.c 
+       ProjectSource/FontStuff.c -o dm_test && ./dm_test
+   and again with DM_NUM_MODULES=8 and DM_NUM_MODULES=16 (2 displays).
+*/
+#include <stdio.h>
+
+static uint16_t CapturedWords[DM_NUM_MODULES * NUM_ROWS * 2];
+static uint16_t NumCaptured;
+static uint8_t NumFrames; // counts SS rises
+
+void SPIOperate_SPI1_Send16( uint16_t TheData)
+{
+  if (NumCaptured < (sizeof(CapturedWords) / sizeof(CapturedWords[0])))
+  {
+    CapturedWords[NumCaptured] = TheData;
+  }
+  NumCaptured++;
+}
+
+void SPIOperate_SPI1_Send16Wait( uint16_t TheData)
+{
+  SPIOperate_SPI1_Send16(TheData);
+  NumFrames++;
+}
+
+bool SPIOperate_SPI1_HasRoom(void)
+{
+  return true;
+}
+
+bool SPIQueue_SPI1_AddFrame(const uint16_t *pWords, uint8_t NumWords)
+{
+  (void)pWords;
+  (void)NumWords;
+  return false; // the harness only exercises blocking output
+}
+
+static uint8_t NumFailed = 0;
+
+static void check(bool Passed, const char *pWhat)
+{
+  if (false == Passed)
+  {
+    printf("FAIL: %s\n", pWhat);
+    NumFailed++;
+  }
+}
+
+static void resetCapture(void)
+{
+  NumCaptured = 0;
+  NumFrames = 0;
+}
+
+// unique-ish test byte for each display, row and module position
+static uint8_t patternByte(uint8_t WhichDisplay, uint8_t WhichRow, uint8_t WhichByte)
+{
+  return (uint8_t)((WhichDisplay << 6) ^ (WhichRow << 3) ^ WhichByte ^ 0x5A);
+}
+
+int main(void)
+{
+  uint8_t WhichDisplay;
+  uint8_t WhichRow;
+  uint8_t WhichByte;
+  uint64_t RowData;
+  uint16_t Index;
+  bool StreamOK = true;
+
+  printf("DM_Display chain test: %d modules, %d displays of %d columns\n",
+         DM_NUM_MODULES, DM_NUM_DISPLAYS, DM_COLS_PER_DISPLAY);
+
+  // a command goes to every module in a single frame
+  resetCapture();
+  DM_TakeInitDisplayStep(); // start shutdown
+  check(NumCaptured == DM_NUM_MODULES, "command word count");
+  check(NumFrames == 1, "command frame count");
+  for (Index = 0; Index < DM_NUM_MODULES; Index++)
+  {
+    StreamOK &= (CapturedWords[Index] == DM_START_SHUTDOWN);
+  }
+  check(StreamOK, "command word values");
+  while (false == DM_TakeInitDisplayStep()) {}
+
+  // fill every row of every display with a known pattern
+  for (WhichDisplay = 1; WhichDisplay <= DM_NUM_DISPLAYS; WhichDisplay++)
+  {
+    for (WhichRow = 0; WhichRow < NUM_ROWS; WhichRow++)
+    {
+      RowData = 0;
+      for (WhichByte = 0; WhichByte < DM_MODULES_PER_DISPLAY; WhichByte++)
+      {
+        RowData |= ((uint64_t)patternByte(WhichDisplay, WhichRow, WhichByte)) 
+                      << (8 * WhichByte);
+      }
+      check(DM_PutDataIntoBufferRow(RowData, WhichRow, WhichDisplay), "put row");
+    }
+  }
+
+  // a full update is one frame per row, last display first, LSB first
+  resetCapture();
+  while (false == DM_TakeDisplayUpdateStep()) {}
+  check(NumCaptured == (DM_NUM_MODULES * NUM_ROWS), "update word count");
+  check(NumFrames == NUM_ROWS, "update frame count");
+  Index = 0;
+  StreamOK = true;
+  for (WhichRow = 0; WhichRow < NUM_ROWS; WhichRow++)
+  {
+    for (WhichDisplay = DM_NUM_DISPLAYS; WhichDisplay > 0; WhichDisplay--)
+    {
+      for (WhichByte = 0; WhichByte < DM_MODULES_PER_DISPLAY; WhichByte++)
+      {
+        StreamOK &= (CapturedWords[Index++] == 
+          ((uint16_t)((NUM_ROWS - WhichRow) << 8) | 
+           BitReverseTable256[patternByte(WhichDisplay, WhichRow, WhichByte)]));
+      }
+    }
+  }
+  check(StreamOK, "update word values");
+
+  // nothing changed, so the dirty row update sends nothing
+  resetCapture();
+  check(DM_TakeDirtyRowUpdateStep(), "clean buffer reports done");
+  check(NumCaptured == 0, "clean buffer sends nothing");
+
+  // one changed row costs exactly one frame
+  DM_PutDataIntoBufferRow(0, 3, 1);
+  resetCapture();
+  while (false == DM_TakeDirtyRowUpdateStep()) {}
+  check((NumCaptured == DM_NUM_MODULES) && (NumFrames == 1), "single dirty row");
+
+  // a column shifted off the left edge is gone, across byte boundaries too
+  DM_PutDataIntoBufferRow((1ULL << (DM_COLS_PER_DISPLAY - 1)) | 0x80, 0, 1);
+  DM_ScrollDisplayBuffer(1, 1);
+  DM_QueryRowData(0, &RowData, 1);
+  check(RowData == 0x100, "scroll across the row");
+
+  // an intensity change is a single frame, each module gets its display's level
+  resetCapture();
+  check(DM_TakeBrightnessUpdateStep() && (0 == NumCaptured), 
+        "unchanged intensity sends nothing");
+  DM_SetBrightness(3, 1);
+  check(DM_TakeBrightnessUpdateStep(), "changed intensity is sent");
+  check((NumCaptured == DM_NUM_MODULES) && (NumFrames == 1), "intensity frame size");
+  check(CapturedWords[DM_NUM_MODULES - 1] == DM_SET_BRIGHTNESS(3), "display 1 intensity");
+  check(CapturedWords[0] == DM_SET_BRIGHTNESS((1 == DM_NUM_DISPLAYS) ? 3 : 
+                                DM_DEFAULT_BRIGHTNESS), "last display intensity");
+
+  // blanking uses the shutdown register and leaves the intensity alone
+  resetCapture();
+  DM_SetShutdown(true, 1);
+  check(DM_TakeBrightnessUpdateStep(), "shutdown is sent");
+  check((NumCaptured == DM_NUM_MODULES) && (NumFrames == 1), "shutdown frame size");
+  check(CapturedWords[DM_NUM_MODULES - 1] == DM_START_SHUTDOWN, "display 1 blanked");
+  check(CapturedWords[0] == ((1 == DM_NUM_DISPLAYS) ? DM_START_SHUTDOWN : 
+                                DM_END_SHUTDOWN), "last display shutdown state");
+  check(3 == DM_GetBrightness(1), "blanking keeps the intensity");
+  resetCapture();
+  DM_SetShutdown(false, 0);
+  check(DM_TakeBrightnessUpdateStep(), "wake is sent");
+  check(CapturedWords[DM_NUM_MODULES - 1] == DM_END_SHUTDOWN, "display 1 lit");
+
+  printf("%s: %d failures\n", (0 == NumFailed) ? "PASS" : "FAIL", NumFailed);
+  return NumFailed;
 }
+#endif
@@ -0,0 +1,82 @@
+/****************************************************************************
+ Module
+     Debounce.c
+ Description
+     Vertical counter debouncer. See Debounce.h.
+ Notes
+     Bit n of Count[k] is bit k of input n's counter. Incrementing every
+     counter at once is a ripple carry down the planes, with the inputs that
+     agree with their debounced level cleared on the way in. Then an input
+     whose counter equals Target in every plane has held its new level long
+     enough: its State bit flips and its counter clears.
+*****************************************************************************/
+/*----------------------------- Include Files -----------------------------*/
+#include <stdbool.h>
+#include <stdint.h>
+#include "Debounce.h"
+
+/*------------------------------ Module Code ------------------------------*/
+/****************************************************************************
+ Function
+    Debounce_Init
+****************************************************************************/
+bool Debounce_Init(Debounce_t *pDebounce, uint32_t Initial,
+                   uint8_t StableSamples)
+{
+  uint8_t k;
+
+  if ((0 == StableSamples) || (StableSamples > DEBOUNCE_MAX_STABLE))
+  {
+    return false;
+  }
+  pDebounce->State = Initial;
+  for (k = 0; k < DEBOUNCE_COUNTER_BITS; k++)
+  {
+    pDebounce->Count[k] = 0;
+    pDebounce->Target[k] = (0 != (StableSamples & (1 << k))) ? UINT32_MAX : 0;
+  }
+  return true;
+}
+
+/****************************************************************************
+ Function
+    Debounce_Sample
+****************************************************************************/
+uint32_t Debounce_Sample(Debounce_t *pDebounce, uint32_t Raw)
+{
+  uint32_t Delta = Raw ^ pDebounce->State;
+  uint32_t Carry = Delta;
+  uint32_t Done = Delta;
+  uint32_t Plane;
+  uint8_t k;
+
+  for (k = 0; k < DEBOUNCE_COUNTER_BITS; k++)
+  {
+    Plane = pDebounce->Count[k] & Delta;
+    pDebounce->Count[k] = Plane ^ Carry;
+    Carry &= Plane;
+    Done &= ~(pDebounce->Count[k] ^ pDebounce->Target[k]);
+  }
+  pDebounce->State ^= Done;
+  for (k = 0; k < DEBOUNCE_COUNTER_BITS; k++)
+  {
+    pDebounce->Count[k] &= ~Done;
+  }
+  return Done;
+}
+
+/****************************************************************************
+ Function
+    Debounce_Busy
+****************************************************************************/
+uint32_t Debounce_Busy(const Debounce_t *pDebounce)
+{
+  uint32_t Busy = 0;
+  uint8_t k;
+
+  for (k = 0; k < DEBOUNCE_COUNTER_BITS; k++)
+  {
+    Busy |= pDebounce->Count[k];
+  }
+  return Busy;
+}
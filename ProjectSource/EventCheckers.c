@@ -39,8 +39,11 @@
 // include our own prototypes to insure consistency between header &
 // actual functionsdefinition
 #include "EventCheckers.h"
-#include "dbprintf.h"
+#define BINLOG_MODULE BINLOG_MODULE_EVENTS
+#include "binlog.h"
 #include "PWM_PIC32.h"
+#include "SensorCapture.h"
+#include "PotSampler.h"
 
 // This is the event checking function sample. It is not intended to be
 // included in the module. It is only here as a sample to guide you in writing
@@ -95,117 +98,86 @@ bool Check4Keystroke(void)
 }
 
 
-#define NUM_HALL_EFFECT 6
-#define FIRST_HALL_PIN 5
-#define LAST_HALL_PIN 10
+// event posted for a falling edge on each sensor, indexed by Sensor_t
+static const ES_EventType_t SensorEvents[NUM_SENSORS] = {
+    [SENSOR_PLANET_1]   = ES_PLANET_HIT,
+    [SENSOR_PLANET_2]   = ES_PLANET_HIT,
+    [SENSOR_PLANET_3]   = ES_PLANET_HIT,
+    [SENSOR_PLANET_4]   = ES_PLANET_HIT,
+    [SENSOR_ASTEROID]   = ES_ASTEROID_HIT,
+    [SENSOR_BLACK_HOLE] = ES_BLACKHOLE_HIT,
+    [SENSOR_COIN]       = ES_COIN_INSERT
+};
 
-#define HALL_PIN_HI 1
-#define HALL_PIN_LO 0
-
-static ES_EventType_t HallEffectEvents[] = {ES_PLANET_HIT,
-                                            ES_PLANET_HIT,
-                                            ES_PLANET_HIT,
-                                            ES_PLANET_HIT,
-                                            ES_ASTEROID_HIT,
-                                            ES_BLACKHOLE_HIT};
-
-static uint8_t LastHallEffectVals[NUM_HALL_EFFECT];
-bool FirstRun = true;
-
-static uint8_t HallEffectVal[NUM_HALL_EFFECT];
-
-// BUG should init last vals to PORT read
-bool CheckHallEffect(void)
+/****************************************************************************
+ Function
+   CheckSensorEdges
+ Parameters
+   None
+ Returns
+   bool: true if a new event was detected & posted
+ Description
+   Takes the oldest falling edge from SensorCapture, polled or captured by
+   the CN interrupt, and posts the event for its sensor: a planet, asteroid
+   or black hole hit from the Hall effect sensors, or a coin from the IR
+   sensor. The EventParam is the Sensor_t, so planet hits carry the planet
+   number 0-3. Warns if edges were lost to a full capture ring.
+****************************************************************************/
+bool CheckSensorEdges(void)
 {
-    if (FirstRun){
-        LastHallEffectVals[0] = PORTBbits.RB5; // planet 1
-        LastHallEffectVals[1] = PORTBbits.RB8; // planet 2
-        LastHallEffectVals[2] = PORTAbits.RA2; // planet 3
-        LastHallEffectVals[3] = PORTAbits.RA3; // planet 4
-        LastHallEffectVals[4] = PORTBbits.RB9; // asteroid
-        LastHallEffectVals[5] = PORTBbits.RB10; // black hole
-        FirstRun = false;
-    }
-    
-    bool ReturnVal = false;
-    HallEffectVal[0] = PORTBbits.RB5; // planet 1
-    HallEffectVal[1] = PORTBbits.RB8; // planet 2
-    HallEffectVal[2] = PORTAbits.RA2; // planet 3
-    HallEffectVal[3] = PORTAbits.RA3; // planet 4
-    HallEffectVal[4] = PORTBbits.RB9; // asteroid
-    HallEffectVal[5] = PORTBbits.RB10; // black hole
-            
-    for (uint8_t i = 0; i <= NUM_HALL_EFFECT; i++) {        
-        if ((HallEffectVal[i] != LastHallEffectVals[i]) && (HallEffectVal[i] == HALL_PIN_LO)) // event detected, so post detected event
-        {
-            DB_printf("HALL EFFECT EVENT\n"); 
-            ES_Event_t ThisEvent;
-            ThisEvent.EventType = HallEffectEvents[i];
-            ThisEvent.EventParam = i;
-            ES_PostAll(ThisEvent);
-            ReturnVal = true;
-        }
-        LastHallEffectVals[i] = HallEffectVal[i];
-    }
+    static uint16_t LastOverruns;
+    SensorEdge_t Edge;
+    uint16_t Overruns;
 
-    return ReturnVal;
-}
-
-static uint8_t CurrentVal; // black hole
-static uint8_t LastVal = 0; // black hole
-
-bool CheckIRSensor(void)
-{
-    bool ReturnVal = false;
-    static uint8_t CurrentVal; // black hole
-    static uint8_t LastVal = 1; // black hole
-    CurrentVal = PORTBbits.RB2; // black hole
-            
-    if ((CurrentVal != LastVal) && (CurrentVal == 0)) // event detected, so post detected event
-    {
-        ES_Event_t ThisEvent;
-        ThisEvent.EventType = ES_COIN_INSERT;
-        ES_PostAll(ThisEvent);
-        ReturnVal = true;
+    if (false == SensorCapture_GetEdge(&Edge)){
+        return false;
     }
-    LastVal = CurrentVal;
-
-    return ReturnVal;
+    Overruns = SensorCapture_GetOverruns();
+    if (Overruns != LastOverruns){
+        LOG_WARN("sensor edges lost: %u\n",
+                 (uint16_t)(Overruns - LastOverruns));
+        LastOverruns = Overruns;
+    }
+    ES_Event_t ThisEvent;
+    ThisEvent.EventType = SensorEvents[Edge.WhichSensor];
+    ThisEvent.EventParam = Edge.WhichSensor;
+    ES_PostAll(ThisEvent);
+    return true;
 }
 
 
+/****************************************************************************
+ Function
+   CheckPotSensor
+ Parameters
+   None
+ Returns
+   bool: true if a new event was detected & posted
+ Description
+   Posts ES_NEW_POT, with the new level 1-100 as the EventParam, whenever
+   the filtered knob level from PotSampler moves. The sampling, filtering
+   and hysteresis all happen in the ADC interrupt, so this is a one byte
+   compare. The level found on the first call is taken as already known.
+****************************************************************************/
 bool CheckPotSensor(void)
 {   
-    bool ReturnVal = false;
-    static uint32_t CurrentVal;
-    static uint32_t LastVal = 0;
+    static uint8_t LastLevel;
     static bool FirstTrigger = true;
+    uint8_t CurrentLevel = PotSampler_GetLevel();
     
-    uint32_t PotNum[1];
-    ADC_MultiRead(PotNum);
-    CurrentVal = PotNum[0];
-    
-    if (!FirstTrigger){
-        if ((CurrentVal != LastVal) && (abs(CurrentVal - LastVal) > 10)) // event detected, so post detected event
-        {      
-            ES_Event_t ThisEvent;
-            ThisEvent.EventType = ES_NEW_POT;
-            int16_t Val = 100 * (CurrentVal) / 1023;
-            if (Val <= 0){
-                Val = 1;
-            } else if (Val >= 100){
-                Val = 100;
-            }
-            ThisEvent.EventParam = Val;
-            ES_PostAll(ThisEvent);
-            ReturnVal = true;
-            LastVal = CurrentVal;
-        }
-    }
-    else {
+    if (FirstTrigger){
         FirstTrigger = false;
-        LastVal = CurrentVal;
+        LastLevel = CurrentLevel;
+        return false;
     }
-
-    return ReturnVal;
+    if (CurrentLevel == LastLevel){
+        return false;
+    }
+    ES_Event_t ThisEvent;
+    LOG_DEBUG("pot level %u\n", CurrentLevel);
+    ThisEvent.EventType = ES_NEW_POT;
+    ThisEvent.EventParam = CurrentLevel;
+    ES_PostAll(ThisEvent);
+    LastLevel = CurrentLevel;
+    return true;
 }
\ No newline at end of file
@@ -14,13 +14,17 @@
 #include "ES_Framework.h"
 #include "GameService.h"
 #include "LEDService.h"
-#include "PIC32_AD_Lib.h"
+#include "PotSampler.h"
 #include "PIC32_SPI_HAL.h"
 #include "ShiftService.h"
+#include "LEDSeqService.h"
 #include "BuzzService.h"
+#include "HapticService.h"
+#include "SensorCapture.h"
 #include "PWM_PIC32.h"
 
-#include "dbprintf.h"
+#define BINLOG_MODULE BINLOG_MODULE_GAME
+#include "binlog.h"
 #include <stdlib.h>
 #include <stdio.h>
 #include <string.h>
@@ -35,10 +39,9 @@
 #define ENTER_RUN      ((MyPriority<<3)|1)
 #define ENTER_TIMEOUT  ((MyPriority<<3)|2)
 
-#define PLANET_LED 0
-#define BLACKHOLE_LED 4
-#define TIMING_LED 7
-#define COIN_LED 5
+#define NO_LEDS 0x0000
+#define START_LEDS 0x1FE0   // coin LED and the countdown bar, outputs 5-12
+#define GAME_OVER_WORDS 6 // SCORE!/FINAL! swaps across the game over time, each flashed once
 /*---------------------------- Module Functions ---------------------------*/
 /* prototypes for private functions for this service.They should be functions
    relevant to the behavior of this service
@@ -46,7 +49,11 @@
 void GetNewPlanet(void);
 void UpdateScore(int16_t DeltaScore);
 void UpdateDisplay(uint8_t WhichDisplay, char *Msg);
+void ScrollDisplay(uint8_t WhichDisplay, char *Msg);
 void GetDifficulty(uint8_t Level);
+static void PlayLEDSequence(LEDSeq_t WhichSeq);
+static void StopLEDSequence(LEDSeq_t WhichSeq);
+static void PlayHaptic(HapticPattern_t WhichPattern);
 
 /*---------------------------- Module Variables ---------------------------*/
 // State Machine Variables
@@ -59,16 +66,11 @@ uint8_t Countdown;
 int8_t TargetPlanet;
 int16_t Score;
 bool BlackHole;
-uint8_t ShiftRegisterVals[13];
 
 // Timing Variables
-bool AsteroidTimeout;
-bool CoinTimeout;
 static uint32_t GameInterval = 1000*10; // timer interval
 static uint32_t UserInputTimeout = 1000*20; // timer interval
-static uint32_t AsteroidDelay = 1000*1;
-static uint32_t CoinDelay = 300;
-static uint32_t GameOverTime = 1000*7; // time after game ends before restart
+static uint32_t GameOverTime = GAME_OVER_TIME; // time after game ends before restart
 static uint32_t LevelDisplayTime = 1500;
 
 // Difficulty Variables
@@ -115,37 +117,30 @@ bool InitGameService(uint8_t Priority)
     TRISBbits.TRISB2 = 1;   //B2 as input
     ANSELBbits.ANSB2 = 0;   //B2 as digital
     
+    // Start watching the sensors for hits and coins
+    SensorCapture_Init(SENSOR_CAPTURE_DEFAULT_MODE);
+    
     // Init Potentiometer Input
     TRISBbits.TRISB3 = 1;   //B3 as input
     ANSELBbits.ANSB3 = 1;   //B3 as analog
-    ADC_ConfigAutoScan(BIT5HI);
+    PotSampler_Init();
     
     // Init Difficulty
-    uint32_t PotNum[1];
-    ADC_MultiRead(PotNum);
-    int16_t Val = 100 * (1023-PotNum[0]) / 1023;
-    if (Val <= 0){
-        Val = 1;
-    } else if (Val >= 100){
-        Val = 100;
-    }
-    GetDifficulty(Val);
+    GetDifficulty(PotSampler_GetLevel());
     
     MyPriority = Priority;
 
     // Init Game Variables
     Score = 0;
     BlackHole = false;
-    AsteroidTimeout = false;
-    CoinTimeout = false;
     Countdown = 6;
     TargetPlanet = -1;
 
-    DB_printf("InitGameService\n");
-    DB_printf("Press 'c' to insert a coin\n");
-    DB_printf("Press 'p' for a planet hit\n");
-    DB_printf("Press 'a' for a asteroid hit\n");
-    DB_printf("Press 'b' for a blackhole hit\n");
+    LOG_INFO("InitGameService\n");
+    LOG_INFO("Press 'c' to insert a coin\n");
+    LOG_INFO("Press 'p' for a planet hit\n");
+    LOG_INFO("Press 'a' for a asteroid hit\n");
+    LOG_INFO("Press 'b' for a blackhole hit\n");
 
     // Init State Machine
     NextState = Waiting2Coins;
@@ -213,57 +208,40 @@ ES_Event_t RunGameService(ES_Event_t ThisEvent)
   {
     case Waiting2Coins:
     {
-        DB_printf("Waiting2Coins\n");
+        LOG_DEBUG("Waiting2Coins\n");
 
         // Reset game Variables
         Score = 0;
         BlackHole = false;
-        AsteroidTimeout = false;
-        CoinTimeout = false;
         Countdown = 6;
         TargetPlanet = -1;
 
         if (ThisEvent.EventType == ES_INIT){
             UpdateDisplay(2, "2 CNS");
-            UpdateDisplay(1, "INSERT");
+            ScrollDisplay(1, "INSERT COINS TO PLAY");
         }
         else if (ThisEvent.EventType == ES_TIMEOUT){
             if (ThisEvent.EventParam == 11){ // countdown timer
                 UpdateDisplay(2, "2 CNS");
-                UpdateDisplay(1, "INSERT");
+                ScrollDisplay(1, "INSERT COINS TO PLAY");
                 
                 // Reset LEDs to initial state
-                uint8_t newVals[13] = {0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0};
-                memcpy(ShiftRegisterVals, newVals, sizeof(ShiftRegisterVals));
-
-                // Post LED update event
-                static ES_Event_t ShiftEvent;
-                ShiftEvent.EventType = ES_UPDATE_SHIFT;
-                ShiftEvent.EventParam = MyPriority;
-                PostShiftService(ShiftEvent);
+                Shift_SetLEDs(NO_LEDS);
             }
         }
         // If first coin was inserted proceed to next state
         else if (ThisEvent.EventType == ES_COIN_INSERT){
-            //ScrollDisplay(2, "HELLO EMMA AND LIAM");
             UpdateDisplay(2, "1 CN");
             UpdateDisplay(1, "INSERT");
             
             ES_Event_t BuzzEvent;
             BuzzEvent.EventType = ES_BUZZ;
-            BuzzEvent.EventParam = 4;
+            BuzzEvent.EventParam = BUZZ_COIN;
             PostBuzzService(BuzzEvent);
+            PlayHaptic(HAPTIC_PULSE);
             
             // Update coin LED
-            ShiftRegisterVals[COIN_LED] = 1;
-            static ES_Event_t ShiftEvent;
-            ShiftEvent.EventType = ES_UPDATE_SHIFT;
-            ShiftEvent.EventParam = MyPriority;
-            PostShiftService(ShiftEvent);
-            
-            // Coin delay
-            CoinTimeout = true;
-            ES_Timer_InitTimer(COIN_DELAY_TIMER, CoinDelay);
+            Shift_SetLED(COIN_LED, true);
             
             // User Input timer
             ES_Timer_InitTimer(USER_INPUT_TIMER, UserInputTimeout);
@@ -286,32 +264,26 @@ ES_Event_t RunGameService(ES_Event_t ThisEvent)
     case Waiting1Coins:
     {
         // If second coin was inserted proceed to next state
-        if (ThisEvent.EventType == ES_COIN_INSERT && CoinTimeout == false){
-            DB_printf("Starting the Game!!!\n");
+        if (ThisEvent.EventType == ES_COIN_INSERT){
+            LOG_INFO("Starting the Game!!!\n");
 
             UpdateDisplay(2, "PLAY!");
             UpdateScore(0);
             
             ES_Event_t BuzzEvent;
             BuzzEvent.EventType = ES_BUZZ;
-            BuzzEvent.EventParam = 5;
+            BuzzEvent.EventParam = BUZZ_START_TUNE;
             PostBuzzService(BuzzEvent);
+            PlayHaptic(HAPTIC_DOUBLE_PULSE);
             
             // Reset LEDs to initial state
-            uint8_t newVals[13] = {0, 0, 0, 0, 0, 1, 1, 1, 1, 1, 1, 1, 1};
-            memcpy(ShiftRegisterVals, newVals, sizeof(ShiftRegisterVals));
-
-            // Post LED update event
-            static ES_Event_t ShiftEvent;
-            ShiftEvent.EventType = ES_UPDATE_SHIFT;
-            ShiftEvent.EventParam = MyPriority;
-            PostShiftService(ShiftEvent);
+            Shift_SetLEDs(START_LEDS);
             
             // update planet for start
             GetNewPlanet();
 
             // get difficulty
-            DB_printf("Difficulty Level: %d\n",DifficultyLevel);
+            LOG_INFO("Difficulty Level: %d\n",DifficultyLevel);
 
             // Start all game timers
             ES_Timer_InitTimer(PLANET_TIMER, PlanetSwitchTime);
@@ -321,10 +293,7 @@ ES_Event_t RunGameService(ES_Event_t ThisEvent)
 
             NextState = GameOn;
         } else if (ThisEvent.EventType == ES_TIMEOUT){
-            if(ThisEvent.EventParam == 7){ //COIN_DELAY_TIMER
-                DB_printf("COIN_DELAY_TIMER\n");
-                CoinTimeout = false; // turn off coin delay
-            } else if (ThisEvent.EventParam == 11){ // COUNTDOWN TIMER
+            if (ThisEvent.EventParam == 11){ // COUNTDOWN TIMER
                 UpdateDisplay(2, "1 CN");
                 UpdateDisplay(1, "INSERT");
             } else if(ThisEvent.EventParam == 10){
@@ -351,17 +320,27 @@ ES_Event_t RunGameService(ES_Event_t ThisEvent)
     case GameOn:
     {
         // Serial print out
-        DB_printf("---------------------------------\n");
-        DB_printf("GameOn for %d more seconds\n",Countdown*10);
-        DB_printf("Score: %d\n",Score);
-        DB_printf("Target Planet: %d\n",TargetPlanet+1);
-        DB_printf("BlackHole: %s\n",BlackHole ? "ON" : "OFF");
-        DB_printf("---------------------------------\n");
+        LOG_DEBUG("---------------------------------\n");
+        LOG_DEBUG("GameOn for %d more seconds\n",Countdown*10);
+        LOG_DEBUG("Score: %d\n",Score);
+        LOG_DEBUG("Target Planet: %d\n",TargetPlanet+1);
+        if (BlackHole){ // no %s in a tokenized log
+            LOG_DEBUG("BlackHole: ON\n");
+        } else {
+            LOG_DEBUG("BlackHole: OFF\n");
+        }
+        LOG_DEBUG("---------------------------------\n");
         
         // Timeout cases
         if (ThisEvent.EventType == ES_TIMEOUT){
             if(ThisEvent.EventParam == 14){ //PLANET_TIMER
                 GetNewPlanet();
+                
+                ES_Event_t BuzzEvent;
+                BuzzEvent.EventType = ES_BUZZ;
+                BuzzEvent.EventParam = BUZZ_ZAP;
+                PostBuzzService(BuzzEvent);
+                
                 ES_Timer_InitTimer(PLANET_TIMER, PlanetSwitchTime); //Start planet timer
             }
             else if(ThisEvent.EventParam == 13){ //BLACKHOLE_TIMER
@@ -369,23 +348,25 @@ ES_Event_t RunGameService(ES_Event_t ThisEvent)
                     if ((rand() % 100) < BlackHoleProb){ // turn on Black Hole
                         BlackHole = true; //toggle
                         
-                        // Update black hole LED
-                        ShiftRegisterVals[BLACKHOLE_LED] = 1;
-                        ES_Event_t myEvent;
-                        myEvent.EventType = ES_UPDATE_SHIFT;
-                        myEvent.EventParam = MyPriority;
-                        PostShiftService(myEvent);
+                        ES_Event_t BuzzEvent;
+                        BuzzEvent.EventType = ES_BUZZ;
+                        BuzzEvent.EventParam = BUZZ_BOOM;
+                        PostBuzzService(BuzzEvent);
+                        
+                        // blink the black hole LED while it is active
+                        PlayLEDSequence(LED_SEQ_BLACK_HOLE);
                     }
                 } else { // Blackhole == true
                     if ((rand() % 100) < (100 - BlackHoleProb)){ // turn off Black Hole
                         BlackHole = false; //toggle
                         
+                        ES_Event_t BuzzEvent;
+                        BuzzEvent.EventType = ES_BUZZ;
+                        BuzzEvent.EventParam = BUZZ_CHIME;
+                        PostBuzzService(BuzzEvent);
+                        
                         // update black hole LED
-                        ShiftRegisterVals[BLACKHOLE_LED] = 0;
-                        ES_Event_t myEvent;
-                        myEvent.EventType = ES_UPDATE_SHIFT;
-                        myEvent.EventParam = MyPriority;
-                        PostShiftService(myEvent);
+                        StopLEDSequence(LED_SEQ_BLACK_HOLE);
                     }
                 }
                 ES_Timer_InitTimer(BLACKHOLE_TIMER, BlackHoleSampleTime); // Restart black hole timer
@@ -395,23 +376,23 @@ ES_Event_t RunGameService(ES_Event_t ThisEvent)
                     ES_Timer_InitTimer(COUNTDOWN_TIMER, GameInterval); //Start 10s timer
                     
                     //Update time LEDs
-                    ShiftRegisterVals[TIMING_LED+Countdown-1] = 0;
-                    ES_Event_t myEvent;
-                    myEvent.EventType = ES_UPDATE_SHIFT;
-                    myEvent.EventParam = MyPriority;
-                    PostShiftService(myEvent);
+                    Shift_SetLED(TIMING_LED+Countdown-1, false);
                     
                     Countdown--;
                 }
                 else{ // Game over
                     ES_Event_t BuzzEvent;
                     BuzzEvent.EventType = ES_BUZZ;
-                    BuzzEvent.EventParam = 6;
+                    BuzzEvent.EventParam = BUZZ_END_TUNE;
                     PostBuzzService(BuzzEvent);
+                    PlayHaptic(HAPTIC_RUMBLE_FADE);
                     
                     NextState = GameOver;
-                    Countdown = 6;
-                    ES_Timer_InitTimer(COUNTDOWN_TIMER, GameOverTime/6);
+                    Countdown = GAME_OVER_WORDS;
+                    UpdateDisplay(2, "FINAL!");
+                    LED_FlashBrightness(0, 1, GameOverTime/GAME_OVER_WORDS);
+                    PlayLEDSequence(LED_SEQ_GAME_OVER);
+                    ES_Timer_InitTimer(COUNTDOWN_TIMER, GameOverTime/GAME_OVER_WORDS);
                     ES_Timer_StopTimer(PLANET_TIMER);
                     ES_Timer_StopTimer(BLACKHOLE_TIMER);
                 }
@@ -422,29 +403,24 @@ ES_Event_t RunGameService(ES_Event_t ThisEvent)
                 
                 ES_Event_t BuzzEvent;
                 BuzzEvent.EventType = ES_BUZZ;
-                BuzzEvent.EventParam = 6;
+                BuzzEvent.EventParam = BUZZ_END_TUNE;
                 PostBuzzService(BuzzEvent);
+                PlayHaptic(HAPTIC_RUMBLE_FADE);
                 
                 // set LEDs to game over state
-                uint8_t newVals[13] = {0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0};
-                memcpy(ShiftRegisterVals, newVals, sizeof(ShiftRegisterVals));
-                ES_Event_t ShiftEvent;
-                ShiftEvent.EventType = ES_UPDATE_SHIFT;
-                PostShiftService(ShiftEvent);
+                StopLEDSequence(LED_SEQ_BLACK_HOLE);
+                Shift_SetLEDs(NO_LEDS);
                 
                 NextState = Waiting;
-                DB_printf("-> Going to Waiting\n");
+                LOG_INFO("-> Going to Waiting\n");
                 
                 ES_Timer_InitTimer(DELAY_TIMER, 3000);
                 ES_Timer_StopTimer(PLANET_TIMER);
                 ES_Timer_StopTimer(BLACKHOLE_TIMER);
             }
-            else if(ThisEvent.EventParam == 12){ // DELAY_TIMER
-                AsteroidTimeout = false;
-            }
         }
         else if (ThisEvent.EventType == ES_PLANET_HIT){
-            DB_printf("ES_PLANET_HIT\n");
+            LOG_DEBUG("ES_PLANET_HIT\n");
 
             if (ThisEvent.EventParam == TargetPlanet){
                 GetNewPlanet();
@@ -452,8 +428,9 @@ ES_Event_t RunGameService(ES_Event_t ThisEvent)
 
                 ES_Event_t BuzzEvent;
                 BuzzEvent.EventType = ES_BUZZ;
-                BuzzEvent.EventParam = 1;
+                BuzzEvent.EventParam = BUZZ_PLANET;
                 PostBuzzService(BuzzEvent);
+                PlayHaptic(HAPTIC_PULSE);
                 
                 ES_Timer_InitTimer(PLANET_TIMER, PlanetSwitchTime); //Restart planet timer
                 ES_Timer_InitTimer(USER_INPUT_TIMER, UserInputTimeout); //Restart user input timer
@@ -461,41 +438,35 @@ ES_Event_t RunGameService(ES_Event_t ThisEvent)
         }
         
         else if(ThisEvent.EventType == ES_ASTEROID_HIT){
-            if(AsteroidTimeout == false){
-                DB_printf("ES_ASTEROID_HIT\n");
-                
-                UpdateScore(-3);
+            LOG_DEBUG("ES_ASTEROID_HIT\n");
+            
+            UpdateScore(-3);
 
-                ES_Event_t BuzzEvent;
-                BuzzEvent.EventType = ES_BUZZ;
-                BuzzEvent.EventParam = 2;
-                PostBuzzService(BuzzEvent);
-                
-                AsteroidTimeout = true;
-                ES_Timer_InitTimer(DELAY_TIMER, AsteroidDelay); // prevent multiple asteroid hits
-                ES_Timer_InitTimer(USER_INPUT_TIMER, UserInputTimeout); //Restart user input timer
-            }
+            ES_Event_t BuzzEvent;
+            BuzzEvent.EventType = ES_BUZZ;
+            BuzzEvent.EventParam = BUZZ_ASTEROID;
+            PostBuzzService(BuzzEvent);
+            PlayHaptic(HAPTIC_STUTTER);
+            
+            ES_Timer_InitTimer(USER_INPUT_TIMER, UserInputTimeout); //Restart user input timer
         }
         
         else if(ThisEvent.EventType == ES_BLACKHOLE_HIT){
-            DB_printf("ES_BLACKHOLE_HIT\n");
+            LOG_DEBUG("ES_BLACKHOLE_HIT\n");
 
             if(BlackHole == true){
                 UpdateScore(-5);
 
                 ES_Event_t BuzzEvent;
                 BuzzEvent.EventType = ES_BUZZ;
-                BuzzEvent.EventParam = 3;
+                BuzzEvent.EventParam = BUZZ_BLACK_HOLE;
                 PostBuzzService(BuzzEvent);
+                PlayHaptic(HAPTIC_RUMBLE_RAMP);
                 
                 BlackHole = false; // turn off black hole
 
                 //Update black hole LEDs
-                ShiftRegisterVals[BLACKHOLE_LED] = 0;
-                ES_Event_t myEvent;
-                myEvent.EventType = ES_UPDATE_SHIFT;
-                myEvent.EventParam = MyPriority;
-                PostShiftService(myEvent);
+                StopLEDSequence(LED_SEQ_BLACK_HOLE);
                 
                 ES_Timer_InitTimer(BLACKHOLE_TIMER, BlackHoleSampleTime);
             }
@@ -508,60 +479,33 @@ ES_Event_t RunGameService(ES_Event_t ThisEvent)
         if (ThisEvent.EventType == ES_TIMEOUT){
             if (ThisEvent.EventParam == 12){
                 NextState = Waiting2Coins;
-                DB_printf("-> Leaving Waiting\n");
+                LOG_INFO("-> Leaving Waiting\n");
                 
                 UpdateDisplay(2, "2 CNS");
-                UpdateDisplay(1, "INSERT");
+                ScrollDisplay(1, "INSERT COINS TO PLAY");
             }
         }
     }
     break;
     case GameOver:
     {                
-        DB_printf("GAME_OVER!!! Your score was: %d\n", Score);
+        LOG_INFO("GAME_OVER!!! Your score was: %d\n", Score);
 
         if (ThisEvent.EventType == ES_TIMEOUT){
             if(ThisEvent.EventParam == 11){
-                if (Countdown > 0){
-                    if ((Countdown % 2) == 1){
-                        UpdateDisplay(2, "SCORE!");
-                        
-                        uint8_t newVals[13] = {1, 0, 1, 0, 1, 0, 1, 0, 1, 0, 1, 0, 1};
-                        memcpy(ShiftRegisterVals, newVals, sizeof(ShiftRegisterVals));
-                        
-                        ES_Event_t ShiftEvent;
-                        ShiftEvent.EventType = ES_UPDATE_SHIFT;
-                        ShiftEvent.EventParam = MyPriority;
-                        PostShiftService(ShiftEvent);
-                        
-                        Countdown--;
-                        ES_Timer_InitTimer(COUNTDOWN_TIMER, GameOverTime/6);
-                    } else {
-                        UpdateDisplay(2, "FINAL!");
-                        
-                        uint8_t newVals[13] = {0, 1, 0, 1, 0, 1, 0, 1, 0, 1, 0, 1, 0};
-                        memcpy(ShiftRegisterVals, newVals, sizeof(ShiftRegisterVals));
-                        
-                        ES_Event_t ShiftEvent;
-                        ShiftEvent.EventType = ES_UPDATE_SHIFT;
-                        ShiftEvent.EventParam = MyPriority;
-                        PostShiftService(ShiftEvent);
-                        
-                        Countdown--;
-                        ES_Timer_InitTimer(COUNTDOWN_TIMER, GameOverTime/6);
-                    }
+                if (--Countdown > 0){
+                    // LEDSeqService plays the chase, only the words swap here
+                    UpdateDisplay(2, ((Countdown % 2) == 1) ? "SCORE!" : "FINAL!");
+                    LED_FlashBrightness(0, 1, GameOverTime/GAME_OVER_WORDS);
+                    ES_Timer_InitTimer(COUNTDOWN_TIMER, GameOverTime/GAME_OVER_WORDS);
                 } else {
-                    DB_printf("Restarting the game...\n");
+                    LOG_INFO("Restarting the game...\n");
+                    LED_StopBrightnessEffect(0);
                     UpdateDisplay(2, "2 CNS");
-                    UpdateDisplay(1, "INSERT");
+                    ScrollDisplay(1, "INSERT COINS TO PLAY");
                     
-                    uint8_t newVals[13] = {0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0};
-                    memcpy(ShiftRegisterVals, newVals, sizeof(ShiftRegisterVals));
-                        
-                    ES_Event_t ShiftEvent;
-                    ShiftEvent.EventType = ES_UPDATE_SHIFT;
-                    ShiftEvent.EventParam = MyPriority;
-                    PostShiftService(ShiftEvent);
+                    StopLEDSequence(LED_SEQ_GAME_OVER);
+                    Shift_SetLEDs(NO_LEDS);
                         
                     NextState = Waiting2Coins;
                     Score = 0;
@@ -580,6 +524,29 @@ ES_Event_t RunGameService(ES_Event_t ThisEvent)
   return ReturnEvent;
 }
 
+/****************************************************************************
+ Function
+     QueryGameService / QueryGameScore / QueryGameCountdown
+
+ Returns
+     GameState_t, int16_t, uint8_t: the current state of the Game state
+     machine, the score, and the countdown LEDs still lit (10s each)
+****************************************************************************/
+GameState_t QueryGameService(void)
+{
+  return CurrentState;
+}
+
+int16_t QueryGameScore(void)
+{
+  return Score;
+}
+
+uint8_t QueryGameCountdown(void)
+{
+  return Countdown;
+}
+
 /***************************************************************************
  private functions
  ***************************************************************************/
@@ -607,14 +574,10 @@ void GetNewPlanet(void){
             NewPlanet = RandNum;
         }
 
-        ShiftRegisterVals[TargetPlanet] = 0;
+        Shift_SetLED(TargetPlanet, false);
     }
     
-    ShiftRegisterVals[NewPlanet] = 1;
-    ES_Event_t myEvent;
-    myEvent.EventType = ES_UPDATE_SHIFT;
-    myEvent.EventParam = MyPriority;
-    PostShiftService(myEvent);
+    Shift_SetLED(NewPlanet, true);
 
     TargetPlanet = NewPlanet;
 }
@@ -633,7 +596,7 @@ Description
 void UpdateScore(int16_t DeltaScore){
     static char ScoreString[4];
 
-    DB_printf("Updating Score...\n");
+    LOG_DEBUG("Updating Score...\n");
     Score = Score + DeltaScore;
     if (Score < 0){
         Score = Score;
@@ -664,6 +627,26 @@ void UpdateDisplay(uint8_t WhichDisplay, char *Msg){
     PostLEDService(myEvent);
 }
 
+/****************************************************************************
+Function
+    ScrollDisplay
+Parameters
+    uint8_t WhichDisplay: which display to scroll across
+    char *Msg: message to scroll, must stay valid while it scrolls
+Returns
+    void
+Description
+    start a marquee of a message too long to fit on the display,
+    it keeps scrolling until the next UpdateDisplay on that display
+****************************************************************************/
+void ScrollDisplay(uint8_t WhichDisplay, char *Msg){
+    ES_Event_t myEvent;
+    myEvent.EventType = ES_SCROLL;
+    myEvent.EventParam = WhichDisplay;
+    myEvent.EventMessage = Msg;
+    PostLEDService(myEvent);
+}
+
 /****************************************************************************
 Function
     GetDifficulty
@@ -679,8 +662,49 @@ void GetDifficulty(uint8_t Level){
     PlanetSwitchTime = PlanetSwitchTime_MIN + ((PlanetSwitchTime_MAX - PlanetSwitchTime_MIN)*(1 - Level/100));
     BlackHoleProb = Level;
     
-    DB_printf("Switch Time: %d\n", PlanetSwitchTime);
-    DB_printf("BH: %d\n", BlackHoleProb);
+    LOG_DEBUG("Switch Time: %d\n", PlanetSwitchTime);
+    LOG_DEBUG("BH: %d\n", BlackHoleProb);
+}
+
+/****************************************************************************
+Function
+    PlayLEDSequence / StopLEDSequence
+Parameters
+    LEDSeq_t WhichSeq: the animation to start or stop
+Returns
+    void
+Description
+    hand an LED animation to LEDSeqService
+****************************************************************************/
+static void PlayLEDSequence(LEDSeq_t WhichSeq){
+    ES_Event_t myEvent;
+    myEvent.EventType = ES_PLAY_LED_SEQ;
+    myEvent.EventParam = WhichSeq;
+    PostLEDSeqService(myEvent);
+}
+
+static void StopLEDSequence(LEDSeq_t WhichSeq){
+    ES_Event_t myEvent;
+    myEvent.EventType = ES_STOP_LED_SEQ;
+    myEvent.EventParam = WhichSeq;
+    PostLEDSeqService(myEvent);
+}
+
+/****************************************************************************
+Function
+    PlayHaptic
+Parameters
+    HapticPattern_t WhichPattern: the vibration pattern to start
+Returns
+    void
+Description
+    hand a vibration pattern to HapticService
+****************************************************************************/
+static void PlayHaptic(HapticPattern_t WhichPattern){
+    ES_Event_t myEvent;
+    myEvent.EventType = ES_HAPTIC;
+    myEvent.EventParam = WhichPattern;
+    PostHapticService(myEvent);
 }
 
 
@@ -0,0 +1,205 @@
+/****************************************************************************
+Module
+    HapticService.c
+
+Description
+    Plays patterns on the vibration motor. A pattern is a bitmask played
+    a bit at a time, least significant bit first, each bit turning the
+    motor on or off for a fixed bit time. Bit times are short next to the
+    motor's spin up, so runs with more or fewer 1s read as stronger or
+    weaker rumble, which is how the ramps are done without a PWM channel
+    (RB15 can only be mapped to OC1, which the buzzer has).
+
+Notes
+    One pattern plays at a time, on HAPTIC_TIMER; playing another replaces
+    it. A run of equal bits is timed as a single interval, so a steady
+    pattern costs one timeout however long it is.
+****************************************************************************/
+/*----------------------------- Include Files -----------------------------*/
+#include "ES_Configure.h"
+#include "ES_Framework.h"
+#include "HapticService.h"
+#define BINLOG_MODULE BINLOG_MODULE_HAPTIC
+#include "binlog.h"
+
+/*----------------------------- Module Defines ----------------------------*/
+#define VIB_MOTOR  LATBbits.LATB15
+
+typedef struct
+{
+    uint32_t Bits;        // motor state per bit time, bit 0 first
+    uint8_t NumBits;
+    uint8_t BitTime_ms;
+    uint8_t NumPlays;     // times through the bits
+} HapticPatternDef_t;
+
+/*---------------------------- Module Functions ---------------------------*/
+static void PlayRun(void);
+static void StopPattern(void);
+
+/*---------------------------- Module Variables ---------------------------*/
+static uint8_t MyPriority;
+
+// indexed by HapticPattern_t, the bits in time order are in the comments
+static const HapticPatternDef_t Patterns[NUM_HAPTIC_PATTERNS] = {
+    // 1111111111
+    [HAPTIC_PULSE]        = { 0x000003FF, 10, 20, 1 },
+    // 11111 00000 11111
+    [HAPTIC_DOUBLE_PULSE] = { 0x00007C1F, 15, 20, 1 },
+    // 11111111 0000 1111
+    [HAPTIC_STUTTER]      = { 0x0000F0FF, 16, 33, 1 },
+    // 1000 1000 1000 1010 1010 1101 1101 1111
+    [HAPTIC_RUMBLE_RAMP]  = { 0xFBB55111, 32, 20, 3 },
+    // 1111 1101 1101 1010 1010 1000 1000 1000
+    [HAPTIC_RUMBLE_FADE]  = { 0x11155BBF, 32, 60, 1 }
+};
+
+// playback state
+static const HapticPatternDef_t *pPlaying = NULL;
+static uint8_t BitIndex;
+static uint8_t PlaysLeft;
+
+/*------------------------------ Module Code ------------------------------*/
+/****************************************************************************
+Function
+    InitHapticService
+
+Parameters
+    uint8_t : the priorty of this service
+
+Returns
+    bool, false if error in initialization, true otherwise
+
+Description
+    Saves away the priority, and does any
+    other required initialization for this service
+****************************************************************************/
+bool InitHapticService(uint8_t Priority)
+{
+    ES_Event_t ThisEvent;
+
+    // Vibration motor
+    TRISBbits.TRISB15 = 0;   //output
+    VIB_MOTOR = 0;
+
+    MyPriority = Priority;
+    pPlaying = NULL;
+
+    // post the initial transition event
+    ThisEvent.EventType = ES_INIT;
+    if (ES_PostToService(MyPriority, ThisEvent) == true)
+    {
+        return true;
+    }
+    else
+    {
+        return false;
+    }
+}
+
+/****************************************************************************
+Function
+    PostHapticService
+
+Parameters
+    EF_Event_t ThisEvent ,the event to post to the queue
+
+Returns
+    bool false if the Enqueue operation failed, true otherwise
+
+Description
+    Posts an event to this state machine's queue
+****************************************************************************/
+bool PostHapticService(ES_Event_t ThisEvent)
+{
+    return ES_PostToService(MyPriority, ThisEvent);
+}
+
+/****************************************************************************
+Function
+    RunHapticService
+
+Parameters
+    ES_Event_t : the event to process
+
+Returns
+    ES_Event, ES_NO_EVENT if no error ES_ERROR otherwise
+
+Description
+    Starts and stops patterns, and moves the playing one on to its next run
+    of bits each time HAPTIC_TIMER expires.
+****************************************************************************/
+ES_Event_t RunHapticService(ES_Event_t ThisEvent)
+{
+    ES_Event_t ReturnEvent;
+    ReturnEvent.EventType = ES_NO_EVENT; // assume no errors
+
+    if (ThisEvent.EventType == ES_HAPTIC){
+        if (ThisEvent.EventParam == HAPTIC_OFF){
+            StopPattern();
+        } else if (ThisEvent.EventParam < NUM_HAPTIC_PATTERNS){
+            pPlaying = &Patterns[ThisEvent.EventParam];
+            BitIndex = 0;
+            PlaysLeft = pPlaying->NumPlays;
+            PlayRun();
+        } else {
+            // logged rather than returned, an ES_ERROR would stop ES_Run
+            LOG_ERROR("no haptic pattern %u\n", ThisEvent.EventParam);
+        }
+    }
+    else if ((ThisEvent.EventType == ES_TIMEOUT) &&
+             (ThisEvent.EventParam == HAPTIC_TIMER) && (NULL != pPlaying)){
+        if (BitIndex >= pPlaying->NumBits){
+            BitIndex = 0;
+            if (0 == --PlaysLeft){
+                StopPattern();
+                return ReturnEvent;
+            }
+        }
+        PlayRun();
+    }
+
+    return ReturnEvent;
+}
+
+/***************************************************************************
+ private functions
+ ***************************************************************************/
+/****************************************************************************
+Function
+    PlayRun
+
+Description
+    Sets the motor to the current bit and times it together with every
+    following bit of the same value
+****************************************************************************/
+static void PlayRun(void)
+{
+    bool IsOn = (0 != (pPlaying->Bits & (1UL << BitIndex)));
+    uint8_t RunLength = 0;
+
+    while ((BitIndex < pPlaying->NumBits) &&
+           (IsOn == (0 != (pPlaying->Bits & (1UL << BitIndex))))){
+        RunLength++;
+        BitIndex++;
+    }
+    VIB_MOTOR = IsOn;
+    ES_Timer_InitTimer(HAPTIC_TIMER, (uint16_t)RunLength * pPlaying->BitTime_ms);
+}
+
+/****************************************************************************
+Function
+    StopPattern
+
+Description
+    Stops the motor
+****************************************************************************/
+static void StopPattern(void)
+{
+    ES_Timer_StopTimer(HAPTIC_TIMER);
+    pPlaying = NULL;
+    VIB_MOTOR = 0;
+}
+
+/*------------------------------- Footnotes -------------------------------*/
+/*------------------------------ End of file ------------------------------*/
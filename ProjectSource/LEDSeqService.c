@@ -0,0 +1,218 @@
+/****************************************************************************
+Module
+    LEDSeqService.c
+
+Description
+    Plays LED animations on the shift register chain from keyframe tables.
+    Each sequence is a list of (LED bitmask, duration) frames plus the mask
+    of outputs it owns. Frames are handed to ShiftService as an overlay, so
+    outputs outside the mask keep showing the game's LEDs. One sequence
+    plays at a time, on LED_SEQ_TIMER; playing another replaces it.
+
+Notes
+    ES_PLAY_LED_SEQ and ES_STOP_LED_SEQ carry an LEDSeq_t in EventParam.
+    A stop only takes effect if that sequence is the one playing, so a
+    stale stop cannot cut off a sequence started since.
+****************************************************************************/
+/*----------------------------- Include Files -----------------------------*/
+#include "ES_Configure.h"
+#include "ES_Framework.h"
+#include "LEDSeqService.h"
+#include "ShiftService.h"
+#include "GameService.h"
+
+/*----------------------------- Module Defines ----------------------------*/
+#define ARRAY_LEN(x) (sizeof(x) / sizeof((x)[0]))
+
+#define CHASE_LEDS_A 0x1555 // even outputs
+#define CHASE_LEDS_B 0x0AAA // odd outputs
+#define BLACKHOLE_BIT (1 << BLACKHOLE_LED)
+// the game over chase plays its two frames this many times across the
+// game over time
+#define GAME_OVER_PLAYS 3
+#define GAME_OVER_FRAME_MS (GAME_OVER_TIME / (2 * GAME_OVER_PLAYS))
+
+typedef struct
+{
+    uint16_t LEDs;        // state of the owned outputs, bit n is output n
+    uint16_t Duration_ms;
+} LEDKeyframe_t;
+
+typedef struct
+{
+    const LEDKeyframe_t *pFrames;
+    uint8_t NumFrames;
+    uint16_t Mask;        // outputs the sequence takes over
+    uint8_t NumPlays;     // times through the frames, 0 repeats until stopped
+} LEDSequence_t;
+
+/*---------------------------- Module Functions ---------------------------*/
+static void ShowFrame(void);
+static void StopSequence(void);
+
+/*---------------------------- Module Variables ---------------------------*/
+static uint8_t MyPriority;
+
+// keyframe tables, these live in flash
+static const LEDKeyframe_t GameOverFrames[] = {
+    { CHASE_LEDS_B, GAME_OVER_FRAME_MS },
+    { CHASE_LEDS_A, GAME_OVER_FRAME_MS }
+};
+
+static const LEDKeyframe_t BlackHoleFrames[] = {
+    { BLACKHOLE_BIT, 250 },
+    { 0,             250 }
+};
+
+// indexed by LEDSeq_t
+static const LEDSequence_t Sequences[NUM_LED_SEQS] = {
+    [LED_SEQ_GAME_OVER]  = { GameOverFrames, ARRAY_LEN(GameOverFrames),
+                             SHIFT_ALL_LEDS, GAME_OVER_PLAYS },
+    [LED_SEQ_BLACK_HOLE] = { BlackHoleFrames, ARRAY_LEN(BlackHoleFrames),
+                             BLACKHOLE_BIT, 0 }
+};
+
+// playback state
+static const LEDSequence_t *pPlaying = NULL;
+static LEDSeq_t PlayingSeq;
+static uint8_t FrameIndex;
+static uint8_t PlaysLeft;
+
+/*------------------------------ Module Code ------------------------------*/
+/****************************************************************************
+Function
+    InitLEDSeqService
+
+Parameters
+    uint8_t : the priorty of this service
+
+Returns
+    bool, false if error in initialization, true otherwise
+
+Description
+    Saves away the priority, and does any
+    other required initialization for this service
+****************************************************************************/
+bool InitLEDSeqService(uint8_t Priority)
+{
+    ES_Event_t ThisEvent;
+
+    MyPriority = Priority;
+    pPlaying = NULL;
+
+    // post the initial transition event
+    ThisEvent.EventType = ES_INIT;
+    if (ES_PostToService(MyPriority, ThisEvent) == true)
+    {
+        return true;
+    }
+    else
+    {
+        return false;
+    }
+}
+
+/****************************************************************************
+Function
+    PostLEDSeqService
+
+Parameters
+    EF_Event_t ThisEvent ,the event to post to the queue
+
+Returns
+    bool false if the Enqueue operation failed, true otherwise
+
+Description
+    Posts an event to this state machine's queue
+****************************************************************************/
+bool PostLEDSeqService(ES_Event_t ThisEvent)
+{
+    return ES_PostToService(MyPriority, ThisEvent);
+}
+
+/****************************************************************************
+Function
+    RunLEDSeqService
+
+Parameters
+    ES_Event_t : the event to process
+
+Returns
+    ES_Event, ES_NO_EVENT if no error ES_ERROR otherwise
+
+Description
+    Starts and stops sequences, and steps the playing one to its next frame
+    each time LED_SEQ_TIMER expires.
+****************************************************************************/
+ES_Event_t RunLEDSeqService(ES_Event_t ThisEvent)
+{
+    ES_Event_t ReturnEvent;
+    ReturnEvent.EventType = ES_NO_EVENT; // assume no errors
+
+    if (ThisEvent.EventType == ES_PLAY_LED_SEQ){
+        if (ThisEvent.EventParam < NUM_LED_SEQS){
+            pPlaying = &Sequences[ThisEvent.EventParam];
+            PlayingSeq = ThisEvent.EventParam;
+            FrameIndex = 0;
+            PlaysLeft = pPlaying->NumPlays;
+            ShowFrame();
+        } else {
+            ReturnEvent.EventType = ES_ERROR;
+            ReturnEvent.EventParam = ThisEvent.EventParam;
+        }
+    }
+    else if (ThisEvent.EventType == ES_STOP_LED_SEQ){
+        if ((NULL != pPlaying) && (ThisEvent.EventParam == PlayingSeq)){
+            StopSequence();
+        }
+    }
+    else if ((ThisEvent.EventType == ES_TIMEOUT) &&
+             (ThisEvent.EventParam == LED_SEQ_TIMER) && (NULL != pPlaying)){
+        FrameIndex++;
+        if (FrameIndex >= pPlaying->NumFrames){
+            FrameIndex = 0;
+            if ((0 != pPlaying->NumPlays) && (0 == --PlaysLeft)){
+                StopSequence();
+                return ReturnEvent;
+            }
+        }
+        ShowFrame();
+    }
+
+    return ReturnEvent;
+}
+
+/***************************************************************************
+ private functions
+ ***************************************************************************/
+/****************************************************************************
+Function
+    ShowFrame
+
+Description
+    Puts the current frame on the owned outputs and times it
+****************************************************************************/
+static void ShowFrame(void)
+{
+    const LEDKeyframe_t *pFrame = &pPlaying->pFrames[FrameIndex];
+
+    Shift_SetOverlay(pPlaying->Mask, pFrame->LEDs);
+    ES_Timer_InitTimer(LED_SEQ_TIMER, pFrame->Duration_ms);
+}
+
+/****************************************************************************
+Function
+    StopSequence
+
+Description
+    Hands the owned outputs back to the game
+****************************************************************************/
+static void StopSequence(void)
+{
+    ES_Timer_StopTimer(LED_SEQ_TIMER);
+    pPlaying = NULL;
+    Shift_SetOverlay(0, 0);
+}
+
+/*------------------------------- Footnotes -------------------------------*/
+/*------------------------------ End of file ------------------------------*/
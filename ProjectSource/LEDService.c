@@ -18,16 +18,57 @@
 #include "ES_DeferRecall.h"
 #include "ES_Port.h"
 #include "terminal.h"
-#include "dbprintf.h"
+#define BINLOG_MODULE BINLOG_MODULE_LED
+#include "binlog.h"
 #include "DM_Display.h"
 #include "PIC32_SPI_HAL.h"
 #include <string.h>
 
 
+/*----------------------------- Module Defines ----------------------------*/
+#define DEFAULT_SCROLL_FRAME_TIME 60 // ms per column
+#define BRIGHTNESS_TICK 20 // ms between intensity steps
+
+/*------------------------------ Module Types -----------------------------*/
+typedef enum
+{
+    EffectNone = 0,
+    EffectFade,
+    EffectPulse,
+    EffectFlash
+} BrightnessEffect_t;
+
+typedef struct
+{
+    BrightnessEffect_t Effect;
+    uint8_t Low;          // pulse floor
+    uint8_t High;         // pulse ceiling
+    uint8_t Target;       // fade end level
+    uint8_t TicksPerStep;
+    uint8_t TickCount;
+    uint8_t FlashesLeft;
+    bool IsRising;        // pulse direction, or flash currently on
+} BrightnessState_t;
+
+/*---------------------------- Module Functions ---------------------------*/
+static bool TakeScrollSteps(void);
+static bool FlushDirtyRows(void);
+static void SPIQueueDrained(void);
+static bool HasUnderrun(void);
+static void TakeBrightnessSteps(void);
+static bool StartEffect(uint8_t WhichDisplay, BrightnessState_t *pNewEffect);
+static uint8_t TicksPerStep(uint16_t Time_ms, uint8_t NumSteps);
+
 /*---------------------------- Module Variables ---------------------------*/
 static uint8_t MyPriority;
 static LED_State_t CurrentState;
 static ES_Event_t DeferralQueue[3 + 1];
+// which displays currently have a marquee running
+static bool IsScrolling[DM_NUM_DISPLAYS];
+static uint16_t ScrollFrameTime = DEFAULT_SCROLL_FRAME_TIME;
+static BrightnessState_t Brightness[DM_NUM_DISPLAYS];
+// SPI1 underruns already answered by resending the frame
+static uint16_t NumUnderrunsSeen;
 
 /*------------------------------ Module Code ------------------------------*/
 
@@ -51,7 +92,7 @@ Author
 ****************************************************************************/
 bool InitLEDService(uint8_t Priority)
 {
-    DB_printf("InitLEDService\n");
+    LOG_INFO("InitLEDService\n");
     ES_Event_t ThisEvent;
     clrScrn();
 
@@ -76,6 +117,12 @@ bool InitLEDService(uint8_t Priority)
     IFS0CLR = _IFS0_INT4IF_MASK;
     while(false == DM_TakeInitDisplayStep()){}
 
+    // from here on rows are clocked out by the SPI1 interrupts
+    if (true == SPIQueue_SPI1_Init(SPIQueueDrained))
+    {
+        DM_SetQueuedOutput(true);
+    }
+
     ES_InitDeferralQueueWith(DeferralQueue, ARRAY_SIZE(DeferralQueue));
 
     MyPriority = Priority;
@@ -110,6 +157,150 @@ bool PostLEDService(ES_Event_t ThisEvent)
     return ES_PostToService(MyPriority, ThisEvent);
 }
 
+/****************************************************************************
+Function
+    LED_SetScrollFrameTime
+
+Parameters
+    uint16_t : the time in ms between single column scroll steps
+
+Returns
+    nothing
+
+Description
+    Sets the marquee frame rate, takes effect at the next scroll step
+****************************************************************************/
+void LED_SetScrollFrameTime(uint16_t FrameTime)
+{
+    if (FrameTime > 0)
+    {
+        ScrollFrameTime = FrameTime;
+    }
+}
+
+/****************************************************************************
+Function
+    LED_FadeBrightness
+
+Parameters
+    uint8_t : the display to fade, 0 for all displays
+    uint8_t : the intensity to end at (0 - DM_MAX_BRIGHTNESS)
+    uint16_t : the time in ms the fade should take
+
+Returns
+    bool, false for an illegal display, true otherwise
+
+Description
+    Steps the intensity one level at a time towards the target
+****************************************************************************/
+bool LED_FadeBrightness(uint8_t WhichDisplay, uint8_t TargetLevel, uint16_t Duration)
+{
+    BrightnessState_t NewEffect = {0};
+    uint8_t Start = DM_GetBrightness((0 == WhichDisplay) ? 1 : WhichDisplay);
+
+    NewEffect.Effect = EffectFade;
+    NewEffect.Target = (TargetLevel > DM_MAX_BRIGHTNESS) ? DM_MAX_BRIGHTNESS : TargetLevel;
+    NewEffect.TicksPerStep = TicksPerStep(Duration, 
+        (Start > NewEffect.Target) ? (Start - NewEffect.Target) : (NewEffect.Target - Start));
+    return StartEffect(WhichDisplay, &NewEffect);
+}
+
+/****************************************************************************
+Function
+    LED_PulseBrightness
+
+Parameters
+    uint8_t : the display to pulse, 0 for all displays
+    uint8_t : the lowest intensity of the pulse
+    uint8_t : the highest intensity of the pulse
+    uint16_t : the time in ms for one full low-high-low cycle
+
+Returns
+    bool, false for an illegal display or levels, true otherwise
+
+Description
+    Ramps the intensity up and down between the levels until stopped
+****************************************************************************/
+bool LED_PulseBrightness(uint8_t WhichDisplay, uint8_t LowLevel, uint8_t HighLevel, uint16_t Period)
+{
+    BrightnessState_t NewEffect = {0};
+
+    if ((LowLevel >= HighLevel) || (HighLevel > DM_MAX_BRIGHTNESS))
+    {
+        return false;
+    }
+    NewEffect.Effect = EffectPulse;
+    NewEffect.Low = LowLevel;
+    NewEffect.High = HighLevel;
+    NewEffect.IsRising = true;
+    NewEffect.TicksPerStep = TicksPerStep(Period, 2 * (HighLevel - LowLevel));
+    return StartEffect(WhichDisplay, &NewEffect);
+}
+
+/****************************************************************************
+Function
+    LED_FlashBrightness
+
+Parameters
+    uint8_t : the display to flash, 0 for all displays
+    uint8_t : the number of off-on flashes
+    uint16_t : the time in ms for one off-on flash
+
+Returns
+    bool, false for an illegal display, true otherwise
+
+Description
+    Blanks and relights the display with the shutdown register, since even
+    intensity 0 is still lit. The intensity itself is left alone.
+****************************************************************************/
+bool LED_FlashBrightness(uint8_t WhichDisplay, uint8_t NumFlashes, uint16_t Period)
+{
+    BrightnessState_t NewEffect = {0};
+
+    if (0 == NumFlashes)
+    {
+        return false;
+    }
+    NewEffect.Effect = EffectFlash;
+    NewEffect.IsRising = true;
+    NewEffect.FlashesLeft = NumFlashes;
+    NewEffect.TicksPerStep = TicksPerStep(Period, 2);
+    return StartEffect(WhichDisplay, &NewEffect);
+}
+
+/****************************************************************************
+Function
+    LED_StopBrightnessEffect
+
+Parameters
+    uint8_t : the display to stop, 0 for all displays
+
+Returns
+    nothing
+
+Description
+    Cancels any running effect and returns to the default intensity, lit
+****************************************************************************/
+void LED_StopBrightnessEffect(uint8_t WhichDisplay)
+{
+    uint8_t i;
+
+    for (i = 0; i < DM_NUM_DISPLAYS; i++)
+    {
+        if ((0 == WhichDisplay) || (i == (WhichDisplay - 1)))
+        {
+            Brightness[i].Effect = EffectNone;
+        }
+    }
+    DM_SetBrightness(DM_DEFAULT_BRIGHTNESS, WhichDisplay);
+    DM_SetShutdown(false, WhichDisplay);
+    if (false == DM_TakeBrightnessUpdateStep())
+    {
+        // no room in the SPI1 queue, let the next tick send it
+        ES_Timer_InitTimer(BRIGHTNESS_TIMER, BRIGHTNESS_TICK);
+    }
+}
+
 /****************************************************************************
 Function
     RunLEDService
@@ -138,6 +329,11 @@ ES_Event_t RunLEDService(ES_Event_t ThisEvent)
             if(ThisEvent.EventType == ES_NEW_WORD)
             {
                 uint8_t WordLength = strlen(ThisEvent.EventMessage);
+                // a static word replaces any marquee on that display
+                if ((ThisEvent.EventParam >= 1) && (ThisEvent.EventParam <= DM_NUM_DISPLAYS))
+                {
+                    IsScrolling[ThisEvent.EventParam - 1] = false;
+                }
                 DM_ClearDisplayBuffer(ThisEvent.EventParam);
                 for (uint8_t i = 0; i < WordLength; i++){
                     if (i > 0){
@@ -146,37 +342,101 @@ ES_Event_t RunLEDService(ES_Event_t ThisEvent)
                     DM_AddChar2DisplayBuffer((unsigned char)ThisEvent.EventMessage[i], ThisEvent.EventParam);
                 }
                 
-                // Center word on display (assuming 4 matrices wide)
-                DM_ScrollDisplayBuffer((32 - (WordLength*4))/2, ThisEvent.EventParam);
+                // Center word on display, if it fits
+                if ((WordLength * 4) < DM_COLS_PER_DISPLAY)
+                {
+                    DM_ScrollDisplayBuffer((DM_COLS_PER_DISPLAY - (WordLength*4))/2, ThisEvent.EventParam);
+                }
                 
                 myEvent.EventType = ES_ROWUPDATE;
                 CurrentState = UPDATING;
                 PostLEDService(myEvent);
             }
+            else if (ThisEvent.EventType == ES_SCROLL)
+            {
+                if (0 != DM_LoadScrollStrip(ThisEvent.EventMessage, ThisEvent.EventParam))
+                {
+                    // start from a blank display so the message enters from the right
+                    DM_ClearDisplayBuffer(ThisEvent.EventParam);
+                    IsScrolling[ThisEvent.EventParam - 1] = true;
+                    ES_Timer_InitTimer(SCROLL_TIMER, ScrollFrameTime);
+
+                    myEvent.EventType = ES_ROWUPDATE;
+                    CurrentState = UPDATING;
+                    PostLEDService(myEvent);
+                }
+            }
+            else if ((ThisEvent.EventType == ES_TIMEOUT) &&
+                     (ThisEvent.EventParam == BRIGHTNESS_TIMER))
+            {
+                TakeBrightnessSteps();
+            }
+            else if (ThisEvent.EventType == ES_SPI_DONE)
+            {
+                // frames queued before going IDLE can still underrun
+                if (true == HasUnderrun())
+                {
+                    myEvent.EventType = ES_ROWUPDATE;
+                    CurrentState = UPDATING;
+                    PostLEDService(myEvent);
+                }
+            }
+            else if ((ThisEvent.EventType == ES_TIMEOUT) &&
+                     (ThisEvent.EventParam == SCROLL_TIMER))
+            {
+                // only flush if the step actually changed some rows, a
+                // marquee can step through columns that are all blank
+                if (true == TakeScrollSteps())
+                {
+                    myEvent.EventType = ES_ROWUPDATE;
+                    CurrentState = UPDATING;
+                    PostLEDService(myEvent);
+                }
+            }
         }
         break;
         case UPDATING:
         {
-            if (ThisEvent.EventType == ES_NEW_WORD)
+            if ((ThisEvent.EventType == ES_NEW_WORD) ||
+                (ThisEvent.EventType == ES_SCROLL))
             {
                 // add event to the defferal queue
                 if (ES_DeferEvent(DeferralQueue, ThisEvent)){
                 }
             }
-            else if (ThisEvent.EventType == ES_ROWUPDATE )
+            else if ((ThisEvent.EventType == ES_TIMEOUT) &&
+                     (ThisEvent.EventParam == BRIGHTNESS_TIMER))
+            {
+                // an intensity frame can go out between two row frames
+                TakeBrightnessSteps();
+            }
+            else if ((ThisEvent.EventType == ES_TIMEOUT) &&
+                     (ThisEvent.EventParam == SCROLL_TIMER))
+            {
+                // the buffer can move on mid-flush, the changed rows are
+                // picked up before the flush finishes
+                TakeScrollSteps();
+            }
+            else if ((ThisEvent.EventType == ES_ROWUPDATE) ||
+                     (ThisEvent.EventType == ES_SPI_DONE))
             {
-                // continue updating display
-                if(DM_TakeDisplayUpdateStep() == false)
+                if (ThisEvent.EventType == ES_SPI_DONE)
                 {
-                    PostLEDService(ThisEvent);
+                    HasUnderrun();
                 }
-                else { // updating is complete, recall defferred events
+                // queue every changed row, if the queue fills up carry on
+                // when it drains
+                if (true == FlushDirtyRows())
+                {
+                    // the queued frames are copies, so the buffer is free
+                    // again, recall defferred events
                     CurrentState = IDLE;
                     if (true == ES_RecallEvents(MyPriority, DeferralQueue)){
                     }
                 }
             }
         }
+        break;
         default:
         {}
         break;
@@ -185,5 +445,282 @@ ES_Event_t RunLEDService(ES_Event_t ThisEvent)
     return ReturnEvent;
 }
 
-/*------------------------------ End of file ------------------------------*/
+/***************************************************************************
+ private functions
+ ***************************************************************************/
 
+/****************************************************************************
+Function
+    TakeScrollSteps
+
+Parameters
+    nothing
+
+Returns
+    bool, true if the step changed any row of any display
+
+Description
+    Advances every running marquee by one column and restarts SCROLL_TIMER
+    while any display is still scrolling
+****************************************************************************/
+static bool TakeScrollSteps(void)
+{
+    bool AnyScrolling = false;
+    uint8_t i;
+
+    for (i = 0; i < DM_NUM_DISPLAYS; i++)
+    {
+        if (true == IsScrolling[i])
+        {
+            DM_TakeScrollStep(i + 1);
+            AnyScrolling = true;
+        }
+    }
+    if (true == AnyScrolling)
+    {
+        ES_Timer_InitTimer(SCROLL_TIMER, ScrollFrameTime);
+    }
+    // the rows were all sent before an IDLE step, so any dirty now are
+    // the ones this step changed
+    return (true == AnyScrolling) && (true == DM_AreRowsDirty());
+}
+
+/****************************************************************************
+Function
+    FlushDirtyRows
+
+Parameters
+    nothing
+
+Returns
+    bool, true once every changed row has been handed to the SPI1 queue
+
+Description
+    Queues changed rows until none are left or the queue is full. Each step
+    either queues a row or finds no room, so 8 tries is always enough.
+****************************************************************************/
+static bool FlushDirtyRows(void)
+{
+    bool IsDone = false;
+    uint8_t i;
+
+    for (i = 0; (i < 8) && (false == IsDone); i++)
+    {
+        IsDone = DM_TakeDirtyRowUpdateStep();
+    }
+    return IsDone;
+}
+
+/****************************************************************************
+Function
+    SPIQueueDrained
+
+Parameters
+    nothing
+
+Returns
+    nothing
+
+Description
+    Called from the SS1 interrupt when the SPI1 queue has emptied
+****************************************************************************/
+static void SPIQueueDrained(void)
+{
+    ES_Event_t DoneEvent;
+
+    DoneEvent.EventType = ES_SPI_DONE;
+    DoneEvent.EventParam = 0;
+    PostLEDService(DoneEvent);
+}
+
+/****************************************************************************
+Function
+    HasUnderrun
+
+Parameters
+    nothing
+
+Returns
+    bool, true if SPI1 has underrun since the last look
+
+Description
+    An underrun splits a frame in two, so the rows it carried landed in the
+    wrong modules. The dirty row flush would never send them again, so
+    every row is marked to have the whole display sent again.
+****************************************************************************/
+static bool HasUnderrun(void)
+{
+    uint16_t NumUnderruns = SPIQueue_SPI1_GetUnderruns();
+
+    if (NumUnderruns == NumUnderrunsSeen)
+    {
+        return false;
+    }
+    LOG_WARN("SPI1 underruns: %u, resending the display\n",
+             (uint16_t)(NumUnderruns - NumUnderrunsSeen));
+    NumUnderrunsSeen = NumUnderruns;
+    DM_MarkAllRowsDirty();
+    return true;
+}
+
+/****************************************************************************
+Function
+    TakeBrightnessSteps
+
+Parameters
+    nothing
+
+Returns
+    nothing
+
+Description
+    Advances every running intensity effect that is due and sends the new
+    levels in one command frame, restarting BRIGHTNESS_TIMER while any
+    effect is still running
+****************************************************************************/
+static void TakeBrightnessSteps(void)
+{
+    BrightnessState_t *pThis;
+    bool AnyRunning = false;
+    uint8_t Level;
+    uint8_t i;
+
+    for (i = 0; i < DM_NUM_DISPLAYS; i++)
+    {
+        pThis = &Brightness[i];
+        if (EffectNone == pThis->Effect)
+        {
+            continue;
+        }
+        AnyRunning = true;
+        if (++pThis->TickCount < pThis->TicksPerStep)
+        {
+            continue;
+        }
+        pThis->TickCount = 0;
+        Level = DM_GetBrightness(i + 1);
+
+        switch (pThis->Effect)
+        {
+            case EffectFade:
+                if (Level < pThis->Target)
+                {
+                    Level++;
+                }
+                else if (Level > pThis->Target)
+                {
+                    Level--;
+                }
+                if (Level == pThis->Target)
+                {
+                    pThis->Effect = EffectNone;
+                }
+                break;
+
+            case EffectPulse:
+                if (true == pThis->IsRising)
+                {
+                    if (++Level >= pThis->High)
+                    {
+                        pThis->IsRising = false;
+                    }
+                }
+                else
+                {
+                    if (--Level <= pThis->Low)
+                    {
+                        pThis->IsRising = true;
+                    }
+                }
+                break;
+
+            case EffectFlash:
+                pThis->IsRising = !pThis->IsRising;
+                DM_SetShutdown(!pThis->IsRising, i + 1);
+                // a flash is complete each time the display comes back on
+                if ((true == pThis->IsRising) && (0 == --pThis->FlashesLeft))
+                {
+                    pThis->Effect = EffectNone;
+                }
+                break;
+
+            default:
+                break;
+        }
+        DM_SetBrightness(Level, i + 1);
+    }
+
+    // a level that did not fit in the SPI1 queue goes out on the next tick
+    if ((false == DM_TakeBrightnessUpdateStep()) || (true == AnyRunning))
+    {
+        ES_Timer_InitTimer(BRIGHTNESS_TIMER, BRIGHTNESS_TICK);
+    }
+}
+
+/****************************************************************************
+Function
+    StartEffect
+
+Parameters
+    uint8_t : the display, 0 for all displays
+    BrightnessState_t * : the effect to run
+
+Returns
+    bool, false for an illegal display, true otherwise
+
+Description
+    Installs the effect on the display(s) and starts the step timer. A
+    display left blanked by an interrupted flash is lit again.
+****************************************************************************/
+static bool StartEffect(uint8_t WhichDisplay, BrightnessState_t *pNewEffect)
+{
+    uint8_t i;
+
+    if (WhichDisplay > DM_NUM_DISPLAYS)
+    {
+        return false;
+    }
+    for (i = 0; i < DM_NUM_DISPLAYS; i++)
+    {
+        if ((0 == WhichDisplay) || (i == (WhichDisplay - 1)))
+        {
+            Brightness[i] = *pNewEffect;
+        }
+    }
+    DM_SetShutdown(false, WhichDisplay);
+    ES_Timer_InitTimer(BRIGHTNESS_TIMER, BRIGHTNESS_TICK);
+    return true;
+}
+
+/****************************************************************************
+Function
+    TicksPerStep
+
+Parameters
+    uint16_t : the time in ms the steps should span
+    uint8_t : the number of intensity steps
+
+Returns
+    uint8_t, the number of BRIGHTNESS_TICKs between steps, at least 1
+****************************************************************************/
+static uint8_t TicksPerStep(uint16_t Time_ms, uint8_t NumSteps)
+{
+    uint16_t Ticks;
+
+    if (0 == NumSteps)
+    {
+        return 1;
+    }
+    Ticks = Time_ms / ((uint16_t)BRIGHTNESS_TICK * NumSteps);
+    if (Ticks < 1)
+    {
+        Ticks = 1;
+    }
+    else if (Ticks > UINT8_MAX)
+    {
+        Ticks = UINT8_MAX;
+    }
+    return (uint8_t)Ticks;
+}
+
+/*------------------------------ End of file ------------------------------*/
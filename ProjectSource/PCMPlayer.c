@@ -0,0 +1,179 @@
+/****************************************************************************
+ Module
+     PCMPlayer.c
+ Description
+     Streams 8 bit samples from flash into the buzzer's PWM duty register
+     from the Timer3 interrupt. See PCMPlayer.h.
+ Notes
+     The PWM channel is OC1, set up on Timer2 by BuzzService. For playback
+     Timer2 is run at PBCLK with a period of 256 ticks, a 78kHz carrier, so
+     each sample goes into OC1RS as it is, with no scaling. Timer3 runs at
+     PBCLK and interrupts once per sample; the ISR is one load and one store
+     until the last sample, when it puts Timer2 back and reports the end.
+*****************************************************************************/
+/*----------------------------- Include Files -----------------------------*/
+#include <xc.h>
+#include <sys/attribs.h> // for ISR macros
+#include <stdbool.h>
+#include <stddef.h>
+#include "PCMPlayer.h"
+
+/*----------------------------- Module Defines ----------------------------*/
+#define PCM_CARRIER_PERIOD 255  // 8 bit samples map straight onto OC1RS
+#define TIMER_PRESCALE_1   0b000
+#define PCM_INT_PRIORITY   4
+// shortest sample period we will take on, 16kHz
+#define MIN_SAMPLE_PERIOD  PCM_SAMPLE_PERIOD(16000)
+
+/*---------------------------- Module Functions ---------------------------*/
+static void stopPlayback(void);
+
+/*---------------------------- Module Variables ---------------------------*/
+// next sample to go out and one past the last, shared with the ISR
+static const uint8_t * volatile pNextSample;
+static const uint8_t * volatile pEndSample;
+static volatile bool IsPlaying = false;
+
+// Timer2 settings in use by the buzzer before the clip started
+static uint32_t SavedPR2;
+static uint8_t SavedT2Prescale;
+
+static PCM_DoneFunc_t pClipDoneFunc = NULL;
+
+/*------------------------------ Module Code ------------------------------*/
+/****************************************************************************
+ Function
+    PCM_Init
+
+ Description
+   Sets Timer3 up as the sample clock, stopped, with its interrupt off
+   until a clip is started.
+****************************************************************************/
+bool PCM_Init(PCM_DoneFunc_t pDoneFunc)
+{
+  T3CONbits.ON = 0;
+  T3CONbits.TCS = 0;  // use PBClk as clock source
+  T3CONbits.TCKPS = TIMER_PRESCALE_1;
+  TMR3 = 0;
+  IPC3bits.T3IP = PCM_INT_PRIORITY;
+  IFS0CLR = _IFS0_T3IF_MASK;
+  IEC0CLR = _IEC0_T3IE_MASK;
+
+  IsPlaying = false;
+  pClipDoneFunc = pDoneFunc;
+  return true;
+}
+
+/****************************************************************************
+ Function
+    PCM_Play
+
+ Description
+   Switches Timer2 to the PCM carrier, puts the first sample out and starts
+   Timer3. The ISR takes it from there.
+****************************************************************************/
+bool PCM_Play(const PCMClip_t *pClip)
+{
+  if ((NULL == pClip) || (0 == pClip->NumSamples) ||
+      (pClip->SamplePeriod < MIN_SAMPLE_PERIOD))
+  {
+    return false;
+  }
+  PCM_Stop();
+
+  SavedPR2 = PR2;
+  SavedT2Prescale = T2CONbits.TCKPS;
+  pNextSample = pClip->pSamples + 1;
+  pEndSample = pClip->pSamples + pClip->NumSamples;
+
+  T2CONbits.ON = 0;
+  T2CONbits.TCKPS = TIMER_PRESCALE_1;
+  PR2 = PCM_CARRIER_PERIOD;
+  TMR2 = 0;
+  OC1RS = pClip->pSamples[0];
+  T2CONbits.ON = 1;
+
+  PR3 = pClip->SamplePeriod - 1;
+  TMR3 = 0;
+  IFS0CLR = _IFS0_T3IF_MASK;
+  IEC0SET = _IEC0_T3IE_MASK;
+  IsPlaying = true;
+  T3CONbits.ON = 1;
+  return true;
+}
+
+/****************************************************************************
+ Function
+    PCM_Stop
+
+ Description
+   Cuts off the clip that is playing, if any. Interrupts are only turned
+   back on if they were on, so this is safe with them already off.
+****************************************************************************/
+void PCM_Stop(void)
+{
+  uint32_t Status;
+
+  Status = __builtin_disable_interrupts();
+  if (true == IsPlaying)
+  {
+    stopPlayback();
+  }
+  if (0 != (Status & _CP0_STATUS_IE_MASK))
+  {
+    __builtin_enable_interrupts();
+  }
+}
+
+/****************************************************************************
+ Function
+    PCM_IsPlaying
+****************************************************************************/
+bool PCM_IsPlaying(void)
+{
+  return IsPlaying;
+}
+
+/****************************************************************************
+ Function
+    PCM_SampleISR
+
+ Description
+   Puts the next sample into OC1RS. After the last one has had its sample
+   period, stops the clip and reports it done.
+****************************************************************************/
+void __ISR(_TIMER_3_VECTOR, IPL4AUTO) PCM_SampleISR(void)
+{
+  IFS0CLR = _IFS0_T3IF_MASK;
+  if (pNextSample != pEndSample)
+  {
+    OC1RS = *pNextSample;
+    pNextSample++;
+  }
+  else
+  {
+    stopPlayback();
+    if (NULL != pClipDoneFunc)
+    {
+      pClipDoneFunc();
+    }
+  }
+}
+
+/*--------------------------- private functions ---------------------------*/
+// silences OC1 and gives Timer2 back to the buzzer, call with Timer3's
+// interrupt unable to run
+static void stopPlayback(void)
+{
+  T3CONbits.ON = 0;
+  IEC0CLR = _IEC0_T3IE_MASK;
+  IFS0CLR = _IFS0_T3IF_MASK;
+
+  OC1RS = 0;
+  T2CONbits.ON = 0;
+  T2CONbits.TCKPS = SavedT2Prescale;
+  PR2 = SavedPR2;
+  TMR2 = 0;
+  T2CONbits.ON = 1;
+  IsPlaying = false;
+}
@@ -0,0 +1,597 @@
+/****************************************************************************
+ Module
+     PCMSamples.c
+ Description
+     Sampled sound effects for PCMPlayer, played by BuzzService.
+ Notes
+     Unsigned 8 bit at 8kHz, 0x80 is silence. Each clip ramps in over its
+     first 2ms so it does not start with a click. New clips need a table
+     here and a PCMClip_t declared in PCMPlayer.h.
+*****************************************************************************/
+/*----------------------------- Include Files -----------------------------*/
+#include <stdint.h>
+#include "PCMPlayer.h"
+
+/*----------------------------- Module Defines ----------------------------*/
+#define PCM_SAMPLE_RATE 8000
+
+/*---------------------------- Module Variables ---------------------------*/
+// falling square/sine chirp, 2 kHz down to 300 Hz, linear fade
+// 2000 samples, 0.25 s at 8000 Hz
+static const uint8_t ZapSamples[] = {
+    0x80, 0x84, 0x72, 0x74, 0x9B, 0x95, 0x57, 0x62, 0xB7, 0xA7, 0x3C, 0x50, 0xD2, 0xBA, 0x21, 0x3B,
+    0xEC, 0xCB, 0x14, 0x33, 0xEB, 0xD0, 0x16, 0x2D, 0xE8, 0xD5, 0x19, 0x28, 0xE5, 0xDB, 0x1D, 0x22,
+    0xE0, 0xE1, 0x23, 0x1D, 0xD9, 0xE6, 0x2B, 0x18, 0xD0, 0xEA, 0x35, 0x15, 0xC6, 0xEB, 0xC1, 0x15,
+    0x39, 0xEA, 0xCD, 0x18, 0x2D, 0xE5, 0xD9, 0x1F, 0x22, 0xDC, 0xE2, 0x2A, 0x1A, 0xD0, 0xE9, 0x38,
+    0x16, 0xC0, 0xEA, 0xC7, 0x17, 0x31, 0xE5, 0xD7, 0x20, 0x22, 0xDA, 0xE3, 0x2E, 0x19, 0xC9, 0xE9,
+    0x40, 0x17, 0x37, 0xE7, 0xD2, 0x1E, 0x25, 0xDB, 0xE2, 0x2D, 0x1A, 0xC8, 0xE9, 0xC1, 0x18, 0x34,
+    0xE5, 0xD6, 0x22, 0x21, 0xD5, 0xE5, 0x36, 0x18, 0x41, 0xE8, 0xCC, 0x1C, 0x29, 0xDC, 0xE0, 0x2E,
+    0x1A, 0xC5, 0xE8, 0xC5, 0x1B, 0x2E, 0xDF, 0xDC, 0x2B, 0x1C, 0xC8, 0xE7, 0xC2, 0x1B, 0x30, 0xDF,
+    0xDC, 0x2C, 0x1C, 0xC6, 0xE7, 0xC4, 0x1C, 0x2D, 0xDC, 0xDE, 0x31, 0x1B, 0xC0, 0xE6, 0xCB, 0x1F,
+    0x27, 0xD6, 0xE2, 0x3A, 0x1A, 0x3C, 0xE3, 0xD4, 0x27, 0x20, 0xCA, 0xE5, 0xC1, 0x1D, 0x2F, 0xDA,
+    0xDE, 0x35, 0x1B, 0x40, 0xE3, 0xD1, 0x26, 0x22, 0xCA, 0xE4, 0xC1, 0x1E, 0x2D, 0xD8, 0xDF, 0x39,
+    0x1C, 0x3B, 0xE0, 0xD6, 0x2D, 0x1F, 0xC1, 0xE4, 0xCB, 0x24, 0x25, 0xCC, 0xE3, 0xBF, 0x1F, 0x2E,
+    0xD5, 0xE0, 0x3D, 0x1D, 0x37, 0xDC, 0xDA, 0x35, 0x1D, 0x3F, 0xE0, 0xD4, 0x2E, 0x1F, 0xBD, 0xE2,
+    0xCE, 0x29, 0x22, 0xC3, 0xE2, 0xC9, 0x26, 0x25, 0xC8, 0xE2, 0xC4, 0x24, 0x28, 0xCB, 0xE1, 0xC1,
+    0x22, 0x2A, 0xCD, 0xE1, 0xBF, 0x22, 0x2C, 0xCE, 0xE0, 0xBD, 0x22, 0x2D, 0xCE, 0xE0, 0xBD, 0x22,
+    0x2C, 0xCE, 0xE0, 0xBF, 0x23, 0x2B, 0xCC, 0xE0, 0xC1, 0x25, 0x29, 0xC8, 0xE0, 0xC4, 0x27, 0x27,
+    0xC4, 0xE0, 0xC8, 0x2A, 0x25, 0xBF, 0xDF, 0xCD, 0x2F, 0x23, 0x46, 0xDD, 0xD3, 0x35, 0x21, 0x3E,
+    0xD9, 0xD8, 0x3D, 0x21, 0x37, 0xD3, 0xDC, 0x46, 0x24, 0x2F, 0xCB, 0xDE, 0xC2, 0x29, 0x28, 0xC0,
+    0xDE, 0xCC, 0x31, 0x23, 0x43, 0xD9, 0xD5, 0x3C, 0x22, 0x37, 0xD1, 0xDB, 0xBA, 0x26, 0x2C, 0xC5,
+    0xDD, 0xC8, 0x2F, 0x25, 0x46, 0xD9, 0xD4, 0x3D, 0x23, 0x37, 0xCF, 0xDB, 0xBD, 0x29, 0x2A, 0xBF,
+    0xDC, 0xCD, 0x36, 0x24, 0x3E, 0xD3, 0xD9, 0x48, 0x27, 0x2E, 0xC3, 0xDC, 0xC9, 0x33, 0x25, 0x41,
+    0xD4, 0xD7, 0x47, 0x27, 0x2F, 0xC2, 0xDB, 0xCA, 0x35, 0x25, 0x3F, 0xD2, 0xD8, 0xB8, 0x29, 0x2C,
+    0xBD, 0xD9, 0xCE, 0x3B, 0x26, 0x39, 0xCC, 0xDA, 0xC0, 0x2F, 0x29, 0x47, 0xD5, 0xD4, 0x46, 0x28,
+    0x30, 0xC1, 0xD9, 0xCB, 0x3A, 0x27, 0x3A, 0xCB, 0xD9, 0xC0, 0x31, 0x29, 0x45, 0xD2, 0xD5, 0xB6,
+    0x2B, 0x2D, 0xB9, 0xD6, 0xD0, 0x43, 0x29, 0x33, 0xC1, 0xD8, 0xCA, 0x3C, 0x28, 0x39, 0xC7, 0xD8,
+    0xC4, 0x37, 0x28, 0x3E, 0xCB, 0xD7, 0xBF, 0x33, 0x2A, 0x43, 0xCE, 0xD6, 0xBB, 0x31, 0x2B, 0x46,
+    0xCF, 0xD5, 0xB9, 0x30, 0x2C, 0x48, 0xD0, 0xD4, 0xB7, 0x30, 0x2D, 0x49, 0xD0, 0xD3, 0xB7, 0x30,
+    0x2D, 0x48, 0xCF, 0xD3, 0xB8, 0x31, 0x2C, 0x47, 0xCE, 0xD4, 0xBA, 0x33, 0x2C, 0x44, 0xCB, 0xD4,
+    0xBE, 0x36, 0x2B, 0x40, 0xC8, 0xD5, 0xC2, 0x3B, 0x2B, 0x3C, 0xC3, 0xD5, 0xC7, 0x40, 0x2C, 0x37,
+    0xBC, 0xD3, 0xCC, 0x48, 0x2E, 0x32, 0xB4, 0xD0, 0xD0, 0xB5, 0x33, 0x2E, 0x46, 0xCA, 0xD3, 0xBE,
+    0x3A, 0x2D, 0x3D, 0xC1, 0xD3, 0xC7, 0x44, 0x2E, 0x35, 0xB6, 0xD0, 0xCE, 0xB4, 0x34, 0x2F, 0x46,
+    0xC8, 0xD2, 0xC0, 0x3E, 0x2E, 0x3A, 0xBC, 0xD1, 0xCB, 0x4B, 0x32, 0x31, 0x4A, 0xCA, 0xD1, 0xBD,
+    0x3C, 0x2E, 0x3C, 0xBC, 0xD1, 0xCA, 0x4C, 0x33, 0x32, 0x4A, 0xC8, 0xD1, 0xBF, 0x3F, 0x2F, 0x3A,
+    0xB8, 0xCE, 0xCC, 0xB2, 0x37, 0x30, 0x44, 0xC2, 0xD0, 0xC4, 0x47, 0x32, 0x35, 0x4E, 0xC9, 0xCF,
+    0xBC, 0x3F, 0x30, 0x3B, 0xB7, 0xCD, 0xCB, 0xB3, 0x39, 0x31, 0x42, 0xBE, 0xCF, 0xC7, 0x4D, 0x35,
+    0x33, 0x48, 0xC3, 0xCF, 0xC3, 0x48, 0x33, 0x36, 0x4D, 0xC6, 0xCE, 0xBF, 0x45, 0x33, 0x38, 0x51,
+    0xC7, 0xCD, 0xBC, 0x43, 0x32, 0x3A, 0xB0, 0xC8, 0xCD, 0xBA, 0x42, 0x33, 0x3B, 0xB1, 0xC8, 0xCC,
+    0xBA, 0x42, 0x33, 0x3B, 0xB0, 0xC7, 0xCC, 0xBB, 0x44, 0x34, 0x3A, 0x52, 0xC6, 0xCC, 0xBC, 0x46,
+    0x35, 0x39, 0x4F, 0xC3, 0xCC, 0xBF, 0x4A, 0x37, 0x37, 0x4B, 0xC0, 0xCC, 0xC3, 0x4F, 0x39, 0x35,
+    0x46, 0xBA, 0xCB, 0xC6, 0xB0, 0x3E, 0x35, 0x41, 0xB4, 0xC8, 0xC9, 0xB7, 0x44, 0x36, 0x3B, 0x51,
+    0xC2, 0xCB, 0xBE, 0x4D, 0x39, 0x37, 0x49, 0xBB, 0xCA, 0xC5, 0xB0, 0x40, 0x36, 0x40, 0xB0, 0xC5,
+    0xC9, 0xBA, 0x49, 0x38, 0x3A, 0x4C, 0xBC, 0xC9, 0xC3, 0xAE, 0x3F, 0x37, 0x41, 0xB0, 0xC4, 0xC8,
+    0xBA, 0x4B, 0x3A, 0x3A, 0x4B, 0xB9, 0xC8, 0xC4, 0xB1, 0x43, 0x38, 0x3F, 0x54, 0xC0, 0xC8, 0xBE,
+    0x52, 0x3E, 0x38, 0x45, 0xB2, 0xC4, 0xC7, 0xB8, 0x4B, 0x3B, 0x3B, 0x4B, 0xB7, 0xC6, 0xC4, 0xB3,
+    0x47, 0x3A, 0x3D, 0x4F, 0xBB, 0xC7, 0xC2, 0xAF, 0x44, 0x39, 0x40, 0x53, 0xBD, 0xC6, 0xBF, 0xAC,
+    0x43, 0x3A, 0x41, 0x55, 0xBE, 0xC6, 0xBE, 0xAA, 0x42, 0x3A, 0x42, 0x56, 0xBD, 0xC6, 0xBE, 0xAA,
+    0x43, 0x3B, 0x42, 0x55, 0xBC, 0xC5, 0xBE, 0xAB, 0x45, 0x3B, 0x41, 0x54, 0xBA, 0xC5, 0xBF, 0xAE,
+    0x47, 0x3C, 0x40, 0x51, 0xB7, 0xC3, 0xC1, 0xB1, 0x4B, 0x3E, 0x3E, 0x4D, 0xB2, 0xC1, 0xC3, 0xB6,
+    0x50, 0x40, 0x3D, 0x48, 0xAC, 0xBE, 0xC3, 0xBB, 0x57, 0x45, 0x3D, 0x43, 0x54, 0xB8, 0xC2, 0xBF,
+    0xAF, 0x4C, 0x3F, 0x3F, 0x4D, 0xB0, 0xBF, 0xC2, 0xB7, 0x55, 0x44, 0x3E, 0x45, 0x57, 0xB8, 0xC2,
+    0xBE, 0xAE, 0x4C, 0x40, 0x40, 0x4D, 0xAE, 0xBD, 0xC1, 0xB8, 0x58, 0x47, 0x3F, 0x44, 0x54, 0xB4,
+    0xC0, 0xBF, 0xB2, 0x52, 0x43, 0x3F, 0x49, 0xA7, 0xB8, 0xC0, 0xBC, 0xAD, 0x4E, 0x41, 0x41, 0x4C,
+    0xAB, 0xBB, 0xC0, 0xB9, 0xA9, 0x4B, 0x41, 0x43, 0x4F, 0xAE, 0xBC, 0xBF, 0xB7, 0xA7, 0x4A, 0x41,
+    0x44, 0x51, 0xAF, 0xBC, 0xBF, 0xB6, 0x5A, 0x4A, 0x41, 0x45, 0x52, 0xAE, 0xBB, 0xBE, 0xB6, 0xA6,
+    0x4B, 0x42, 0x44, 0x51, 0xAD, 0xBA, 0xBE, 0xB7, 0xA8, 0x4D, 0x43, 0x44, 0x4F, 0xAA, 0xB8, 0xBE,
+    0xB8, 0xAA, 0x50, 0x45, 0x43, 0x4C, 0xA5, 0xB5, 0xBD, 0xBA, 0xAE, 0x55, 0x48, 0x43, 0x49, 0x57,
+    0xB0, 0xBB, 0xBC, 0xB3, 0x5B, 0x4C, 0x44, 0x46, 0x51, 0xA9, 0xB7, 0xBC, 0xB7, 0xAA, 0x53, 0x47,
+    0x44, 0x4C, 0x5A, 0xB0, 0xBA, 0xBA, 0xB1, 0x5B, 0x4D, 0x45, 0x47, 0x52, 0xA8, 0xB5, 0xBB, 0xB7,
+    0xAC, 0x56, 0x4A, 0x45, 0x4A, 0x57, 0xAC, 0xB7, 0xBA, 0xB4, 0xA7, 0x52, 0x48, 0x46, 0x4E, 0x5B,
+    0xAF, 0xB8, 0xB9, 0xB1, 0xA3, 0x50, 0x47, 0x47, 0x50, 0xA3, 0xB1, 0xB9, 0xB8, 0xAF, 0x5C, 0x4F,
+    0x48, 0x48, 0x52, 0xA4, 0xB1, 0xB8, 0xB7, 0xAE, 0x5C, 0x4F, 0x48, 0x49, 0x52, 0xA3, 0xB0, 0xB8,
+    0xB7, 0xAE, 0x5E, 0x51, 0x49, 0x49, 0x51, 0x5E, 0xAE, 0xB6, 0xB7, 0xB0, 0xA3, 0x53, 0x4A, 0x49,
+    0x4F, 0x5B, 0xAB, 0xB5, 0xB7, 0xB2, 0xA6, 0x57, 0x4D, 0x49, 0x4D, 0x58, 0xA7, 0xB2, 0xB7, 0xB4,
+    0xAA, 0x5C, 0x51, 0x4A, 0x4B, 0x53, 0xA1, 0xAD, 0xB5, 0xB5, 0xAF, 0xA3, 0x56, 0x4D, 0x4A, 0x4F,
+    0x59, 0xA6, 0xB1, 0xB5, 0xB3, 0xAA, 0x5E, 0x52, 0x4C, 0x4C, 0x53, 0x5E, 0xAA, 0xB3, 0xB5, 0xB0,
+    0xA6, 0x5A, 0x50, 0x4B, 0x4E, 0x56, 0xA1, 0xAC, 0xB3, 0xB4, 0xAE, 0xA3, 0x58, 0x4F, 0x4C, 0x4F,
+    0x58, 0xA2, 0xAD, 0xB3, 0xB3, 0xAC, 0xA1, 0x58, 0x4F, 0x4D, 0x50, 0x59, 0xA2, 0xAD, 0xB3, 0xB2,
+    0xAC, 0xA1, 0x59, 0x50, 0x4D, 0x51, 0x59, 0xA1, 0xAB, 0xB2, 0xB2, 0xAC, 0xA2, 0x5B, 0x52, 0x4E,
+    0x50, 0x58, 0x9F, 0xA9, 0xB0, 0xB2, 0xAD, 0xA4, 0x5E, 0x54, 0x4F, 0x4F, 0x56, 0x5F, 0xA5, 0xAE,
+    0xB1, 0xAF, 0xA7, 0x62, 0x58, 0x51, 0x4F, 0x53, 0x5B, 0xA0, 0xAA, 0xB0, 0xB0, 0xAB, 0xA2, 0x5D,
+    0x55, 0x50, 0x51, 0x57, 0x60, 0xA4, 0xAC, 0xB0, 0xAE, 0xA7, 0x9E, 0x5A, 0x53, 0x50, 0x53, 0x5A,
+    0x9D, 0xA7, 0xAD, 0xAF, 0xAC, 0xA5, 0x62, 0x59, 0x53, 0x51, 0x55, 0x5C, 0x9E, 0xA7, 0xAD, 0xAF,
+    0xAB, 0xA3, 0x62, 0x59, 0x53, 0x52, 0x56, 0x5D, 0x9E, 0xA7, 0xAD, 0xAE, 0xAA, 0xA3, 0x62, 0x5A,
+    0x54, 0x52, 0x56, 0x5D, 0x9D, 0xA6, 0xAC, 0xAD, 0xAA, 0xA3, 0x64, 0x5B, 0x55, 0x53, 0x55, 0x5C,
+    0x65, 0xA3, 0xAA, 0xAD, 0xAB, 0xA5, 0x9D, 0x5E, 0x57, 0x54, 0x55, 0x5A, 0x62, 0x9F, 0xA7, 0xAB,
+    0xAC, 0xA7, 0xA0, 0x63, 0x5B, 0x56, 0x54, 0x57, 0x5E, 0x9A, 0xA3, 0xA9, 0xAB, 0xAA, 0xA4, 0x9C,
+    0x60, 0x59, 0x55, 0x56, 0x5A, 0x61, 0x9D, 0xA4, 0xA9, 0xAB, 0xA8, 0xA2, 0x9A, 0x5F, 0x59, 0x56,
+    0x57, 0x5C, 0x63, 0x9E, 0xA5, 0xA9, 0xAA, 0xA7, 0xA0, 0x66, 0x5F, 0x59, 0x56, 0x58, 0x5C, 0x64,
+    0x9D, 0xA4, 0xA8, 0xA9, 0xA6, 0xA0, 0x67, 0x60, 0x5A, 0x57, 0x58, 0x5C, 0x63, 0x9C, 0xA2, 0xA7,
+    0xA8, 0xA6, 0xA1, 0x9A, 0x62, 0x5C, 0x58, 0x58, 0x5B, 0x61, 0x99, 0xA0, 0xA5, 0xA8, 0xA7, 0xA3,
+    0x9C, 0x66, 0x5F, 0x5A, 0x59, 0x5A, 0x5F, 0x66, 0x9C, 0xA2, 0xA6, 0xA7, 0xA5, 0x9F, 0x99, 0x63,
+    0x5D, 0x5A, 0x5A, 0x5C, 0x62, 0x69, 0x9D, 0xA3, 0xA6, 0xA6, 0xA3, 0x9D, 0x69, 0x62, 0x5D, 0x5A,
+    0x5B, 0x5E, 0x63, 0x97, 0x9E, 0xA3, 0xA5, 0xA5, 0xA2, 0x9C, 0x69, 0x62, 0x5E, 0x5B, 0x5B, 0x5F,
+    0x64, 0x97, 0x9D, 0xA2, 0xA4, 0xA4, 0xA1, 0x9C, 0x6A, 0x64, 0x5F, 0x5C, 0x5C, 0x5F, 0x63, 0x6A,
+    0x9B, 0xA0, 0xA3, 0xA4, 0xA2, 0x9D, 0x97, 0x66, 0x61, 0x5E, 0x5C, 0x5E, 0x62, 0x68, 0x98, 0x9E,
+    0xA1, 0xA3, 0xA2, 0x9F, 0x9A, 0x6A, 0x64, 0x60, 0x5E, 0x5E, 0x60, 0x65, 0x6A, 0x9A, 0x9F, 0xA2,
+    0xA2, 0xA1, 0x9D, 0x97, 0x69, 0x64, 0x60, 0x5E, 0x5F, 0x62, 0x67, 0x95, 0x9A, 0x9E, 0xA1, 0xA1,
+    0x9F, 0x9C, 0x96, 0x69, 0x64, 0x60, 0x5F, 0x60, 0x63, 0x67, 0x94, 0x99, 0x9D, 0xA0, 0xA1, 0x9F,
+    0x9B, 0x96, 0x6A, 0x65, 0x62, 0x60, 0x60, 0x63, 0x67, 0x6C, 0x97, 0x9C, 0x9F, 0xA0, 0x9F, 0x9C,
+    0x98, 0x6D, 0x68, 0x64, 0x61, 0x61, 0x62, 0x65, 0x6A, 0x94, 0x99, 0x9D, 0x9F, 0x9F, 0x9D, 0x99,
+    0x95, 0x6B, 0x67, 0x63, 0x62, 0x62, 0x64, 0x67, 0x6C, 0x95, 0x99, 0x9D, 0x9E, 0x9E, 0x9B, 0x98,
+    0x93, 0x6B, 0x67, 0x64, 0x62, 0x63, 0x65, 0x69, 0x6D, 0x95, 0x99, 0x9C, 0x9D, 0x9D, 0x9B, 0x97,
+    0x93, 0x6C, 0x68, 0x65, 0x63, 0x64, 0x65, 0x69, 0x6D, 0x93, 0x97, 0x9A, 0x9C, 0x9C, 0x9B, 0x98,
+    0x94, 0x6E, 0x6A, 0x66, 0x65, 0x64, 0x65, 0x68, 0x6C, 0x91, 0x95, 0x98, 0x9B, 0x9B, 0x9B, 0x98,
+    0x95, 0x91, 0x6C, 0x69, 0x66, 0x65, 0x65, 0x67, 0x6A, 0x6E, 0x92, 0x95, 0x98, 0x9A, 0x9A, 0x99,
+    0x97, 0x94, 0x90, 0x6D, 0x69, 0x67, 0x66, 0x66, 0x68, 0x6B, 0x6E, 0x91, 0x95, 0x98, 0x99, 0x9A,
+    0x99, 0x96, 0x93, 0x90, 0x6E, 0x6A, 0x68, 0x67, 0x67, 0x69, 0x6B, 0x6E, 0x90, 0x93, 0x96, 0x98,
+    0x99, 0x98, 0x96, 0x94, 0x90, 0x70, 0x6C, 0x6A, 0x68, 0x68, 0x69, 0x6B, 0x6D, 0x71, 0x91, 0x94,
+    0x96, 0x97, 0x98, 0x97, 0x95, 0x92, 0x8F, 0x6F, 0x6C, 0x6A, 0x69, 0x69, 0x6A, 0x6C, 0x6F, 0x72,
+    0x91, 0x93, 0x95, 0x97, 0x97, 0x96, 0x94, 0x91, 0x8E, 0x70, 0x6D, 0x6B, 0x6A, 0x6A, 0x6B, 0x6D,
+    0x6F, 0x72, 0x8F, 0x92, 0x94, 0x95, 0x96, 0x95, 0x93, 0x91, 0x8E, 0x71, 0x6F, 0x6D, 0x6B, 0x6B,
+    0x6B, 0x6D, 0x6F, 0x72, 0x8E, 0x90, 0x92, 0x94, 0x95, 0x94, 0x93, 0x91, 0x8F, 0x74, 0x71, 0x6F,
+    0x6D, 0x6C, 0x6C, 0x6D, 0x6E, 0x70, 0x73, 0x8D, 0x90, 0x92, 0x93, 0x94, 0x93, 0x92, 0x90, 0x8E,
+    0x74, 0x72, 0x70, 0x6E, 0x6D, 0x6D, 0x6E, 0x6F, 0x71, 0x73, 0x8C, 0x8F, 0x91, 0x92, 0x93, 0x92,
+    0x91, 0x90, 0x8E, 0x8B, 0x73, 0x71, 0x6F, 0x6E, 0x6E, 0x6E, 0x6F, 0x71, 0x73, 0x8B, 0x8D, 0x8F,
+    0x90, 0x91, 0x91, 0x91, 0x90, 0x8E, 0x8C, 0x75, 0x73, 0x71, 0x70, 0x6F, 0x6F, 0x70, 0x71, 0x72,
+    0x74, 0x8A, 0x8C, 0x8E, 0x8F, 0x90, 0x90, 0x90, 0x8F, 0x8D, 0x8B, 0x76, 0x74, 0x72, 0x71, 0x70,
+    0x70, 0x71, 0x72, 0x73, 0x75, 0x77, 0x8B, 0x8D, 0x8E, 0x8F, 0x8F, 0x8F, 0x8E, 0x8D, 0x8B, 0x89,
+    0x76, 0x74, 0x73, 0x72, 0x71, 0x71, 0x72, 0x73, 0x75, 0x76, 0x89, 0x8B, 0x8C, 0x8D, 0x8E, 0x8E,
+    0x8E, 0x8D, 0x8C, 0x8A, 0x88, 0x76, 0x75, 0x74, 0x73, 0x72, 0x73, 0x73, 0x74, 0x76, 0x77, 0x89,
+    0x8A, 0x8B, 0x8C, 0x8D, 0x8D, 0x8D, 0x8C, 0x8B, 0x8A, 0x88, 0x77, 0x76, 0x75, 0x74, 0x74, 0x74,
+    0x74, 0x75, 0x76, 0x77, 0x79, 0x89, 0x8A, 0x8B, 0x8B, 0x8C, 0x8C, 0x8B, 0x8A, 0x89, 0x88, 0x79,
+    0x78, 0x77, 0x76, 0x75, 0x75, 0x75, 0x75, 0x76, 0x77, 0x78, 0x87, 0x88, 0x89, 0x8A, 0x8A, 0x8B,
+    0x8B, 0x8A, 0x89, 0x88, 0x87, 0x86, 0x79, 0x78, 0x77, 0x76, 0x76, 0x76, 0x76, 0x77, 0x78, 0x79,
+    0x7A, 0x87, 0x88, 0x88, 0x89, 0x89, 0x89, 0x89, 0x89, 0x88, 0x87, 0x86, 0x7A, 0x79, 0x78, 0x78,
+    0x77, 0x77, 0x77, 0x78, 0x78, 0x79, 0x7A, 0x7B, 0x86, 0x87, 0x87, 0x88, 0x88, 0x88, 0x88, 0x87,
+    0x87, 0x86, 0x85, 0x7B, 0x7A, 0x7A, 0x79, 0x79, 0x79, 0x79, 0x79, 0x79, 0x7A, 0x7B, 0x7B, 0x85,
+    0x85, 0x86, 0x86, 0x87, 0x87, 0x87, 0x86, 0x86, 0x85, 0x85, 0x84, 0x7C, 0x7B, 0x7B, 0x7A, 0x7A,
+    0x7A, 0x7A, 0x7A, 0x7B, 0x7B, 0x7C, 0x7C, 0x84, 0x84, 0x85, 0x85, 0x85, 0x85, 0x85, 0x85, 0x85,
+    0x84, 0x84, 0x83, 0x7D, 0x7C, 0x7C, 0x7B, 0x7B, 0x7B, 0x7B, 0x7B, 0x7C, 0x7C, 0x7C, 0x7D, 0x83,
+    0x83, 0x84, 0x84, 0x84, 0x84, 0x84, 0x84, 0x84, 0x83, 0x83, 0x83, 0x82, 0x7D, 0x7D, 0x7D, 0x7D,
+    0x7D, 0x7D, 0x7D, 0x7D, 0x7D, 0x7D, 0x7E, 0x7E, 0x82, 0x82, 0x82, 0x83, 0x83, 0x83, 0x83, 0x83,
+    0x83, 0x82, 0x82, 0x82, 0x82, 0x7E, 0x7E, 0x7E, 0x7E, 0x7E, 0x7E, 0x7E, 0x7E, 0x7E, 0x7E, 0x7F,
+    0x7F, 0x7F, 0x81, 0x81, 0x81, 0x81, 0x81, 0x81, 0x81, 0x81, 0x81, 0x81, 0x81, 0x81, 0x81, 0x7F,
+    0x7F, 0x7F, 0x7F, 0x7F, 0x7F, 0x7F, 0x7F, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80
+};
+
+// low passed noise burst, darkening as it decays
+// 4000 samples, 0.50 s at 8000 Hz
+static const uint8_t BoomSamples[] = {
+    0x80, 0x7B, 0x7E, 0x7D, 0x73, 0x83, 0x71, 0x7C, 0x76, 0x5E, 0x4F, 0x3D, 0x53, 0x88, 0x91, 0x69,
+    0x40, 0x43, 0x23, 0x50, 0x35, 0x3C, 0x5B, 0x66, 0x4F, 0x8D, 0x9B, 0xC8, 0x97, 0xB5, 0xEC, 0xC0,
+    0xC1, 0xDB, 0xFA, 0xFA, 0xE1, 0xE7, 0xC6, 0x73, 0x37, 0x07, 0x07, 0x0F, 0x63, 0x6D, 0x39, 0x11,
+    0x08, 0x36, 0x21, 0x21, 0x67, 0x91, 0x93, 0x52, 0x69, 0x49, 0x80, 0x8B, 0x8B, 0xA1, 0x70, 0x6D,
+    0x58, 0x29, 0x0C, 0x57, 0xAD, 0xA8, 0x74, 0x86, 0x66, 0x7A, 0x47, 0x0C, 0x0D, 0x0D, 0x12, 0x74,
+    0x68, 0x57, 0x77, 0x7E, 0x93, 0xCC, 0x93, 0xA4, 0xB1, 0xA1, 0x95, 0xA0, 0x7D, 0x8A, 0x6A, 0x82,
+    0xBA, 0xB5, 0xB5, 0x84, 0x62, 0x28, 0x43, 0x35, 0x50, 0x5F, 0x85, 0x92, 0x91, 0x84, 0x51, 0x86,
+    0x6B, 0x4F, 0x43, 0x61, 0x8B, 0xC5, 0xA5, 0x8A, 0x77, 0xAC, 0x88, 0x4D, 0x2D, 0x40, 0x46, 0x4A,
+    0x6D, 0x99, 0xA4, 0x7C, 0x6B, 0x57, 0x74, 0x5B, 0x92, 0xCA, 0xEB, 0xD3, 0x83, 0x63, 0x8A, 0x69,
+    0x66, 0x41, 0x40, 0x47, 0x8A, 0x6D, 0x7F, 0x94, 0x82, 0x64, 0x86, 0x65, 0x8A, 0x8A, 0x77, 0x7B,
+    0xB2, 0xC5, 0xAE, 0x9F, 0x79, 0x60, 0x32, 0x1E, 0x25, 0x3B, 0x42, 0x72, 0x57, 0x39, 0x33, 0x38,
+    0x64, 0x5F, 0x95, 0x75, 0x3E, 0x6F, 0x68, 0x5A, 0x33, 0x2E, 0x5E, 0x40, 0x57, 0x64, 0x7A, 0x62,
+    0x53, 0x76, 0x63, 0x66, 0x43, 0x51, 0x71, 0x4F, 0x83, 0xB3, 0xCB, 0xE3, 0xB9, 0x7F, 0x79, 0x97,
+    0xBA, 0xC7, 0xC3, 0x86, 0x90, 0xBD, 0xAD, 0x85, 0x67, 0x39, 0x35, 0x74, 0x90, 0x96, 0x91, 0x87,
+    0x7A, 0x82, 0x59, 0x83, 0x99, 0x6E, 0x4E, 0x72, 0xA1, 0xC7, 0xCB, 0xBA, 0xD7, 0xD0, 0xA3, 0x87,
+    0xAB, 0x8C, 0x8B, 0x8F, 0x76, 0x9A, 0x84, 0xA4, 0x87, 0x9A, 0xAF, 0xBC, 0x96, 0x85, 0x8B, 0x61,
+    0x48, 0x59, 0x3B, 0x5E, 0x46, 0x66, 0x9F, 0xD1, 0xAB, 0xB2, 0xA6, 0x8D, 0x9A, 0x6F, 0x83, 0xAB,
+    0xA8, 0x85, 0x56, 0x62, 0x5A, 0x4D, 0x77, 0x9C, 0xCC, 0xD9, 0xC3, 0x9F, 0xAC, 0x83, 0x4F, 0x6B,
+    0x6C, 0x4B, 0x3A, 0x32, 0x28, 0x46, 0x7C, 0xA2, 0x87, 0x58, 0x7B, 0x78, 0x86, 0x5E, 0x6F, 0x9C,
+    0xA1, 0x90, 0x9C, 0xAE, 0xBA, 0xD0, 0xAD, 0xB5, 0x9F, 0x68, 0x45, 0x6D, 0x9A, 0x94, 0xA7, 0x7E,
+    0x7C, 0x7A, 0x5A, 0x76, 0x90, 0x7E, 0x7B, 0x86, 0x7D, 0x9A, 0x96, 0x9C, 0x71, 0x64, 0x73, 0x55,
+    0x33, 0x3C, 0x3A, 0x32, 0x2D, 0x3E, 0x33, 0x30, 0x2D, 0x36, 0x59, 0x7F, 0x7E, 0x95, 0x91, 0x74,
+    0x72, 0x7F, 0x8D, 0xB2, 0xC2, 0xBE, 0x91, 0x99, 0x81, 0x80, 0x8D, 0x88, 0x8A, 0x83, 0x69, 0x4F,
+    0x66, 0x8C, 0x8B, 0x69, 0x71, 0x56, 0x55, 0x70, 0x5E, 0x59, 0x64, 0x54, 0x41, 0x50, 0x49, 0x59,
+    0x85, 0x8E, 0x97, 0xB5, 0xCB, 0xCE, 0xCE, 0xCE, 0xCE, 0xCE, 0xBC, 0xA3, 0x7F, 0x80, 0xA4, 0x9A,
+    0xB1, 0xC6, 0xCD, 0xBB, 0x8F, 0xA0, 0xBC, 0xB6, 0x96, 0x7D, 0x8B, 0xAA, 0xB4, 0xC7, 0xBD, 0xA0,
+    0x7D, 0x64, 0x5B, 0x72, 0x79, 0x5A, 0x5F, 0x7F, 0x6E, 0x65, 0x58, 0x80, 0x99, 0x8B, 0x78, 0x85,
+    0x6F, 0x4A, 0x36, 0x36, 0x36, 0x57, 0x8C, 0x7A, 0x65, 0x74, 0x5C, 0x5B, 0x45, 0x53, 0x81, 0xAA,
+    0xB6, 0xBB, 0xB0, 0x89, 0x9D, 0x7D, 0x75, 0x73, 0x7D, 0x80, 0x89, 0x95, 0xB4, 0xC7, 0xC7, 0xC7,
+    0xC7, 0xC0, 0xB9, 0x9A, 0x6D, 0x7B, 0x7D, 0x62, 0x43, 0x3A, 0x47, 0x47, 0x5C, 0x89, 0xB3, 0xB0,
+    0xBA, 0xC0, 0xC6, 0xC5, 0xC5, 0xA1, 0x72, 0x86, 0x72, 0x6B, 0x55, 0x4C, 0x74, 0x97, 0xA6, 0x91,
+    0x7C, 0x8B, 0x9B, 0x85, 0x80, 0x8F, 0xA5, 0xB2, 0xC2, 0xA2, 0xA9, 0xBF, 0xAE, 0xA8, 0xA6, 0x97,
+    0xA4, 0x9F, 0x98, 0x76, 0x52, 0x3E, 0x3E, 0x3E, 0x3E, 0x43, 0x65, 0x66, 0x5F, 0x57, 0x67, 0x58,
+    0x6D, 0x8D, 0x99, 0xB3, 0xC1, 0xAB, 0xA3, 0x92, 0x9A, 0xA6, 0x90, 0x90, 0x8B, 0x7B, 0x65, 0x7F,
+    0x76, 0x92, 0x9A, 0x7C, 0x7C, 0x66, 0x68, 0x60, 0x6E, 0x83, 0x8D, 0x98, 0xA2, 0x88, 0x77, 0x61,
+    0x66, 0x6A, 0x73, 0x81, 0x9E, 0x87, 0x96, 0x9B, 0xA3, 0x91, 0x98, 0x81, 0x88, 0x80, 0x94, 0x90,
+    0x8D, 0x72, 0x71, 0x6B, 0x7B, 0x94, 0xA5, 0xB9, 0xA1, 0x9F, 0x80, 0x6A, 0x57, 0x52, 0x4D, 0x66,
+    0x71, 0x80, 0x74, 0x81, 0x78, 0x8F, 0x9F, 0xA4, 0xA2, 0xA1, 0x96, 0x9A, 0xA0, 0xB4, 0xA5, 0x9A,
+    0x89, 0x9A, 0x97, 0x8E, 0x96, 0x8F, 0x79, 0x75, 0x65, 0x4C, 0x45, 0x45, 0x46, 0x4A, 0x46, 0x46,
+    0x46, 0x55, 0x71, 0x7A, 0x83, 0x88, 0x9B, 0x9D, 0xA4, 0xA2, 0x97, 0x95, 0xA5, 0xAB, 0x8D, 0x91,
+    0x9D, 0xA8, 0xB8, 0xB0, 0xAE, 0xA8, 0x89, 0x90, 0x91, 0x76, 0x66, 0x67, 0x5D, 0x5E, 0x69, 0x5C,
+    0x56, 0x59, 0x70, 0x6A, 0x64, 0x62, 0x76, 0x90, 0x91, 0x9A, 0xA7, 0xB4, 0xB7, 0xB1, 0xA1, 0x90,
+    0x94, 0x93, 0x9B, 0xA1, 0x93, 0x77, 0x6E, 0x7F, 0x80, 0x78, 0x7C, 0x85, 0x95, 0xA2, 0xB3, 0xAA,
+    0xA3, 0x85, 0x8F, 0x93, 0x8C, 0x9B, 0xAB, 0xB3, 0xB3, 0xA0, 0x9E, 0x90, 0x98, 0x99, 0xA1, 0x9D,
+    0xA1, 0x9C, 0x7F, 0x80, 0x84, 0x79, 0x88, 0x9F, 0x97, 0x8C, 0x75, 0x78, 0x87, 0x7F, 0x73, 0x85,
+    0x9F, 0xB4, 0xAB, 0x9F, 0x94, 0x97, 0x98, 0x91, 0x90, 0x88, 0x81, 0x72, 0x66, 0x64, 0x6C, 0x69,
+    0x77, 0x8B, 0x95, 0xA4, 0x9E, 0x9A, 0x82, 0x7D, 0x7F, 0x6E, 0x68, 0x5D, 0x6A, 0x72, 0x70, 0x66,
+    0x5E, 0x6F, 0x6E, 0x60, 0x53, 0x5E, 0x7C, 0x95, 0xAB, 0xB1, 0xA0, 0x94, 0x88, 0x84, 0x76, 0x6F,
+    0x7F, 0x82, 0x7F, 0x85, 0x8E, 0x7F, 0x8D, 0x92, 0x92, 0x96, 0x93, 0x9A, 0x85, 0x86, 0x79, 0x81,
+    0x73, 0x7C, 0x8E, 0x92, 0x81, 0x6B, 0x6E, 0x76, 0x73, 0x79, 0x8F, 0x88, 0x81, 0x8D, 0x99, 0x8F,
+    0x8C, 0x7D, 0x6A, 0x57, 0x60, 0x66, 0x6D, 0x6A, 0x5C, 0x52, 0x62, 0x70, 0x7B, 0x74, 0x62, 0x52,
+    0x61, 0x79, 0x84, 0x78, 0x85, 0x8B, 0x9A, 0x8A, 0x7A, 0x87, 0x7D, 0x7A, 0x6E, 0x73, 0x7B, 0x71,
+    0x68, 0x6A, 0x74, 0x78, 0x7A, 0x83, 0x82, 0x7E, 0x82, 0x82, 0x72, 0x7F, 0x7A, 0x7F, 0x8C, 0x9B,
+    0x9D, 0x8F, 0x8F, 0x98, 0x98, 0x86, 0x79, 0x7C, 0x8F, 0x93, 0x8D, 0x88, 0x7B, 0x6E, 0x6F, 0x7C,
+    0x7B, 0x85, 0x91, 0x84, 0x87, 0x7F, 0x7B, 0x80, 0x73, 0x7F, 0x72, 0x74, 0x6A, 0x6D, 0x74, 0x73,
+    0x81, 0x88, 0x7E, 0x83, 0x88, 0x92, 0x9F, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0x9E, 0x83, 0x6A, 0x64,
+    0x76, 0x76, 0x69, 0x69, 0x66, 0x6A, 0x73, 0x70, 0x68, 0x5C, 0x6C, 0x72, 0x81, 0x8B, 0x90, 0x96,
+    0x91, 0x8E, 0x8A, 0x96, 0x9B, 0xA1, 0xA1, 0x97, 0x98, 0x87, 0x8D, 0x7F, 0x71, 0x6D, 0x6E, 0x7F,
+    0x8B, 0x97, 0x9D, 0x94, 0x8C, 0x83, 0x7C, 0x80, 0x78, 0x79, 0x82, 0x87, 0x95, 0x9D, 0x9E, 0xA3,
+    0x9C, 0x91, 0x81, 0x72, 0x7E, 0x82, 0x82, 0x74, 0x77, 0x84, 0x8F, 0x8D, 0x93, 0x8F, 0x8D, 0x87,
+    0x91, 0x89, 0x8B, 0x85, 0x83, 0x84, 0x7F, 0x74, 0x7A, 0x70, 0x75, 0x72, 0x75, 0x74, 0x7C, 0x86,
+    0x82, 0x87, 0x7C, 0x7E, 0x78, 0x6B, 0x70, 0x7B, 0x73, 0x6D, 0x73, 0x71, 0x6C, 0x6D, 0x79, 0x85,
+    0x88, 0x7E, 0x73, 0x7A, 0x75, 0x71, 0x70, 0x72, 0x6B, 0x71, 0x7A, 0x73, 0x7A, 0x7A, 0x77, 0x7C,
+    0x82, 0x90, 0x93, 0x88, 0x79, 0x7C, 0x80, 0x78, 0x7A, 0x81, 0x8F, 0x97, 0x92, 0x81, 0x74, 0x75,
+    0x7D, 0x7A, 0x6D, 0x6D, 0x7C, 0x78, 0x6E, 0x79, 0x74, 0x73, 0x6B, 0x66, 0x63, 0x6C, 0x7D, 0x86,
+    0x81, 0x74, 0x7C, 0x7C, 0x7A, 0x7A, 0x71, 0x74, 0x78, 0x7D, 0x83, 0x81, 0x88, 0x92, 0x8B, 0x87,
+    0x8D, 0x89, 0x82, 0x7B, 0x73, 0x70, 0x66, 0x6A, 0x7B, 0x7F, 0x84, 0x88, 0x7C, 0x84, 0x8C, 0x95,
+    0x8D, 0x88, 0x85, 0x77, 0x79, 0x7A, 0x79, 0x7A, 0x73, 0x7E, 0x81, 0x86, 0x91, 0x8D, 0x88, 0x82,
+    0x8B, 0x8F, 0x88, 0x80, 0x79, 0x70, 0x7A, 0x76, 0x7E, 0x81, 0x7A, 0x7E, 0x87, 0x80, 0x83, 0x78,
+    0x71, 0x77, 0x7D, 0x79, 0x80, 0x85, 0x8F, 0x97, 0x98, 0x95, 0x9B, 0x90, 0x84, 0x81, 0x88, 0x7E,
+    0x80, 0x84, 0x7D, 0x77, 0x77, 0x6E, 0x65, 0x62, 0x61, 0x61, 0x61, 0x6B, 0x68, 0x61, 0x65, 0x64,
+    0x62, 0x66, 0x68, 0x64, 0x61, 0x6C, 0x74, 0x74, 0x74, 0x74, 0x6F, 0x67, 0x69, 0x67, 0x63, 0x70,
+    0x82, 0x8D, 0x8E, 0x86, 0x7E, 0x81, 0x89, 0x95, 0x96, 0x9C, 0x9E, 0x96, 0x8A, 0x88, 0x8C, 0x8C,
+    0x87, 0x7C, 0x6F, 0x76, 0x7C, 0x7A, 0x71, 0x69, 0x63, 0x63, 0x71, 0x81, 0x80, 0x85, 0x87, 0x8A,
+    0x8F, 0x86, 0x86, 0x88, 0x7F, 0x80, 0x87, 0x8F, 0x91, 0x85, 0x81, 0x77, 0x77, 0x6F, 0x6C, 0x70,
+    0x7A, 0x7B, 0x84, 0x82, 0x80, 0x81, 0x7C, 0x77, 0x79, 0x7F, 0x81, 0x79, 0x79, 0x73, 0x7A, 0x74,
+    0x71, 0x7A, 0x85, 0x83, 0x8B, 0x93, 0x90, 0x8A, 0x8B, 0x91, 0x8C, 0x82, 0x78, 0x77, 0x78, 0x78,
+    0x81, 0x7B, 0x7F, 0x7B, 0x83, 0x85, 0x82, 0x82, 0x7B, 0x7C, 0x82, 0x85, 0x88, 0x90, 0x8B, 0x8D,
+    0x92, 0x89, 0x7E, 0x79, 0x77, 0x7D, 0x79, 0x7C, 0x7A, 0x82, 0x84, 0x7F, 0x79, 0x7D, 0x7F, 0x83,
+    0x7D, 0x83, 0x84, 0x82, 0x7F, 0x83, 0x7D, 0x81, 0x7C, 0x78, 0x7D, 0x78, 0x70, 0x70, 0x7B, 0x85,
+    0x83, 0x7A, 0x73, 0x6A, 0x66, 0x67, 0x67, 0x70, 0x70, 0x71, 0x7A, 0x79, 0x7B, 0x79, 0x7E, 0x7F,
+    0x87, 0x84, 0x80, 0x86, 0x8F, 0x8D, 0x92, 0x98, 0x91, 0x85, 0x87, 0x88, 0x8C, 0x92, 0x98, 0x91,
+    0x89, 0x86, 0x81, 0x83, 0x7D, 0x82, 0x81, 0x80, 0x7C, 0x75, 0x6C, 0x69, 0x6A, 0x6B, 0x76, 0x74,
+    0x7A, 0x7A, 0x81, 0x7D, 0x84, 0x81, 0x7B, 0x80, 0x86, 0x83, 0x7C, 0x7D, 0x83, 0x83, 0x84, 0x84,
+    0x82, 0x81, 0x7C, 0x78, 0x76, 0x78, 0x76, 0x75, 0x71, 0x76, 0x73, 0x77, 0x77, 0x74, 0x71, 0x73,
+    0x78, 0x7A, 0x82, 0x81, 0x7B, 0x79, 0x75, 0x77, 0x78, 0x7B, 0x7D, 0x79, 0x71, 0x6F, 0x76, 0x77,
+    0x79, 0x75, 0x76, 0x7D, 0x7C, 0x7B, 0x82, 0x86, 0x82, 0x7E, 0x82, 0x83, 0x82, 0x82, 0x7C, 0x76,
+    0x72, 0x77, 0x75, 0x7B, 0x85, 0x85, 0x89, 0x8B, 0x87, 0x88, 0x82, 0x81, 0x87, 0x84, 0x7C, 0x7E,
+    0x83, 0x82, 0x88, 0x8F, 0x93, 0x8D, 0x89, 0x84, 0x7F, 0x7C, 0x7D, 0x81, 0x86, 0x84, 0x89, 0x8C,
+    0x8A, 0x8B, 0x89, 0x8C, 0x91, 0x92, 0x95, 0x91, 0x89, 0x7F, 0x80, 0x82, 0x82, 0x86, 0x81, 0x81,
+    0x80, 0x83, 0x85, 0x86, 0x87, 0x83, 0x80, 0x7C, 0x76, 0x74, 0x72, 0x75, 0x71, 0x75, 0x7B, 0x7A,
+    0x7F, 0x7E, 0x83, 0x84, 0x85, 0x7F, 0x7D, 0x7D, 0x7F, 0x82, 0x89, 0x90, 0x8D, 0x8B, 0x84, 0x80,
+    0x7C, 0x7D, 0x7E, 0x7E, 0x7A, 0x7B, 0x82, 0x85, 0x80, 0x78, 0x77, 0x72, 0x78, 0x7D, 0x83, 0x88,
+    0x84, 0x7D, 0x80, 0x85, 0x82, 0x7F, 0x7B, 0x7D, 0x83, 0x82, 0x7D, 0x81, 0x82, 0x86, 0x8B, 0x90,
+    0x92, 0x8F, 0x90, 0x89, 0x82, 0x7F, 0x78, 0x77, 0x76, 0x71, 0x6D, 0x73, 0x77, 0x74, 0x75, 0x7C,
+    0x82, 0x88, 0x8D, 0x87, 0x89, 0x8C, 0x89, 0x8A, 0x8E, 0x92, 0x91, 0x92, 0x92, 0x93, 0x93, 0x92,
+    0x92, 0x8C, 0x86, 0x80, 0x80, 0x7C, 0x76, 0x72, 0x73, 0x79, 0x7E, 0x7F, 0x7C, 0x7C, 0x7A, 0x77,
+    0x75, 0x71, 0x6E, 0x73, 0x7A, 0x80, 0x83, 0x87, 0x86, 0x89, 0x8E, 0x8C, 0x8C, 0x85, 0x80, 0x7D,
+    0x7F, 0x7C, 0x77, 0x7B, 0x7B, 0x80, 0x7F, 0x7A, 0x74, 0x75, 0x79, 0x79, 0x78, 0x77, 0x76, 0x72,
+    0x75, 0x78, 0x7B, 0x7F, 0x81, 0x7D, 0x7A, 0x78, 0x7A, 0x7D, 0x7F, 0x7C, 0x78, 0x7A, 0x7E, 0x7C,
+    0x78, 0x74, 0x78, 0x7C, 0x80, 0x80, 0x80, 0x7C, 0x77, 0x71, 0x74, 0x78, 0x78, 0x75, 0x74, 0x74,
+    0x76, 0x75, 0x7A, 0x7B, 0x7F, 0x7D, 0x7A, 0x76, 0x7A, 0x7E, 0x7E, 0x7F, 0x83, 0x82, 0x82, 0x81,
+    0x81, 0x82, 0x7E, 0x7E, 0x7E, 0x7A, 0x7D, 0x81, 0x7F, 0x7F, 0x83, 0x82, 0x83, 0x88, 0x88, 0x85,
+    0x80, 0x7E, 0x7C, 0x7B, 0x7F, 0x84, 0x88, 0x84, 0x83, 0x82, 0x7F, 0x79, 0x77, 0x75, 0x78, 0x7D,
+    0x83, 0x85, 0x81, 0x7D, 0x7A, 0x7D, 0x81, 0x85, 0x89, 0x8B, 0x8E, 0x8C, 0x8D, 0x8A, 0x8B, 0x8A,
+    0x8D, 0x88, 0x89, 0x85, 0x84, 0x80, 0x7D, 0x7D, 0x7C, 0x7E, 0x7E, 0x7F, 0x82, 0x86, 0x86, 0x83,
+    0x7E, 0x7A, 0x76, 0x77, 0x7A, 0x7C, 0x7E, 0x7C, 0x7D, 0x7E, 0x82, 0x80, 0x81, 0x82, 0x83, 0x83,
+    0x87, 0x8B, 0x8F, 0x8F, 0x8B, 0x85, 0x7D, 0x7A, 0x7C, 0x7F, 0x7F, 0x82, 0x81, 0x80, 0x7F, 0x7B,
+    0x77, 0x77, 0x78, 0x76, 0x77, 0x77, 0x7B, 0x7D, 0x81, 0x84, 0x83, 0x82, 0x83, 0x84, 0x83, 0x7E,
+    0x7C, 0x7A, 0x7D, 0x83, 0x82, 0x80, 0x82, 0x83, 0x84, 0x81, 0x80, 0x7F, 0x81, 0x83, 0x84, 0x86,
+    0x87, 0x85, 0x82, 0x81, 0x82, 0x80, 0x7D, 0x7F, 0x83, 0x82, 0x84, 0x88, 0x89, 0x88, 0x85, 0x83,
+    0x7F, 0x7E, 0x80, 0x7D, 0x7D, 0x7C, 0x7A, 0x79, 0x78, 0x76, 0x75, 0x78, 0x7C, 0x7D, 0x7B, 0x7A,
+    0x7A, 0x7A, 0x78, 0x7B, 0x7E, 0x82, 0x82, 0x83, 0x81, 0x7D, 0x7D, 0x7B, 0x7A, 0x78, 0x7C, 0x7C,
+    0x7E, 0x7E, 0x7E, 0x7E, 0x7C, 0x7A, 0x7C, 0x81, 0x81, 0x83, 0x84, 0x84, 0x81, 0x7E, 0x7E, 0x80,
+    0x7F, 0x7C, 0x7D, 0x80, 0x81, 0x83, 0x82, 0x83, 0x83, 0x83, 0x83, 0x83, 0x85, 0x86, 0x83, 0x80,
+    0x7D, 0x79, 0x75, 0x73, 0x75, 0x75, 0x73, 0x74, 0x75, 0x79, 0x7B, 0x7C, 0x7F, 0x7E, 0x7E, 0x80,
+    0x83, 0x82, 0x85, 0x88, 0x87, 0x86, 0x85, 0x82, 0x82, 0x84, 0x83, 0x81, 0x7E, 0x7E, 0x7F, 0x82,
+    0x81, 0x82, 0x83, 0x83, 0x83, 0x85, 0x84, 0x82, 0x82, 0x84, 0x86, 0x89, 0x87, 0x88, 0x88, 0x88,
+    0x84, 0x83, 0x80, 0x7D, 0x7C, 0x7A, 0x7A, 0x7A, 0x77, 0x76, 0x74, 0x74, 0x74, 0x79, 0x7C, 0x7D,
+    0x7A, 0x7A, 0x7E, 0x7E, 0x7D, 0x7C, 0x7B, 0x7B, 0x7B, 0x7C, 0x7C, 0x7D, 0x7D, 0x7C, 0x7A, 0x78,
+    0x75, 0x75, 0x78, 0x79, 0x7A, 0x7C, 0x80, 0x83, 0x83, 0x86, 0x84, 0x84, 0x84, 0x85, 0x86, 0x89,
+    0x87, 0x85, 0x82, 0x7E, 0x7C, 0x7D, 0x7E, 0x80, 0x81, 0x84, 0x88, 0x89, 0x8A, 0x88, 0x84, 0x81,
+    0x7F, 0x80, 0x80, 0x7D, 0x7D, 0x7E, 0x7D, 0x7E, 0x81, 0x83, 0x85, 0x83, 0x84, 0x85, 0x83, 0x82,
+    0x80, 0x81, 0x81, 0x80, 0x7F, 0x7D, 0x7D, 0x7B, 0x7B, 0x7B, 0x7B, 0x7C, 0x7C, 0x7D, 0x7C, 0x7D,
+    0x7B, 0x7D, 0x80, 0x81, 0x82, 0x84, 0x84, 0x85, 0x84, 0x83, 0x81, 0x7E, 0x7D, 0x7F, 0x7F, 0x7E,
+    0x80, 0x80, 0x81, 0x7F, 0x7F, 0x81, 0x83, 0x85, 0x86, 0x87, 0x85, 0x83, 0x84, 0x82, 0x80, 0x82,
+    0x83, 0x84, 0x85, 0x87, 0x88, 0x88, 0x89, 0x86, 0x84, 0x80, 0x7D, 0x7C, 0x7C, 0x7F, 0x82, 0x85,
+    0x88, 0x88, 0x89, 0x86, 0x83, 0x7F, 0x7B, 0x7C, 0x7E, 0x7E, 0x7F, 0x7E, 0x7B, 0x7A, 0x7C, 0x7B,
+    0x7A, 0x7B, 0x7D, 0x7F, 0x80, 0x80, 0x81, 0x80, 0x81, 0x80, 0x81, 0x81, 0x80, 0x7F, 0x7F, 0x7E,
+    0x7D, 0x7E, 0x81, 0x83, 0x85, 0x87, 0x86, 0x85, 0x83, 0x82, 0x80, 0x7E, 0x7F, 0x80, 0x81, 0x82,
+    0x83, 0x84, 0x84, 0x82, 0x81, 0x81, 0x80, 0x81, 0x80, 0x7E, 0x7D, 0x7C, 0x7C, 0x7D, 0x7F, 0x80,
+    0x82, 0x82, 0x83, 0x81, 0x82, 0x84, 0x84, 0x85, 0x87, 0x87, 0x86, 0x85, 0x86, 0x84, 0x81, 0x7F,
+    0x7D, 0x7E, 0x7F, 0x81, 0x83, 0x83, 0x82, 0x7F, 0x80, 0x7F, 0x7F, 0x80, 0x80, 0x80, 0x82, 0x84,
+    0x86, 0x87, 0x86, 0x84, 0x82, 0x80, 0x7E, 0x7D, 0x7D, 0x7B, 0x7C, 0x7C, 0x7E, 0x80, 0x81, 0x82,
+    0x84, 0x85, 0x85, 0x86, 0x84, 0x82, 0x81, 0x82, 0x81, 0x7F, 0x7E, 0x7E, 0x7E, 0x7F, 0x7E, 0x7F,
+    0x7F, 0x7E, 0x7F, 0x7E, 0x80, 0x82, 0x82, 0x82, 0x83, 0x82, 0x83, 0x82, 0x80, 0x7D, 0x7D, 0x7D,
+    0x7E, 0x81, 0x82, 0x83, 0x83, 0x82, 0x82, 0x83, 0x84, 0x84, 0x84, 0x84, 0x86, 0x86, 0x86, 0x85,
+    0x84, 0x82, 0x82, 0x81, 0x82, 0x84, 0x83, 0x82, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x81, 0x81,
+    0x81, 0x80, 0x7F, 0x7F, 0x7E, 0x7E, 0x7F, 0x7F, 0x80, 0x80, 0x7F, 0x7E, 0x7F, 0x7F, 0x81, 0x83,
+    0x84, 0x84, 0x83, 0x82, 0x82, 0x81, 0x82, 0x83, 0x83, 0x82, 0x81, 0x81, 0x80, 0x81, 0x81, 0x81,
+    0x82, 0x82, 0x83, 0x83, 0x84, 0x82, 0x81, 0x81, 0x83, 0x84, 0x83, 0x83, 0x85, 0x86, 0x85, 0x85,
+    0x84, 0x83, 0x82, 0x80, 0x81, 0x82, 0x83, 0x82, 0x81, 0x82, 0x83, 0x83, 0x82, 0x81, 0x7F, 0x7F,
+    0x7E, 0x7E, 0x7F, 0x80, 0x80, 0x80, 0x82, 0x81, 0x7F, 0x80, 0x80, 0x80, 0x7F, 0x7E, 0x7D, 0x7E,
+    0x80, 0x80, 0x7F, 0x7E, 0x7D, 0x7D, 0x7D, 0x7E, 0x7F, 0x80, 0x7F, 0x7E, 0x7E, 0x7D, 0x7D, 0x7D,
+    0x7D, 0x7D, 0x7C, 0x7B, 0x7A, 0x79, 0x7A, 0x7C, 0x7D, 0x7D, 0x7D, 0x7E, 0x7F, 0x81, 0x82, 0x83,
+    0x84, 0x84, 0x85, 0x83, 0x84, 0x84, 0x84, 0x84, 0x83, 0x82, 0x81, 0x81, 0x82, 0x82, 0x83, 0x83,
+    0x82, 0x81, 0x82, 0x82, 0x82, 0x82, 0x81, 0x81, 0x80, 0x7E, 0x7E, 0x7E, 0x7D, 0x7D, 0x7F, 0x81,
+    0x82, 0x81, 0x82, 0x83, 0x84, 0x84, 0x85, 0x85, 0x85, 0x84, 0x84, 0x85, 0x85, 0x85, 0x84, 0x82,
+    0x82, 0x81, 0x81, 0x81, 0x80, 0x7F, 0x7E, 0x7C, 0x7C, 0x7C, 0x7B, 0x7B, 0x7B, 0x7B, 0x7A, 0x7A,
+    0x7A, 0x7A, 0x7A, 0x7A, 0x7A, 0x7A, 0x7A, 0x7A, 0x7A, 0x7A, 0x7A, 0x7A, 0x7C, 0x7E, 0x80, 0x82,
+    0x82, 0x82, 0x83, 0x83, 0x84, 0x85, 0x84, 0x84, 0x83, 0x83, 0x82, 0x82, 0x82, 0x81, 0x81, 0x81,
+    0x81, 0x82, 0x81, 0x80, 0x80, 0x81, 0x81, 0x80, 0x81, 0x81, 0x82, 0x81, 0x81, 0x80, 0x7F, 0x7E,
+    0x7C, 0x7C, 0x7D, 0x7E, 0x7F, 0x80, 0x81, 0x81, 0x80, 0x7F, 0x7E, 0x7E, 0x7D, 0x7E, 0x7D, 0x7E,
+    0x7F, 0x80, 0x7F, 0x7F, 0x80, 0x81, 0x82, 0x82, 0x82, 0x82, 0x82, 0x83, 0x83, 0x84, 0x84, 0x83,
+    0x83, 0x82, 0x81, 0x82, 0x82, 0x82, 0x81, 0x7F, 0x7E, 0x7F, 0x7E, 0x7E, 0x7E, 0x7F, 0x7F, 0x80,
+    0x80, 0x80, 0x80, 0x7F, 0x80, 0x80, 0x7F, 0x7F, 0x7F, 0x80, 0x81, 0x81, 0x82, 0x82, 0x81, 0x80,
+    0x7F, 0x80, 0x81, 0x81, 0x82, 0x81, 0x81, 0x80, 0x80, 0x81, 0x81, 0x82, 0x81, 0x81, 0x81, 0x81,
+    0x81, 0x81, 0x81, 0x81, 0x82, 0x83, 0x83, 0x84, 0x84, 0x84, 0x83, 0x82, 0x82, 0x82, 0x82, 0x81,
+    0x81, 0x82, 0x82, 0x81, 0x81, 0x82, 0x82, 0x82, 0x81, 0x81, 0x81, 0x81, 0x81, 0x80, 0x7F, 0x7E,
+    0x7D, 0x7C, 0x7B, 0x7C, 0x7D, 0x7E, 0x7F, 0x7F, 0x80, 0x81, 0x82, 0x82, 0x82, 0x82, 0x81, 0x80,
+    0x7F, 0x7E, 0x7F, 0x7E, 0x7E, 0x7E, 0x7F, 0x7F, 0x80, 0x80, 0x80, 0x81, 0x81, 0x82, 0x83, 0x84,
+    0x84, 0x85, 0x85, 0x85, 0x84, 0x84, 0x83, 0x82, 0x82, 0x82, 0x81, 0x81, 0x81, 0x81, 0x81, 0x81,
+    0x81, 0x81, 0x81, 0x80, 0x7F, 0x7F, 0x7F, 0x7E, 0x7D, 0x7C, 0x7C, 0x7D, 0x7E, 0x7F, 0x80, 0x81,
+    0x81, 0x81, 0x80, 0x7F, 0x80, 0x80, 0x80, 0x81, 0x82, 0x83, 0x83, 0x82, 0x82, 0x82, 0x82, 0x81,
+    0x81, 0x81, 0x82, 0x81, 0x80, 0x7F, 0x7F, 0x7E, 0x7E, 0x7E, 0x7F, 0x7F, 0x80, 0x81, 0x82, 0x82,
+    0x81, 0x80, 0x7F, 0x7F, 0x80, 0x81, 0x81, 0x81, 0x81, 0x80, 0x7F, 0x7F, 0x7F, 0x7F, 0x80, 0x81,
+    0x81, 0x80, 0x80, 0x80, 0x80, 0x81, 0x81, 0x81, 0x81, 0x82, 0x82, 0x83, 0x83, 0x82, 0x82, 0x82,
+    0x81, 0x81, 0x81, 0x81, 0x81, 0x80, 0x80, 0x80, 0x80, 0x7F, 0x7E, 0x7F, 0x7F, 0x7F, 0x7F, 0x80,
+    0x80, 0x80, 0x80, 0x80, 0x81, 0x81, 0x81, 0x82, 0x82, 0x83, 0x83, 0x83, 0x83, 0x83, 0x82, 0x83,
+    0x83, 0x83, 0x83, 0x83, 0x83, 0x83, 0x83, 0x82, 0x82, 0x82, 0x81, 0x81, 0x80, 0x81, 0x81, 0x80,
+    0x80, 0x80, 0x81, 0x81, 0x81, 0x81, 0x82, 0x81, 0x81, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80,
+    0x80, 0x80, 0x80, 0x81, 0x80, 0x7F, 0x7F, 0x7F, 0x80, 0x80, 0x80, 0x80, 0x7F, 0x7F, 0x7F, 0x7F,
+    0x80, 0x80, 0x7F, 0x7F, 0x7F, 0x80, 0x80, 0x7F, 0x7F, 0x7F, 0x7E, 0x7E, 0x7E, 0x7D, 0x7E, 0x7E,
+    0x7E, 0x7F, 0x7F, 0x80, 0x80, 0x81, 0x81, 0x81, 0x81, 0x82, 0x82, 0x82, 0x82, 0x82, 0x82, 0x81,
+    0x81, 0x80, 0x80, 0x80, 0x80, 0x80, 0x7F, 0x7F, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80,
+    0x7F, 0x7F, 0x7F, 0x80, 0x80, 0x7F, 0x7F, 0x80, 0x81, 0x81, 0x81, 0x81, 0x81, 0x81, 0x81, 0x81,
+    0x82, 0x82, 0x82, 0x82, 0x82, 0x82, 0x82, 0x82, 0x82, 0x82, 0x82, 0x83, 0x83, 0x83, 0x83, 0x83,
+    0x83, 0x82, 0x82, 0x81, 0x81, 0x81, 0x80, 0x80, 0x81, 0x81, 0x81, 0x80, 0x80, 0x80, 0x80, 0x81,
+    0x81, 0x82, 0x82, 0x82, 0x81, 0x81, 0x81, 0x81, 0x81, 0x81, 0x81, 0x81, 0x82, 0x82, 0x82, 0x81,
+    0x80, 0x7F, 0x7F, 0x7F, 0x7F, 0x80, 0x80, 0x7F, 0x7F, 0x7F, 0x7E, 0x7E, 0x7E, 0x7E, 0x7E, 0x7E,
+    0x7E, 0x7F, 0x7F, 0x7F, 0x80, 0x80, 0x80, 0x7F, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x7F, 0x7F,
+    0x7F, 0x7F, 0x7F, 0x7F, 0x7F, 0x7F, 0x7F, 0x7F, 0x7F, 0x80, 0x81, 0x81, 0x81, 0x81, 0x82, 0x82,
+    0x82, 0x82, 0x83, 0x83, 0x83, 0x83, 0x83, 0x83, 0x83, 0x83, 0x82, 0x82, 0x81, 0x81, 0x81, 0x80,
+    0x80, 0x80, 0x80, 0x80, 0x7F, 0x7F, 0x7F, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80,
+    0x81, 0x81, 0x81, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x81, 0x80, 0x80, 0x80, 0x7F,
+    0x7F, 0x7F, 0x7F, 0x7F, 0x7F, 0x7F, 0x7F, 0x7F, 0x7F, 0x7F, 0x80, 0x80, 0x80, 0x80, 0x81, 0x81,
+    0x81, 0x81, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x7F, 0x7F, 0x7F, 0x7F, 0x7F, 0x7F, 0x7F, 0x80,
+    0x80, 0x80, 0x81, 0x81, 0x81, 0x81, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80,
+    0x80, 0x80, 0x80, 0x80, 0x81, 0x80, 0x80, 0x80, 0x80, 0x7F, 0x7F, 0x7F, 0x80, 0x80, 0x80, 0x80,
+    0x80, 0x80, 0x80, 0x7F, 0x7F, 0x7F, 0x7F, 0x7F, 0x7F, 0x7F, 0x7F, 0x7F, 0x80, 0x80, 0x80, 0x81,
+    0x81, 0x80, 0x80, 0x80, 0x81, 0x81, 0x81, 0x81, 0x81, 0x81, 0x81, 0x80, 0x80, 0x80, 0x80, 0x81,
+    0x81, 0x81, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x7F, 0x7F, 0x7F,
+    0x7F, 0x7F, 0x7F, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80,
+    0x81, 0x81, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x7F, 0x7F, 0x7F, 0x7E,
+    0x7E, 0x7E, 0x7E, 0x7E, 0x7E, 0x7D, 0x7D, 0x7D, 0x7D, 0x7D, 0x7E, 0x7E, 0x7E, 0x7E, 0x7E, 0x7F,
+    0x7F, 0x7F, 0x7F, 0x7F, 0x7F, 0x7F, 0x7F, 0x7F, 0x7F, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80,
+    0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x81, 0x81, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80,
+    0x81, 0x81, 0x80, 0x80, 0x81, 0x81, 0x80, 0x80, 0x80, 0x80, 0x7F, 0x7F, 0x7F, 0x7F, 0x7F, 0x7F,
+    0x7F, 0x7F, 0x7F, 0x7F, 0x7F, 0x7F, 0x7F, 0x7F, 0x7F, 0x7F, 0x7F, 0x7F, 0x7F, 0x80, 0x7F, 0x80,
+    0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x81, 0x81, 0x81, 0x81, 0x81, 0x81, 0x81, 0x81, 0x80, 0x80,
+    0x80, 0x80, 0x80, 0x7F, 0x7F, 0x7F, 0x7F, 0x7F, 0x7F, 0x7F, 0x7F, 0x7F, 0x7F, 0x7F, 0x7F, 0x80,
+    0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x81, 0x81, 0x81, 0x80, 0x80, 0x80,
+    0x80, 0x80, 0x80, 0x80, 0x80, 0x81, 0x81, 0x81, 0x81, 0x81, 0x81, 0x81, 0x81, 0x81, 0x81, 0x81,
+    0x81, 0x81, 0x80, 0x80, 0x80, 0x80, 0x80, 0x7F, 0x7F, 0x7F, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80,
+    0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x81, 0x81, 0x81, 0x81, 0x81, 0x81, 0x81,
+    0x80, 0x80, 0x80, 0x80, 0x80, 0x7F, 0x7F, 0x7F, 0x7F, 0x7F, 0x7F, 0x7F, 0x7F, 0x7F, 0x7F, 0x80,
+    0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x81, 0x81, 0x81, 0x81, 0x81, 0x81, 0x81, 0x81, 0x81,
+    0x81, 0x81, 0x81, 0x81, 0x81, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80,
+    0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x7F,
+    0x7F, 0x7F, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x7F,
+    0x7F, 0x7F, 0x80, 0x7F, 0x7F, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x81, 0x81, 0x81, 0x81, 0x81,
+    0x81, 0x80, 0x80, 0x80, 0x80, 0x80, 0x81, 0x80, 0x80, 0x80, 0x80, 0x80, 0x81, 0x81, 0x81, 0x81,
+    0x81, 0x81, 0x81, 0x81, 0x81, 0x81, 0x81, 0x81, 0x81, 0x81, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80,
+    0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x81, 0x81, 0x81, 0x81, 0x80, 0x80, 0x81, 0x81,
+    0x81, 0x81, 0x81, 0x80, 0x80, 0x80, 0x80, 0x81, 0x81, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80,
+    0x80, 0x80, 0x80, 0x80, 0x80, 0x81, 0x80, 0x80, 0x81, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80,
+    0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80,
+    0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80,
+    0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x81,
+    0x81, 0x81, 0x80, 0x81, 0x81, 0x80, 0x80, 0x81, 0x81, 0x81, 0x81, 0x81, 0x81, 0x81, 0x81, 0x81,
+    0x81, 0x81, 0x81, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80,
+    0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80,
+    0x80, 0x80, 0x80, 0x80, 0x81, 0x81, 0x81, 0x81, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80,
+    0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80,
+    0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80,
+    0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80,
+    0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80,
+    0x80, 0x81, 0x81, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80,
+    0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x81, 0x81, 0x81, 0x81, 0x81, 0x81, 0x81, 0x81, 0x81, 0x81,
+    0x81, 0x81, 0x81, 0x81, 0x81, 0x81, 0x81, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80,
+    0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80,
+    0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80,
+    0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x7F, 0x7F, 0x7F, 0x7F,
+    0x7F, 0x7F, 0x7F, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80,
+    0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80,
+    0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80,
+    0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80,
+    0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80,
+    0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80,
+    0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80,
+    0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80,
+    0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80,
+    0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80,
+    0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80,
+    0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x81, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80,
+    0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80,
+    0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80,
+    0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80,
+    0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80,
+    0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80
+};
+
+// two note bell, E6 then G6, exponential decay
+// 2800 samples, 0.35 s at 8000 Hz
+static const uint8_t ChimeSamples[] = {
+    0x80, 0x84, 0x87, 0x80, 0x72, 0x6E, 0x7E, 0x98, 0x9E, 0x84, 0x5F, 0x57, 0x79, 0xA9, 0xB5, 0x8A,
+    0x4F, 0x43, 0x73, 0xB0, 0xBE, 0x8F, 0x52, 0x42, 0x6F, 0xAC, 0xBE, 0x93, 0x55, 0x41, 0x6B, 0xA9,
+    0xBF, 0x97, 0x59, 0x41, 0x67, 0xA5, 0xBF, 0x9B, 0x5D, 0x41, 0x63, 0xA2, 0xBF, 0x9E, 0x60, 0x41,
+    0x60, 0x9E, 0xBE, 0xA2, 0x64, 0x42, 0x5D, 0x9A, 0xBE, 0xA5, 0x68, 0x43, 0x59, 0x96, 0xBD, 0xA8,
+    0x6C, 0x44, 0x57, 0x92, 0xBB, 0xAB, 0x70, 0x45, 0x54, 0x8E, 0xBA, 0xAD, 0x74, 0x47, 0x51, 0x89,
+    0xB8, 0xB0, 0x79, 0x49, 0x4F, 0x85, 0xB6, 0xB2, 0x7D, 0x4B, 0x4D, 0x81, 0xB4, 0xB3, 0x81, 0x4D,
+    0x4C, 0x7D, 0xB1, 0xB5, 0x85, 0x50, 0x4A, 0x79, 0xAF, 0xB6, 0x89, 0x53, 0x49, 0x76, 0xAC, 0xB7,
+    0x8C, 0x55, 0x48, 0x72, 0xA9, 0xB8, 0x90, 0x58, 0x48, 0x6E, 0xA6, 0xB8, 0x94, 0x5C, 0x47, 0x6B,
+    0xA3, 0xB9, 0x97, 0x5F, 0x47, 0x67, 0x9F, 0xB9, 0x9A, 0x62, 0x47, 0x64, 0x9C, 0xB8, 0x9D, 0x66,
+    0x48, 0x61, 0x98, 0xB8, 0xA0, 0x69, 0x49, 0x5E, 0x95, 0xB7, 0xA3, 0x6D, 0x4A, 0x5C, 0x91, 0xB6,
+    0xA6, 0x71, 0x4B, 0x59, 0x8D, 0xB5, 0xA8, 0x74, 0x4C, 0x57, 0x8A, 0xB3, 0xAA, 0x78, 0x4E, 0x55,
+    0x86, 0xB1, 0xAC, 0x7C, 0x50, 0x53, 0x82, 0xAF, 0xAE, 0x7F, 0x52, 0x51, 0x7F, 0xAD, 0xAF, 0x83,
+    0x54, 0x50, 0x7B, 0xAB, 0xB1, 0x87, 0x56, 0x4F, 0x78, 0xA9, 0xB2, 0x8A, 0x59, 0x4E, 0x74, 0xA6,
+    0xB2, 0x8D, 0x5B, 0x4D, 0x71, 0xA3, 0xB3, 0x91, 0x5E, 0x4D, 0x6E, 0xA0, 0xB3, 0x94, 0x61, 0x4D,
+    0x6B, 0x9D, 0xB3, 0x97, 0x64, 0x4D, 0x68, 0x9A, 0xB3, 0x9A, 0x67, 0x4D, 0x65, 0x97, 0xB2, 0x9C,
+    0x6B, 0x4E, 0x62, 0x94, 0xB2, 0x9F, 0x6E, 0x4F, 0x60, 0x91, 0xB1, 0xA1, 0x71, 0x50, 0x5E, 0x8D,
+    0xB0, 0xA3, 0x74, 0x51, 0x5C, 0x8A, 0xAE, 0xA5, 0x78, 0x52, 0x5A, 0x87, 0xAD, 0xA7, 0x7B, 0x54,
+    0x58, 0x83, 0xAB, 0xA9, 0x7E, 0x56, 0x56, 0x80, 0xA9, 0xAA, 0x82, 0x58, 0x55, 0x7D, 0xA7, 0xAB,
+    0x85, 0x5A, 0x54, 0x7A, 0xA5, 0xAC, 0x88, 0x5C, 0x53, 0x77, 0xA3, 0xAD, 0x8B, 0x5E, 0x53, 0x74,
+    0xA1, 0xAE, 0x8E, 0x61, 0x52, 0x71, 0x9E, 0xAE, 0x91, 0x63, 0x52, 0x6E, 0x9B, 0xAE, 0x94, 0x66,
+    0x52, 0x6B, 0x99, 0xAE, 0x96, 0x69, 0x52, 0x69, 0x96, 0xAE, 0x99, 0x6C, 0x53, 0x66, 0x93, 0xAD,
+    0x9B, 0x6F, 0x53, 0x64, 0x90, 0xAC, 0x9D, 0x72, 0x54, 0x62, 0x8D, 0xAB, 0x9F, 0x75, 0x55, 0x60,
+    0x8A, 0xAA, 0xA1, 0x78, 0x56, 0x5E, 0x87, 0xA9, 0xA3, 0x7B, 0x58, 0x5C, 0x84, 0xA8, 0xA4, 0x7D,
+    0x59, 0x5B, 0x81, 0xA6, 0xA6, 0x80, 0x5B, 0x5A, 0x7E, 0xA4, 0xA7, 0x83, 0x5D, 0x59, 0x7B, 0xA2,
+    0xA8, 0x86, 0x5F, 0x58, 0x78, 0xA0, 0xA8, 0x89, 0x61, 0x57, 0x76, 0x9E, 0xA9, 0x8C, 0x63, 0x57,
+    0x73, 0x9C, 0xA9, 0x8E, 0x65, 0x57, 0x70, 0x99, 0xA9, 0x91, 0x68, 0x57, 0x6E, 0x97, 0xA9, 0x93,
+    0x6A, 0x57, 0x6C, 0x94, 0xA9, 0x96, 0x6D, 0x57, 0x69, 0x92, 0xA9, 0x98, 0x6F, 0x58, 0x67, 0x8F,
+    0xA8, 0x9A, 0x72, 0x58, 0x65, 0x8D, 0xA7, 0x9C, 0x75, 0x59, 0x64, 0x8A, 0xA6, 0x9D, 0x77, 0x5A,
+    0x62, 0x87, 0xA5, 0x9F, 0x7A, 0x5B, 0x60, 0x84, 0xA4, 0xA0, 0x7D, 0x5D, 0x5F, 0x82, 0xA3, 0xA1,
+    0x80, 0x5E, 0x5E, 0x7F, 0xA1, 0xA3, 0x82, 0x60, 0x5D, 0x7D, 0x9F, 0xA3, 0x85, 0x61, 0x5C, 0x7A,
+    0x9E, 0xA4, 0x87, 0x63, 0x5C, 0x78, 0x9C, 0xA5, 0x8A, 0x65, 0x5B, 0x75, 0x9A, 0xA5, 0x8C, 0x67,
+    0x5B, 0x73, 0x98, 0xA5, 0x8E, 0x69, 0x5B, 0x70, 0x95, 0xA5, 0x91, 0x6C, 0x5B, 0x6E, 0x93, 0xA5,
+    0x93, 0x6E, 0x5B, 0x6C, 0x91, 0xA5, 0x95, 0x70, 0x5B, 0x6A, 0x8F, 0xA4, 0x97, 0x73, 0x5C, 0x69,
+    0x8C, 0xA4, 0x98, 0x75, 0x5D, 0x67, 0x8A, 0xA3, 0x9A, 0x77, 0x5E, 0x65, 0x87, 0xA2, 0x9B, 0x7A,
+    0x5F, 0x64, 0x85, 0xA1, 0x9D, 0x7C, 0x60, 0x63, 0x82, 0xA0, 0x9E, 0x7F, 0x61, 0x62, 0x80, 0x9E,
+    0x9F, 0x81, 0x62, 0x61, 0x7E, 0x9D, 0xA0, 0x83, 0x64, 0x60, 0x7B, 0x9B, 0xA0, 0x86, 0x66, 0x5F,
+    0x79, 0x9A, 0xA1, 0x88, 0x67, 0x5F, 0x77, 0x98, 0xA1, 0x8A, 0x69, 0x5F, 0x75, 0x96, 0xA2, 0x8C,
+    0x6B, 0x5E, 0x73, 0x94, 0xA2, 0x8E, 0x6D, 0x5E, 0x71, 0x92, 0xA2, 0x90, 0x6F, 0x5F, 0x6F, 0x90,
+    0xA1, 0x92, 0x71, 0x5F, 0x6D, 0x8E, 0xA1, 0x94, 0x73, 0x5F, 0x6B, 0x8C, 0xA0, 0x95, 0x75, 0x60,
+    0x6A, 0x89, 0xA0, 0x97, 0x78, 0x61, 0x68, 0x87, 0x9F, 0x98, 0x7A, 0x62, 0x67, 0x85, 0x9E, 0x99,
+    0x7C, 0x4F, 0x4F, 0x88, 0xB7, 0xA7, 0x6D, 0x4C, 0x66, 0x9A, 0xAB, 0x8D, 0x67, 0x63, 0x7C, 0x90,
+    0x8F, 0x83, 0x7D, 0x7C, 0x77, 0x74, 0x7F, 0x95, 0x99, 0x7D, 0x5D, 0x61, 0x8C, 0xAF, 0x9E, 0x67,
+    0x4A, 0x6B, 0xA5, 0xB6, 0x89, 0x53, 0x52, 0x83, 0xAD, 0xA2, 0x74, 0x5A, 0x6C, 0x8E, 0x99, 0x8A,
+    0x78, 0x75, 0x7B, 0x7D, 0x7F, 0x88, 0x92, 0x88, 0x6E, 0x61, 0x78, 0x9F, 0xA7, 0x81, 0x55, 0x58,
+    0x8B, 0xB4, 0xA2, 0x69, 0x4A, 0x69, 0xA0, 0xB0, 0x8B, 0x5E, 0x5B, 0x7F, 0x9E, 0x98, 0x7C, 0x6D,
+    0x74, 0x81, 0x85, 0x85, 0x88, 0x88, 0x7B, 0x6B, 0x6F, 0x8B, 0xA2, 0x93, 0x69, 0x54, 0x71, 0xA3,
+    0xAF, 0x85, 0x53, 0x54, 0x87, 0xB1, 0xA2, 0x6F, 0x52, 0x6A, 0x96, 0xA4, 0x8B, 0x6C, 0x68, 0x7C,
+    0x8C, 0x8B, 0x83, 0x81, 0x7E, 0x76, 0x72, 0x7F, 0x95, 0x98, 0x7D, 0x5F, 0x63, 0x8C, 0xAC, 0x9B,
+    0x68, 0x4F, 0x6D, 0xA2, 0xB0, 0x88, 0x58, 0x58, 0x83, 0xA7, 0x9D, 0x76, 0x60, 0x6F, 0x8B, 0x94,
+    0x88, 0x7B, 0x79, 0x7B, 0x7A, 0x7D, 0x88, 0x93, 0x89, 0x6F, 0x62, 0x78, 0x9D, 0xA4, 0x81, 0x58,
+    0x5B, 0x8A, 0xAF, 0x9F, 0x6B, 0x50, 0x6C, 0x9C, 0xAA, 0x89, 0x62, 0x60, 0x7F, 0x99, 0x94, 0x7D,
+    0x71, 0x77, 0x80, 0x82, 0x84, 0x89, 0x89, 0x7C, 0x6B, 0x6F, 0x8B, 0xA1, 0x92, 0x6B, 0x57, 0x73,
+    0xA0, 0xAB, 0x84, 0x58, 0x59, 0x87, 0xAB, 0x9E, 0x71, 0x58, 0x6D, 0x93, 0x9F, 0x89, 0x6F, 0x6D,
+    0x7D, 0x88, 0x88, 0x84, 0x83, 0x80, 0x76, 0x71, 0x7E, 0x94, 0x98, 0x7D, 0x60, 0x65, 0x8B, 0xA9,
+    0x98, 0x6A, 0x53, 0x6F, 0x9F, 0xAB, 0x86, 0x5D, 0x5D, 0x83, 0xA2, 0x99, 0x77, 0x65, 0x72, 0x89,
+    0x90, 0x87, 0x7D, 0x7C, 0x7B, 0x78, 0x7B, 0x88, 0x93, 0x89, 0x6F, 0x63, 0x79, 0x9B, 0xA2, 0x80,
+    0x5B, 0x5F, 0x8A, 0xAA, 0x9B, 0x6D, 0x56, 0x6E, 0x99, 0xA5, 0x88, 0x67, 0x65, 0x7F, 0x94, 0x90,
+    0x7E, 0x75, 0x79, 0x7E, 0x7F, 0x83, 0x8A, 0x8B, 0x7C, 0x6B, 0x70, 0x8B, 0x9F, 0x91, 0x6C, 0x5B,
+    0x74, 0x9E, 0xA7, 0x83, 0x5C, 0x5E, 0x86, 0xA6, 0x9A, 0x72, 0x5E, 0x70, 0x90, 0x9A, 0x87, 0x73,
+    0x71, 0x7D, 0x85, 0x85, 0x84, 0x85, 0x81, 0x76, 0x70, 0x7E, 0x94, 0x97, 0x7D, 0x62, 0x67, 0x8B,
+    0xA5, 0x96, 0x6C, 0x58, 0x71, 0x9C, 0xA6, 0x85, 0x61, 0x62, 0x83, 0x9D, 0x95, 0x79, 0x6A, 0x75,
+    0x86, 0x8C, 0x85, 0x7F, 0x7E, 0x7C, 0x77, 0x7A, 0x88, 0x93, 0x89, 0x70, 0x65, 0x79, 0x9A, 0x9F,
+    0x80, 0x5E, 0x62, 0x89, 0xA6, 0x98, 0x6F, 0x5B, 0x71, 0x96, 0xA0, 0x86, 0x6A, 0x6A, 0x80, 0x90,
+    0x8D, 0x7F, 0x79, 0x7B, 0x7D, 0x7D, 0x82, 0x8B, 0x8B, 0x7C, 0x6B, 0x70, 0x8A, 0x9D, 0x90, 0x6D,
+    0x5D, 0x76, 0x9B, 0xA3, 0x82, 0x5F, 0x62, 0x86, 0xA2, 0x96, 0x74, 0x63, 0x73, 0x8E, 0x95, 0x86,
+    0x76, 0x74, 0x7D, 0x83, 0x83, 0x85, 0x87, 0x82, 0x75, 0x70, 0x7E, 0x93, 0x96, 0x7D, 0x64, 0x69,
+    0x8A, 0xA2, 0x94, 0x6E, 0x5C, 0x73, 0x99, 0xA1, 0x84, 0x65, 0x66, 0x83, 0x99, 0x91, 0x7A, 0x6E,
+    0x77, 0x85, 0x89, 0x84, 0x81, 0x80, 0x7C, 0x76, 0x79, 0x88, 0x93, 0x89, 0x70, 0x66, 0x7A, 0x98,
+    0x9D, 0x80, 0x61, 0x65, 0x88, 0xA2, 0x95, 0x71, 0x5F, 0x73, 0x93, 0x9B, 0x85, 0x6E, 0x6D, 0x80,
+    0x8D, 0x8A, 0x80, 0x7B, 0x7C, 0x7C, 0x7C, 0x81, 0x8B, 0x8C, 0x7C, 0x6C, 0x71, 0x8A, 0x9B, 0x8E,
+    0x6E, 0x60, 0x77, 0x99, 0x9F, 0x82, 0x63, 0x65, 0x86, 0x9D, 0x93, 0x76, 0x67, 0x75, 0x8B, 0x91,
+    0x85, 0x78, 0x77, 0x7D, 0x81, 0x81, 0x85, 0x88, 0x82, 0x75, 0x70, 0x7E, 0x93, 0x95, 0x7D, 0x66,
+    0x6B, 0x8A, 0x9F, 0x92, 0x6F, 0x60, 0x75, 0x96, 0x9D, 0x84, 0x68, 0x69, 0x82, 0x95, 0x8F, 0x7B,
+    0x72, 0x79, 0x83, 0x86, 0x84, 0x83, 0x82, 0x7C, 0x75, 0x79, 0x88, 0x93, 0x88, 0x71, 0x68, 0x7B,
+    0x97, 0x9A, 0x7F, 0x64, 0x68, 0x88, 0x9F, 0x92, 0x72, 0x63, 0x75, 0x91, 0x97, 0x84, 0x71, 0x71,
+    0x7F, 0x8A, 0x88, 0x81, 0x7E, 0x7D, 0x7B, 0x7A, 0x81, 0x8C, 0x8C, 0x7C, 0x6D, 0x72, 0x89, 0x9A,
+    0x8D, 0x70, 0x63, 0x78, 0x97, 0x9C, 0x81, 0x66, 0x69, 0x85, 0x9A, 0x90, 0x77, 0x6B, 0x77, 0x89,
+    0x8E, 0x84, 0x7A, 0x7A, 0x7D, 0x7F, 0x80, 0x85, 0x89, 0x83, 0x75, 0x70, 0x7E, 0x92, 0x94, 0x7E,
+    0x68, 0x6D, 0x89, 0x9D, 0x90, 0x71, 0x63, 0x76, 0x94, 0x9A, 0x83, 0x6B, 0x6D, 0x82, 0x91, 0x8C,
+    0x7C, 0x75, 0x7A, 0x82, 0x84, 0x83, 0x84, 0x83, 0x7C, 0x75, 0x79, 0x88, 0x92, 0x88, 0x72, 0x69,
+    0x7B, 0x95, 0x98, 0x7F, 0x66, 0x6A, 0x87, 0x9B, 0x90, 0x74, 0x67, 0x77, 0x8E, 0x94, 0x84, 0x73,
+    0x73, 0x7F, 0x88, 0x86, 0x81, 0x7F, 0x7E, 0x7B, 0x79, 0x81, 0x8C, 0x8C, 0x7D, 0x6E, 0x72, 0x89,
+    0x98, 0x8C, 0x71, 0x66, 0x79, 0x95, 0x99, 0x81, 0x69, 0x6C, 0x85, 0x96, 0x8E, 0x78, 0x6E, 0x78,
+    0x88, 0x8B, 0x84, 0x7C, 0x7C, 0x7D, 0x7E, 0x7F, 0x85, 0x89, 0x83, 0x76, 0x71, 0x7E, 0x91, 0x92,
+    0x7E, 0x69, 0x6E, 0x88, 0x9A, 0x8E, 0x72, 0x66, 0x78, 0x92, 0x96, 0x82, 0x6E, 0x70, 0x82, 0x8F,
+    0x8A, 0x7D, 0x77, 0x7B, 0x81, 0x82, 0x82, 0x85, 0x84, 0x7D, 0x75, 0x79, 0x88, 0x91, 0x88, 0x73,
+    0x6B, 0x7C, 0x93, 0x96, 0x7F, 0x69, 0x6D, 0x87, 0x98, 0x8E, 0x75, 0x6A, 0x78, 0x8C, 0x91, 0x83,
+    0x76, 0x76, 0x7F, 0x85, 0x84, 0x82, 0x81, 0x7F, 0x7A, 0x79, 0x80, 0x8B, 0x8C, 0x7D, 0x6E, 0x73,
+    0x88, 0x96, 0x8B, 0x72, 0x68, 0x7A, 0x93, 0x96, 0x81, 0x6B, 0x6E, 0x84, 0x93, 0x8C, 0x79, 0x71,
+    0x7A, 0x86, 0x89, 0x83, 0x7E, 0x7D, 0x7E, 0x7C, 0x7E, 0x85, 0x8A, 0x83, 0x76, 0x71, 0x7E, 0x90,
+    0x91, 0x7E, 0x6B, 0x70, 0x88, 0x97, 0x8C, 0x73, 0x69, 0x79, 0x8F, 0x93, 0x82, 0x71, 0x72, 0x82,
+    0x8C, 0x88, 0x7E, 0x7A, 0x7C, 0x80, 0x80, 0x82, 0x85, 0x85, 0x7D, 0x75, 0x79, 0x87, 0x90, 0x87,
+    0x73, 0x6C, 0x7C, 0x92, 0x94, 0x7F, 0x6B, 0x6F, 0x86, 0x95, 0x8C, 0x76, 0x6D, 0x79, 0x8A, 0x8E,
+    0x83, 0x78, 0x78, 0x7F, 0x84, 0x83, 0x82, 0x82, 0x80, 0x7A, 0x78, 0x80, 0x8B, 0x8B, 0x7D, 0x6F,
+    0x74, 0x88, 0x94, 0x8A, 0x73, 0x6B, 0x7B, 0x91, 0x94, 0x80, 0x6E, 0x71, 0x84, 0x90, 0x8A, 0x7A,
+    0x74, 0x7B, 0x85, 0x87, 0x82, 0x7F, 0x7F, 0x7E, 0x7C, 0x7E, 0x85, 0x8A, 0x83, 0x76, 0x72, 0x7E,
+    0x8F, 0x90, 0x7E, 0x6D, 0x72, 0x87, 0x95, 0x8B, 0x75, 0x6C, 0x7A, 0x8E, 0x91, 0x82, 0x73, 0x74,
+    0x81, 0x8A, 0x86, 0x7F, 0x7B, 0x7D, 0x7F, 0x7F, 0x82, 0x86, 0x85, 0x7D, 0x75, 0x79, 0x87, 0x90,
+    0x86, 0x74, 0x6E, 0x7D, 0x90, 0x92, 0x7F, 0x6D, 0x71, 0x86, 0x93, 0x8A, 0x78, 0x70, 0x7A, 0x89,
+    0x8B, 0x82, 0x79, 0x7A, 0x7F, 0x82, 0x82, 0x82, 0x83, 0x80, 0x7A, 0x78, 0x80, 0x8B, 0x8B, 0x7D,
+    0x70, 0x75, 0x87, 0x93, 0x89, 0x74, 0x6D, 0x7B, 0x8F, 0x91, 0x80, 0x70, 0x73, 0x83, 0x8E, 0x88,
+    0x7B, 0x76, 0x7C, 0x83, 0x85, 0x82, 0x80, 0x80, 0x7E, 0x7B, 0x7D, 0x85, 0x8A, 0x83, 0x77, 0x73,
+    0x7F, 0x8E, 0x8E, 0x7E, 0x6E, 0x73, 0x87, 0x93, 0x8A, 0x76, 0x6E, 0x7B, 0x8C, 0x8E, 0x81, 0x75,
+    0x76, 0x81, 0x88, 0x85, 0x7F, 0x7D, 0x7E, 0x7E, 0x7E, 0x81, 0x86, 0x85, 0x7D, 0x75, 0x79, 0x87,
+    0x8F, 0x86, 0x75, 0x6F, 0x7D, 0x8F, 0x90, 0x7F, 0x6F, 0x73, 0x85, 0x90, 0x89, 0x79, 0x72, 0x7B,
+    0x87, 0x89, 0x82, 0x7B, 0x7B, 0x7F, 0x81, 0x81, 0x83, 0x84, 0x81, 0x7A, 0x78, 0x80, 0x8B, 0x8A,
+    0x7D, 0x71, 0x76, 0x87, 0x91, 0x88, 0x75, 0x6F, 0x7C, 0x8D, 0x8F, 0x80, 0x72, 0x75, 0x83, 0x8C,
+    0x87, 0x7C, 0x78, 0x7C, 0x82, 0x84, 0x82, 0x81, 0x80, 0x7E, 0x7B, 0x7D, 0x85, 0x8A, 0x83, 0x77,
+    0x73, 0x7F, 0x8D, 0x8D, 0x7E, 0x70, 0x74, 0x86, 0x91, 0x88, 0x77, 0x71, 0x7C, 0x8A, 0x8C, 0x81,
+    0x77, 0x78, 0x81, 0x86, 0x84, 0x80, 0x7E, 0x7E, 0x7E, 0x7E, 0x81, 0x86, 0x86, 0x7D, 0x76, 0x79,
+    0x86, 0x8E, 0x85, 0x76, 0x71, 0x7E, 0x8D, 0x8E, 0x7F, 0x71, 0x75, 0x85, 0x8E, 0x88, 0x7A, 0x74,
+    0x7C, 0x86, 0x88, 0x82, 0x7C, 0x7C, 0x7F, 0x80, 0x81, 0x83, 0x84, 0x81, 0x7A, 0x78, 0x80, 0x8A,
+    0x8A, 0x7D, 0x72, 0x77, 0x87, 0x90, 0x87, 0x76, 0x71, 0x7D, 0x8C, 0x8D, 0x80, 0x74, 0x76, 0x83,
+    0x8A, 0x86, 0x7D, 0x7A, 0x7D, 0x82, 0x82, 0x82, 0x82, 0x81, 0x7E, 0x7A, 0x7D, 0x85, 0x89, 0x83,
+    0x77, 0x74, 0x7F, 0x8C, 0x8C, 0x7E, 0x71, 0x76, 0x86, 0x8F, 0x87, 0x78, 0x73, 0x7C, 0x89, 0x8A,
+    0x81, 0x78, 0x79, 0x80, 0x85, 0x83, 0x80, 0x7F, 0x7F, 0x7D, 0x7D, 0x81, 0x86, 0x86, 0x7D, 0x76,
+    0x7A, 0x86, 0x8D, 0x85, 0x76, 0x72, 0x7E, 0x8C, 0x8D, 0x7F, 0x73, 0x76, 0x84, 0x8C, 0x87, 0x7B,
+    0x76, 0x7D, 0x85, 0x86, 0x81, 0x7D, 0x7D, 0x7F, 0x7F, 0x80, 0x83, 0x85, 0x81, 0x7A, 0x78, 0x80,
+    0x8A, 0x89, 0x7D, 0x73, 0x78, 0x86, 0x8E, 0x86, 0x77, 0x72, 0x7D, 0x8B, 0x8C, 0x80, 0x76, 0x78,
+    0x82, 0x88, 0x85, 0x7E, 0x7B, 0x7E, 0x81, 0x81, 0x81, 0x82, 0x82, 0x7E, 0x7A, 0x7D, 0x85, 0x89,
+    0x83, 0x78, 0x75, 0x7F, 0x8B, 0x8B, 0x7E, 0x73, 0x77, 0x85, 0x8D, 0x86, 0x79, 0x74, 0x7D, 0x88,
+    0x89, 0x81, 0x7A, 0x7B, 0x80, 0x83, 0x82, 0x81, 0x80, 0x7F, 0x7D, 0x7D, 0x81, 0x86, 0x85, 0x7D,
+    0x76, 0x7A, 0x86, 0x8C, 0x84, 0x77, 0x74, 0x7E, 0x8B, 0x8B, 0x7F, 0x74, 0x77, 0x84, 0x8B, 0x86,
+    0x7B, 0x78, 0x7D, 0x84, 0x85, 0x81, 0x7E, 0x7E, 0x7F, 0x7E, 0x80, 0x83, 0x85, 0x81, 0x7A, 0x79,
+    0x80, 0x89, 0x88, 0x7D, 0x74, 0x78, 0x86, 0x8D, 0x85, 0x78, 0x74, 0x7E, 0x89, 0x8A, 0x80, 0x77,
+    0x79, 0x82, 0x87, 0x84, 0x7E, 0x7C, 0x7E, 0x80, 0x81, 0x81, 0x83, 0x82, 0x7E, 0x7A, 0x7D, 0x85,
+    0x89, 0x83, 0x78, 0x76, 0x7F, 0x8A, 0x8A, 0x7E, 0x74, 0x78, 0x85, 0x8C, 0x85, 0x7A, 0x76, 0x7D,
+    0x87, 0x87, 0x81, 0x7B, 0x7C, 0x80, 0x82, 0x82, 0x81, 0x81, 0x7F, 0x7D, 0x7C, 0x81, 0x86, 0x85,
+    0x7D, 0x77, 0x7B, 0x85, 0x8B, 0x84, 0x78, 0x75, 0x7F, 0x8A, 0x8A, 0x7F, 0x76, 0x78, 0x83, 0x89,
+    0x85, 0x7C, 0x79, 0x7E, 0x83, 0x84, 0x81, 0x7F, 0x7F, 0x7F, 0x7E, 0x7F, 0x83, 0x85, 0x81, 0x7A,
+    0x79, 0x80, 0x89, 0x88, 0x7D, 0x75, 0x79, 0x85, 0x8B, 0x85, 0x79, 0x75, 0x7E, 0x88, 0x89, 0x80,
+    0x78, 0x7A, 0x82, 0x86, 0x83, 0x7F, 0x7D, 0x7F, 0x80, 0x80, 0x81, 0x83, 0x82, 0x7E, 0x7A, 0x7D,
+    0x85, 0x88, 0x82, 0x79, 0x77, 0x7F, 0x89, 0x89, 0x7E, 0x75, 0x79, 0x84, 0x8A, 0x85, 0x7A, 0x77,
+    0x7E, 0x86, 0x86, 0x80, 0x7C, 0x7D, 0x80, 0x82, 0x81, 0x81, 0x81, 0x80, 0x7D, 0x7C, 0x81, 0x86,
+    0x85, 0x7D, 0x77, 0x7B, 0x85, 0x8A, 0x84, 0x79, 0x76, 0x7F, 0x89, 0x89, 0x7F, 0x77, 0x7A, 0x83,
+    0x88, 0x84, 0x7D, 0x7A, 0x7E, 0x82, 0x83, 0x81, 0x80, 0x80, 0x7F, 0x7E, 0x7F, 0x83, 0x85, 0x81,
+    0x7A, 0x79, 0x80, 0x88, 0x87, 0x7E, 0x76, 0x7A, 0x85, 0x8A, 0x84, 0x79, 0x77, 0x7E, 0x87, 0x87,
+    0x80, 0x7A, 0x7B, 0x81, 0x85, 0x83, 0x7F, 0x7E, 0x7F, 0x7F, 0x7F, 0x81, 0x83, 0x82, 0x7E, 0x7A,
+    0x7D, 0x84, 0x88, 0x82, 0x79, 0x77, 0x80, 0x89, 0x88, 0x7E, 0x76, 0x7A, 0x84, 0x89, 0x84, 0x7B,
+    0x79, 0x7E, 0x85, 0x85, 0x80, 0x7D, 0x7D, 0x80, 0x81, 0x81, 0x81, 0x82, 0x80, 0x7D, 0x7C, 0x81,
+    0x86, 0x85, 0x7E, 0x78, 0x7B, 0x85, 0x89, 0x83, 0x79, 0x77, 0x7F, 0x88, 0x88, 0x7F, 0x78, 0x7A,
+    0x82, 0x87, 0x83, 0x7D, 0x7B, 0x7E, 0x82, 0x82, 0x81, 0x80, 0x80, 0x7F, 0x7D, 0x7F, 0x83, 0x85,
+    0x81, 0x7B, 0x7A, 0x80, 0x87, 0x86, 0x7E, 0x77, 0x7B, 0x84, 0x89, 0x84, 0x7A, 0x78, 0x7F, 0x86,
+    0x86, 0x80, 0x7B, 0x7C, 0x81, 0x84, 0x82, 0x80, 0x7F, 0x7F, 0x7F, 0x7F, 0x81, 0x83, 0x82, 0x7E,
+    0x7A, 0x7D, 0x84, 0x87, 0x82, 0x7A, 0x78, 0x80, 0x88, 0x87, 0x7E, 0x78, 0x7B, 0x83, 0x88, 0x83,
+    0x7C, 0x7A, 0x7E, 0x84, 0x84, 0x80, 0x7E, 0x7E, 0x80, 0x80, 0x80, 0x82, 0x82, 0x80, 0x7D, 0x7C,
+    0x81, 0x86, 0x85, 0x7E, 0x79, 0x7C, 0x84, 0x88, 0x83, 0x7A, 0x78, 0x7F, 0x87, 0x87, 0x7F, 0x79,
+    0x7B, 0x82, 0x86, 0x83, 0x7E, 0x7C, 0x7F, 0x81, 0x81, 0x81, 0x81, 0x80, 0x7F, 0x7D, 0x7F, 0x83,
+    0x85, 0x81, 0x7B, 0x7A, 0x80, 0x87, 0x86, 0x7E, 0x78, 0x7B, 0x84, 0x88, 0x83, 0x7B, 0x79, 0x7F,
+    0x85, 0x85, 0x80, 0x7B, 0x7D, 0x81, 0x83, 0x82, 0x80, 0x7F, 0x7F, 0x7F, 0x7F, 0x81, 0x83, 0x83,
+    0x7E, 0x7B, 0x7D, 0x84, 0x87, 0x82, 0x7A, 0x79, 0x80, 0x87, 0x86, 0x7E, 0x78, 0x7B, 0x83, 0x87,
+    0x83, 0x7C, 0x7B, 0x7F, 0x83, 0x83, 0x80, 0x7E, 0x7F, 0x7F, 0x80, 0x80, 0x82, 0x82, 0x80, 0x7D,
+    0x7C, 0x81, 0x85, 0x84, 0x7E, 0x79, 0x7C, 0x84, 0x88, 0x82, 0x7A, 0x79, 0x7F, 0x86, 0x86, 0x7F,
+    0x7A, 0x7C, 0x82, 0x85, 0x82, 0x7E, 0x7D, 0x7F, 0x81, 0x81, 0x81, 0x81, 0x81, 0x7F, 0x7D, 0x7F,
+    0x83, 0x85, 0x81, 0x7B, 0x7B, 0x80, 0x86, 0x85, 0x7E, 0x79, 0x7C, 0x84, 0x87, 0x83, 0x7B, 0x7A,
+    0x7F, 0x85, 0x85, 0x80, 0x7C, 0x7D, 0x81, 0x82, 0x81, 0x80, 0x80, 0x7F, 0x7E, 0x7E, 0x81, 0x83,
+    0x82, 0x7E, 0x7B, 0x7E, 0x84, 0x86, 0x82, 0x7B, 0x7A, 0x80, 0x86, 0x86, 0x7F, 0x79, 0x7C, 0x83,
+    0x86, 0x82, 0x7D, 0x7C, 0x7F, 0x83, 0x83, 0x80, 0x7F, 0x7F, 0x7F, 0x7F, 0x80, 0x82, 0x82, 0x80,
+    0x7D, 0x7C, 0x81, 0x85, 0x84, 0x7E, 0x7A, 0x7D, 0x84, 0x87, 0x82, 0x7B, 0x7A, 0x7F, 0x86, 0x85,
+    0x7F, 0x7B, 0x7D, 0x82, 0x84, 0x82, 0x7F, 0x7E, 0x7F, 0x80, 0x80, 0x81, 0x81, 0x81, 0x7F, 0x7D,
+    0x7F, 0x83, 0x84, 0x81, 0x7B, 0x7B, 0x80, 0x86, 0x85, 0x7E, 0x79, 0x7C, 0x83, 0x86, 0x82, 0x7C,
+    0x7B, 0x7F, 0x84, 0x84, 0x80, 0x7D, 0x7E, 0x80, 0x81, 0x81, 0x80, 0x80, 0x80, 0x7E, 0x7E, 0x81,
+    0x83, 0x82, 0x7E, 0x7B, 0x7E, 0x83, 0x86, 0x81, 0x7B, 0x7A, 0x80, 0x86, 0x85, 0x7F, 0x7A, 0x7C,
+    0x82, 0x85, 0x82, 0x7D, 0x7C, 0x7F, 0x82, 0x82, 0x80, 0x7F, 0x7F, 0x7F, 0x7F, 0x80, 0x82, 0x82,
+    0x80, 0x7D, 0x7D, 0x81, 0x85, 0x84, 0x7E, 0x7A, 0x7D, 0x83, 0x86, 0x82, 0x7C, 0x7A, 0x80, 0x85,
+    0x84, 0x7F, 0x7C, 0x7D, 0x81, 0x83, 0x82, 0x7F, 0x7E, 0x7F, 0x80, 0x80, 0x81, 0x82, 0x81, 0x7F,
+    0x7D, 0x7F, 0x83, 0x84, 0x81, 0x7C, 0x7B, 0x80, 0x85, 0x84, 0x7E, 0x7A, 0x7D, 0x83, 0x86, 0x82,
+    0x7C, 0x7B, 0x7F, 0x83, 0x83, 0x80, 0x7E, 0x7E, 0x80, 0x81, 0x81, 0x81, 0x81, 0x80, 0x7E, 0x7E,
+    0x81, 0x83, 0x82, 0x7E, 0x7B, 0x7E, 0x83, 0x85, 0x81, 0x7C, 0x7B, 0x80, 0x85, 0x84, 0x7F, 0x7B,
+    0x7D, 0x82, 0x84, 0x82, 0x7E, 0x7D, 0x7F, 0x82, 0x82, 0x80, 0x80, 0x80, 0x7F, 0x7F, 0x80, 0x82,
+    0x83, 0x80, 0x7D, 0x7D, 0x81, 0x84, 0x83, 0x7E, 0x7B, 0x7D, 0x83, 0x85, 0x82, 0x7C, 0x7B, 0x80,
+    0x84, 0x84, 0x7F, 0x7C, 0x7E, 0x81, 0x83, 0x81, 0x7F, 0x7F, 0x7F, 0x80, 0x80, 0x81, 0x82, 0x81,
+    0x7F, 0x7D, 0x7F, 0x83, 0x84, 0x81, 0x7C, 0x7C, 0x80, 0x85, 0x84, 0x7E, 0x7B, 0x7D, 0x83, 0x85,
+    0x82, 0x7D, 0x7C, 0x7F, 0x83, 0x83, 0x80, 0x7E, 0x7F, 0x80, 0x81, 0x81, 0x81, 0x81, 0x80, 0x7E,
+    0x7E, 0x81, 0x83, 0x82, 0x7E, 0x7C, 0x7E, 0x83, 0x85, 0x81, 0x7C, 0x7B, 0x80, 0x85, 0x84, 0x7F
+};
+
+// the clips, as handed to PCM_Play
+const PCMClip_t PCMClip_Zap = {
+  ZapSamples, sizeof(ZapSamples), PCM_SAMPLE_PERIOD(PCM_SAMPLE_RATE)
+};
+
+const PCMClip_t PCMClip_Boom = {
+  BoomSamples, sizeof(BoomSamples), PCM_SAMPLE_PERIOD(PCM_SAMPLE_RATE)
+};
+
+const PCMClip_t PCMClip_Chime = {
+  ChimeSamples, sizeof(ChimeSamples), PCM_SAMPLE_PERIOD(PCM_SAMPLE_RATE)
+};
+
+/*------------------------------ End of file ------------------------------*/
@@ -12,7 +12,9 @@
 *****************************************************************************/
 /*----------------------------- Include Files -----------------------------*/
 #include <xc.h>
+#include <sys/attribs.h> // for ISR macros
 #include <stdbool.h> 
+#include <stddef.h>
 #include "PIC32_SPI_HAL.h"
 
 /*--------------------------- External Variables --------------------------*/
@@ -25,6 +27,14 @@
 #define MAP_SDO1 0b0011
 #define MAP_SDO2 0b0100
 
+// sizes of the SPI1 transaction queue, both must be powers of 2
+#define SPI1_QUEUE_WORDS  128
+#define SPI1_QUEUE_FRAMES 16
+// interrupt when the transmit buffer is half empty or more
+#define STXISEL_HALF_EMPTY 0b10
+#define SPI1_INT_PRIORITY 6
+#define SS1_INT_PRIORITY  5
+
 /*------------------------------ Module Types -----------------------------*/
 
 /*---------------------------- Module Functions ---------------------------*/
@@ -33,6 +43,7 @@ static bool isSPI_ModuleLegal( SPI_Module_t WhichModule);
 static bool isSS_OutputPinLegal(SPI_Module_t WhichModule, 
                                 SPI_PinMap_t WhichPin);
 static bool isSDOPinLegal( SPI_PinMap_t WhichPin);
+static bool startNextFrame(void);
 
 /*---------------------------- Module Variables ---------------------------*/
   // these will allow us to reference both SPI1 & SPI2 through these pointers
@@ -102,6 +113,19 @@ static SPI_PinMap_t const LegalSDOxPins[] = { SPI_NO_PIN, SPI_RPA1, SPI_RPA2,
                                               SPI_RPB11, SPI_RPB13 
 };
 
+// SPI1 transaction queue. The head indices belong to the ISRs, the tail
+// indices to the main line code. All four run freely and are masked on use.
+static uint16_t QueueWords[SPI1_QUEUE_WORDS];
+static uint8_t QueueFrameLens[SPI1_QUEUE_FRAMES];
+static volatile uint16_t WordHead;
+static volatile uint16_t WordTail;
+static volatile uint8_t FrameHead;
+static volatile uint8_t FrameTail;
+static volatile uint8_t WordsLeftInFrame;
+static volatile bool IsQueueBusy;
+static volatile uint16_t NumUnderruns;
+static SPI_FrameDoneFunc_t pFrameDoneFunc;
+
 /*------------------------------ Module Code ------------------------------*/
 
 
@@ -718,6 +742,167 @@ bool SPIOperate_HasSS1_Risen(void)
   return ReturnVal;
 }
 
+/****************************************************************************
+ Function
+    SPIOperate_SPI1_HasRoom
+ Description
+   Tests if there is room in the SPI1 transmit buffer for another word
+****************************************************************************/
+bool SPIOperate_SPI1_HasRoom(void)
+{
+  return (0 == SPI1STATbits.SPITBF);
+}
+
+/****************************************************************************
+ Function
+    SPIQueue_SPI1_Init
+
+ Description
+   Switches SPI1 over to interrupt driven transmission. The SPI1 TX interrupt
+   fills the enhanced buffer with the words of the frame at the head of the
+   queue, the INT4 (SS1 rising) interrupt marks the frame as latched and
+   starts the next one. SPI1 must already be configured in enhanced buffer
+   mode with SS1 mapped. The blocking SPI1 Wait functions must not be used
+   after this call, INT4IF now belongs to the ISR.
+****************************************************************************/
+bool SPIQueue_SPI1_Init(SPI_FrameDoneFunc_t pDoneFunc)
+{
+  if (0 == SPI1CONbits.ENHBUF)
+  {
+    return false; // the ISR relies on the FIFO
+  }
+  __builtin_disable_interrupts();
+  WordHead = WordTail = 0;
+  FrameHead = FrameTail = 0;
+  WordsLeftInFrame = 0;
+  IsQueueBusy = false;
+  NumUnderruns = 0;
+  pFrameDoneFunc = pDoneFunc;
+
+  SPI1CONbits.STXISEL = STXISEL_HALF_EMPTY;
+  IPC7bits.SPI1IP = SPI1_INT_PRIORITY;
+  IFS1CLR = _IFS1_SPI1TXIF_MASK;
+  IEC1CLR = _IEC1_SPI1TXIE_MASK; // only enabled while a frame has words left
+
+  IPC4bits.INT4IP = SS1_INT_PRIORITY;
+  IFS0CLR = _IFS0_INT4IF_MASK;
+  IEC0SET = _IEC0_INT4IE_MASK;
+  __builtin_enable_interrupts();
+  return true;
+}
+
+/****************************************************************************
+ Function
+    SPIQueue_SPI1_AddFrame
+
+ Description
+   Copies the words of one SS framed transfer into the queue and starts
+   transmission if the bus is idle. Returns false, queuing nothing, if the
+   whole frame does not fit.
+****************************************************************************/
+bool SPIQueue_SPI1_AddFrame(const uint16_t *pWords, uint8_t NumWords)
+{
+  uint8_t i;
+
+  if ((0 == NumWords) || (NumWords > SPI1_QUEUE_WORDS))
+  {
+    return false;
+  }
+  // the ISRs only ever free space, so a check that passes stays true
+  if ((((uint16_t)(WordTail - WordHead)) + NumWords > SPI1_QUEUE_WORDS) ||
+      ((uint8_t)(FrameTail - FrameHead) >= SPI1_QUEUE_FRAMES))
+  {
+    return false;
+  }
+  for (i = 0; i < NumWords; i++)
+  {
+    QueueWords[(WordTail + i) & (SPI1_QUEUE_WORDS - 1)] = pWords[i];
+  }
+  QueueFrameLens[FrameTail & (SPI1_QUEUE_FRAMES - 1)] = NumWords;
+
+  __builtin_disable_interrupts();
+  WordTail += NumWords;
+  FrameTail++;
+  if (false == IsQueueBusy)
+  {
+    startNextFrame();
+  }
+  __builtin_enable_interrupts();
+  return true;
+}
+
+/****************************************************************************
+ Function
+    SPIQueue_SPI1_IsIdle
+
+ Description
+   Tests if every queued frame has been clocked out and latched
+****************************************************************************/
+bool SPIQueue_SPI1_IsIdle(void)
+{
+  return (false == IsQueueBusy);
+}
+
+/****************************************************************************
+ Function
+    SPIQueue_SPI1_GetUnderruns
+
+ Description
+   Returns the number of times SS1 rose before a frame was complete, i.e. the
+   TX interrupt was held off long enough for the FIFO to run dry
+****************************************************************************/
+uint16_t SPIQueue_SPI1_GetUnderruns(void)
+{
+  return NumUnderruns;
+}
+
+/****************************************************************************
+ Function
+    SPI1_TxISR
+
+ Description
+   Tops up the transmit buffer from the frame in progress, and turns itself
+   off once the last word of the frame is in the buffer.
+****************************************************************************/
+void __ISR(_SPI_1_VECTOR, IPL6AUTO) SPI1_TxISR(void)
+{
+  while ((0 != WordsLeftInFrame) && (0 == SPI1STATbits.SPITBF))
+  {
+    SPI1BUF = QueueWords[WordHead & (SPI1_QUEUE_WORDS - 1)];
+    WordHead++;
+    WordsLeftInFrame--;
+  }
+  if (0 == WordsLeftInFrame)
+  {
+    IEC1CLR = _IEC1_SPI1TXIE_MASK;
+  }
+  IFS1CLR = _IFS1_SPI1TXIF_MASK;
+}
+
+/****************************************************************************
+ Function
+    SS1_RiseISR
+
+ Description
+   SS1 has risen, so the chain has latched the frame. Start the next one, or
+   report that the queue has drained.
+****************************************************************************/
+void __ISR(_EXTERNAL_4_VECTOR, IPL5AUTO) SS1_RiseISR(void)
+{
+  IFS0CLR = _IFS0_INT4IF_MASK;
+  if (0 != WordsLeftInFrame)
+  {
+    // SS rose part way through a frame, the rest will go out as a frame of
+    // its own. Count it, the display owner resends once the queue drains.
+    NumUnderruns++;
+    return;
+  }
+  if ((false == startNextFrame()) && (NULL != pFrameDoneFunc))
+  {
+    pFrameDoneFunc();
+  }
+}
+
 /****************************************************************************
  Function
     SPIOperate_HasSS2_Risen
@@ -812,6 +997,29 @@ static bool isSS_OutputPinLegal(SPI_Module_t WhichModule, SPI_PinMap_t WhichPin)
   return ReturnVal;
 }
 
+/****************************************************************************
+ Function
+    startNextFrame
+
+ Description
+   Called with interrupts off or from an ISR. Moves the next queued frame into
+   progress and lets the TX interrupt start filling the buffer. Returns false
+   if the queue is empty.
+****************************************************************************/
+static bool startNextFrame(void)
+{
+  if (FrameHead == FrameTail)
+  {
+    IsQueueBusy = false;
+    return false;
+  }
+  WordsLeftInFrame = QueueFrameLens[FrameHead & (SPI1_QUEUE_FRAMES - 1)];
+  FrameHead++;
+  IsQueueBusy = true;
+  IEC1SET = _IEC1_SPI1TXIE_MASK;
+  return true;
+}
+
 /****************************************************************************
  Function
     isSDOPinLegal
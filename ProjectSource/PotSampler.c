@@ -0,0 +1,150 @@
+/****************************************************************************
+ Module
+     PotSampler.c
+ Description
+     Interrupt driven sampling and filtering of the difficulty knob. See
+     PotSampler.h.
+ Notes
+     The ADC runs auto sample, auto convert on AN5 with the buffer split in
+     two 8 word halves, so the ISR reads the half that has just filled
+     while the ADC fills the other. Nothing stops or restarts sampling.
+
+     All the arithmetic is adds, shifts and one multiply. The filter keeps
+     the reading with 6 bits of fraction so that the low pass does not
+     stall short of the input. Level boundaries are worked out in 1/256ths
+     of a level; the level moves only once the reading is more than
+     POT_HYSTERESIS past the edge of the present level.
+*****************************************************************************/
+/*----------------------------- Include Files -----------------------------*/
+#include <xc.h>
+#include <sys/attribs.h> // for ISR macros
+#include <stdbool.h>
+#include "PotSampler.h"
+
+/*----------------------------- Module Defines ----------------------------*/
+#define POT_CHANNEL         5   // AN5 is RB3
+#define POT_SAMPLES_PER_INT 8   // one buffer half
+#define POT_BLOCK_SHIFT     3   // log2 of POT_SAMPLES_PER_INT
+#define POT_ADCS            255 // TAD = 2 * (ADCS + 1) PBCLK periods
+#define POT_SAMC            31  // acquisition time in TAD
+#define POT_INT_PRIORITY    2
+
+#define FILTER_FRACTION     6   // bits of fraction kept in Filtered
+#define POT_IIR_SHIFT       3   // alpha = 1/8, a time constant of ~70ms
+// Filtered * LEVEL_SCALE >> 16 maps 0-65472 onto 0-99 levels, Q8
+#define LEVEL_SCALE         25369UL
+#define HALF_LEVEL          128
+#define POT_HYSTERESIS      96  // 3/8 of a level, about 4 ADC counts
+
+/*---------------------------- Module Functions ---------------------------*/
+static uint16_t readBlock(void);
+static void updateLevel(void);
+
+/*---------------------------- Module Variables ---------------------------*/
+static volatile uint16_t Filtered;  // 0-1023 in Q6
+static volatile uint8_t Level = POT_MIN_LEVEL;
+
+/*------------------------------ Module Code ------------------------------*/
+/****************************************************************************
+ Function
+    PotSampler_Init
+
+ Description
+   Auto sample, auto convert on AN5 alone, interrupting every 8 conversions
+   into alternating buffer halves. The first block is waited for with the
+   interrupt off and seeds the filter and the level directly.
+****************************************************************************/
+bool PotSampler_Init(void)
+{
+  AD1CON1bits.ON = 0;
+  IEC0CLR = _IEC0_AD1IE_MASK;
+
+  AD1CON1 = 0;
+  AD1CON1bits.SSRC = 0b111;  // internal counter ends sampling
+  AD1CON2 = 0;
+  AD1CON2bits.BUFM = 1;      // two 8 word halves
+  AD1CON2bits.CSCNA = 1;     // scan, of just the one input
+  AD1CON2bits.SMPI = POT_SAMPLES_PER_INT - 1;
+  AD1CON3 = 0;
+  AD1CON3bits.ADCS = POT_ADCS;
+  AD1CON3bits.SAMC = POT_SAMC;
+  AD1CHS = 0;
+  AD1CSSL = 1 << POT_CHANNEL;
+  IPC5bits.AD1IP = POT_INT_PRIORITY;
+  IFS0CLR = _IFS0_AD1IF_MASK;
+
+  AD1CON1bits.ON = 1;
+  AD1CON1bits.ASAM = 1;
+  while (0 == IFS0bits.AD1IF)
+  {}
+  Filtered = readBlock() << FILTER_FRACTION;
+  Level = POT_MIN_LEVEL +
+          ((((Filtered * LEVEL_SCALE) >> 16) + HALF_LEVEL) >> 8);
+  IFS0CLR = _IFS0_AD1IF_MASK;
+  IEC0SET = _IEC0_AD1IE_MASK;
+  return true;
+}
+
+/****************************************************************************
+ Function
+    PotSampler_GetLevel
+****************************************************************************/
+uint8_t PotSampler_GetLevel(void)
+{
+  return Level;
+}
+
+/****************************************************************************
+ Function
+    PotSampler_GetFiltered
+****************************************************************************/
+uint16_t PotSampler_GetFiltered(void)
+{
+  return Filtered;
+}
+
+/****************************************************************************
+ Function
+    PotSampler_ADCISR
+
+ Description
+   A buffer half is full: average it into the filter and requantize.
+****************************************************************************/
+void __ISR(_ADC_VECTOR, IPL2AUTO) PotSampler_ADCISR(void)
+{
+  int32_t Input = (int32_t)readBlock() << FILTER_FRACTION;
+
+  IFS0CLR = _IFS0_AD1IF_MASK;
+  Filtered += (Input - (int32_t)Filtered) >> POT_IIR_SHIFT;
+  updateLevel();
+}
+
+/*--------------------------- private functions ---------------------------*/
+// the mean of the buffer half the ADC is not filling
+static uint16_t readBlock(void)
+{
+  volatile uint32_t *pResult;
+  uint32_t Sum = 0;
+  uint8_t i;
+
+  // BUFS 1: the ADC is filling 8-F, so 0-7 is ours
+  pResult = (1 == AD1CON2bits.BUFS) ? &ADC1BUF0 : &ADC1BUF8;
+  for (i = 0; i < POT_SAMPLES_PER_INT; i++)
+  {
+    // ADC1BUFx are 16 bytes apart
+    Sum += pResult[4 * i];
+  }
+  return (uint16_t)(Sum >> POT_BLOCK_SHIFT);
+}
+
+static void updateLevel(void)
+{
+  int32_t Position = (int32_t)((Filtered * LEVEL_SCALE) >> 16);
+  int32_t Centre = (int32_t)(Level - POT_MIN_LEVEL) << 8;
+
+  if ((Position > Centre + HALF_LEVEL + POT_HYSTERESIS) ||
+      (Position < Centre - HALF_LEVEL - POT_HYSTERESIS))
+  {
+    Level = POT_MIN_LEVEL + ((Position + HALF_LEVEL) >> 8);
+  }
+}
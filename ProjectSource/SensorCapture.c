@@ -0,0 +1,283 @@
+/****************************************************************************
+ Module
+     SensorCapture.c
+ Description
+     Debounced falling edge capture for the game's sensor inputs, polled or
+     from the change notification interrupt. See SensorCapture.h.
+ Notes
+     The sensor pins of both ports are packed into one word, port B in the
+     low half and port A in the high half, so that one Debounce_Sample
+     covers them all. Every sample, and in CN mode every change notice,
+     first goes through noteFalls, which stamps a pin the first time it is
+     seen to fall from a debounced high. The stamp is dropped again if the
+     pin settles back high, and goes out with the edge if the fall holds.
+     Edges are found as (last & ~now) over the whole word and handed out
+     by count trailing zeros, so a quiet sample costs one snapshot and a
+     compare, and a busy one costs a step per edge, never per pin.
+
+     In CN mode the change notice and Timer4 interrupts are at the same
+     priority, so neither interrupts the other and they can share the
+     debouncer. Timer4 runs only while Debounce_Busy says a pin is still
+     settling.
+
+     The ring buffer has a single producer (the Timer4 ISR, or the event
+     checker in polled mode) and a single consumer (the event checker). Head
+     is only written by the producer and Tail only by the consumer, so
+     neither side needs interrupts off.
+*****************************************************************************/
+/*----------------------------- Include Files -----------------------------*/
+#include <xc.h>
+#include <sys/attribs.h> // for ISR macros
+#include <stdbool.h>
+#include <stddef.h>
+#include "SensorCapture.h"
+#include "Debounce.h"
+
+/*----------------------------- Module Defines ----------------------------*/
+// must be a power of 2
+#define EDGE_RING_SIZE 16
+
+#define CAPTURE_INT_PRIORITY 3 // both CN and Timer4
+#define CNCON_ON_MASK        0x00008000
+
+#define PBCLK_HZ             20000000L
+#define CORE_COUNTS_PER_US   20 // CP0 Count, SYSCLK/2
+#define TIMER_PRESCALE_8     0b011
+#define SAMPLE_TIMER_PERIOD \
+  ((SENSOR_SAMPLE_PERIOD_US * (PBCLK_HZ / 1000000L)) / 8 - 1)
+#define SAMPLE_CORE_COUNTS   (SENSOR_SAMPLE_PERIOD_US * CORE_COUNTS_PER_US)
+
+#define PORTA_SENSOR_MASK ((1 << 2) | (1 << 3))
+#define PORTB_SENSOR_MASK ((1 << 2) | (1 << 5) | (1 << 8) | (1 << 9) | \
+                           (1 << 10))
+#define PORTA_SHIFT 16
+
+/*---------------------------- Module Functions ---------------------------*/
+static uint32_t readSensorPins(void);
+static void noteFalls(uint32_t Raw, uint32_t Stamp);
+static void sampleSensors(uint32_t Stamp);
+static void queueEdges(uint32_t Falling);
+
+/*---------------------------- Module Variables ---------------------------*/
+// which sensor is on each bit of the packed pin word, only the bits in the
+// masks are used
+static const uint8_t SensorForBit[32] = {
+  [2] = SENSOR_COIN, [5] = SENSOR_PLANET_1, [8] = SENSOR_PLANET_2,
+  [9] = SENSOR_ASTEROID, [10] = SENSOR_BLACK_HOLE,
+  [PORTA_SHIFT + 2] = SENSOR_PLANET_3, [PORTA_SHIFT + 3] = SENSOR_PLANET_4
+};
+
+static SensorEdge_t EdgeRing[EDGE_RING_SIZE];
+static volatile uint8_t EdgeHead;  // next slot to fill
+static volatile uint8_t EdgeTail;  // next slot to collect
+static volatile uint16_t NumOverruns;
+
+static Debounce_t Debouncer;
+static uint32_t LastRaw;           // packed pins as last read
+static uint32_t StampedPins;       // pins with a fall stamped in FallStamp
+static uint32_t FallStamp[NUM_SENSORS];
+static uint32_t LastSampleCount;   // CP0 Count of the last polled sample
+
+static SensorCaptureMode_t CurrentMode = SENSOR_CAPTURE_POLL;
+
+/*------------------------------ Module Code ------------------------------*/
+/****************************************************************************
+ Function
+    SensorCapture_Init
+
+ Description
+   Turns change notification and Timer4 off, empties the ring and starts
+   the debouncer from the pins as they are now. In CN mode it then sets
+   Timer4 up as the sample clock and enables change notification on just
+   the sensor pins.
+****************************************************************************/
+bool SensorCapture_Init(SensorCaptureMode_t Mode)
+{
+  if ((SENSOR_CAPTURE_POLL != Mode) && (SENSOR_CAPTURE_CN != Mode))
+  {
+    return false;
+  }
+  IEC1CLR = _IEC1_CNAIE_MASK | _IEC1_CNBIE_MASK;
+  IEC0CLR = _IEC0_T4IE_MASK;
+  CNCONACLR = CNCON_ON_MASK;
+  CNCONBCLR = CNCON_ON_MASK;
+  T4CONbits.ON = 0;
+
+  EdgeHead = EdgeTail = 0;
+  NumOverruns = 0;
+  CurrentMode = Mode;
+
+  if (SENSOR_CAPTURE_CN == Mode)
+  {
+    T4CONbits.TCS = 0;  // use PBClk as clock source
+    T4CONbits.TCKPS = TIMER_PRESCALE_8;
+    PR4 = SAMPLE_TIMER_PERIOD;
+    IPC4bits.T4IP = CAPTURE_INT_PRIORITY;
+    CNENA = PORTA_SENSOR_MASK;
+    CNENB = PORTB_SENSOR_MASK;
+    CNCONASET = CNCON_ON_MASK;
+    CNCONBSET = CNCON_ON_MASK;
+    IPC8bits.CNIP = CAPTURE_INT_PRIORITY;
+  }
+  LastRaw = readSensorPins(); // this read also ends any pending mismatch
+  Debounce_Init(&Debouncer, LastRaw, SENSOR_STABLE_SAMPLES);
+  StampedPins = 0;
+  LastSampleCount = _CP0_GET_COUNT();
+  IFS1CLR = _IFS1_CNAIF_MASK | _IFS1_CNBIF_MASK;
+  IFS0CLR = _IFS0_T4IF_MASK;
+  if (SENSOR_CAPTURE_CN == Mode)
+  {
+    IEC0SET = _IEC0_T4IE_MASK;
+    IEC1SET = _IEC1_CNAIE_MASK | _IEC1_CNBIE_MASK;
+  }
+  return true;
+}
+
+/****************************************************************************
+ Function
+    SensorCapture_GetEdge
+****************************************************************************/
+bool SensorCapture_GetEdge(SensorEdge_t *pEdge)
+{
+  uint32_t Now;
+
+  if (SENSOR_CAPTURE_POLL == CurrentMode)
+  {
+    Now = _CP0_GET_COUNT();
+    if ((Now - LastSampleCount) >= SAMPLE_CORE_COUNTS)
+    {
+      LastSampleCount = Now;
+      sampleSensors(Now);
+    }
+  }
+  if (EdgeTail == EdgeHead)
+  {
+    return false;
+  }
+  *pEdge = EdgeRing[EdgeTail & (EDGE_RING_SIZE - 1)];
+  EdgeTail++;
+  return true;
+}
+
+/****************************************************************************
+ Function
+    SensorCapture_GetMode
+****************************************************************************/
+SensorCaptureMode_t SensorCapture_GetMode(void)
+{
+  return CurrentMode;
+}
+
+/****************************************************************************
+ Function
+    SensorCapture_GetOverruns
+****************************************************************************/
+uint16_t SensorCapture_GetOverruns(void)
+{
+  return NumOverruns;
+}
+
+/****************************************************************************
+ Function
+    SensorCapture_CNISR
+
+ Description
+   A sensor pin has changed. Stamp it first, then read both ports, which
+   ends the mismatch, note any falls and make sure Timer4 is sampling.
+****************************************************************************/
+void __ISR(_CHANGE_NOTICE_VECTOR, IPL3AUTO) SensorCapture_CNISR(void)
+{
+  uint32_t Stamp = _CP0_GET_COUNT();
+  uint32_t Raw = readSensorPins();
+
+  IFS1CLR = _IFS1_CNAIF_MASK | _IFS1_CNBIF_MASK;
+  noteFalls(Raw, Stamp);
+  if (0 == T4CONbits.ON)
+  {
+    TMR4 = 0;
+    T4CONbits.ON = 1;
+  }
+}
+
+/****************************************************************************
+ Function
+    SensorCapture_SampleISR
+
+ Description
+   One debounce sample. Stops Timer4 once every pin has settled; the next
+   change notice starts it again.
+****************************************************************************/
+void __ISR(_TIMER_4_VECTOR, IPL3AUTO) SensorCapture_SampleISR(void)
+{
+  IFS0CLR = _IFS0_T4IF_MASK;
+  sampleSensors(_CP0_GET_COUNT());
+  if (0 == Debounce_Busy(&Debouncer))
+  {
+    T4CONbits.ON = 0;
+  }
+}
+
+/*--------------------------- private functions ---------------------------*/
+static uint32_t readSensorPins(void)
+{
+  return ((PORTA & PORTA_SENSOR_MASK) << PORTA_SHIFT) |
+         (PORTB & PORTB_SENSOR_MASK);
+}
+
+// stamps pins that have just gone low from a debounced high, unless the
+// fall they are part of is already stamped
+static void noteFalls(uint32_t Raw, uint32_t Stamp)
+{
+  uint32_t Fell = LastRaw & ~Raw & Debouncer.State & ~StampedPins;
+
+  StampedPins |= Fell;
+  while (0 != Fell)
+  {
+    FallStamp[SensorForBit[__builtin_ctz(Fell)]] = Stamp;
+    Fell &= Fell - 1;
+  }
+  LastRaw = Raw;
+}
+
+static void sampleSensors(uint32_t Stamp)
+{
+  uint32_t Raw = readSensorPins();
+  uint32_t Changed;
+
+  // nothing moving and nothing settling, the usual case when polled
+  if ((Raw == Debouncer.State) && (0 == Debounce_Busy(&Debouncer)))
+  {
+    LastRaw = Raw;
+    StampedPins = 0; // any fall noted since was a glitch
+    return;
+  }
+  noteFalls(Raw, Stamp);
+  Changed = Debounce_Sample(&Debouncer, Raw);
+  queueEdges(Changed & ~Debouncer.State);
+  // pins that have flipped, or gone back to their level, lose their stamp
+  StampedPins &= Debounce_Busy(&Debouncer);
+}
+
+// one ring entry per set bit in Falling, lowest bit first
+static void queueEdges(uint32_t Falling)
+{
+  SensorEdge_t *pSlot;
+  Sensor_t WhichSensor;
+
+  while (0 != Falling)
+  {
+    WhichSensor = SensorForBit[__builtin_ctz(Falling)];
+    if ((uint8_t)(EdgeHead - EdgeTail) >= EDGE_RING_SIZE)
+    {
+      NumOverruns++;
+    }
+    else
+    {
+      pSlot = &EdgeRing[EdgeHead & (EDGE_RING_SIZE - 1)];
+      pSlot->WhichSensor = WhichSensor;
+      pSlot->Stamp = FallStamp[WhichSensor];
+      EdgeHead++;
+    }
+    Falling &= Falling - 1;
+  }
+}
@@ -4,6 +4,10 @@ Module
 
 Description
     This is a source file to control all LEDs by way of shift register updates.
+    Two ways of clocking the chain out are provided: a burst that writes the
+    whole chain and latches it from a single ES_UPDATE_SHIFT, and the original
+    timer-stepped sequence that moves one pin per SHIFT_TIMER expiry. The
+    burst is used unless Shift_SetBurstMode(false) has been called.
 ****************************************************************************/
 /*----------------------------- Include Files -----------------------------*/
 /* include header files for this state machine as well as any machines at the
@@ -20,7 +24,8 @@ Description
 #include "PWM_PIC32.h"
 #include "ES_DeferRecall.h"
 
-#include "dbprintf.h"
+#define BINLOG_MODULE BINLOG_MODULE_SHIFT
+#include "binlog.h"
 #include <stdlib.h>
 #include <stdio.h>
 #include <string.h>
@@ -31,10 +36,27 @@ Description
 #define ENTER_TIMEOUT  ((MyPriority<<3)|2)
 
 // Shift register
-#define DATA    LATBbits.LATB11
-#define CLK     LATBbits.LATB12
-#define OUTPUT  LATBbits.LATB13
-#define NUM_SHIFT 13 // number of outputs used on shift registers
+#define DATA_MASK   (1 << 11) // RB11
+#define CLK_MASK    (1 << 12) // RB12
+#define OUTPUT_MASK (1 << 13) // RB13, latched into the outputs on rising edge
+#define NUM_SHIFT 13 // number of outputs used on shift registers, see SHIFT_ALL_LEDS
+
+// SCK2 is fixed to RB15 (vibration motor), so SPI2 cannot clock this chain.
+// Pins are driven with the atomic SET/CLR registers instead; successive
+// writes are one PBCLK (50ns) apart, inside the 74HC595 setup and pulse
+// width limits at 3.3V.
+#ifndef TEST
+#define PIN_HI(Mask) (LATBSET = (Mask))
+#define PIN_LO(Mask) (LATBCLR = (Mask))
+#else
+static void TestSetPin(uint32_t Mask, bool IsHigh);
+#define PIN_HI(Mask) TestSetPin((Mask), true)
+#define PIN_LO(Mask) TestSetPin((Mask), false)
+#endif
+
+/*---------------------------- Module Functions ---------------------------*/
+static void ShiftOutBurst(uint16_t Outputs);
+static void RequestUpdate(void);
 
 /*---------------------------- Module Variables ---------------------------*/
 // State Machine Variables
@@ -45,7 +67,16 @@ static ShiftState_t NextState;
 // Shift register variables
 static uint8_t ShiftsRemaining = NUM_SHIFT;
 static uint16_t ShiftInterval = 1; // keep as low as possible
-extern uint8_t ShiftRegisterVals[13]; // extern from GameService
+static bool IsBurstMode = true;
+
+// LED state, bit n drives output n
+static uint16_t LEDState = 0;       // what the game wants shown
+static uint16_t OverlayMask = 0;    // outputs currently owned by a sequence
+static uint16_t OverlayLEDs = 0;
+static uint16_t LatchedState = 0;   // what the chain is showing
+static uint16_t ShiftingState;      // snapshot being clocked out
+static bool IsLatchedKnown = false; // chain contents are unknown at reset
+static bool IsUpdatePosted = false;
 
 // Deferral queue variables
 static ES_Event_t DeferralQueue[5];
@@ -73,17 +104,16 @@ bool InitShiftService(uint8_t Priority)
 {
 
     // Init the shift register
-    TRISBbits.TRISB11 = 0;   //output
-    TRISBbits.TRISB12 = 0;   //output
-    TRISBbits.TRISB13 = 0;   //output
-    OUTPUT = 1;
+    TRISBCLR = DATA_MASK | CLK_MASK | OUTPUT_MASK; //outputs
+    PIN_LO(CLK_MASK);
+    PIN_HI(OUTPUT_MASK);
     
     // State machine vars
     ES_Event_t ThisEvent;
-    NextState = Waiting2Coins_P;
+    NextState = WaitingShift;
     MyPriority = Priority;
 
-    DB_printf("InitShiftService\n");
+    LOG_INFO("InitShiftService\n");
     
     ES_InitDeferralQueueWith(DeferralQueue, ARRAY_SIZE(DeferralQueue));
     
@@ -117,6 +147,110 @@ bool PostShiftService(ES_Event_t ThisEvent)
     return ES_PostToService(MyPriority, ThisEvent);
 }
 
+/****************************************************************************
+Function
+    Shift_SetLEDs
+
+Parameters
+    uint16_t : new state of every output, bit n is output n
+
+Returns
+    nothing
+
+Description
+    Replaces the whole LED state and asks for an update. The chain is only
+    reshifted if the state differs from what it last latched.
+****************************************************************************/
+void Shift_SetLEDs(uint16_t NewLEDs)
+{
+    LEDState = NewLEDs & SHIFT_ALL_LEDS;
+    RequestUpdate();
+}
+
+/****************************************************************************
+Function
+    Shift_SetLED
+
+Parameters
+    uint8_t : which output, 0 to NUM_SHIFT - 1
+    bool : true to turn it on
+
+Returns
+    nothing
+
+Description
+    Changes a single LED and asks for an update. Any number of changes made
+    while handling one event go out together in a single shift.
+****************************************************************************/
+void Shift_SetLED(uint8_t WhichLED, bool IsOn)
+{
+    if (WhichLED >= NUM_SHIFT){
+        return;
+    }
+    if (true == IsOn){
+        LEDState |= (1 << WhichLED);
+    } else {
+        LEDState &= ~(1 << WhichLED);
+    }
+    RequestUpdate();
+}
+
+/****************************************************************************
+Function
+    Shift_SetOverlay
+
+Parameters
+    uint16_t : the outputs the overlay takes over, 0 to release them all
+    uint16_t : the state of those outputs
+
+Returns
+    nothing
+
+Description
+    Used by LEDSeqService to show animation frames on top of the game's
+    LEDs. Outputs in the mask show the overlay, the rest show the state set
+    with Shift_SetLED(s), which carries on being tracked underneath.
+****************************************************************************/
+void Shift_SetOverlay(uint16_t Mask, uint16_t LEDs)
+{
+    OverlayMask = Mask & SHIFT_ALL_LEDS;
+    OverlayLEDs = LEDs & OverlayMask;
+    RequestUpdate();
+}
+
+/****************************************************************************
+Function
+    Shift_GetLEDs
+
+Returns
+    uint16_t, the LED state most recently set, bit n is output n. Does not
+    include any overlay.
+****************************************************************************/
+uint16_t Shift_GetLEDs(void)
+{
+    return LEDState;
+}
+
+/****************************************************************************
+Function
+    Shift_SetBurstMode
+
+Parameters
+    bool : true to clock the chain out in one burst, false to fall back to
+           one pin change per SHIFT_TIMER expiry
+
+Returns
+    nothing
+
+Description
+    Takes effect from the next ES_UPDATE_SHIFT. The stepped path is slow
+    (about 40ms for the chain) but can be watched on a meter or scope.
+****************************************************************************/
+void Shift_SetBurstMode(bool IsBurst)
+{
+    IsBurstMode = IsBurst;
+}
+
 /****************************************************************************
 Function
     RunShiftService
@@ -129,7 +263,8 @@ Returns
 
 Description
     Waits for shift event and then updates the shift registers via
-    clock, data line, and output latch sequence.
+    clock, data line, and output latch sequence. Updates requested while a
+    stepped update is in progress are deferred until it finishes.
 ****************************************************************************/
 ES_Event_t RunShiftService(ES_Event_t ThisEvent)
 {
@@ -140,23 +275,28 @@ ES_Event_t RunShiftService(ES_Event_t ThisEvent)
     
     switch (CurrentState)
     {
-        case Waiting:
+        case WaitingShift:
         {
             if (ThisEvent.EventType == ES_INIT){
                 // Reset LEDs to initial state (all off)
-                uint8_t newVals[13] = {0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0};
-                memcpy(ShiftRegisterVals, newVals, sizeof(ShiftRegisterVals));
-
-                // Post shift update event
-                static ES_Event_t ShiftEvent;
-                ShiftEvent.EventType = ES_UPDATE_SHIFT;
-                ShiftEvent.EventParam = MyPriority;
-                PostShiftService(ShiftEvent);
+                Shift_SetLEDs(0);
             }
             else if (ThisEvent.EventType == ES_UPDATE_SHIFT){
-                OUTPUT = 1; // turn off output
-                NextState = UpdatingShift;
-                ES_Timer_InitTimer(SHIFT_TIMER, ShiftInterval);
+                // take one copy of the state for the whole shift, it is
+                // only ever changed from service context
+                IsUpdatePosted = false;
+                ShiftingState = (LEDState & ~OverlayMask) | OverlayLEDs;
+                if ((true == IsLatchedKnown) && (ShiftingState == LatchedState)){
+                    // nothing has changed since the last latch
+                } else if (true == IsBurstMode){
+                    ShiftOutBurst(ShiftingState);
+                    LatchedState = ShiftingState;
+                    IsLatchedKnown = true;
+                } else {
+                    PIN_HI(OUTPUT_MASK); // latch idles high
+                    NextState = UpdatingShift;
+                    ES_Timer_InitTimer(SHIFT_TIMER, ShiftInterval);
+                }
             }
         }
         break;
@@ -165,31 +305,42 @@ ES_Event_t RunShiftService(ES_Event_t ThisEvent)
             static uint8_t ShiftStep = 0;
             static bool LatchHi = true;
 
-            if(ThisEvent.EventParam == 9 && ThisEvent.EventType == ES_TIMEOUT){
+            if (ThisEvent.EventType == ES_UPDATE_SHIFT){
+                // the values may change again, send them once this is done
+                ES_DeferEvent(DeferralQueue, ThisEvent);
+            }
+            else if(ThisEvent.EventParam == SHIFT_TIMER && ThisEvent.EventType == ES_TIMEOUT){
                 if (ShiftsRemaining > 0){ // still shifting bits
                     if (ShiftStep == 0){ // setting data line
-                        DATA = ShiftRegisterVals[ShiftsRemaining-1];
+                        if (0 != (ShiftingState & (1 << (ShiftsRemaining-1)))){
+                            PIN_HI(DATA_MASK);
+                        } else {
+                            PIN_LO(DATA_MASK);
+                        }
                         ES_Timer_InitTimer(SHIFT_TIMER, ShiftInterval);
                         ShiftStep++;
                     } else if (ShiftStep == 1){ // setting clock high
-                        CLK = 1;
+                        PIN_HI(CLK_MASK);
                         ES_Timer_InitTimer(SHIFT_TIMER, ShiftInterval);
                         ShiftStep++;
                     } else if (ShiftStep == 2){ // setting clock low
-                        CLK = 0;
+                        PIN_LO(CLK_MASK);
                         ES_Timer_InitTimer(SHIFT_TIMER, ShiftInterval);
                         ShiftStep = 0;
                         ShiftsRemaining--;
                     }
                 } else  if (LatchHi){ // shift complete, pulse output latch
-                    OUTPUT = 0;
+                    PIN_LO(OUTPUT_MASK);
                     ES_Timer_InitTimer(SHIFT_TIMER, ShiftInterval);
                     LatchHi = false;
                 } else { // reset output latch
-                    OUTPUT = 1;
+                    PIN_HI(OUTPUT_MASK);
                     LatchHi = true;
-                    NextState = Waiting;
+                    NextState = WaitingShift;
                     ShiftsRemaining = NUM_SHIFT;
+                    LatchedState = ShiftingState;
+                    IsLatchedKnown = true;
+                    ES_RecallEvents(MyPriority, DeferralQueue);
                 }
             }
         }
@@ -202,6 +353,315 @@ ES_Event_t RunShiftService(ES_Event_t ThisEvent)
     return ReturnEvent;
 }
 
+/***************************************************************************
+ private functions
+ ***************************************************************************/
+/****************************************************************************
+Function
+    ShiftOutBurst
+
+Parameters
+    uint16_t : the outputs to latch, bit n is output n
+
+Returns
+    nothing
+
+Description
+    Clocks every output into the chain, last output first, then pulses the
+    latch. Takes a few microseconds.
+****************************************************************************/
+static void ShiftOutBurst(uint16_t Outputs)
+{
+    uint8_t i;
+
+    for (i = NUM_SHIFT; i > 0; i--)
+    {
+        if (0 != (Outputs & (1 << (i - 1)))){
+            PIN_HI(DATA_MASK);
+        } else {
+            PIN_LO(DATA_MASK);
+        }
+        PIN_HI(CLK_MASK);
+        PIN_LO(CLK_MASK);
+    }
+    PIN_LO(OUTPUT_MASK);
+    PIN_HI(OUTPUT_MASK);
+}
+
+/****************************************************************************
+Function
+    RequestUpdate
+
+Description
+    Posts ES_UPDATE_SHIFT unless one is already waiting, so a run of changes
+    costs one event and one shift.
+****************************************************************************/
+static void RequestUpdate(void)
+{
+    ES_Event_t ShiftEvent;
+
+    if (true == IsUpdatePosted){
+        return;
+    }
+    ShiftEvent.EventType = ES_UPDATE_SHIFT;
+    ShiftEvent.EventParam = MyPriority;
+    IsUpdatePosted = PostShiftService(ShiftEvent);
+}
+
+#ifdef TEST
+/* Host test that the burst and the timer-stepped paths put the same bit
+   stream on the chain, and that unchanged LED state is not reshifted. The
+   framework calls are replaced by stubs, pin writes are captured, and the
+   state of the chain is decoded at each latch.
+   gcc -DTEST -IHostTools/include -IFrameworkHeaders -IProjectHeaders
+       ProjectSource/ShiftService.c -o shift_test && ./shift_test
+*/
+#include <stdio.h>
+#undef printf // dbprintf.h sends it to DB_printf, stubbed out below
+
+#define MAX_BITS 64
+
+volatile uint32_t TRISBCLR;
+
+static uint32_t PinState;
+static uint8_t ClockedBits[MAX_BITS];
+static uint8_t NumClocked;
+static uint8_t NumLatches;
+static uint16_t ChainOutputs; // decoded at the last latch
+static bool IsTimerRunning;
+static uint16_t NumTimerStarts;
+static ES_Event_t PostedEvent;
+static uint8_t NumPosted;
+static ES_Event_t DeferredEvent;
+static bool IsEventDeferred;
+static uint8_t NumFailed = 0;
+
+static void TestSetPin(uint32_t Mask, bool IsHigh)
+{
+  uint8_t i;
+  bool WasHigh = (0 != (PinState & Mask));
+
+  PinState = IsHigh ? (PinState | Mask) : (PinState & ~Mask);
+  if ((true == IsHigh) && (false == WasHigh))
+  {
+    if (CLK_MASK == Mask)
+    {
+      if (MAX_BITS == NumClocked)
+      {
+        // keep the most recent bits
+        memmove(&ClockedBits[0], &ClockedBits[1], MAX_BITS - 1);
+        NumClocked--;
+      }
+      ClockedBits[NumClocked++] = (0 != (PinState & DATA_MASK));
+    }
+    else if ((OUTPUT_MASK == Mask) && (NumClocked >= NUM_SHIFT))
+    {
+      // the last bit clocked in sits in the first output
+      ChainOutputs = 0;
+      for (i = 0; i < NUM_SHIFT; i++)
+      {
+        ChainOutputs |= ClockedBits[NumClocked - 1 - i] << i;
+      }
+      NumLatches++;
+    }
+  }
+}
+
+bool ES_PostToService(uint8_t WhichService, ES_Event_t ThisEvent)
+{
+  (void)WhichService;
+  PostedEvent = ThisEvent;
+  NumPosted++;
+  return true;
+}
+
+ES_TimerReturn_t ES_Timer_InitTimer(uint8_t Num, uint16_t NewTime)
+{
+  (void)Num;
+  (void)NewTime;
+  IsTimerRunning = true;
+  NumTimerStarts++;
+  return ES_Timer_OK;
+}
+
+uint8_t ES_InitQueue(ES_Event_t *pBlock, uint8_t BlockSize)
+{
+  (void)pBlock;
+  return BlockSize;
+}
+
+bool ES_EnQueueLIFO(ES_Event_t *pBlock, ES_Event_t Event2Add)
+{
+  (void)pBlock;
+  DeferredEvent = Event2Add;
+  IsEventDeferred = true;
+  return true;
+}
+
+bool ES_RecallEvents(uint8_t WhichService, ES_Event_t *pBlock)
+{
+  (void)pBlock;
+  if (true == IsEventDeferred)
+  {
+    IsEventDeferred = false;
+    ES_PostToService(WhichService, DeferredEvent);
+    return true;
+  }
+  return false;
+}
+
+void DB_printf(const char *Format, ...)
+{
+  (void)Format;
+}
+
+uint16_t BinLogMask = 0xFFFF;
+
+static void check(bool Passed, const char *pWhat)
+{
+  if (false == Passed)
+  {
+    printf("FAIL: %s\n", pWhat);
+    NumFailed++;
+  }
+}
+
+// runs the service until it stops asking for events
+static void pump(void)
+{
+  ES_Event_t ThisEvent;
+
+  for (;;)
+  {
+    if (0 != NumPosted)
+    {
+      NumPosted--;
+      RunShiftService(PostedEvent);
+    }
+    else if (true == IsTimerRunning)
+    {
+      IsTimerRunning = false;
+      ThisEvent.EventType = ES_TIMEOUT;
+      ThisEvent.EventParam = SHIFT_TIMER;
+      RunShiftService(ThisEvent);
+    }
+    else
+    {
+      return;
+    }
+  }
+}
+
+static void resetCapture(void)
+{
+  NumClocked = 0;
+  NumLatches = 0;
+  NumTimerStarts = 0;
+}
+
+int main(void)
+{
+  static const uint16_t Patterns[] = { 0x1FFF, 0x1555, 0x0AAA,
+                                       0x0001, 0x1000, 0x0F0F, 0x0000 };
+  uint8_t BurstBits[MAX_BITS];
+  uint8_t BurstClocked;
+  uint8_t p;
+  uint8_t i;
+  ES_Event_t ThisEvent;
+
+  printf("Shift chain test: %d outputs\n", NUM_SHIFT);
+  InitShiftService(0);
+  pump(); // ES_INIT clears the outputs
+  check(1 == NumLatches, "init shifts once even though the state is 0");
+  check(0 == ChainOutputs, "init clears the chain");
+
+  for (p = 0; p < (sizeof(Patterns) / sizeof(Patterns[0])); p++)
+  {
+    Shift_SetBurstMode(true);
+    resetCapture();
+    Shift_SetLEDs(Patterns[p]);
+    pump();
+    check(1 == NumLatches, "burst latches once");
+    check(NUM_SHIFT == NumClocked, "burst clocks every output");
+    check(0 == NumTimerStarts, "burst needs no timer");
+    check(Patterns[p] == ChainOutputs, "burst latches the requested outputs");
+    memcpy(BurstBits, ClockedBits, sizeof(BurstBits));
+    BurstClocked = NumClocked;
+
+    // the same state again is not reshifted
+    resetCapture();
+    Shift_SetLEDs(Patterns[p]);
+    pump();
+    check(0 == NumLatches, "unchanged state is skipped");
+
+    // move away, then come back with the stepped path
+    Shift_SetLEDs(~Patterns[p]);
+    pump();
+    Shift_SetBurstMode(false);
+    resetCapture();
+    Shift_SetLEDs(Patterns[p]);
+    pump();
+    check(1 == NumLatches, "stepped latches once");
+    check(((NUM_SHIFT * 3) + 2) == NumTimerStarts, "stepped timer count");
+    check((BurstClocked == NumClocked) &&
+          (0 == memcmp(BurstBits, ClockedBits, NumClocked)),
+          "stepped bit stream matches burst");
+  }
+
+  // many changes in one event cost one post and one shift
+  Shift_SetBurstMode(true);
+  Shift_SetLEDs(0);
+  pump();
+  resetCapture();
+  for (i = 0; i < NUM_SHIFT; i++)
+  {
+    Shift_SetLED(i, true);
+  }
+  check(1 == NumPosted, "one post for a run of changes");
+  pump();
+  check((1 == NumLatches) && (SHIFT_ALL_LEDS == ChainOutputs), "run of changes");
+
+  // an LED turned off and on again before the shift is no change at all
+  resetCapture();
+  Shift_SetLED(3, false);
+  Shift_SetLED(3, true);
+  pump();
+  check(0 == NumLatches, "off then on again is skipped");
+
+  // a change made mid-way through a stepped update is not lost
+  Shift_SetBurstMode(false);
+  Shift_SetLEDs(0);
+  NumPosted--;
+  RunShiftService(PostedEvent); // starts the stepped shift of 0
+  resetCapture();
+  IsTimerRunning = false;
+  ThisEvent.EventType = ES_TIMEOUT;
+  ThisEvent.EventParam = SHIFT_TIMER;
+  RunShiftService(ThisEvent); // first data bit is out
+  Shift_SetLED(0, true);
+  pump();
+  check(2 == NumLatches, "deferred update sent after the first");
+  check(0x0001 == ChainOutputs, "deferred update carries the new value");
+  check(0x0001 == Shift_GetLEDs(), "state reads back");
+
+  // an overlay owns only the outputs in its mask
+  Shift_SetBurstMode(true);
+  Shift_SetLEDs(0x0003);
+  Shift_SetOverlay(0x0012, 0x1FF0);
+  pump();
+  check(0x0011 == ChainOutputs, "overlay composited through its mask");
+  Shift_SetLED(1, false); // hidden under the overlay
+  Shift_SetLED(2, true);
+  pump();
+  check(0x0015 == ChainOutputs, "game LEDs change around the overlay");
+  Shift_SetOverlay(0, 0);
+  pump();
+  check(0x0005 == ChainOutputs, "releasing the overlay shows the game LEDs");
+
+  printf("%s: %d failures\n", (0 == NumFailed) ? "PASS" : "FAIL", NumFailed);
+  return NumFailed;
+}
+#endif
 /*------------------------------- Footnotes -------------------------------*/
 /*------------------------------ End of file ------------------------------*/
 
@@ -0,0 +1,125 @@
+/****************************************************************************
+ Module
+     Telemetry.c
+ Description
+     Gathers and frames the telemetry record. See Telemetry.h.
+ Notes
+     The record is built straight into a payload buffer as varints, so
+     counts that are usually small, the queue depths and the events run in
+     one period, take a byte each. Dispatch counts go out as differences
+     from the last record and the loop statistics are taken and restarted,
+     so every record covers just its own period, whether or not the one
+     before it was sent.
+*****************************************************************************/
+/*----------------------------- Include Files -----------------------------*/
+#include <xc.h>
+#include <stdbool.h>
+#include "ES_Configure.h"
+#include "ES_Framework.h"
+#include "terminal.h"
+#include "binlog.h"
+#include "GameService.h"
+#include "Telemetry.h"
+
+/*----------------------------- Module Defines ----------------------------*/
+#define COUNTDOWN_STEP_S  10   // each countdown LED is 10 seconds
+#define STAMP_BYTES       6    // site id and CP0 Count
+#define MAX_VARINT        5
+#define NUM_GAME_FIELDS   4    // sequence, state, score, countdown
+#define NUM_LOOP_FIELDS   4    // passes, longest, total, skipped
+#define TELEMETRY_MAX_PAYLOAD (STAMP_BYTES + MAX_VARINT * (NUM_GAME_FIELDS + \
+                               1 + 2 * NUM_SERVICES + NUM_LOOP_FIELDS))
+#define TELEMETRY_MAX_FRAME   (TELEMETRY_MAX_PAYLOAD + 3)
+
+// 115200 baud as terminal.c sets it, 10 bits a byte
+#define LINK_BYTES_PER_S  11520UL
+#define MAX_LINK_PERCENT  10
+
+#if TELEMETRY_MAX_PAYLOAD > BINLOG_MAX_PAYLOAD
+#error "a telemetry record for this many services does not fit a frame"
+#endif
+#if (TELEMETRY_MAX_FRAME * 1000UL / TELEMETRY_PERIOD_MS) * 100 > \
+    LINK_BYTES_PER_S * MAX_LINK_PERCENT
+#error "telemetry could take more than 10% of the terminal; slow it down"
+#endif
+
+/*---------------------------- Module Functions ---------------------------*/
+
+/*---------------------------- Module Variables ---------------------------*/
+static bool IsEnabled;
+static uint32_t Sequence;
+static uint32_t NumSkipped;
+static uint32_t LastDispatched[NUM_SERVICES];
+
+/*------------------------------ Module Code ------------------------------*/
+/****************************************************************************
+ Function
+    Telemetry_Send
+****************************************************************************/
+bool Telemetry_Send(void)
+{
+  uint8_t Payload[TELEMETRY_MAX_PAYLOAD];
+  uint8_t Length = 0;
+  uint16_t Site = BINLOG_SITE_TELEMETRY;
+  uint32_t Stamp = _CP0_GET_COUNT();
+  ES_LoopStats_t Loops;
+  uint32_t Dispatched;
+  uint8_t NumServices = ES_GetNumServices();
+  uint8_t i;
+
+  // the counts move on whether or not this one goes out
+  ES_TakeLoopStats(&Loops);
+  Payload[Length++] = (uint8_t)Site;
+  Payload[Length++] = (uint8_t)(Site >> 8);
+  Payload[Length++] = (uint8_t)Stamp;
+  Payload[Length++] = (uint8_t)(Stamp >> 8);
+  Payload[Length++] = (uint8_t)(Stamp >> 16);
+  Payload[Length++] = (uint8_t)(Stamp >> 24);
+  Length += BinLog_PutVarint(&Payload[Length], Sequence++);
+  Length += BinLog_PutVarint(&Payload[Length], QueryGameService());
+  Length += BinLog_PutVarint(&Payload[Length], (int32_t)QueryGameScore());
+  Length += BinLog_PutVarint(&Payload[Length],
+                             QueryGameCountdown() * COUNTDOWN_STEP_S);
+  Length += BinLog_PutVarint(&Payload[Length], NumServices);
+  for (i = 0; i < NumServices; i++)
+  {
+    Length += BinLog_PutVarint(&Payload[Length], ES_GetQueueDepth(i));
+  }
+  for (i = 0; i < NumServices; i++)
+  {
+    Dispatched = ES_GetDispatchCount(i);
+    Length += BinLog_PutVarint(&Payload[Length], Dispatched - LastDispatched[i]);
+    LastDispatched[i] = Dispatched;
+  }
+  Length += BinLog_PutVarint(&Payload[Length], Loops.NumLoops);
+  Length += BinLog_PutVarint(&Payload[Length], Loops.MaxTicks);
+  Length += BinLog_PutVarint(&Payload[Length], Loops.TotalTicks);
+  Length += BinLog_PutVarint(&Payload[Length], NumSkipped);
+
+  if (false == IsEnabled)
+  {
+    return true;
+  }
+  // a torn frame would cost the decoder the next one too
+  if (Terminal_GetTxFree() < Length + 3)
+  {
+    NumSkipped++;
+    return false;
+  }
+  BinLog_SendFrame(Payload, Length);
+  return true;
+}
+
+/****************************************************************************
+ Function
+    Telemetry_SetEnabled / Telemetry_IsEnabled
+****************************************************************************/
+void Telemetry_SetEnabled(bool NewEnabled)
+{
+  IsEnabled = NewEnabled;
+}
+
+bool Telemetry_IsEnabled(void)
+{
+  return IsEnabled;
+}
@@ -42,8 +42,11 @@
 #include "ES_Port.h"
 #include "terminal.h"
 #include "dbprintf.h"
+#include "binlog.h"
 #include "GameService.h"
-#include "PerceptionService.h"
+#include "ShiftService.h"
+#include "Telemetry.h"
+#include "ES_Profile.h"
 
 /*----------------------------- Module Defines ----------------------------*/
 // these times assume a 10.000mS/tick timing
@@ -56,12 +59,21 @@
 #define ENTER_RUN      ((MyPriority<<3)|1)
 #define ENTER_TIMEOUT  ((MyPriority<<3)|2)
 
+#define LOG_MASK_KEY   'L'  // shows the log mask, the next key changes it
+#define TELEMETRY_KEY  'T'  // turns the telemetry records on and off
+#define PROFILE_KEY    'P'  // prints ES_Run's profile and starts it over
+#define QUEUES_KEY     'Q'  // prints the queue diagnostics and event history
+#define LATENCY_KEY    'W'  // prints how long ES_Run's passes have taken
+#define TRACE_KEY      'D'  // dumps the event trace, for HostTools/Trace_Decode
+
 //#define TEST_INT_POST
 //#define BLINK LED
 /*---------------------------- Module Functions ---------------------------*/
 /* prototypes for private functions for this service.They should be functions
    relevant to the behavior of this service
 */
+static bool HandleLogKey(char Key);
+
 #ifdef BLINK_LED
 static void InitLED(void);
 static void BlinkLED(void);
@@ -189,6 +201,7 @@ ES_Event_t RunTestHarnessService0(ES_Event_t ThisEvent)
   {
     case ES_INIT:
     {
+      ES_Timer_InitTimer(SERVICE0_TIMER, TELEMETRY_PERIOD_MS);
 //      ES_Timer_InitTimer(SERVICE0_TIMER, HALF_SEC);
 //      puts("Service 00:");
 //      DB_printf("\rES_INIT received in Service %d\r\n", MyPriority);
@@ -196,6 +209,11 @@ ES_Event_t RunTestHarnessService0(ES_Event_t ThisEvent)
     break;
     case ES_TIMEOUT:   // re-start timer & announce
     {
+      if (SERVICE0_TIMER == ThisEvent.EventParam)
+      {
+        ES_Timer_InitTimer(SERVICE0_TIMER, TELEMETRY_PERIOD_MS);
+        Telemetry_Send();
+      }
 //      ES_Timer_InitTimer(SERVICE0_TIMER, FIVE_SEC);
 ////      DB_printf("ES_TIMEOUT received from Timer %d in Service %d\r\n",
 //          ThisEvent.EventParam, MyPriority;
@@ -208,6 +226,38 @@ ES_Event_t RunTestHarnessService0(ES_Event_t ThisEvent)
     break;
     case ES_NEW_KEY:   // announce
     {
+        if (TELEMETRY_KEY == ThisEvent.EventParam)
+        {
+          Telemetry_SetEnabled(!Telemetry_IsEnabled());
+        }
+        else if (PROFILE_KEY == ThisEvent.EventParam)
+        {
+          // too long for the buffer, so wait for room rather than drop it
+          Terminal_SetTxPolicy(TERMINAL_TX_BLOCK);
+          ES_Profile_Print();
+          Terminal_SetTxPolicy(TERMINAL_TX_DROP);
+        }
+        else if (QUEUES_KEY == ThisEvent.EventParam)
+        {
+          Terminal_SetTxPolicy(TERMINAL_TX_BLOCK);
+          ES_PrintQueueStats();
+          ES_PrintEventHistory();
+          Terminal_SetTxPolicy(TERMINAL_TX_DROP);
+        }
+        else if (TRACE_KEY == ThisEvent.EventParam)
+        {
+          ES_StartTraceDump();
+        }
+        else if (LATENCY_KEY == ThisEvent.EventParam)
+        {
+          Terminal_SetTxPolicy(TERMINAL_TX_BLOCK);
+          ES_PrintLatencyStats();
+          Terminal_SetTxPolicy(TERMINAL_TX_DROP);
+        }
+        else
+        {
+          HandleLogKey((char)ThisEvent.EventParam);
+        }
 //        DB_printf("ES_NEW_KEY received with -> %c <- in Test Service\r\n",(char)ThisEvent.EventParam);
 //        if ('1' == ThisEvent.EventParam) //planet
 //        {
@@ -257,7 +307,7 @@ ES_Event_t RunTestHarnessService0(ES_Event_t ThisEvent)
 //            DB_printf("POSTING SHIFT\n");
 //            ES_Event_t NewEvent;
 //            NewEvent.EventType = ES_UPDATE_SHIFT;
-//            PostPerceptionService(NewEvent);
+//            PostShiftService(NewEvent);
 //        }
     }
     break;
@@ -272,6 +322,67 @@ ES_Event_t RunTestHarnessService0(ES_Event_t ThisEvent)
 /***************************************************************************
  private functions
  ***************************************************************************/
+/****************************************************************************
+ Function
+   HandleLogKey
+
+ Description
+   The terminal's log mask command. 'L' lists the modules with their bit
+   and whether they are on; the key after it toggles one module by its
+   hex digit, or turns them all on with '+' or off with '-'. Returns true
+   if the key was taken by the command.
+****************************************************************************/
+static bool HandleLogKey(char Key)
+{
+  static bool IsArmed = false;
+  uint16_t Mask = BinLog_GetMask();
+  uint8_t Module;
+  const char *pName;
+
+  if (LOG_MASK_KEY == Key)
+  {
+    // a line per module, more than the buffer is sure to have room for
+    Terminal_SetTxPolicy(TERMINAL_TX_BLOCK);
+    for (Module = 0; NULL != (pName = BinLog_GetModuleName(Module)); Module++)
+    {
+      DB_printf("%x %s %s\n", Module, pName,
+                (0 != (Mask & (1U << Module))) ? "on" : "off");
+    }
+    DB_printf("log mask %x: 0-f toggles, + all on, - all off\n", Mask);
+    Terminal_SetTxPolicy(TERMINAL_TX_DROP);
+    IsArmed = true;
+    return true;
+  }
+  if (false == IsArmed)
+  {
+    return false;
+  }
+  IsArmed = false;
+  if ('+' == Key)
+  {
+    Mask = 0xFFFF;
+  }
+  else if ('-' == Key)
+  {
+    Mask = 0;
+  }
+  else if ((Key >= '0') && (Key <= '9'))
+  {
+    Mask ^= 1U << (Key - '0');
+  }
+  else if ((Key >= 'a') && (Key <= 'f'))
+  {
+    Mask ^= 1U << (Key - 'a' + 10);
+  }
+  else
+  {
+    return false;
+  }
+  BinLog_SetMask(Mask);
+  DB_printf("log mask %x\n", Mask);
+  return true;
+}
+
 #ifdef BLINK_LED
 #define LED LATBbits.LATB6
 static void InitLED(void)